@@ -0,0 +1,156 @@
+/**
+ * 🏭 基準電路生成器 - AkingSPICE 2.1
+ *
+ * 每個電路族按規模參數 n 生成 SPICE 網表與對應的仿真配置
+ * (minTimeStep 取最大步長的同一量級，使各檔位的步數穩定、耗時可比)：
+ *   rc_ladder       n 節 RC 梯形網絡，階躍激勵
+ *   resistive_mesh  n×n 二維電阻網格 (僅 DC 工作點)
+ *   rlc_chain       n 級 RLC 低通濾波器鏈，正弦激勵
+ *   diode_bridge    n 個並聯負載的全橋整流器，正弦激勵
+ *   inverter_chain  n 級電阻負載 NMOS 反相器鏈，脈衝激勵
+ *   buck_converter  n 相交錯 Buck 變換器 (高邊 NMOS + 續流二極體)
+ */
+
+'use strict';
+
+/** 各規模檔位對應的 n */
+const SIZES = {
+  rc_ladder: { small: 10, medium: 50, large: 200 },
+  resistive_mesh: { small: 5, medium: 15, large: 30 },
+  rlc_chain: { small: 4, medium: 16, large: 64 },
+  diode_bridge: { small: 1, medium: 4, large: 16 },
+  inverter_chain: { small: 2, medium: 8, large: 32 },
+  buck_converter: { small: 1, medium: 2, large: 4 }
+};
+
+function rcLadder(n) {
+  const lines = [`* rc ladder (${n} sections)`, 'V1 n0 0 PULSE(0 1 0 1e-7 1e-7 1 2)'];
+  for (let i = 1; i <= n; i++) {
+    lines.push(`R${i} n${i - 1} n${i} 100`);
+    lines.push(`C${i} n${i} 0 1n`);
+  }
+  lines.push('.END');
+  return {
+    netlist: lines.join('\n'),
+    config: { endTime: 2e-5, initialTimeStep: 1e-7, maxTimeStep: 2e-7, minTimeStep: 5e-8 }
+  };
+}
+
+function resistiveMesh(n) {
+  const node = (x, y) => (x === 0 && y === 0 ? '0' : `m${x}_${y}`);
+  const lines = [`* ${n}x${n} resistive mesh`, `V1 ${node(n - 1, n - 1)} 0 DC 1`];
+  let r = 0;
+  for (let y = 0; y < n; y++) {
+    for (let x = 0; x < n; x++) {
+      if (x + 1 < n) lines.push(`R${++r} ${node(x, y)} ${node(x + 1, y)} ${100 + (r % 7) * 10}`);
+      if (y + 1 < n) lines.push(`R${++r} ${node(x, y)} ${node(x, y + 1)} ${100 + (r % 5) * 10}`);
+    }
+  }
+  lines.push('.END');
+  return { netlist: lines.join('\n'), config: { endTime: 0 } };
+}
+
+function rlcChain(n) {
+  const lines = [`* rlc filter chain (${n} stages)`, 'V1 n0 0 SIN(0 1 10k)'];
+  for (let i = 1; i <= n; i++) {
+    lines.push(`R${i} n${i - 1} x${i} 10`);
+    lines.push(`L${i} x${i} n${i} 100u`);
+    lines.push(`C${i} n${i} 0 100n`);
+  }
+  lines.push(`RLOAD n${n} 0 1k`);
+  lines.push('.END');
+  return {
+    netlist: lines.join('\n'),
+    config: { endTime: 2e-4, initialTimeStep: 5e-7, maxTimeStep: 1e-6, minTimeStep: 2e-7 }
+  };
+}
+
+function diodeBridge(n) {
+  const lines = [
+    `* full-wave diode bridge (${n} loads)`,
+    'V1 ac1 ac2 SIN(0 10 1k)',
+    'RREF ac2 0 1meg',
+    'D1 ac1 p DMOD',
+    'D2 ac2 p DMOD',
+    'D3 m ac1 DMOD',
+    'D4 m ac2 DMOD',
+    'RM m 0 1m',
+    'CF p m 10u'
+  ];
+  for (let i = 1; i <= n; i++) {
+    lines.push(`RL${i} p o${i} 10`);
+    lines.push(`CL${i} o${i} m 1u`);
+    lines.push(`RO${i} o${i} m ${1000 * i}`);
+  }
+  lines.push('.MODEL DMOD D IS=1e-14 N=1');
+  lines.push('.END');
+  return {
+    netlist: lines.join('\n'),
+    config: { endTime: 2e-3, initialTimeStep: 2e-6, maxTimeStep: 5e-6, minTimeStep: 1e-6 }
+  };
+}
+
+function inverterChain(n) {
+  const lines = [
+    `* nmos inverter chain (${n} stages)`,
+    'VDD vdd 0 DC 5',
+    'VIN s0 0 PULSE(0 5 1u 100n 100n 4u 10u)'
+  ];
+  for (let i = 1; i <= n; i++) {
+    lines.push(`RD${i} vdd s${i} 10k`);
+    lines.push(`M${i} s${i} s${i - 1} 0 0 NMOD`);
+    lines.push(`CL${i} s${i} 0 10p`);
+  }
+  lines.push('.MODEL NMOD NMOS VTH=1 KP=2e-3');
+  lines.push('.END');
+  return {
+    netlist: lines.join('\n'),
+    config: { endTime: 2e-5, initialTimeStep: 2e-8, maxTimeStep: 5e-8, minTimeStep: 1e-8 }
+  };
+}
+
+function buckConverter(n) {
+  const period = 10e-6;
+  const lines = [`* ${n}-phase interleaved buck converter`, 'VIN vin 0 DC 12'];
+  for (let k = 1; k <= n; k++) {
+    const delay = ((k - 1) * period) / n;
+    // 高邊 NMOS：柵極驅動以地為參考，導通時 Vgs ≈ 5V
+    lines.push(`VG${k} g${k} 0 PULSE(0 17 ${delay} 50n 50n 4u ${period})`);
+    lines.push(`M${k} vin g${k} sw${k} sw${k} NMOD`);
+    lines.push(`D${k} 0 sw${k} DMOD`);
+    lines.push(`L${k} sw${k} out ${20 * n}u`);
+  }
+  lines.push('COUT out 0 47u');
+  lines.push('RLOAD out 0 2');
+  lines.push('.MODEL NMOD NMOS VTH=2 KP=5');
+  lines.push('.MODEL DMOD D IS=1e-12 N=1');
+  lines.push('.END');
+  return {
+    netlist: lines.join('\n'),
+    config: { endTime: 10 * period, initialTimeStep: 5e-8, maxTimeStep: 1e-7, minTimeStep: 2e-8 }
+  };
+}
+
+const GENERATORS = {
+  rc_ladder: rcLadder,
+  resistive_mesh: resistiveMesh,
+  rlc_chain: rlcChain,
+  diode_bridge: diodeBridge,
+  inverter_chain: inverterChain,
+  buck_converter: buckConverter
+};
+
+/**
+ * 生成某規模檔位下的全部基準電路
+ * @param {'small'|'medium'|'large'} size
+ * @returns {{name: string, family: string, n: number, netlist: string, config: object}[]}
+ */
+function generateCircuits(size) {
+  return Object.keys(GENERATORS).map(family => {
+    const n = SIZES[family][size];
+    if (n === undefined) throw new Error(`Unknown benchmark size: ${size}`);
+    return { name: `${family}/${n}`, family, n, ...GENERATORS[family](n) };
+  });
+}
+
+module.exports = { SIZES, GENERATORS, generateCircuits };
@@ -0,0 +1,177 @@
+/**
+ * ⏱️ 基準測試執行與基線比較 - AkingSPICE 2.1
+ *
+ * 每個電路重複運行 repeat 次，牆鐘時間取中位數，其餘指標取自中位數那次運行：
+ * - PerformanceMetrics 各階段耗時、步數、Newton 迭代次數、矩陣分解次數
+ * - 堆內存：運行前後的差值與運行期間的峰值 (以 --expose-gc 啟動時先做 GC)
+ *   仿真經 engine.stream() 驅動，峰值在每塊交付時採樣 (最長間隔 HEAP_SAMPLE_INTERVAL_MS)
+ *
+ * 輸出格式穩定 (固定鍵序、按電路名排序、數值舍入)，便於提交基線與 diff。
+ */
+
+'use strict';
+
+const SCHEMA = 'akingspice-benchmark/1';
+
+/** 基線比較的指標 (相對增長超過閾值即為回歸) */
+const COMPARED_METRICS = ['wallTimeMs', 'steps', 'newtonIterations', 'matrixFactorizations'];
+
+const PHASES = [
+  'totalSimulationTime',
+  'matrixAssemblyTime',
+  'deviceEvaluationTime',
+  'matrixFactorizationTime',
+  'matrixSolutionTime',
+  'convergenceCheckTime',
+  'eventDetectionTime',
+  'waveformSaveTime'
+];
+
+// 讓出事件循環的開銷約 1ms，間隔取 100ms 使其對計時的影響在 1% 左右
+const HEAP_SAMPLE_INTERVAL_MS = 100;
+const STREAM_CHUNK_ROWS = 1024;
+
+const round = (value, digits = 3) => {
+  const scale = 10 ** digits;
+  return Math.round(value * scale) / scale;
+};
+
+function collectGarbage() {
+  if (typeof global.gc === 'function') global.gc();
+}
+
+// 仿真核心的診斷輸出很多，運行期間靜默 console
+async function silenced(run) {
+  const saved = { log: console.log, info: console.info, warn: console.warn, debug: console.debug };
+  const noop = () => {};
+  console.log = console.info = console.warn = console.debug = noop;
+  try {
+    return await run();
+  } finally {
+    Object.assign(console, saved);
+  }
+}
+
+/**
+ * 單次運行一個電路
+ * @param {{CircuitSimulationEngine: Function, SpiceNetlistParser: Function}} simulator
+ */
+async function runOnce(simulator, circuit, configOverrides) {
+  const parser = new simulator.SpiceNetlistParser();
+  const netlist = parser.parseNetlist(circuit.netlist);
+  const engine = new simulator.CircuitSimulationEngine({ ...circuit.config, ...configOverrides });
+  engine.addDevices(parser.createDevicesFromNetlist(netlist));
+
+  collectGarbage();
+  const heapBefore = process.memoryUsage().heapUsed;
+  let heapPeak = heapBefore;
+
+  const start = performance.now();
+  const result = await silenced(async () => {
+    const iterator = engine.stream({ chunkRows: STREAM_CHUNK_ROWS, maxLatency: HEAP_SAMPLE_INTERVAL_MS });
+    for (;;) {
+      const next = await iterator.next();
+      heapPeak = Math.max(heapPeak, process.memoryUsage().heapUsed);
+      if (next.done) return next.value;
+    }
+  });
+  const wallTimeMs = performance.now() - start;
+  const heapAfter = process.memoryUsage().heapUsed;
+  heapPeak = Math.max(heapPeak, heapAfter);
+
+  const metrics = result.performanceMetrics;
+  const phases = {};
+  for (const phase of PHASES) phases[phase] = round(metrics[phase] ?? 0);
+
+  return {
+    success: result.success === true,
+    ...(result.errorMessage ? { error: String(result.errorMessage) } : {}),
+    wallTimeMs: round(wallTimeMs),
+    steps: result.totalSteps,
+    rejectedSteps: metrics.failedSteps,
+    newtonIterations: metrics.newtonIterations,
+    matrixFactorizations: metrics.matrixFactorizations,
+    matrixRefactorizations: metrics.matrixRefactorizations,
+    phases,
+    heap: {
+      deltaBytes: heapAfter - heapBefore,
+      peakBytes: heapPeak - heapBefore
+    }
+  };
+}
+
+/**
+ * 運行一個電路 repeat 次，返回中位數那次的記錄
+ */
+async function runBenchmark(simulator, circuit, options = {}) {
+  const repeat = Math.max(1, options.repeat ?? 3);
+  const runs = [];
+  for (let i = 0; i < repeat; i++) {
+    runs.push(await runOnce(simulator, circuit, options.config ?? {}));
+  }
+  const sorted = runs.slice().sort((a, b) => a.wallTimeMs - b.wallTimeMs);
+  const median = sorted[Math.floor((sorted.length - 1) / 2)];
+  return {
+    name: circuit.name,
+    family: circuit.family,
+    n: circuit.n,
+    ...median,
+    wallTimeMinMs: sorted[0].wallTimeMs,
+    wallTimeMaxMs: sorted[sorted.length - 1].wallTimeMs
+  };
+}
+
+/**
+ * 組裝穩定的報告對象
+ */
+function createReport(results, options) {
+  return {
+    schema: SCHEMA,
+    environment: {
+      node: process.version,
+      platform: process.platform,
+      arch: process.arch
+    },
+    size: options.size,
+    repeat: options.repeat,
+    results: results.slice().sort((a, b) => (a.name < b.name ? -1 : a.name > b.name ? 1 : 0))
+  };
+}
+
+/**
+ * 與基線報告比較：指標增長超過 threshold (相對值) 或由成功變為失敗即為回歸
+ * @returns {{name: string, metric: string, baseline: number, current: number, change: number, regression: boolean}[]}
+ */
+function compareReports(current, baseline, threshold) {
+  if (baseline.schema !== SCHEMA) {
+    throw new Error(`Unsupported baseline schema: ${baseline.schema}`);
+  }
+  const byName = new Map(baseline.results.map(result => [result.name, result]));
+  const comparisons = [];
+  for (const result of current.results) {
+    const reference = byName.get(result.name);
+    if (!reference) continue;
+    if (reference.success && !result.success) {
+      comparisons.push({ name: result.name, metric: 'success', baseline: 1, current: 0, change: -1, regression: true });
+    }
+    // 失敗運行的計數只覆蓋到失敗點，與成功運行不可比
+    if (!reference.success || !result.success) continue;
+    for (const metric of COMPARED_METRICS) {
+      const before = reference[metric];
+      const after = result[metric];
+      if (typeof before !== 'number' || typeof after !== 'number') continue;
+      const change = before > 0 ? (after - before) / before : after > 0 ? Infinity : 0;
+      comparisons.push({
+        name: result.name,
+        metric,
+        baseline: before,
+        current: after,
+        change: round(change, 4),
+        regression: change > threshold
+      });
+    }
+  }
+  return comparisons;
+}
+
+module.exports = { SCHEMA, COMPARED_METRICS, runBenchmark, createReport, compareReports };
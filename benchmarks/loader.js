@@ -0,0 +1,29 @@
+/**
+ * 📦 加載仿真器模塊 (基準測試共用)
+ *
+ * 優先加載 tsc 編譯後的 dist/src，否則通過 ts-node 直接加載 src/。
+ */
+
+'use strict';
+
+const fs = require('fs');
+const path = require('path');
+
+const ROOT = path.resolve(__dirname, '..');
+
+/**
+ * @param {string[]} modules 相對 src/ 的模塊路徑 (不含擴展名)
+ * @returns {object[]} 與 modules 一一對應的導出對象
+ */
+function loadModules(modules) {
+  const load = base => modules.map(module => require(path.join(ROOT, base, module)));
+  if (modules.every(module => fs.existsSync(path.join(ROOT, 'dist/src', `${module}.js`)))) return load('dist/src');
+  try {
+    require('ts-node').register({ transpileOnly: true, compilerOptions: { module: 'commonjs' } });
+  } catch {
+    throw new Error('Simulator not built: run `npm run build` first, or install ts-node to load src/ directly');
+  }
+  return load('src');
+}
+
+module.exports = { loadModules };
@@ -0,0 +1,152 @@
+#!/usr/bin/env node
+/**
+ * 🎞️ 線性求解序列重放基準 (npm run benchmark:replay)
+ *
+ * 用法：
+ *   npm run benchmark:replay -- <recording> [選項]        重放已保存的序列 (.aksr 文件或 MatrixMarket 目錄)
+ *   npm run benchmark:replay -- --circuit <name> [選項]   先運行基準電路並錄製，再重放
+ *
+ * 選項：
+ *   --circuit <family/n>         基準電路名 (見 circuits.js，如 buck_converter/2)
+ *   --size <small|medium|large>  查找 --circuit 的規模檔位 (默認 small)
+ *   --max-frames <n>             錄製的最大幀數 (默認 10000)
+ *   --save <path>                保存錄製結果 (以 / 結尾或已存在的目錄寫 MatrixMarket，否則寫 .aksr)
+ *   --solver <list>              逗號分隔的求解器模式 (默認 numeric,klu,iterative,auto)
+ *   --mixed-precision            另以 Float32 因子 + 迭代精化重放 klu 與 auto 模式
+ *   --output <file>              將 JSON 報告寫入文件 (默認輸出到 stdout)
+ *
+ * 每種模式報告分解/求解耗時 (ms)、分解與重分解次數、精化步數，以及相對殘差 ‖Ax − b‖∞ / ‖b‖∞ 的最大值與均值。
+ */
+
+'use strict';
+
+const fs = require('fs');
+const { generateCircuits } = require('./circuits');
+const { loadModules } = require('./loader');
+
+const SCHEMA = 'akingspice-solver-replay/1';
+const SOLVER_MODES = ['numeric', 'klu', 'iterative', 'auto'];
+
+function parseArguments(argv) {
+  const options = { recording: null, circuit: null, size: 'small', maxFrames: 10000, save: null, solvers: SOLVER_MODES, mixedPrecision: false, output: null };
+  for (let i = 0; i < argv.length; i++) {
+    const flag = argv[i];
+    const value = argv[i + 1];
+    switch (flag) {
+      case '--circuit': options.circuit = value; i++; break;
+      case '--size': options.size = value; i++; break;
+      case '--max-frames': options.maxFrames = Number.parseInt(value, 10); i++; break;
+      case '--save': options.save = value; i++; break;
+      case '--solver': options.solvers = value.split(',').map(mode => mode.trim()); i++; break;
+      case '--mixed-precision': options.mixedPrecision = true; break;
+      case '--output': options.output = value; i++; break;
+      default:
+        if (flag.startsWith('--') || options.recording) throw new Error(`Unknown option: ${flag}`);
+        options.recording = flag;
+    }
+  }
+  if (!options.recording === !options.circuit) throw new Error('Specify either a recording path or --circuit <name>');
+  const unknown = options.solvers.filter(mode => !SOLVER_MODES.includes(mode));
+  if (unknown.length > 0) throw new Error(`Unknown solver mode: ${unknown.join(', ')}`);
+  if (!Number.isInteger(options.maxFrames) || options.maxFrames < 1) throw new Error('--max-frames must be a positive integer');
+  return options;
+}
+
+// 仿真核心的診斷輸出很多，錄製期間靜默 console
+async function record(modules, options) {
+  const [engineModule, parserModule, recording] = modules;
+  const circuit = generateCircuits(options.size).find(candidate => candidate.name === options.circuit);
+  if (!circuit) throw new Error(`No benchmark circuit named '${options.circuit}' at size '${options.size}'`);
+
+  const parser = new parserModule.SpiceNetlistParser();
+  const engine = new engineModule.CircuitSimulationEngine(circuit.config);
+  engine.addDevices(parser.createDevicesFromNetlist(parser.parseNetlist(circuit.netlist)));
+  const recorder = new recording.SolverRecorder({ maxFrames: options.maxFrames });
+  engine.setSolverRecorder(recorder);
+
+  const saved = { log: console.log, info: console.info, warn: console.warn, debug: console.debug, error: console.error };
+  console.log = console.info = console.warn = console.debug = console.error = () => {};
+  let result;
+  try {
+    result = await engine.runSimulation();
+  } finally {
+    Object.assign(console, saved);
+  }
+  process.stderr.write(`🎞️  ${circuit.name}: ${recorder.frames.length} frames recorded`
+    + `${recorder.droppedFrames > 0 ? ` (${recorder.droppedFrames} dropped)` : ''}`
+    + `${result.success ? '' : ' (simulation failed; frames up to the failure are kept)'}\n`);
+  return recorder.frames;
+}
+
+function save(recording, frames, path) {
+  const directory = path.endsWith('/') || (fs.existsSync(path) && fs.statSync(path).isDirectory());
+  if (directory) {
+    recording.SolverRecording.writeMatrixMarket(frames, path);
+  } else {
+    recording.SolverRecording.writeBinary(frames, path);
+  }
+  process.stderr.write(`💾 Recording saved to ${path}\n`);
+}
+
+const round = (value, digits = 3) => {
+  const scale = 10 ** digits;
+  return Math.round(value * scale) / scale;
+};
+
+async function main() {
+  const options = parseArguments(process.argv.slice(2));
+  const modules = loadModules([
+    'core/simulation/circuit_simulation_engine',
+    'core/parser/spice_netlist_parser',
+    'math/sparse/solver_recording'
+  ]);
+  const recording = modules[2];
+
+  const frames = options.circuit ? await record(modules, options) : recording.SolverRecording.read(options.recording);
+  if (frames.length === 0) throw new Error('Recording contains no frames');
+  if (options.save) save(recording, frames, options.save);
+
+  const patternChanges = frames.filter(frame => frame.patternChange).length;
+  process.stderr.write(`🔁 Replaying ${frames.length} frames (${patternChanges} pattern changes)\n`);
+
+  const runs = options.solvers.map(mode => [mode, false]);
+  if (options.mixedPrecision) {
+    runs.push(...options.solvers.filter(mode => mode === 'klu' || mode === 'auto').map(mode => [mode, true]));
+  }
+
+  const results = [];
+  for (const [mode, mixedPrecision] of runs) {
+    const result = recording.SolverRecording.replay(frames, mode, mixedPrecision);
+    const label = mixedPrecision ? `${mode}+f32` : mode;
+    process.stderr.write(`   ${label.padEnd(9)} factor ${round(result.factorTime).toString().padStart(10)} ms`
+      + `  solve ${round(result.solveTime).toString().padStart(10)} ms`
+      + `  max residual ${result.maxResidual.toExponential(2)}`
+      + `${mixedPrecision ? `  ${result.refinementSteps} refinement steps, ${result.precisionFallbacks} fallbacks` : ''}`
+      + `${result.failures > 0 ? `  ${result.failures} failed` : ''}\n`);
+    results.push({
+      ...result,
+      factorTime: round(result.factorTime),
+      solveTime: round(result.solveTime)
+    });
+  }
+
+  const report = {
+    schema: SCHEMA,
+    source: options.circuit ?? options.recording,
+    frames: frames.length,
+    patternChanges,
+    results
+  };
+  const json = `${JSON.stringify(report, null, 2)}\n`;
+  if (options.output) {
+    fs.writeFileSync(options.output, json);
+    process.stderr.write(`📄 Report written to ${options.output}\n`);
+  } else {
+    process.stdout.write(json);
+  }
+}
+
+main().catch(error => {
+  process.stderr.write(`${error instanceof Error ? error.message : error}\n`);
+  process.exitCode = 2;
+});
@@ -0,0 +1,99 @@
+#!/usr/bin/env node
+/**
+ * 🚀 AkingSPICE 基準測試入口 (npm run benchmark)
+ *
+ * 用法：
+ *   npm run benchmark -- [選項]
+ *
+ * 選項：
+ *   --size <small|medium|large>  電路規模檔位 (默認 small)
+ *   --filter <text>              只運行名稱包含 text 的電路 (如 rc_ladder)
+ *   --repeat <n>                 每個電路重複次數，取中位數 (默認 3)
+ *   --solver <auto|numeric|klu>  覆蓋線性求解器模式
+ *   --output <file>              將 JSON 報告寫入文件 (默認輸出到 stdout)
+ *   --baseline <file>            與基線報告比較
+ *   --threshold <ratio>          回歸閾值 (相對增長，默認 0.1 = 10%)
+ *
+ * 仿真失敗記錄在報告中 (success = false)；相對基線出現回歸 (含由成功變為失敗) 時以非零狀態碼退出。
+ * 仿真器經 loader.js 加載 (優先 dist/，否則 ts-node 加載 src/)。
+ */
+
+'use strict';
+
+const fs = require('fs');
+const { generateCircuits } = require('./circuits');
+const { runBenchmark, createReport, compareReports } = require('./harness');
+const { loadModules } = require('./loader');
+
+function parseArguments(argv) {
+  const options = { size: 'small', filter: null, repeat: 3, solver: null, output: null, baseline: null, threshold: 0.1 };
+  for (let i = 0; i < argv.length; i++) {
+    const flag = argv[i];
+    const value = argv[i + 1];
+    switch (flag) {
+      case '--size': options.size = value; i++; break;
+      case '--filter': options.filter = value; i++; break;
+      case '--repeat': options.repeat = Number.parseInt(value, 10); i++; break;
+      case '--solver': options.solver = value; i++; break;
+      case '--output': options.output = value; i++; break;
+      case '--baseline': options.baseline = value; i++; break;
+      case '--threshold': options.threshold = Number.parseFloat(value); i++; break;
+      default: throw new Error(`Unknown option: ${flag}`);
+    }
+  }
+  if (!Number.isInteger(options.repeat) || options.repeat < 1) throw new Error('--repeat must be a positive integer');
+  if (!(options.threshold >= 0)) throw new Error('--threshold must be a non-negative number');
+  return options;
+}
+
+function loadSimulator() {
+  const [engine, parser] = loadModules(['core/simulation/circuit_simulation_engine', 'core/parser/spice_netlist_parser']);
+  return { CircuitSimulationEngine: engine.CircuitSimulationEngine, SpiceNetlistParser: parser.SpiceNetlistParser };
+}
+
+async function main() {
+  const options = parseArguments(process.argv.slice(2));
+  const simulator = loadSimulator();
+  const circuits = generateCircuits(options.size)
+    .filter(circuit => !options.filter || circuit.name.includes(options.filter));
+  if (circuits.length === 0) throw new Error(`No benchmark circuits match '${options.filter}'`);
+
+  const results = [];
+  for (const circuit of circuits) {
+    process.stderr.write(`⏱️  ${circuit.name} ... `);
+    const result = await runBenchmark(simulator, circuit, {
+      repeat: options.repeat,
+      config: options.solver ? { solverMode: options.solver } : {}
+    });
+    process.stderr.write(`${result.success ? `${result.wallTimeMs} ms` : `FAILED${result.error ? ` (${result.error})` : ''}`}\n`);
+    results.push(result);
+  }
+
+  const report = createReport(results, options);
+  const json = `${JSON.stringify(report, null, 2)}\n`;
+  if (options.output) {
+    fs.writeFileSync(options.output, json);
+    process.stderr.write(`📄 Report written to ${options.output}\n`);
+  } else {
+    process.stdout.write(json);
+  }
+
+  if (options.baseline) {
+    const baseline = JSON.parse(fs.readFileSync(options.baseline, 'utf8'));
+    const regressions = compareReports(report, baseline, options.threshold).filter(entry => entry.regression);
+    for (const entry of regressions) {
+      process.stderr.write(entry.metric === 'success'
+        ? `❌ ${entry.name} now fails\n`
+        : `❌ ${entry.name} ${entry.metric}: ${entry.baseline} -> ${entry.current} (+${(entry.change * 100).toFixed(1)}%)\n`);
+    }
+    if (regressions.length === 0) {
+      process.stderr.write(`✅ No regressions above ${(options.threshold * 100).toFixed(1)}%\n`);
+    }
+    process.exitCode = regressions.length > 0 ? 1 : 0;
+  }
+}
+
+main().catch(error => {
+  process.stderr.write(`${error instanceof Error ? error.message : error}\n`);
+  process.exitCode = 2;
+});
@@ -5,7 +5,7 @@
  * Vp/Vs = n, n*Ip + Is = 0
  */
 
-import { ComponentInterface, ValidationResult, ComponentInfo, AssemblyContext } from '../../core/interfaces/component';
+import { ComponentInterface, ValidationResult, ComponentInfo, AssemblyContext, StampDerivativeContext, ParameterStamp } from '../../core/interfaces/component';
 import { ComponentValidation, MNAStampingHelpers } from '../../math/numerical/safety';
 
 export class IdealTransformer implements ComponentInterface {
@@ -95,6 +95,23 @@ export class IdealTransformer implements ComponentInterface {
     MNAStampingHelpers.safeMatrixAdd(context.matrix, is, is, 1, this.name);
   }
 
+  /**
+   * 📐 匝数比的残差偏导
+   * 
+   * F[ip] = Vp - n*Vs，F[is] = n*ip + is
+   */
+  stampParameterDerivatives(context: StampDerivativeContext, stamp: ParameterStamp): void {
+    if (this._primaryCurrentIndex === undefined || this._secondaryCurrentIndex === undefined) return;
+
+    const ns1 = context.nodeMap.get(this.nodes[2]);
+    const ns2 = context.nodeMap.get(this.nodes[3]);
+    const x = context.solutionVector;
+    const vs = (ns1 !== undefined ? x.get(ns1) : 0) - (ns2 !== undefined ? x.get(ns2) : 0);
+
+    stamp('', this._primaryCurrentIndex, -vs);
+    stamp('', this._secondaryCurrentIndex, x.get(this._primaryCurrentIndex));
+  }
+
 
   getExtraVariableCount(): number {
     return 2; // 需要两个额外的电流变量
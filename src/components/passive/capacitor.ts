@@ -5,7 +5,7 @@
  * 支持 Backward Euler 和 Trapezoidal 积分方法
  */
 
-import { ComponentInterface, ValidationResult, ComponentInfo, AssemblyContext } from '../../core/interfaces/component';
+import { ComponentInterface, ValidationResult, ComponentInfo, AssemblyContext, StampDerivativeContext, ParameterStamp, HistoryStamp } from '../../core/interfaces/component';
 
 /**
  * 🔋 线性电容组件
@@ -128,6 +128,57 @@ export class Capacitor implements ComponentInterface {
     }
   }
 
+  /**
+   * 📐 电容值的残差偏导
+   * 
+   * 瞬态 F[n1] = (C/Δt)·(V - V_prev)，∂F/∂C = (V - V_prev)/Δt；DC 时电容为开路，偏导为 0
+   */
+  stampParameterDerivatives(context: StampDerivativeContext, stamp: ParameterStamp): void {
+    const { nodeMap, dt, previousSolutionVector, solutionVector } = context;
+    if (!previousSolutionVector || dt <= 0) return;
+
+    const n1 = nodeMap.get(this.nodes[0]);
+    const n2 = nodeMap.get(this.nodes[1]);
+    const voltage = (vector: StampDerivativeContext['solutionVector']) =>
+      (n1 !== undefined && n1 >= 0 ? vector.get(n1) : 0) - (n2 !== undefined && n2 >= 0 ? vector.get(n2) : 0);
+
+    // 与 assemble() 一致：t = 0 时使用零初始条件
+    const previousVoltage = context.currentTime > 1e-15 ? voltage(previousSolutionVector) : 0;
+    const derivative = (voltage(solutionVector) - previousVoltage) / dt;
+
+    if (n1 !== undefined && n1 >= 0) {
+      stamp('', n1, derivative);
+    }
+    if (n2 !== undefined && n2 >= 0) {
+      stamp('', n2, -derivative);
+    }
+  }
+
+  /**
+   * 📐 历史项偏导：I_eq = G_eq·V_prev，∂F[n1]/∂V_prev = -G_eq
+   */
+  stampHistoryDerivatives(context: StampDerivativeContext, stamp: HistoryStamp): void {
+    const { nodeMap, dt, previousSolutionVector } = context;
+    if (!previousSolutionVector || dt <= 0 || context.currentTime <= 1e-15) return;
+
+    const n1 = nodeMap.get(this.nodes[0]);
+    const n2 = nodeMap.get(this.nodes[1]);
+    const geq = this._capacitance / dt;
+
+    if (n1 !== undefined && n1 >= 0) {
+      stamp(n1, n1, -geq);
+      if (n2 !== undefined && n2 >= 0) {
+        stamp(n1, n2, geq);
+      }
+    }
+    if (n2 !== undefined && n2 >= 0) {
+      stamp(n2, n2, -geq);
+      if (n1 !== undefined && n1 >= 0) {
+        stamp(n2, n1, geq);
+      }
+    }
+  }
+
   /**
    * ⚡️ 检查此组件是否可能产生事件
    * 
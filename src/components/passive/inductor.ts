@@ -5,7 +5,7 @@
  * 支持电流型和电压型伴随模型
  */
 
-import { ComponentInterface, ValidationResult, ComponentInfo, AssemblyContext } from '../../core/interfaces/component';
+import { ComponentInterface, ValidationResult, ComponentInfo, AssemblyContext, StampDerivativeContext, ParameterStamp, HistoryStamp } from '../../core/interfaces/component';
 
 /**
  * ⚡ 线性电感组件
@@ -122,6 +122,29 @@ export class Inductor implements ComponentInterface {
     rhs.add(iL_idx, -Veq);
   }
 
+  /**
+   * 📐 电感值的残差偏导
+   * 
+   * 瞬态 F[iL] = V1 - V2 - (L/Δt)·(I - I_prev)，∂F/∂L = -(I - I_prev)/Δt；DC 时为固定小电阻，偏导为 0
+   */
+  stampParameterDerivatives(context: StampDerivativeContext, stamp: ParameterStamp): void {
+    const { dt, previousSolutionVector, solutionVector } = context;
+    if (this._currentIndex === undefined || !previousSolutionVector || dt <= 0) return;
+
+    const iL_idx = this._currentIndex;
+    stamp('', iL_idx, -(solutionVector.get(iL_idx) - previousSolutionVector.get(iL_idx)) / dt);
+  }
+
+  /**
+   * 📐 历史项偏导：V_eq = R_eq·I_prev，∂F[iL]/∂I_prev = R_eq
+   */
+  stampHistoryDerivatives(context: StampDerivativeContext, stamp: HistoryStamp): void {
+    const { dt, previousSolutionVector } = context;
+    if (this._currentIndex === undefined || !previousSolutionVector || dt <= 0) return;
+
+    stamp(this._currentIndex, this._currentIndex, this._inductance / dt);
+  }
+
   /**
    * ⚡️ 检查此组件是否可能产生事件
    * 
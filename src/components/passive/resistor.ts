@@ -5,7 +5,7 @@
  * 遵循标准 SPICE 模型和 MNA 矩阵装配规则
  */
 
-import { ComponentInterface, ValidationResult, ComponentInfo, AssemblyContext } from '../../core/interfaces/component';
+import { ComponentInterface, ValidationResult, ComponentInfo, AssemblyContext, StampDerivativeContext, ParameterStamp } from '../../core/interfaces/component';
 
 /**
  * 🔧 线性电阻组件
@@ -79,6 +79,26 @@ export class Resistor implements ComponentInterface {
     }
   }
 
+  /**
+   * 📐 电阻值的残差偏导
+   * 
+   * F[n1] = G·(V1 - V2)，∂G/∂R = -1/R²
+   */
+  stampParameterDerivatives(context: StampDerivativeContext, stamp: ParameterStamp): void {
+    const n1 = context.nodeMap.get(this.nodes[0]);
+    const n2 = context.nodeMap.get(this.nodes[1]);
+    const x = context.solutionVector;
+    const v = (n1 !== undefined && n1 >= 0 ? x.get(n1) : 0) - (n2 !== undefined && n2 >= 0 ? x.get(n2) : 0);
+    const derivative = -v / (this._resistance * this._resistance);
+
+    if (n1 !== undefined && n1 >= 0) {
+      stamp('', n1, derivative);
+    }
+    if (n2 !== undefined && n2 >= 0) {
+      stamp('', n2, -derivative);
+    }
+  }
+
   /**
    * ⚡️ 检查此组件是否可能产生事件
    * 
@@ -5,7 +5,7 @@
  * 支持直流、正弦波、脉冲等多种波形
  */
 
-import { ComponentInterface, SourceInterface, ValidationResult, ComponentInfo, WaveformDescriptor, ScalableSource, AssemblyContext } from '../../core/interfaces/component';
+import { ComponentInterface, SourceInterface, ValidationResult, ComponentInfo, WaveformDescriptor, ScalableSource, SourceScaleState, AssemblyContext, StampDerivativeContext, ParameterStamp } from '../../core/interfaces/component';
 
 /**
  * ⚡ 理想电压源组件
@@ -54,6 +54,16 @@ export class VoltageSource implements ComponentInterface, SourceInterface, Scala
   restoreSource(): void {
     this._dcValue = this._originalValue;
   }
+
+  getScaleState(): SourceScaleState {
+    return { dcValue: this._dcValue, baseValue: this._originalValue, scaleFactor: this._dcScaleFactor };
+  }
+
+  restoreScaleState(state: SourceScaleState): void {
+    this._dcValue = state.dcValue;
+    this._originalValue = state.baseValue;
+    this._dcScaleFactor = state.scaleFactor;
+  }
   
   /**
    * 🎯 获取直流值
@@ -72,6 +82,19 @@ export class VoltageSource implements ComponentInterface, SourceInterface, Scala
     this._dcScaleFactor = factor;
   }
   
+  /**
+   * 🆕 设置直流值 (用于 DC 扫描)
+   * 
+   * 同时更新源步进的基准值，使同伦回退在新的扫描点上进行
+   */
+  setDcValue(value: number): void {
+    this._dcValue = value;
+    this._originalValue = value;
+    if (this._waveform.type === 'DC') {
+      this._waveform = { type: 'DC', parameters: { value } };
+    }
+  }
+  
   /**
    * 🔢 设置电流支路索引
    */
@@ -240,6 +263,18 @@ export class VoltageSource implements ComponentInterface, SourceInterface, Scala
     return false;
   }
 
+  /**
+   * 📐 直流值的残差偏导：F[iv] = V+ - V- - Vs，∂F/∂Vs = -1
+   * 
+   * 只在激励取直流值时 (DC 分析或 DC 波形) 有定义，其他波形参数不求导
+   */
+  stampParameterDerivatives(context: StampDerivativeContext, stamp: ParameterStamp): void {
+    if (this._currentIndex === undefined) return;
+    if (context.currentTime === 0 || this._waveform.type === 'DC') {
+      stamp('', this._currentIndex, -1);
+    }
+  }
+
 
   /**
    * 🔍 组件验证
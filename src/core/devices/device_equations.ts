@@ -0,0 +1,209 @@
+/**
+ * 🧮 器件方程 - AkingSPICE 2.1
+ *
+ * 二极管与 MOSFET 的纯函数求值 (工作区、电流与线性化电导)
+ * IntelligentDiode / IntelligentMOSFET 的单实例装配与
+ * BatchedCircuitSimulator 的批量内核共用同一份方程，
+ * 模型修改只需在此处进行
+ *
+ * 🎯 约定：
+ *   求值结果写入调用方提供的输出对象，批量内层循环不产生分配
+ *   仅依赖标量参数，不读取器件状态
+ */
+
+// 物理常数
+export const THERMAL_VOLTAGE = 0.026; // 热电压 (26mV @ 300K)
+
+// 数值常数
+export const MIN_CONDUCTANCE = 1e-12;      // 最小电导 (避免奇异)
+export const MAX_EXPONENTIAL_ARG = 50;     // 指数参数上限 (防止溢出)
+export const LIMITING_VOLTAGE_TOL = 1e-6;  // 限幅后与实际结电压之差超过此值视为 noncon
+
+const DIODE_BREAKDOWN_VOLTAGE = -5.0;      // 线性击穿模型拐点
+const DIODE_BREAKDOWN_CONDUCTANCE = 0.1;
+const MOSFET_CUTOFF_RESISTANCE = 1e12;     // 截止区 DC 电流使用的关断电阻
+const MOSFET_TRANSITION_WIDTH = 5 * THERMAL_VOLTAGE; // Vth 附近的亚阈值过渡带
+const MOSFET_SUBTHRESHOLD_SLOPE = 2;       // 亚阈值斜率因子
+
+/**
+ * Diode operating state enumeration
+ */
+export enum DiodeState {
+  FORWARD_BIAS = 'forward_bias',     // Forward bias
+  REVERSE_BIAS = 'reverse_bias',     // Reverse bias
+  BREAKDOWN = 'breakdown',           // Breakdown state
+  TRANSITION = 'transition'          // Transition state
+}
+
+/**
+ * MOSFET 工作区域枚举
+ */
+export enum MOSFETRegion {
+  CUTOFF = 'cutoff',           // 截止区
+  LINEAR = 'linear',           // 线性区 (欧姆区)
+  SATURATION = 'saturation',   // 饱和区 (恒流区)
+  SUBTHRESHOLD = 'subthreshold' // 亚阈值区
+}
+
+/**
+ * 二极管求值结果
+ */
+export interface DiodeEvaluation {
+  state: DiodeState;
+  current: number;
+  conductance: number;
+}
+
+/**
+ * MOSFET 求值结果 (漏极电流与小信号参数)
+ */
+export interface MOSFETEvaluation {
+  region: MOSFETRegion;
+  Id: number;
+  gm: number;
+  gds: number;
+}
+
+/**
+ * 二极管工作状态 (击穿 / 零偏附近线性过渡 / 正偏 / 反偏)
+ */
+export function diodeState(Vd: number, n: number): DiodeState {
+  if (Vd < DIODE_BREAKDOWN_VOLTAGE) {
+    return DiodeState.BREAKDOWN;
+  }
+  if (Math.abs(Vd) < 2 * n * THERMAL_VOLTAGE) {
+    return DiodeState.TRANSITION;
+  }
+  return Vd > 0 ? DiodeState.FORWARD_BIAS : DiodeState.REVERSE_BIAS;
+}
+
+/**
+ * 结电压限幅：超过临界电压时相对上次结电压做对数压缩
+ *
+ * @returns 用于线性化的结电压
+ */
+export function limitDiodeVoltage(Vd: number, lastVd: number, Is: number, n: number): number {
+  const nVt = n * THERMAL_VOLTAGE;
+  const Vcrit = nVt * Math.log(nVt / (Math.SQRT2 * Is));
+  if (Vd > Vcrit) {
+    return lastVd + nVt * Math.log((Vd - lastVd) / nVt + 1);
+  }
+  return Vd;
+}
+
+/**
+ * 二极管分段模型：电流与电导
+ */
+export function evaluateDiode(Vd: number, Is: number, n: number, out: DiodeEvaluation): DiodeEvaluation {
+  const nVt = n * THERMAL_VOLTAGE;
+  const state = diodeState(Vd, n);
+  out.state = state;
+
+  switch (state) {
+    case DiodeState.BREAKDOWN:
+      // Simple linear breakdown model
+      out.current = -(Vd - DIODE_BREAKDOWN_VOLTAGE) * DIODE_BREAKDOWN_CONDUCTANCE;
+      out.conductance = DIODE_BREAKDOWN_CONDUCTANCE;
+      break;
+
+    case DiodeState.TRANSITION:
+      // Linear approximation around Vd=0
+      out.current = Is * Vd / nVt;
+      out.conductance = Math.max(Is / nVt, MIN_CONDUCTANCE);
+      break;
+
+    case DiodeState.FORWARD_BIAS: {
+      // Shockley 方程 (Vd 直接作为结电压，未计串联电阻)
+      const expArg = Math.max(-MAX_EXPONENTIAL_ARG, Math.min(Vd / nVt, MAX_EXPONENTIAL_ARG));
+      const exponential = Math.exp(expArg);
+      out.current = Is * (exponential - 1);
+      out.conductance = Math.max(Is / nVt * exponential, MIN_CONDUCTANCE);
+      break;
+    }
+
+    case DiodeState.REVERSE_BIAS:
+      out.current = -Is;
+      out.conductance = MIN_CONDUCTANCE;
+      break;
+  }
+  return out;
+}
+
+/**
+ * MOSFET 工作区域 (Vth 两侧 5Vt 为亚阈值过渡带)
+ */
+export function mosfetRegion(Vgs: number, Vds: number, Vth: number): MOSFETRegion {
+  if (Vgs < Vth - MOSFET_TRANSITION_WIDTH) {
+    return MOSFETRegion.CUTOFF;
+  }
+  if (Vgs > Vth + MOSFET_TRANSITION_WIDTH) {
+    return Vds < Vgs - Vth ? MOSFETRegion.LINEAR : MOSFETRegion.SATURATION;
+  }
+  return MOSFETRegion.SUBTHRESHOLD;
+}
+
+/**
+ * MOSFET Level 1 分区模型：漏极电流与 gm、gds
+ */
+export function evaluateMOSFET(
+  Vgs: number,
+  Vds: number,
+  Vth: number,
+  Kp: number,
+  lambda: number,
+  Roff: number,
+  out: MOSFETEvaluation
+): MOSFETEvaluation {
+  const region = mosfetRegion(Vgs, Vds, Vth);
+  const clm = 1 + lambda * Vds; // 沟道长度调制
+  let gm = 0;
+  let gds = MIN_CONDUCTANCE;
+  out.region = region;
+
+  switch (region) {
+    case MOSFETRegion.CUTOFF:
+      // 截止区视为极大电阻，避免矩阵奇异
+      out.Id = Vds / MOSFET_CUTOFF_RESISTANCE;
+      gds = 1 / Roff;
+      break;
+
+    case MOSFETRegion.SUBTHRESHOLD: {
+      const slopeVt = MOSFET_SUBTHRESHOLD_SLOPE * THERMAL_VOLTAGE;
+      const expArg = (Vgs - Vth) / slopeVt;
+      const clamped = Math.max(-MAX_EXPONENTIAL_ARG, Math.min(MAX_EXPONENTIAL_ARG, expArg));
+      const drainFactor = 1 - Math.exp(-Vds / THERMAL_VOLTAGE);
+      out.Id = Kp * Math.exp(clamped) * drainFactor * clm;
+      if (expArg < MAX_EXPONENTIAL_ARG) {
+        const I0 = Kp * slopeVt ** 2;
+        const exponential = Math.exp(expArg);
+        gm = I0 / slopeVt * exponential * drainFactor;
+        gds = I0 / THERMAL_VOLTAGE * exponential * Math.exp(-Vds / THERMAL_VOLTAGE);
+      } else {
+        gm = 1e12; // Large but not infinite
+        gds = 1e-9;
+      }
+      break;
+    }
+
+    case MOSFETRegion.LINEAR: {
+      const VgsEff = Vgs - Vth;
+      out.Id = Kp * (VgsEff * Vds - 0.5 * Vds * Vds) * clm;
+      gm = Kp * Vds * clm;
+      gds = Kp * (VgsEff - Vds) * clm + Kp * VgsEff * Vds * lambda;
+      break;
+    }
+
+    case MOSFETRegion.SATURATION: {
+      const VgsEff = Vgs - Vth;
+      out.Id = 0.5 * Kp * VgsEff * VgsEff * clm;
+      gm = Kp * VgsEff * clm;
+      gds = 0.5 * Kp * VgsEff * VgsEff * lambda;
+      break;
+    }
+  }
+
+  // Final validation to prevent NaN/Infinity
+  out.gm = isFinite(gm) ? gm : 1e12;
+  out.gds = isFinite(gds) && gds > 0 ? gds : MIN_CONDUCTANCE;
+  return out;
+}
@@ -31,6 +31,9 @@ import {
 import { Vector } from '../../math/sparse/vector';
 // ADDED: Import the base interface
 import type { ComponentInterface, AssemblyContext } from '../interfaces/component';
+import { getLogger } from '../logging/logger';
+
+const log = getLogger('devices');
 
 /**
  * 设备载入结果
@@ -119,6 +122,17 @@ export interface DeviceState {
   readonly temperature: number;
 }
 
+/**
+ * 设备工作状态快照 (可 JSON 序列化，供 DC 工作点缓存使用)
+ */
+export interface DeviceStateSnapshot {
+  /** 设备工作模式 */
+  readonly operatingMode: string;
+  
+  /** 内部状态变量 (仅保留标量) */
+  readonly internalStates: Readonly<Record<string, string | number | boolean>>;
+}
+
 /**
  * 收敛性分析结果
  */
@@ -492,7 +506,7 @@ export abstract class IntelligentDeviceModelBase implements IIntelligentDeviceMo
             time: event.time,
         };
         
-        console.log(`[${this.name}] handled event at t=${event.time.toExponential(3)}s. New mode: ${newMode}`);
+        if (log.debugEnabled) log.debug(`[${this.name}] handled event at t=${event.time.toExponential(3)}s. New mode: ${newMode}`);
     }
   }
 
@@ -675,6 +689,30 @@ export abstract class IntelligentDeviceModelBase implements IIntelligentDeviceMo
     this._updatePerformanceMetrics();
   }
 
+  /**
+   * 💾 导出工作状态快照
+   */
+  getStateSnapshot(): DeviceStateSnapshot {
+    const internalStates: Record<string, string | number | boolean> = {};
+    for (const [key, value] of Object.entries(this._currentState.internalStates)) {
+      if (typeof value === 'number' || typeof value === 'string' || typeof value === 'boolean') {
+        internalStates[key] = value;
+      }
+    }
+    return { operatingMode: this._currentState.operatingMode, internalStates };
+  }
+
+  /**
+   * 💾 恢复工作状态快照 (如上次收敛时的线性化点)
+   */
+  restoreStateSnapshot(snapshot: DeviceStateSnapshot): void {
+    this._currentState = {
+      ...this._currentState,
+      operatingMode: snapshot.operatingMode,
+      internalStates: { ...this._currentState.internalStates, ...snapshot.internalStates }
+    };
+  }
+
   /**
    * 📊 性能报告生成
    */
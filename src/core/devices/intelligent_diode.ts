@@ -29,6 +29,8 @@ import type {
 } from '../../types/index';
 import { 
   AssemblyContext,
+  StampDerivativeContext,
+  ParameterStamp,
 } from '../interfaces/component';
 import { 
   IntelligentDeviceModelBase,
@@ -39,16 +41,19 @@ import {
   NumericalChallenge,
   DiodeParameters
 } from './intelligent_device_model';
-
-/**
- * Diode operating state enumeration
- */
-export enum DiodeState {
-  FORWARD_BIAS = 'forward_bias',     // Forward bias
-  REVERSE_BIAS = 'reverse_bias',     // Reverse bias
-  BREAKDOWN = 'breakdown',           // Breakdown state
-  TRANSITION = 'transition'          // Transition state
-}
+import {
+  DiodeState,
+  DiodeEvaluation,
+  THERMAL_VOLTAGE,
+  MIN_CONDUCTANCE,
+  MAX_EXPONENTIAL_ARG,
+  LIMITING_VOLTAGE_TOL,
+  diodeState,
+  evaluateDiode,
+  limitDiodeVoltage
+} from './device_equations';
+
+export { DiodeState } from './device_equations';
 
 /**
  * 🚀 Intelligent Diode Model Implementation
@@ -59,15 +64,16 @@ export enum DiodeState {
 export class IntelligentDiode extends IntelligentDeviceModelBase {
   private readonly _diodeParams: DiodeParameters;
   
-  // Physical constants
-  private static readonly VT = 0.026; // Thermal voltage (26mV @ 300K)
-  
-  // Numerical constants
-  private static readonly MIN_CONDUCTANCE = 1e-12; // Minimum conductance
-  private static readonly MAX_EXPONENTIAL_ARG = 50; // Maximum exponential argument (prevents overflow)
+  // Numerical constants (model equations live in device_equations)
   private static readonly FORWARD_VOLTAGE_LIMIT = 2.0; // Forward voltage limit (V)
   private static readonly CONVERGENCE_VOLTAGE_TOL = 1e-9; // Voltage convergence tolerance (nV)
   
+  // Scratch output for the shared model equations
+  private readonly _evaluation: DiodeEvaluation = { state: DiodeState.REVERSE_BIAS, current: 0, conductance: 0 };
+  
+  // Set when the last assembly linearized at a limited voltage (SPICE "noncon")
+  private _voltageLimited = false;
+  
   constructor(
     deviceId: string,
     nodes: [string, string], // [Anode, Cathode]
@@ -103,29 +109,22 @@ export class IntelligentDiode extends IntelligentDeviceModelBase {
 
     const Va = solutionVector.get(anodeIndex);
     const Vc = solutionVector.get(cathodeIndex);
-    let Vd = Va - Vc;
+    const rawVd = Va - Vc;
 
-    // --- BEGIN CRITICAL VOLTAGE LIMITING ---
+    // Critical voltage limiting against the last linearization point
     const lastVd = this._currentState.internalStates['voltage'] as number || 0;
     const { n, Is } = this._diodeParams;
-    const Vt = IntelligentDiode.VT;
-    const Vcrit = n * Vt * Math.log(n * Vt / (Math.SQRT2 * Is));
+    const Vd = limitDiodeVoltage(rawVd, lastVd, Is, n);
+    this._voltageLimited = Math.abs(Vd - rawVd) > LIMITING_VOLTAGE_TOL;
 
-    if (Vd > Vcrit) {
-        Vd = lastVd + n * Vt * Math.log((Vd - lastVd) / (n * Vt) + 1);
-    }
-    // --- END CRITICAL VOLTAGE LIMITING ---
-
-    const state = this._determineOperatingState(Vd);
-    const dcAnalysis = this._computeDCCharacteristics(Vd, state);
-    const conductance = this._computeConductance(Vd, state);
+    const { state, current, conductance } = evaluateDiode(Vd, Is, n, this._evaluation);
     
     // Key: Add Gmin to ensure numerical stability
     const totalConductance = conductance + (gmin || 0);
 
     // Linearization error compensation: I_actual - G*V
     const linearCurrent = conductance * Vd;
-    const error = dcAnalysis.current - linearCurrent;
+    const error = current - linearCurrent;
 
     // Stamp Matrix
     matrix.add(anodeIndex, anodeIndex, totalConductance);
@@ -139,7 +138,61 @@ export class IntelligentDiode extends IntelligentDeviceModelBase {
 
     // Update internal state after assembly
     const capacitance = this._computeCapacitance(Vd);
-    this._currentState = this._createNewDeviceState(Vd, state, dcAnalysis, conductance, capacitance);
+    this._currentState = this._createNewDeviceState(Vd, state, current, conductance, capacitance);
+  }
+
+  /**
+   * 🛡️ Whether the last assembly was linearized at a limited voltage
+   * 
+   * While limiting is active the companion model does not describe the
+   * current solution, so a small Newton update does not imply convergence.
+   */
+  hasLimitedVoltage(): boolean {
+    return this._voltageLimited;
+  }
+
+  /**
+   * 📐 Residual derivatives with respect to IS and N (adjoint sensitivity)
+   * 
+   * F[anode] = I(Vd), F[cathode] = -I(Vd), evaluated at the converged
+   * (unlimited) junction voltage with the same piecewise model as assemble().
+   */
+  stampParameterDerivatives(context: StampDerivativeContext, stamp: ParameterStamp): void {
+    const anodeIndex = context.nodeMap.get(this.nodes[0]!);
+    const cathodeIndex = context.nodeMap.get(this.nodes[1]!);
+    if (anodeIndex === undefined || cathodeIndex === undefined) return;
+
+    const Vd = context.solutionVector.get(anodeIndex) - context.solutionVector.get(cathodeIndex);
+    const { Is, n } = this._diodeParams;
+    const nVt = n * THERMAL_VOLTAGE;
+
+    let dIdIs = 0;
+    let dIdN = 0;
+    switch (diodeState(Vd, n)) {
+      case DiodeState.REVERSE_BIAS:
+        dIdIs = -1;
+        break;
+      case DiodeState.FORWARD_BIAS: {
+        const expArgUnsafe = Vd / nVt;
+        const expArg = Math.max(-MAX_EXPONENTIAL_ARG, Math.min(expArgUnsafe, MAX_EXPONENTIAL_ARG));
+        const exponential = Math.exp(expArg);
+        dIdIs = exponential - 1;
+        // Clamped exponent no longer depends on N
+        dIdN = expArg === expArgUnsafe ? -Is * exponential * expArg / n : 0;
+        break;
+      }
+      case DiodeState.TRANSITION:
+        dIdIs = Vd / nVt;
+        dIdN = -Is * Vd / (nVt * n);
+        break;
+      case DiodeState.BREAKDOWN:
+        break;
+    }
+
+    stamp('IS', anodeIndex, dIdIs);
+    stamp('IS', cathodeIndex, -dIdIs);
+    stamp('N', anodeIndex, dIdN);
+    stamp('N', cathodeIndex, -dIdN);
   }
 
   /**
@@ -211,7 +264,7 @@ export class IntelligentDiode extends IntelligentDeviceModelBase {
     const Va = solution.get(anodeIndex);
     const Vc = solution.get(cathodeIndex);
     const Vd = Va - Vc;
-    return this._determineOperatingState(Vd);
+    return diodeState(Vd, this._diodeParams.n);
   }
 
   private _initializeDiodeState(): void {
@@ -222,91 +275,13 @@ export class IntelligentDiode extends IntelligentDeviceModelBase {
         state: DiodeState.REVERSE_BIAS,
         voltage: 0,
         current: 0,
-        conductance: IntelligentDiode.MIN_CONDUCTANCE,
+        conductance: MIN_CONDUCTANCE,
         capacitance: this._diodeParams.Cj0,
         temperature: 300
       }
     };
   }
 
-  private _determineOperatingState(Vd: number): DiodeState {
-    const { n } = this._diodeParams;
-    const Vt = IntelligentDiode.VT;
-    
-    if (Vd < -5.0) {
-      return DiodeState.BREAKDOWN;
-    }
-    
-    if (Math.abs(Vd) < 2 * n * Vt) {
-      return DiodeState.TRANSITION;
-    }
-    
-    return Vd > 0 ? DiodeState.FORWARD_BIAS : DiodeState.REVERSE_BIAS;
-  }
-
-  private _computeDCCharacteristics(Vd: number, state: DiodeState) {
-    const { Is, n } = this._diodeParams;
-    const Vt = IntelligentDiode.VT;
-    
-    switch (state) {
-      case DiodeState.REVERSE_BIAS:
-        return { current: -Is, voltage: Vd };
-        
-      case DiodeState.FORWARD_BIAS:
-        // For forward bias, the voltage Vd is across the entire device (junction + series resistance).
-        // We need to solve for the current Id such that Vd = V_junction + Id * Rs.
-        // V_junction is related to Id by the Shockley equation: Id = Is * (exp(V_junction / (n * Vt)) - 1).
-        // This is a transcendental equation. For simplicity in this iteration, we'll use Vd
-        // directly in the Shockley equation but acknowledge this is an approximation.
-        // A more robust solution would involve an inner Newton loop or a Lambert-W function approximation.
-        const expArgUnsafe = Vd / (n * Vt);
-        const expArg = Math.max(-IntelligentDiode.MAX_EXPONENTIAL_ARG, Math.min(expArgUnsafe, IntelligentDiode.MAX_EXPONENTIAL_ARG));
-        const current = Is * (Math.exp(expArg) - 1);
-        // The voltage passed to the return object should be the total device voltage.
-        return { current, voltage: Vd };
-        
-      case DiodeState.BREAKDOWN:
-        const breakdownCurrent = -(Vd + 5.0) * 0.1; // Simple linear breakdown model
-        return { current: breakdownCurrent, voltage: Vd };
-        
-      case DiodeState.TRANSITION:
-        // Linear approximation around Vd=0
-        const transitionCurrent = Is * Vd / (n * Vt);
-        return { current: transitionCurrent, voltage: Vd };
-        
-      default:
-        throw new Error(`Unknown diode state: ${state}`);
-    }
-  }
-
-  private _computeConductance(Vd: number, state: DiodeState): number {
-    const { Is, n } = this._diodeParams;
-    const Vt = IntelligentDiode.VT;
-    
-    switch (state) {
-      case DiodeState.REVERSE_BIAS:
-        return IntelligentDiode.MIN_CONDUCTANCE;
-        
-      case DiodeState.FORWARD_BIAS:
-        // This is the derivative of the simplified Shockley equation used in _computeDCCharacteristics.
-        // dI/dVd = d/dVd [ Is * (exp(Vd / (n * Vt)) - 1) ] = (Is / (n * Vt)) * exp(Vd / (n * Vt))
-        const expArgUnsafe = Vd / (n * Vt);
-        const expArg = Math.max(-IntelligentDiode.MAX_EXPONENTIAL_ARG, Math.min(expArgUnsafe, IntelligentDiode.MAX_EXPONENTIAL_ARG));
-        const conductance = (Is / (n * Vt)) * Math.exp(expArg);
-        return Math.max(conductance, IntelligentDiode.MIN_CONDUCTANCE);
-        
-      case DiodeState.BREAKDOWN:
-        return 0.1; // Corresponds to the linear breakdown model
-        
-      case DiodeState.TRANSITION:
-        // Corresponds to the linear model around Vd=0
-        return Math.max(Is / (n * Vt), IntelligentDiode.MIN_CONDUCTANCE);
-        
-      default:
-        return IntelligentDiode.MIN_CONDUCTANCE;
-    }
-  }
-
   private _computeCapacitance(Vd: number): number {
     const { Cj0, Vj, m } = this._diodeParams;
     
@@ -321,7 +296,7 @@ export class IntelligentDiode extends IntelligentDeviceModelBase {
   private _createNewDeviceState(
     Vd: number,
     state: DiodeState,
-    dcAnalysis: any,
+    current: number,
     conductance: number,
     capacitance: number
   ): DeviceState {
@@ -331,7 +306,7 @@ export class IntelligentDiode extends IntelligentDeviceModelBase {
       internalStates: {
         state,
         voltage: Vd,
-        current: dcAnalysis.current,
+        current,
         conductance,
         capacitance,
         temperature: this._currentState.temperature
@@ -346,7 +321,7 @@ export class IntelligentDiode extends IntelligentDeviceModelBase {
     const currentVd = this._currentState.internalStates['voltage'] as number || 0;
     const newVd = currentVd + deltaVd;
     const currentState = this._currentState.internalStates['state'] as DiodeState;
-    const newState = this._determineOperatingState(newVd);
+    const newState = diodeState(newVd, this._diodeParams.n);
     
     const stateStable = currentState === newState;
     
@@ -418,7 +393,7 @@ export class IntelligentDiode extends IntelligentDeviceModelBase {
     }
     
     const { n } = this._diodeParams;
-    const expArg = voltage / (n * IntelligentDiode.VT);
+    const expArg = voltage / (n * THERMAL_VOLTAGE);
     if (expArg > 30) {
       challenges.push({
         type: 'stiffness',
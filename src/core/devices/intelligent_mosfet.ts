@@ -38,16 +38,15 @@ import {
   NumericalChallenge,
   MOSFETParameters
 } from './intelligent_device_model';
+import {
+  MOSFETRegion,
+  MOSFETEvaluation,
+  MIN_CONDUCTANCE,
+  evaluateMOSFET,
+  mosfetRegion
+} from './device_equations';
 
-/**
- * MOSFET 工作区域枚举
- */
-export enum MOSFETRegion {
-  CUTOFF = 'cutoff',           // 截止区
-  LINEAR = 'linear',           // 线性区 (欧姆区)
-  SATURATION = 'saturation',   // 饱和区 (恒流区)
-  SUBTHRESHOLD = 'subthreshold' // 亚阈值区
-}
+export { MOSFETRegion } from './device_equations';
 
 /**
  * MOSFET 内部状态
@@ -68,14 +67,13 @@ export class IntelligentMOSFET extends IntelligentDeviceModelBase {
   private readonly _sourceNode: string;
   private readonly _mosfetParams: MOSFETParameters;
   
-  // 物理常数
-  private static readonly VT = 0.026; // 热电压 (26mV @ 300K)
-  
-  // 数值常数
-  private static readonly MIN_CONDUCTANCE = 1e-12; // 最小电导 (避免奇异)
+  // 数值常数 (模型方程见 device_equations)
   private static readonly MAX_VOLTAGE_STEP = 0.5;  // 最大电压步长 (V)
   private static readonly SWITCH_THRESHOLD = 0.1;  // 开关检测阈值 (V)
   
+  // 共享模型方程的求值输出
+  private readonly _evaluation: MOSFETEvaluation = { region: MOSFETRegion.CUTOFF, Id: 0, gm: 0, gds: MIN_CONDUCTANCE };
+  
   constructor(
     deviceId: string,
     nodes: [string, string, string], // [Drain, Gate, Source]
@@ -124,23 +122,17 @@ export class IntelligentMOSFET extends IntelligentDeviceModelBase {
       throw new Error(detailedError);
     }
     
-    // 3. 确定工作区域
-    const region = this._determineOperatingRegion(Vgs, Vds);
-    
-    // 4. 计算 DC 特性
-    const dcAnalysis = this._computeDCCharacteristics(Vgs, Vds, region);
-    
-    // 5. 计算小信号参数
-    const smallSignal = this._computeSmallSignalParameters(Vgs, Vds, region);
+    // 3. 工作区域、DC 电流与小信号参数
+    const { Vth, Kp, lambda, Roff } = this._mosfetParams;
+    const { region, Id, gm, gds } = evaluateMOSFET(Vgs, Vds, Vth, Kp, lambda, Roff, this._evaluation);
     
     // Add Gmin
-    const totalGds = smallSignal.gds + (gmin || 0);
+    const totalGds = gds + (gmin || 0);
 
-    // 6. 计算右侧向量贡献 (线性化误差)
-    const Ieq = dcAnalysis.Id - (smallSignal.gm * Vgs + smallSignal.gds * Vds);
+    // 4. 计算右侧向量贡献 (线性化误差)
+    const Ieq = Id - (gm * Vgs + gds * Vds);
 
-    // 7. Stamp Matrix
-    const { gm } = smallSignal;
+    // 5. Stamp Matrix
     matrix.add(drainIndex, gateIndex, gm);
     matrix.add(drainIndex, drainIndex, totalGds);
     matrix.add(drainIndex, sourceIndex, -(gm + totalGds));
@@ -149,14 +141,14 @@ export class IntelligentMOSFET extends IntelligentDeviceModelBase {
     matrix.add(sourceIndex, drainIndex, -totalGds);
     matrix.add(sourceIndex, sourceIndex, gm + totalGds);
 
-    // 8. Stamp RHS
+    // 6. Stamp RHS
     rhs.add(drainIndex, -Ieq);
     rhs.add(sourceIndex, Ieq);
 
-    // 9. 更新设备状态
+    // 7. 更新设备状态
     const capacitance = this._computeCapacitances(Vgs, Vds);
     this._currentState = this._createNewDeviceState(
-      Vgs, Vds, region, smallSignal, capacitance
+      Vgs, Vds, region, { gm, gds, gmbs: 0 }, capacitance
     );
   }
 
@@ -267,7 +259,7 @@ export class IntelligentMOSFET extends IntelligentDeviceModelBase {
     const Vgs = Vg - Vs;
     const Vds = Vd - Vs;
     
-    return this._determineOperatingRegion(Vgs, Vds);
+    return mosfetRegion(Vgs, Vds, this._mosfetParams.Vth);
   }
 
   /**
@@ -331,7 +323,7 @@ export class IntelligentMOSFET extends IntelligentDeviceModelBase {
         Vds: 0,
         Vbs: 0,
         gm: 0,
-        gds: IntelligentMOSFET.MIN_CONDUCTANCE,
+        gds: MIN_CONDUCTANCE,
         gmbs: 0,
         Cgs: this._mosfetParams.Cgs,
         Cgd: this._mosfetParams.Cgd,
@@ -341,135 +333,6 @@ export class IntelligentMOSFET extends IntelligentDeviceModelBase {
     };
   }
 
-  /**
-   * 确定 MOSFET 工作区域
-   */
-  private _determineOperatingRegion(Vgs: number, Vds: number): MOSFETRegion {
-    const { Vth } = this._mosfetParams;
-    const transitionWidth = 5 * IntelligentMOSFET.VT; // 5 * 26mV = 130mV transition region
-
-    // Smooth transition around Vth
-    if (Vgs < Vth - transitionWidth) {
-        return MOSFETRegion.CUTOFF;
-    }
-    if (Vgs > Vth + transitionWidth) {
-        // On region
-        const Vdsat = Vgs - Vth;
-        return Vds < Vdsat ? MOSFETRegion.LINEAR : MOSFETRegion.SATURATION;
-    }
-    
-    // Subthreshold/Transition region
-    return MOSFETRegion.SUBTHRESHOLD;
-  }
-
-  /**
-   * 计算 DC 特性
-   */
-  private _computeDCCharacteristics(
-    Vgs: number, 
-    Vds: number, 
-    region: MOSFETRegion
-  ) {
-    const { Vth, Kp, lambda } = this._mosfetParams;
-    // Use a much larger off-resistance for better numerical stability in cutoff
-    const Roff = 1e12; 
-    
-    switch (region) {
-      case MOSFETRegion.CUTOFF:
-        // In cutoff, model as a very large resistor Roff.
-        // This is CRITICAL for numerical stability, especially during DC analysis,
-        // as it prevents the matrix from becoming singular and provides a clear "off" state.
-        const Id_off = Vds / Roff;
-        return { Id: Id_off, Ig: 0, Is: -Id_off };
-        
-      case MOSFETRegion.SUBTHRESHOLD:
-        // 亚阈值传导 (指数特性)
-        const expArgUnsafe = (Vgs - Vth) / (2 * IntelligentMOSFET.VT);
-        const expArg = Math.max(-50, Math.min(50, expArgUnsafe)); // 限制范围
-        const Isub = Kp * Math.exp(expArg) * (1 - Math.exp(-Vds / IntelligentMOSFET.VT));
-        return { Id: Isub * (1 + lambda * Vds), Ig: 0, Is: -Isub };
-        
-      case MOSFETRegion.LINEAR:
-        // 线性区 (欧姆区)
-        const VgsEff = Vgs - Vth;
-        // 增加平滑处理，避免 Vds 接近 0 时出现数值问题
-        const Id_lin = Kp * (VgsEff * Vds - 0.5 * Vds * Vds);
-        return { Id: Id_lin * (1 + lambda * Vds), Ig: 0, Is: -Id_lin };
-        
-      case MOSFETRegion.SATURATION:
-        // 饱和区 (恒流区)
-        const VgsEff_sat = Vgs - Vth;
-        const Id_sat = 0.5 * Kp * VgsEff_sat * VgsEff_sat;
-        return { Id: Id_sat * (1 + lambda * Vds), Ig: 0, Is: -Id_sat };
-        
-      default:
-        throw new Error(`Unknown MOSFET region: ${region}`);
-    }
-  }
-
-  /**
-   * 计算小信号参数
-   */
-  private _computeSmallSignalParameters(
-    Vgs: number, 
-    Vds: number, 
-    region: MOSFETRegion
-  ) {
-    const { Vth, Kp, lambda, Roff } = this._mosfetParams;
-    let gm = 0;
-    let gds = IntelligentMOSFET.MIN_CONDUCTANCE;
-
-    switch (region) {
-      case MOSFETRegion.CUTOFF:
-        gm = 0;
-        // The conductance is 1/Roff. This provides a stable, non-zero value.
-        gds = 1 / Roff;
-        break;
-        
-      case MOSFETRegion.SUBTHRESHOLD:
-        const n = 2; // Subthreshold slope factor
-        const expArg = (Vgs - Vth) / (n * IntelligentMOSFET.VT);
-        const I0 = Kp * (n * IntelligentMOSFET.VT)**2;
-        // Clamp the argument to prevent overflow
-        if (expArg < 50) { 
-            const expVal = Math.exp(expArg);
-            const term = (1 - Math.exp(-Vds / IntelligentMOSFET.VT));
-            gm = (I0 / (n * IntelligentMOSFET.VT)) * expVal * term;
-            gds = (I0 / IntelligentMOSFET.VT) * expVal * Math.exp(-Vds / IntelligentMOSFET.VT);
-        } else {
-            gm = 1e12; // Large but not infinite
-            gds = 1e-9;
-        }
-        break;
-        
-      case MOSFETRegion.LINEAR:
-        const VgsEff = Vgs - Vth;
-        gm = Kp * Vds * (1 + lambda * Vds);
-        gds = Kp * (VgsEff - Vds) * (1 + lambda * Vds) + 
-              Kp * VgsEff * Vds * lambda;
-        break;
-        
-      case MOSFETRegion.SATURATION:
-        const VgsEff_sat = Vgs - Vth;
-        gm = Kp * VgsEff_sat * (1 + lambda * Vds);
-        gds = 0.5 * Kp * VgsEff_sat * VgsEff_sat * lambda;
-        break;
-        
-      default:
-        throw new Error(`Unknown MOSFET region: ${region}`);
-    }
-
-    // Final validation to prevent NaN/Infinity
-    gm = isFinite(gm) ? gm : 1e12;
-    gds = isFinite(gds) && gds > 0 ? gds : IntelligentMOSFET.MIN_CONDUCTANCE;
-
-    return {
-      gm,
-      gds,
-      gmbs: 0 // Not modeled yet
-    };
-  }
-
   /**
    * 计算电容效应
    */
@@ -626,7 +489,7 @@ export class IntelligentMOSFET extends IntelligentDeviceModelBase {
     
     // 工作区域边界挑战
     const gds = this._currentState.internalStates['gds'] as number;
-    if (gds < IntelligentMOSFET.MIN_CONDUCTANCE * 10) {
+    if (gds < MIN_CONDUCTANCE * 10) {
       challenges.push({
         type: 'ill_conditioning',
         severity: 0.6,
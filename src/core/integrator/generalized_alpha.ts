@@ -33,6 +33,9 @@ import type {
   IVector
 } from '../../types/index';
 import { Vector } from '../../math/sparse/vector';
+import type { SimulationTracer } from '../simulation/simulation_tracer';
+import type { SolverRecorder } from '../../math/sparse/solver_recording';
+import { Logger, LogLevel, getLogger } from '../logging/logger';
 // import { UltraKLUSolver } from '../../../wasm/klu_solver'; // 動態導入
 
 /**
@@ -85,6 +88,36 @@ interface GeneralizedAlphaState extends IntegratorState {
   };
 }
 
+/**
+ * 積分狀態快照 (檢查點)：向量以 Float64Array 保存，恢復後逐位相同
+ */
+export interface GeneralizedAlphaStateSnapshot {
+  readonly time: Time;
+  readonly timestep: Time;
+  readonly solution: Float64Array;
+  readonly derivative: Float64Array | null;
+  readonly velocity: Float64Array;
+  readonly acceleration: Float64Array;
+  readonly stepStats: {
+    readonly accepted: number;
+    readonly rejected: number;
+    readonly newtonIterations: number;
+  };
+}
+
+/**
+ * 積分器快照：當前/前一步狀態與統計計數
+ */
+export interface GeneralizedAlphaSnapshot {
+  readonly current: GeneralizedAlphaStateSnapshot | null;
+  readonly previous: GeneralizedAlphaStateSnapshot | null;
+  readonly totalSteps: number;
+  readonly acceptedSteps: number;
+  readonly rejectedSteps: number;
+  readonly totalNewtonIterations: number;
+  readonly avgSolveTime: number;
+}
+
 /**
  * Newton 迭代結果
  */
@@ -127,6 +160,15 @@ export class GeneralizedAlphaIntegrator implements IIntegrator {
   
   // 高性能求解器
   private _kluSolver: any | null = null;
+
+  // 執行軌迹 (可選)
+  private _tracer: SimulationTracer | null = null;
+
+  // 線性求解序列錄製 (可選)
+  private _solverRecorder: SolverRecorder | null = null;
+
+  // 日誌 (verbose 時使用獨立的 DEBUG 級實例)
+  private readonly _log: Logger;
   
   // 性能統計
   private _totalSteps = 0;
@@ -146,6 +188,7 @@ export class GeneralizedAlphaIntegrator implements IIntegrator {
       useKLUSolver: options.useKLUSolver ?? true,
       verbose: options.verbose ?? false
     };
+    this._log = this._options.verbose ? new Logger('generalized-alpha', LogLevel.DEBUG) : getLogger('generalized-alpha');
     
     // 根據 ρ∞ 計算 Generalized-α 參數
     const rho = this._options.spectralRadius;
@@ -159,10 +202,12 @@ export class GeneralizedAlphaIntegrator implements IIntegrator {
       this._initializeKLUSolver();
     }
     
-    this._logInfo(`🚀 Generalized-α 積分器已初始化`);
-    this._logInfo(`   數值阻尼參數 ρ∞ = ${rho}`);
-    this._logInfo(`   計算參數: α_m=${this._alpha_m.toFixed(4)}, α_f=${this._alpha_f.toFixed(4)}`);
-    this._logInfo(`   Newmark 參數: γ=${this._gamma.toFixed(4)}, β=${this._beta.toFixed(4)}`);
+    if (this._log.debugEnabled) {
+      this._log.debug(`🚀 Generalized-α 積分器已初始化`);
+      this._log.debug(`   數值阻尼參數 ρ∞ = ${rho}`);
+      this._log.debug(`   計算參數: α_m=${this._alpha_m.toFixed(4)}, α_f=${this._alpha_f.toFixed(4)}`);
+      this._log.debug(`   Newmark 參數: γ=${this._gamma.toFixed(4)}, β=${this._beta.toFixed(4)}`);
+    }
   }
 
   /**
@@ -252,20 +297,20 @@ export class GeneralizedAlphaIntegrator implements IIntegrator {
     this._totalSteps++;
     const startTime = performance.now();
     
-    this._logInfo(`\n🚀 Generalized-α Step ${this._totalSteps}: t=${t.toFixed(6)}s, dt=${dt.toExponential(3)}s`);
+    if (this._log.debugEnabled) this._log.debug(`\n🚀 Generalized-α Step ${this._totalSteps}: t=${t.toFixed(6)}s, dt=${dt.toExponential(3)}s`);
 
     try {
       // 1. 初始化狀態 (首步)
       if (!this._currentState) {
         const initialState = this._initializeFirstStep(system, t, solution);
         this._currentState = initialState;
-        this._logInfo(`   ✅ 初始狀態設置完成，繼續執行第一步積分...`);
+        this._log.debug(`   ✅ 初始狀態設置完成，繼續執行第一步積分...`);
         // 注意：不要在這裡返回！繼續執行積分步驟。
       }
 
       // 2. 預測下一步狀態
       const predicted = this._predictNextStep(t + dt, dt);
-      this._logInfo(`   🔮 預測完成: ||v||=${predicted.solution.norm().toExponential(3)}`);
+      if (this._log.debugEnabled) this._log.debug(`   🔮 預測完成: ||v||=${predicted.solution.norm().toExponential(3)}`);
 
       // 3. 執行 Newton 修正迭代
       const corrected = this._correctStep(system, t + dt, dt, predicted);
@@ -275,7 +320,7 @@ export class GeneralizedAlphaIntegrator implements IIntegrator {
         this._rejectedSteps++;
         const newDt = this._adjustTimestep(dt, 10.0, false); // 大誤差表示需要減小步長
         
-        this._logInfo(`   ❌ Newton 未收斂，拒絕步長，新 dt=${newDt.toExponential(3)}s`);
+        if (this._log.debugEnabled) this._log.debug(`   ❌ Newton 未收斂，拒絕步長，新 dt=${newDt.toExponential(3)}s`);
         
         return {
           solution: this._currentState.solution,
@@ -287,7 +332,7 @@ export class GeneralizedAlphaIntegrator implements IIntegrator {
 
       // 4. 估計局部截斷誤差
       const lte = this._estimateLocalTruncationError(corrected, predicted);
-      this._logInfo(`   📊 LTE 估計: ${lte.toExponential(3)} (容差: ${this._options.tolerance.toExponential(3)})`);
+      if (this._log.debugEnabled) this._log.debug(`   📊 LTE 估計: ${lte.toExponential(3)} (容差: ${this._options.tolerance.toExponential(3)})`);
 
       // 5. 決定是否接受此步
       // 🔧 對於第一步（timestep = 0），使用更寬鬆的容差，因為預測-修正差異天然較大
@@ -296,7 +341,7 @@ export class GeneralizedAlphaIntegrator implements IIntegrator {
       const acceptStep = lte <= effectiveTolerance;
       
       if (isFirstRealStep) {
-        this._logInfo(`   🎯 第一步使用寬鬆容差: ${effectiveTolerance.toExponential(3)}`);
+        if (this._log.debugEnabled) this._log.debug(`   🎯 第一步使用寬鬆容差: ${effectiveTolerance.toExponential(3)}`);
       }
       const nextDt = this._adjustTimestep(dt, lte, acceptStep);
 
@@ -310,7 +355,7 @@ export class GeneralizedAlphaIntegrator implements IIntegrator {
         const solveTime = performance.now() - startTime;
         this._avgSolveTime = (this._avgSolveTime * (this._acceptedSteps - 1) + solveTime) / this._acceptedSteps;
         
-        this._logInfo(`   ✅ 步長接受: ${corrected.iterations} Newton 迭代, ${solveTime.toFixed(3)}ms`);
+        if (this._log.debugEnabled) this._log.debug(`   ✅ 步長接受: ${corrected.iterations} Newton 迭代, ${solveTime.toFixed(3)}ms`);
         this._logPerformanceStats();
         
         return {
@@ -323,7 +368,7 @@ export class GeneralizedAlphaIntegrator implements IIntegrator {
         // 拒絕此步，重試更小步長
         this._rejectedSteps++;
         
-        this._logInfo(`   ❌ 步長拒絕 (LTE 過大)，新 dt=${nextDt.toExponential(3)}s`);
+        if (this._log.debugEnabled) this._log.debug(`   ❌ 步長拒絕 (LTE 過大)，新 dt=${nextDt.toExponential(3)}s`);
         
         return {
           solution: this._currentState.solution,
@@ -375,11 +420,25 @@ export class GeneralizedAlphaIntegrator implements IIntegrator {
     return this._adjustTimestep(dt, error, true);
   }
 
+  /**
+   * 🧵 設置執行軌迹記錄器，每次 Newton 迭代記錄一個跨度 (null 關閉)
+   */
+  setTracer(tracer: SimulationTracer | null): void {
+    this._tracer = tracer;
+  }
+
+  /**
+   * 🎞️ 設置線性求解錄製器，每次 Newton 線性求解記錄一幀 (null 關閉)
+   */
+  setSolverRecorder(recorder: SolverRecorder | null): void {
+    this._solverRecorder = recorder;
+  }
+
   /**
    * 重新啟動積分器 (事件檢測後)
    */
   async restart(initialState: IntegratorState): Promise<void> {
-    this._logInfo(`🔄 重新啟動 Generalized-α 積分器`);
+    this._log.debug(`🔄 重新啟動 Generalized-α 積分器`);
     
     // 重置求解器狀態 (電路拓撲可能改變)
     
@@ -407,6 +466,52 @@ export class GeneralizedAlphaIntegrator implements IIntegrator {
     return Promise.resolve();
   }
 
+  /**
+   * 📸 保存積分器狀態 (檢查點)
+   */
+  saveState(): GeneralizedAlphaSnapshot {
+    const save = (state: GeneralizedAlphaState | null): GeneralizedAlphaStateSnapshot | null => state && {
+      time: state.time,
+      timestep: state.timestep,
+      solution: Float64Array.from(state.solution.toArray()),
+      derivative: state.derivative ? Float64Array.from(state.derivative.toArray()) : null,
+      velocity: Float64Array.from(state.velocity.toArray()),
+      acceleration: Float64Array.from(state.acceleration.toArray()),
+      stepStats: { ...state.stepStats }
+    };
+    return {
+      current: save(this._currentState),
+      previous: save(this._previousState),
+      totalSteps: this._totalSteps,
+      acceptedSteps: this._acceptedSteps,
+      rejectedSteps: this._rejectedSteps,
+      totalNewtonIterations: this._totalNewtonIterations,
+      avgSolveTime: this._avgSolveTime
+    };
+  }
+
+  /**
+   * 📸 恢復 saveState() 保存的狀態，後續步進與保存時逐位相同
+   */
+  loadState(snapshot: GeneralizedAlphaSnapshot): void {
+    const load = (state: GeneralizedAlphaStateSnapshot | null): GeneralizedAlphaState | null => state && {
+      time: state.time,
+      solution: Vector.from(Array.from(state.solution)),
+      ...(state.derivative ? { derivative: Vector.from(Array.from(state.derivative)) } : {}),
+      velocity: Vector.from(Array.from(state.velocity)),
+      acceleration: Vector.from(Array.from(state.acceleration)),
+      timestep: state.timestep,
+      stepStats: { ...state.stepStats }
+    };
+    this._currentState = load(snapshot.current);
+    this._previousState = load(snapshot.previous);
+    this._totalSteps = snapshot.totalSteps;
+    this._acceptedSteps = snapshot.acceptedSteps;
+    this._rejectedSteps = snapshot.rejectedSteps;
+    this._totalNewtonIterations = snapshot.totalNewtonIterations;
+    this._avgSolveTime = snapshot.avgSolveTime;
+  }
+
   /**
    * 清空積分器狀態
    */
@@ -419,7 +524,7 @@ export class GeneralizedAlphaIntegrator implements IIntegrator {
       this._kluSolver.reset();
     }
     
-    this._logInfo(`♻️  Generalized-α 積分器已清空`);
+    this._log.debug(`♻️  Generalized-α 積分器已清空`);
   }
 
   /**
@@ -462,7 +567,7 @@ export class GeneralizedAlphaIntegrator implements IIntegrator {
     }
     
     this.clear();
-    this._logInfo(`♻️  Generalized-α 積分器資源已釋放`);
+    this._log.debug(`♻️  Generalized-α 積分器資源已釋放`);
   }
 
   // === 私有方法實現 ===
@@ -472,7 +577,7 @@ export class GeneralizedAlphaIntegrator implements IIntegrator {
    */
   private _initializeKLUSolver(): void {
     // KLU 求解器將在需要時動態載入
-    this._logInfo(`🚀 KLU 求解器將在需要時載入`);
+    this._log.debug(`🚀 KLU 求解器將在需要時載入`);
   }
 
   /**
@@ -516,7 +621,7 @@ export class GeneralizedAlphaIntegrator implements IIntegrator {
     // 解決方案：使用當前解作為預測（相當於後向歐拉的隱式預測）
     const isFirstStep = curr.timestep === 0;
     if (isFirstStep) {
-      this._logInfo('   🎯 第一步：使用當前解作為預測（隱式啟動）');
+      this._log.debug('   🎯 第一步：使用當前解作為預測（隱式啟動）');
       return {
         time: t_n1,
         solution: curr.solution.clone(), // 使用當前 DC 工作點作為預測
@@ -563,7 +668,7 @@ export class GeneralizedAlphaIntegrator implements IIntegrator {
   private _correctStep(
     system: IMNASystem,
     t_n1: Time, // Time at the end of the step
-    _dt: Time,   // Timestep (h) - unused in simplified version
+    dt: Time,    // Timestep (h) - 僅用於軌迹標註
     predicted: GeneralizedAlphaState
   ): NewtonResult {
     let v_n1 = predicted.solution.clone(); // Start with the predicted solution x_k
@@ -571,8 +676,14 @@ export class GeneralizedAlphaIntegrator implements IIntegrator {
     let converged = false;
     let iterations = 0;
     let finalResidual = Infinity;
+    // 每次迭代一個軌迹跨度，在下一次迭代開始或循環結束時記錄
+    let spanStart = this._tracer ? this._tracer.begin() : 0;
 
     for (iterations = 0; iterations < this._options.maxNewtonIterations; iterations++) {
+      if (this._tracer && iterations > 0) {
+        this._tracer.end('newton', spanStart, t_n1, dt, finalResidual, iterations - 1);
+        spanStart = this._tracer.begin();
+      }
       // 1. 核心步驟：呼叫系統的 assemble 方法。
       //    這會根據當前的解 v_n1 和時間 t_n1 更新系統矩陣 (J) 和 RHS (b)。
       //    對於瞬態分析，組件的 assemble 方法會使用伴隨模型，
@@ -590,7 +701,7 @@ export class GeneralizedAlphaIntegrator implements IIntegrator {
           converged = false;
           break;
         }
-        this._logInfo(`     ✓ RHS norm: ${bNorm.toExponential(3)}`);
+        if (this._log.debugEnabled) this._log.debug(`     ✓ RHS norm: ${bNorm.toExponential(3)}`);
       }
 
       // 2. 計算殘差 F(x_k) = J * x_k - b
@@ -600,7 +711,7 @@ export class GeneralizedAlphaIntegrator implements IIntegrator {
       const residual = b.minus(Jx);
       
       finalResidual = residual.norm();
-      this._logInfo(`     Newton[${iterations}]: ||Residual|| = ${finalResidual.toExponential(3)}`);
+      if (this._log.debugEnabled) this._log.debug(`     Newton[${iterations}]: ||Residual|| = ${finalResidual.toExponential(3)}`);
       
       // 3. 檢查收斂
       if (finalResidual < this._options.newtonTolerance) {
@@ -611,7 +722,7 @@ export class GeneralizedAlphaIntegrator implements IIntegrator {
       // 4. 求解線性系統 J * Δx = residual = b - J*x
       //    即 J * Δx = b - J*x_k，解出 Δx 後，x_{k+1} = x_k + Δx 將滿足 J*x_{k+1} ≈ b
       try {
-        const delta = this._solveNewtonStep(J, residual);
+        const delta = this._solveNewtonStep(J, residual, t_n1);
         
         const deltaNorm = delta.norm();
         if (isNaN(deltaNorm)) {
@@ -619,7 +730,7 @@ export class GeneralizedAlphaIntegrator implements IIntegrator {
             converged = false;
             break;
         }
-        this._logInfo(`     Newton[${iterations}]: ||Update|| = ${deltaNorm.toExponential(3)}`);
+        if (this._log.debugEnabled) this._log.debug(`     Newton[${iterations}]: ||Update|| = ${deltaNorm.toExponential(3)}`);
 
         // 5. 更新解向量 x_{k+1} = x_k + Δx
         (v_n1 as Vector).addInPlace(delta);
@@ -636,6 +747,7 @@ export class GeneralizedAlphaIntegrator implements IIntegrator {
         break;
       }
     }
+    this._tracer?.end('newton', spanStart, t_n1, dt, finalResidual, Math.min(iterations, this._options.maxNewtonIterations - 1));
 
     // 關鍵：不再需要 _updateVelocityAcceleration，因為伴隨模型已處理歷史項。
     // 我們在步長被接受後才更新速度。
@@ -679,8 +791,11 @@ export class GeneralizedAlphaIntegrator implements IIntegrator {
    * 
    * 求解線性系統 J * Δx = residual，其中 residual = b - J*x_k
    */
-  private _solveNewtonStep(jacobian: any, residual: IVector): VoltageVector {
-    console.log('🧮 執行 Newton 步求解...');
+  private _solveNewtonStep(jacobian: any, residual: IVector, time: Time): VoltageVector {
+    this._log.debug('🧮 執行 Newton 步求解...');
+    if (this._solverRecorder && typeof jacobian?.toCSC === 'function') {
+      this._solverRecorder.record(jacobian, residual, 'transient', time);
+    }
     
     const n = residual.size;
     
@@ -689,14 +804,14 @@ export class GeneralizedAlphaIntegrator implements IIntegrator {
       if (jacobian && typeof jacobian.solve === 'function') {
         // 使用我們改進的求解器 (支持 numeric.js 和迭代求解器)
         // 直接傳入 residual = b - J*x，求解 J * Δx = residual
-        console.log('🚀 使用改進的稀疏矩陣求解器...');
+        this._log.debug('🚀 使用改進的稀疏矩陣求解器...');
         const solution = jacobian.solve(residual);
-        console.log(`✅ Newton步求解完成 (求解器: ${jacobian._solverMode || 'default'})`);
+        if (this._log.debugEnabled) this._log.debug(`✅ Newton步求解完成 (求解器: ${jacobian._solverMode || 'default'})`);
         return solution;
       }
       
       // 回退到改進的對角求解
-      console.warn('⚠️ 使用對角求解作為回退方案');
+      this._log.warn('⚠️ 使用對角求解作為回退方案');
       const delta = new Vector(n);
       
       for (let i = 0; i < n; i++) {
@@ -712,7 +827,7 @@ export class GeneralizedAlphaIntegrator implements IIntegrator {
       return delta;
       
     } catch (error) {
-      console.error('❌ Newton步求解失敗:', error);
+      this._log.error('❌ Newton步求解失敗:', error);
       
       // 緊急回退：使用最小步長
       const delta = new Vector(n);
@@ -823,21 +938,15 @@ export class GeneralizedAlphaIntegrator implements IIntegrator {
 
   // === 輔助方法 ===
 
-  private _logInfo(message: string): void {
-    if (this._options.verbose) {
-      console.log(message);
-    }
-  }
-
   private _logError(message: string): void {
-    console.error(`[Generalized-α] ${message}`);
+    this._log.error(`[Generalized-α] ${message}`);
   }
 
   private _logPerformanceStats(): void {
-    if (!this._options.verbose) return;
+    if (!this._log.debugEnabled) return;
     
     const report = this.getPerformanceReport();
-    console.log(`   📊 性能統計: ${report.acceptanceRate.toFixed(2)} 接受率, ${report.avgNewtonIterations.toFixed(1)} 平均Newton迭代`);
+    this._log.debug(`   📊 性能統計: ${report.acceptanceRate.toFixed(2)} 接受率, ${report.avgNewtonIterations.toFixed(1)} 平均Newton迭代`);
   }
 }
 
@@ -47,6 +47,45 @@ export interface AssemblyContext {
   readonly getExtraVariableIndex?: (componentName: string, variableType: string) => number | undefined;
 }
 
+/**
+ * 📐 印记导数上下文 (伴随灵敏度分析)
+ *
+ * 描述某次已收敛装配的工作点。残差记为 F = A·x − b，
+ * 组件按 assemble() 中相同的伴随模型给出 F 的偏导。
+ */
+export interface StampDerivativeContext {
+  /** 节点名称到矩阵索引的映射 */
+  readonly nodeMap: Map<string, number>;
+
+  /** 装配时的仿真时间 (DC 为 0) */
+  readonly currentTime: number;
+
+  /** 装配时的时间步长 (DC 为 0) */
+  readonly dt: number;
+
+  /** 收敛解 */
+  readonly solutionVector: IVector;
+
+  /** 装配时使用的上一个时间点的解 (DC 时缺省) */
+  readonly previousSolutionVector?: IVector;
+
+  /** 额外变数索引 */
+  readonly getExtraVariableIndex?: (componentName: string, variableType: string) => number | undefined;
+}
+
+/**
+ * ∂F[row]/∂p 的一个分量
+ *
+ * parameter 为大写参数名 (如 'IS')；空字符串表示元件主值 (R/C/L 的值、独立源的直流值)，
+ * 与蒙特卡罗容差目标一致：R1、D1.IS
+ */
+export type ParameterStamp = (parameter: string, row: number, value: number) => void;
+
+/**
+ * ∂F[row]/∂x_prev[column] 的一个元素 (伴随模型的历史项)
+ */
+export type HistoryStamp = (row: number, column: number, value: number) => void;
+
 /**
  * 🎯 核心组件接口 (重构版本)
  * 
@@ -91,7 +130,27 @@ export interface ComponentInterface {
    */
   handleEvent?(event: IEvent, context: AssemblyContext): void;
 
-  
+  /**
+   * 🛡️ 最近一次组装是否在限幅后的电压处线性化 (SPICE noncon)
+   * 
+   * 为 true 时 Newton 不能仅凭更新量很小就判定收敛
+   */
+  hasLimitedVoltage?(): boolean;
+
+  /**
+   * 📐 残差对组件参数的偏导 ∂F/∂p (伴随灵敏度)
+   *
+   * 未实现的组件不提供可求导参数
+   */
+  stampParameterDerivatives?(context: StampDerivativeContext, stamp: ParameterStamp): void;
+
+  /**
+   * 📐 残差对上一时间点解的偏导 ∂F/∂x_prev (瞬态伴随的反向耦合)
+   *
+   * 伴随模型含历史项的组件 (电容、电感等) 必须实现
+   */
+  stampHistoryDerivatives?(context: StampDerivativeContext, stamp: HistoryStamp): void;
+
   /**
    * 🔍 组件参数验证
    * 
@@ -118,6 +177,19 @@ export interface ComponentInterface {
 export interface ScalableSource {
   scaleSource(factor: number): void;
   restoreSource(): void;
+
+  /** 📸 缩放状态 (检查点) */
+  getScaleState(): SourceScaleState;
+  restoreScaleState(state: SourceScaleState): void;
+}
+
+/**
+ * 📸 激励源缩放状态：当前直流值、源步进基准值与波形缩放因子
+ */
+export interface SourceScaleState {
+  readonly dcValue: number;
+  readonly baseValue: number;
+  readonly scaleFactor: number;
 }
 
 /**
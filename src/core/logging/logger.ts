@@ -0,0 +1,118 @@
+/**
+ * 📝 分级日志 - AkingSPICE 2.1
+ *
+ * 热路径上的日志以级别开关守卫，关闭时只剩一次布尔读取与分支，不做字符串格式化：
+ *
+ *   if (log.debugEnabled) log.debug(`Newton[${k}]: ||Δx|| = ${norm.toExponential(3)}`);
+ *
+ * - 模块级共享日志器由 getLogger(scope) 获取，setLogLevel() 统一调整级别
+ * - 需要独立级别的实例 (如 verbose 引擎) 可直接 new Logger(scope, level)
+ * - 输出经可替换的 sink，默认写到 console
+ */
+
+/**
+ * 日志级别 (数值越大越详细)
+ */
+export enum LogLevel {
+  SILENT = 0,
+  ERROR = 1,
+  WARN = 2,
+  INFO = 3,
+  DEBUG = 4
+}
+
+/**
+ * 日志输出目标
+ */
+export type LogSink = (level: LogLevel, scope: string, message: string, details: readonly unknown[]) => void;
+
+const consoleSink: LogSink = (level, _scope, message, details) => {
+  switch (level) {
+    case LogLevel.ERROR: console.error(message, ...details); break;
+    case LogLevel.WARN: console.warn(message, ...details); break;
+    case LogLevel.INFO: console.info(message, ...details); break;
+    default: console.debug(message, ...details); break;
+  }
+};
+
+let defaultLevel = LogLevel.WARN;
+let sink: LogSink = consoleSink;
+const registry = new Map<string, Logger>();
+
+export class Logger {
+  errorEnabled = false;
+  warnEnabled = false;
+  infoEnabled = false;
+  debugEnabled = false;
+  private _level = LogLevel.SILENT;
+
+  constructor(readonly scope: string, level: LogLevel = defaultLevel) {
+    this.setLevel(level);
+  }
+
+  get level(): LogLevel {
+    return this._level;
+  }
+
+  setLevel(level: LogLevel): void {
+    this._level = level;
+    this.errorEnabled = level >= LogLevel.ERROR;
+    this.warnEnabled = level >= LogLevel.WARN;
+    this.infoEnabled = level >= LogLevel.INFO;
+    this.debugEnabled = level >= LogLevel.DEBUG;
+  }
+
+  error(message: string, ...details: unknown[]): void {
+    if (this.errorEnabled) sink(LogLevel.ERROR, this.scope, message, details);
+  }
+
+  warn(message: string, ...details: unknown[]): void {
+    if (this.warnEnabled) sink(LogLevel.WARN, this.scope, message, details);
+  }
+
+  info(message: string, ...details: unknown[]): void {
+    if (this.infoEnabled) sink(LogLevel.INFO, this.scope, message, details);
+  }
+
+  debug(message: string, ...details: unknown[]): void {
+    if (this.debugEnabled) sink(LogLevel.DEBUG, this.scope, message, details);
+  }
+}
+
+/**
+ * 获取模块级共享日志器 (同一 scope 返回同一实例)
+ */
+export function getLogger(scope: string): Logger {
+  let logger = registry.get(scope);
+  if (!logger) {
+    logger = new Logger(scope);
+    registry.set(scope, logger);
+  }
+  return logger;
+}
+
+/**
+ * 设置共享日志器的级别；不指定 scope 时作用于全部共享日志器及之后新建的日志器
+ */
+export function setLogLevel(level: LogLevel, scope?: string): void {
+  if (scope !== undefined) {
+    getLogger(scope).setLevel(level);
+    return;
+  }
+  defaultLevel = level;
+  for (const logger of registry.values()) logger.setLevel(level);
+}
+
+/**
+ * 当前默认级别
+ */
+export function getLogLevel(): LogLevel {
+  return defaultLevel;
+}
+
+/**
+ * 替换输出目标 (null 恢复 console)
+ */
+export function setLogSink(next: LogSink | null): void {
+  sink = next ?? consoleSink;
+}
@@ -16,6 +16,7 @@
  *   基础器件: R, L, C, D, M (MOSFET)
  *   电源: V (电压源), I (电流源)
  *   控制语句: .param, .model, .tran, .dc
+ *   输出控制: .save/.probe (记录信号), .meas (在线测量)
  *   分析命令: .op, .ac, .noise
  *   子电路: .subckt, .ends
  * 
@@ -74,6 +75,8 @@ export interface ParsedNetlist {
   readonly parameters: Map<string, number>;
   readonly models: Map<string, NetlistModel>;
   readonly analysisCommands: readonly AnalysisCommand[];
+  readonly probes: readonly string[];           // .SAVE/.PROBE 信号 (V(node)、I(device)、ALL)，空表示全部记录
+  readonly measurements: readonly MeasureDefinition[]; // .MEAS TRAN 测量
   readonly subcircuits: Map<string, SubcircuitDefinition>;
   readonly nodeList: readonly string[];
   readonly statistics: ParseStatistics;
@@ -102,6 +105,31 @@ export interface AnalysisCommand {
   readonly stepSize?: number;
 }
 
+/**
+ * 测量的过零条件 (.MEAS TRIG/TARG/WHEN)
+ */
+export interface MeasureCrossing {
+  readonly signal: string;
+  readonly value: number;
+  readonly edge: 'RISE' | 'FALL' | 'CROSS';
+  readonly count: number;   // 第几次过零，-1 表示最后一次 (LAST)
+  readonly delay: number;   // TD：此时间之前的过零不计
+}
+
+/**
+ * .MEAS 测量定义
+ */
+export interface MeasureDefinition {
+  readonly name: string;
+  readonly kind: 'AVG' | 'RMS' | 'MIN' | 'MAX' | 'PP' | 'INTEG' | 'TRIG_TARG' | 'WHEN' | 'FIND';
+  readonly signal?: string;             // 窗口类测量与 FIND 的信号
+  readonly from?: number;               // 窗口起点 (默认仿真起点)
+  readonly to?: number;                 // 窗口终点 (默认仿真终点)
+  readonly at?: number;                 // FIND ... AT=
+  readonly trigger?: MeasureCrossing;   // TRIG 或 WHEN 条件
+  readonly target?: MeasureCrossing;    // TARG 条件
+}
+
 /**
  * 子电路定义
  */
@@ -133,6 +161,8 @@ export class SpiceNetlistParser {
   private readonly _subcircuits: Map<string, SubcircuitDefinition> = new Map();
   private readonly _elements: NetlistElement[] = [];
   private readonly _analysisCommands: AnalysisCommand[] = [];
+  private readonly _probes: string[] = [];
+  private readonly _measurements: MeasureDefinition[] = [];
   private readonly _warnings: string[] = [];
   private readonly _errors: string[] = [];
   
@@ -144,6 +174,10 @@ export class SpiceNetlistParser {
   private _currentLineNumber: number = 0;
   private _parseStartTime: number = 0;
   
+  // 智能设备参数的规范名称 (网表中参数名不区分大小写)
+  private static readonly DIODE_PARAMETER_NAMES = ['Is', 'n', 'Rs', 'Cj0', 'Vj', 'm', 'BV', 'tt'] as const;
+  private static readonly MOSFET_PARAMETER_NAMES = ['Vth', 'Kp', 'lambda', 'Cgs', 'Cgd', 'Ron', 'Roff', 'Vmax', 'Imax'] as const;
+  
   // 预定义参数和常数
   private readonly _constants: Map<string, number> = new Map([
     ['PI', Math.PI],
@@ -221,6 +255,8 @@ export class SpiceNetlistParser {
   private _reset(): void {
     this._elements.length = 0;
     this._analysisCommands.length = 0;
+    this._probes.length = 0;
+    this._measurements.length = 0;
     this._warnings.length = 0;
     this._errors.length = 0;
     this._parameters.clear();
@@ -311,6 +347,10 @@ export class SpiceNetlistParser {
       
       if (line.startsWith('.TRAN') || line.startsWith('.AC') || line.startsWith('.DC') || line.startsWith('.OP')) {
         this._parseAnalysisCommand(line);
+      } else if (line.startsWith('.SAVE') || line.startsWith('.PROBE')) {
+        this._parseProbeDirective(line);
+      } else if (line.startsWith('.MEAS')) {
+        this._parseMeasure(line);
       } else if (line.match(/^[RLCDMVIXK]/)) {
         this._parseElement(line);
       }
@@ -421,6 +461,131 @@ export class SpiceNetlistParser {
     });
   }
 
+  private _parseProbeDirective(line: string): void {
+    // .SAVE V(out) I(R1) node ...   |   .PROBE [TRAN|DC] V(out) ...
+    const tokens = line.replace(/^\.\w+\s*/, '').match(/[A-Za-z]+\([^)]*\)|[^\s,()]+/g) ?? [];
+
+    for (const token of tokens) {
+      const upper = token.toUpperCase();
+      if (upper === 'TRAN' || upper === 'DC' || upper === 'AC' || upper === 'OP') continue;
+
+      const signal = upper === 'ALL' ? 'ALL' : this._parseSignal(token);
+      if (signal === null) {
+        this._warnings.push(`Line ${this._currentLineNumber}: Unsupported probe signal '${token}'`);
+      } else if (!this._probes.includes(signal)) {
+        this._probes.push(signal);
+      }
+    }
+  }
+
+  /**
+   * 规整信号名：V(node) 保留节点名大小写，I(device) 器件名大写，裸节点名视为 V(node)
+   */
+  private _parseSignal(token: string): string | null {
+    const call = token.match(/^([A-Za-z]+)\(\s*([^,\s)]+)\s*\)$/);
+    if (call && call[1] && call[2]) {
+      const kind = call[1].toUpperCase();
+      if (kind === 'V') return `V(${call[2]})`;
+      if (kind === 'I') return `I(${call[2].toUpperCase()})`;
+      return null;
+    }
+    return token.includes('(') ? null : `V(${token})`;
+  }
+
+  private _parseMeasure(line: string): void {
+    // .MEAS [TRAN] name AVG|RMS|MIN|MAX|PP|INTEG sig [FROM=t] [TO=t]
+    // .MEAS [TRAN] name TRIG sig VAL=v [RISE|FALL|CROSS=n|LAST] [TD=t] TARG sig VAL=v ...
+    // .MEAS [TRAN] name WHEN sig=v [RISE|FALL|CROSS=n] [TD=t]
+    // .MEAS [TRAN] name FIND sig AT=t
+    const tokens = line.replace(/\s*=\s*/g, '=').split(/\s+/).slice(1);
+    const fail = (reason: string): void => {
+      this._warnings.push(`Line ${this._currentLineNumber}: Ignored .MEAS (${reason})`);
+    };
+
+    const analysis = tokens[0]?.toUpperCase();
+    if (analysis === 'DC' || analysis === 'AC' || analysis === 'OP') {
+      fail(`${analysis} measurements are not supported`);
+      return;
+    }
+    if (analysis === 'TRAN') tokens.shift();
+
+    const name = tokens.shift();
+    const kindToken = tokens.shift()?.toUpperCase();
+    if (!name || !kindToken) {
+      fail('missing name or measurement type');
+      return;
+    }
+
+    // 拆分 key=value 选项
+    const options = (from: number, to: number = tokens.length): Map<string, string> => {
+      const result = new Map<string, string>();
+      for (const token of tokens.slice(from, to)) {
+        const [key, value] = token.split('=');
+        if (key && value !== undefined) result.set(key.toUpperCase(), value);
+      }
+      return result;
+    };
+    const number = (value: string | undefined): number | undefined =>
+      value === undefined ? undefined : this._evaluateExpression(value);
+    const crossing = (signal: string, value: number, opts: Map<string, string>): MeasureCrossing => {
+      const edge = opts.has('RISE') ? 'RISE' : opts.has('FALL') ? 'FALL' : 'CROSS';
+      const countText = opts.get(edge) ?? '1';
+      return {
+        signal,
+        value,
+        edge,
+        count: countText.toUpperCase() === 'LAST' ? -1 : Math.max(1, Math.round(this._evaluateExpression(countText))),
+        delay: number(opts.get('TD')) ?? 0
+      };
+    };
+
+    try {
+      const kind = kindToken === 'INTEGRAL' ? 'INTEG' : kindToken;
+      if (kind === 'AVG' || kind === 'RMS' || kind === 'MIN' || kind === 'MAX' || kind === 'PP' || kind === 'INTEG') {
+        const signal = tokens[0] ? this._parseSignal(tokens[0]) : null;
+        if (!signal) return fail(`invalid signal for ${kind}`);
+        const opts = options(1);
+        const from = number(opts.get('FROM'));
+        const to = number(opts.get('TO'));
+        this._measurements.push({
+          name, kind, signal,
+          ...(from !== undefined ? { from } : {}),
+          ...(to !== undefined ? { to } : {})
+        });
+      } else if (kind === 'TRIG') {
+        const targIndex = tokens.findIndex(token => token.toUpperCase() === 'TARG');
+        const trigSignal = tokens[0] ? this._parseSignal(tokens[0]) : null;
+        const targSignal = targIndex >= 0 && tokens[targIndex + 1] ? this._parseSignal(tokens[targIndex + 1]!) : null;
+        if (!trigSignal || !targSignal) return fail('TRIG/TARG needs two signals');
+        const trigOpts = options(1, targIndex);
+        const targOpts = options(targIndex + 2);
+        const trigValue = number(trigOpts.get('VAL'));
+        const targValue = number(targOpts.get('VAL'));
+        if (trigValue === undefined || targValue === undefined) return fail('TRIG/TARG needs VAL=');
+        this._measurements.push({
+          name,
+          kind: 'TRIG_TARG',
+          trigger: crossing(trigSignal, trigValue, trigOpts),
+          target: crossing(targSignal, targValue, targOpts)
+        });
+      } else if (kind === 'WHEN') {
+        const [signalToken, valueText] = (tokens[0] ?? '').split('=');
+        const signal = signalToken ? this._parseSignal(signalToken) : null;
+        if (!signal || valueText === undefined) return fail('WHEN needs sig=value');
+        this._measurements.push({ name, kind, trigger: crossing(signal, this._evaluateExpression(valueText), options(1)) });
+      } else if (kind === 'FIND') {
+        const signal = tokens[0] ? this._parseSignal(tokens[0]) : null;
+        const at = number(options(1).get('AT'));
+        if (!signal || at === undefined) return fail('FIND needs a signal and AT=');
+        this._measurements.push({ name, kind, signal, at });
+      } else {
+        fail(`unsupported measurement type ${kindToken}`);
+      }
+    } catch (error) {
+      fail(String(error));
+    }
+  }
+
   private _parseElement(line: string): void {
     const parts = line.split(/\s+/).filter(p => p); // filter out empty strings
     if (parts.length < 3 || !parts[0]) {
@@ -781,22 +946,20 @@ export class SpiceNetlistParser {
                   return this._createVoltageSource(element);
 
               case NetlistElementType.DIODE:
-                  // const diodeModel = element.modelName ? netlist.models.get(element.modelName) : null; // Unused
                   // [修正] 传递字符串节点，让智能设备工厂处理。但由于接口不一致，我们暂时在这里做转换。
                   // 理想情况下，智能设备也应该接受 string[]。
                   return SmartDeviceFactory.createDiode(
                       element.name,
-                      [nodes[0], nodes[1]],
-                      { /* ... model params ... */ }
+                      [nodes[0]!, nodes[1]!],
+                      this._collectDeviceParameters(element, netlist, SpiceNetlistParser.DIODE_PARAMETER_NAMES)
                   );
 
               case NetlistElementType.MOSFET:
-                  // const mosfetModel = element.modelName ? netlist.models.get(element.modelName) : null; // Unused
                   // [修正] 节点问题同上
                   return SmartDeviceFactory.createMOSFET(
                       element.name,
-                      [nodes[0], nodes[1], nodes[2]],
-                      { /* ... model params ... */ }
+                      [nodes[0]!, nodes[1]!, nodes[2]!],
+                      this._collectDeviceParameters(element, netlist, SpiceNetlistParser.MOSFET_PARAMETER_NAMES)
                   );
               
               case NetlistElementType.COUPLING: // 'K'
@@ -823,6 +986,33 @@ export class SpiceNetlistParser {
       }
   }
 
+  /**
+   * 合并 .MODEL 参数与实例参数 (实例参数优先)，并映射到设备参数的规范名称
+   */
+  private _collectDeviceParameters(
+      element: NetlistElement,
+      netlist: ParsedNetlist,
+      canonicalNames: readonly string[]
+  ): Record<string, number> {
+      const byUpperName = new Map(canonicalNames.map(name => [name.toUpperCase(), name] as const));
+      const result: Record<string, number> = {};
+
+      const apply = (name: string, value: string | number): void => {
+          const canonical = byUpperName.get(name.toUpperCase());
+          if (canonical !== undefined && typeof value === 'number' && isFinite(value)) {
+              result[canonical] = value;
+          }
+      };
+
+      const model = element.modelName ? netlist.models.get(element.modelName) : undefined;
+      if (element.modelName && !model) {
+          this._warnings.push(`Model '${element.modelName}' for ${element.name} not found, using defaults.`);
+      }
+      model?.parameters.forEach((value, name) => apply(name, value));
+      element.parameters.forEach((value, name) => apply(name, value));
+      return result;
+  }
+
   // [新增] 辅助函数来创建电压源
   private _createVoltageSource(element: NetlistElement): VoltageSource {
       const name = element.name;
@@ -877,6 +1067,8 @@ export class SpiceNetlistParser {
       parameters: new Map(this._parameters),
       models: new Map(this._models),
       analysisCommands: this._analysisCommands,
+      probes: [...this._probes],
+      measurements: [...this._measurements],
       subcircuits: new Map(this._subcircuits),
       nodeList: Array.from(this._nodes),
       statistics: {
@@ -900,6 +1092,8 @@ export class SpiceNetlistParser {
       parameters: new Map(),
       models: new Map(),
       analysisCommands: [],
+      probes: [],
+      measurements: [],
       subcircuits: new Map(),
       nodeList: [],
       statistics: {
@@ -0,0 +1,478 @@
+/**
+ * 🎯 伴随灵敏度分析 - AkingSPICE 2.1
+ *
+ * 一次反向扫描求出输出对全部元件参数的导数，代价与参数个数无关：
+ * - DC：复用 DC Newton 最后一次分解的子矩阵，求解 Jᵀ·λ = ∂g/∂x，dg/dp = -λᵀ·∂F/∂p
+ * - 瞬态：正向仿真记录每个接受步的解与雅可比 (数值相同的相邻步共享同一份，反向时不重分解)，
+ *   反向递推 J_nᵀ·λ_n = ∂G/∂x_n - (∂F_{n+1}/∂x_n)ᵀ·λ_{n+1}，再经 UIC 置零掩码回到 DC 工作点
+ * - 多个输出在每一步以一次分块转置求解 (solveMany) 完成；种子全零的步跳过求解
+ * - ∂F/∂p 与 ∂F/∂x_prev 由组件的 stampParameterDerivatives / stampHistoryDerivatives 提供
+ *
+ * 步长选择视为与参数无关；FROM/TO/AT 处的补采样按相邻接受解线性插值求导
+ * (在线测量使用积分器的 Hermite 稠密输出，两者相差插值误差量级)。
+ *
+ * 📋 用法：
+ *   const engine = new CircuitSimulationEngine({ ..., measurements, adjointSensitivity: true });
+ *   await engine.runSimulation();
+ *   engine.computeSensitivities(['tdelay']).get('tdelay')!.get('R1');  // ∂tdelay/∂R1
+ */
+
+import type { Time, IVector } from '../../types/index';
+import { SparseMatrix } from '../../math/sparse/matrix';
+import type { CSCMatrix, SolverMode } from '../../math/sparse/matrix';
+import { Vector } from '../../math/sparse/vector';
+import type { ComponentInterface, StampDerivativeContext } from '../interfaces/component';
+import type { MeasureDefinition } from '../parser/spice_netlist_parser';
+import { differentiateMeasurement, measurementBreakpoints } from './measurement';
+
+/**
+ * 输出信号的线性形式：值 = Σ coefficient·x[index]
+ *
+ * parameter 表示信号本身显含的参数 (如 I(R) = V/R)：∂s/∂p = scale·s
+ */
+export interface SignalForm {
+  readonly terms: readonly (readonly [index: number, coefficient: number])[];
+  readonly parameter?: { readonly key: string; readonly scale: number };
+}
+
+/**
+ * 灵敏度输出：.MEAS 测量 (对整个瞬态轨迹求导) 或 DC 工作点处的信号
+ */
+export type SensitivityOutput =
+  | { readonly kind: 'measure'; readonly definition: MeasureDefinition }
+  | { readonly kind: 'signal'; readonly signal: string };
+
+/**
+ * 电路描述 (由引擎提供)
+ */
+export interface AdjointCircuit {
+  readonly devices: readonly ComponentInterface[];
+  readonly nodeMap: Map<string, number>;
+
+  /** 接地节点索引 (-1 表示无) */
+  readonly groundIndex: number;
+
+  readonly getExtraVariableIndex: (componentName: string, variableType: string) => number | undefined;
+  readonly solverMode: SolverMode;
+  readonly startTime: Time;
+  readonly endTime: Time;
+
+  /** 全部 .MEAS 定义 (决定补采样时刻) */
+  readonly measurements: readonly MeasureDefinition[];
+
+  /** 信号名 -> 线性形式 (未知信号应抛出错误) */
+  readonly signal: (name: string) => SignalForm;
+}
+
+/** 测量样本序列：样本 j = w0[j]·x[n0[j]] + w1[j]·x[n1[j]] */
+interface MeasurementSamples {
+  readonly times: Float64Array;
+  readonly n0: Int32Array;
+  readonly w0: Float64Array;
+  readonly n1: Int32Array;
+  readonly w1: Float64Array;
+}
+
+/** 一个接受步 (或 UIC 初始状态) */
+interface TrajectoryPoint {
+  readonly time: Time;
+  readonly dt: number;
+  readonly solution: Vector;
+
+  /** 该步收敛时的雅可比 (初始状态为 null) */
+  readonly jacobian: CSCMatrix | null;
+}
+
+/**
+ * 📼 伴随轨迹记录器
+ *
+ * 引擎在 DC 收敛、UIC 初始化与每个接受步后调用；内存约为每步一个解向量，
+ * 雅可比只在数值变化时另存一份 (线性电路定步长时整个瞬态只存一份)。
+ */
+export class AdjointRecorder {
+  private _operatingPoint: { jacobian: SparseMatrix; mapping: readonly number[]; solution: Vector } | null = null;
+  private _resetIndices: readonly number[] = [];
+  private readonly _trajectory: TrajectoryPoint[] = [];
+  private _distinctJacobians = 0;
+
+  /**
+   * 📍 DC 工作点及其 (已分解的) 去地子矩阵雅可比
+   *
+   * @param mapping 子矩阵索引 -> 完整系统索引
+   */
+  recordOperatingPoint(jacobian: SparseMatrix, mapping: readonly number[], solution: IVector): void {
+    this._operatingPoint = { jacobian, mapping, solution: Vector.from(solution.toArray()) };
+    this._trajectory.length = 0;
+    this._distinctJacobians = 0;
+  }
+
+  /**
+   * ⏱️ 瞬态初始状态 (UIC 置零之后)
+   *
+   * @param resetIndices UIC 置零的分量 (与 DC 工作点无关)
+   */
+  recordInitialState(time: Time, solution: IVector, resetIndices: readonly number[]): void {
+    this._resetIndices = resetIndices;
+    this._trajectory.length = 0;
+    this._trajectory.push({ time, dt: 0, solution: Vector.from(solution.toArray()), jacobian: null });
+  }
+
+  /**
+   * ✅ 接受步：收敛解与组装时的步长、雅可比 (时间未推进的调用被忽略)
+   */
+  recordStep(time: Time, dt: number, solution: IVector, jacobian: SparseMatrix): void {
+    const last = this._trajectory[this._trajectory.length - 1];
+    if (!last || time <= last.time) return;
+
+    let csc = jacobian.toCSC();
+    const previous = this._lastJacobian();
+    if (previous && sameCSC(previous, csc)) {
+      csc = previous;
+    } else {
+      this._distinctJacobians++;
+    }
+    this._trajectory.push({ time, dt, solution: Vector.from(solution.toArray()), jacobian: csc });
+  }
+
+  /** 记录的接受步数 */
+  get stepCount(): number {
+    return Math.max(0, this._trajectory.length - 1);
+  }
+
+  /** 数值互不相同的瞬态雅可比个数 (反向扫描的分解次数) */
+  get distinctJacobianCount(): number {
+    return this._distinctJacobians;
+  }
+
+  get hasOperatingPoint(): boolean {
+    return this._operatingPoint !== null;
+  }
+
+  clear(): void {
+    this._operatingPoint = null;
+    this._resetIndices = [];
+    this._trajectory.length = 0;
+    this._distinctJacobians = 0;
+  }
+
+  /**
+   * 🎯 反向扫描：各输出对全部参数的导数
+   *
+   * @returns 输出名 -> (参数键 -> 导数)；参数键为元件名 (主值) 或 元件名.参数名。
+   *          条件未满足的测量不出现在结果中。
+   */
+  compute(circuit: AdjointCircuit, outputs: readonly SensitivityOutput[]): Map<string, Map<string, number>> {
+    const operatingPoint = this._operatingPoint;
+    if (!operatingPoint) {
+      throw new Error('伴随灵敏度需要 DC 工作点记录 (adjointSensitivity 未开启或仿真从检查点恢复)');
+    }
+    const trajectory = this._trajectory;
+    const size = operatingPoint.solution.size;
+    const ground = circuit.groundIndex;
+    if (ground >= 0) {
+      // Newton 不更新地节点分量 (可能残留初值)：求导时按 0 V 处理，与去地求解一致
+      operatingPoint.solution.set(ground, 0);
+      trajectory.forEach(point => point.solution.set(ground, 0));
+    }
+
+    // 测量种子：active[k].weights[s][n] 为输出 k 对第 n 个轨迹点上信号 s 的导数
+    const accumulator = new SensitivityAccumulator(circuit.devices);
+    const active: { name: string; forms: SignalForm[]; weights: Float64Array[] }[] = [];
+    const dcSeeds: { name: string; form: SignalForm }[] = [];
+    const samples = trajectory.length > 1 ? this._measurementSamples(circuit) : null;
+
+    for (const output of outputs) {
+      if (output.kind === 'signal') {
+        dcSeeds.push({ name: output.signal, form: circuit.signal(output.signal) });
+        continue;
+      }
+      if (!samples) {
+        throw new Error(`测量 ${output.definition.name} 需要瞬态轨迹记录`);
+      }
+      const seed = this._measurementSeed(circuit, output.definition, samples, accumulator, active.length);
+      if (seed) {
+        active.push({ name: output.definition.name, ...seed });
+      }
+    }
+    dcSeeds.forEach(({ form }, i) => {
+      accumulator.addExplicit(form, evaluate(form, operatingPoint.solution), active.length + i);
+    });
+
+    // 瞬态反向递推 (λ 为上一处理步 n+1 的伴随向量，全零时为 null)
+    let lambda: Float64Array[] | null = null;
+    let initial: Float64Array[] | null = null;  // ∂G/∂x_0 - (∂F_1/∂x_0)ᵀ·λ_1
+    const work = new SparseMatrix(size, size);
+    work.setSolverMode(circuit.solverMode);
+    let loaded: CSCMatrix | null = null;
+
+    for (let n = trajectory.length - 1; n >= 0; n--) {
+      const point = trajectory[n]!;
+      const rhs = active.map(({ forms, weights }) => {
+        const b = new Float64Array(size);
+        forms.forEach((form, s) => addForm(b, form, weights[s]![n]!));
+        return b;
+      });
+      if (lambda) {
+        this._subtractHistory(circuit, n + 1, lambda, rhs);
+      }
+      if (n === 0) {
+        initial = rhs;
+        break;
+      }
+
+      if (ground >= 0) rhs.forEach(b => { b[ground] = 0; });
+      if (rhs.every(isZero)) {
+        lambda = null;
+        continue;
+      }
+      if (point.jacobian !== loaded) {
+        work.loadCSC(point.jacobian!);
+        loaded = point.jacobian;
+      }
+      lambda = work.solveMany(rhs.map(b => Vector.from(Array.from(b))), true).map(v => Float64Array.from(v.toArray()));
+      accumulator.accumulate(this._context(circuit, n), lambda);
+    }
+
+    // 初始状态 → DC 工作点：UIC 置零的分量不依赖 DC 解
+    const dcRhs: Float64Array[] = active.map((_, k) => {
+      const b = initial?.[k] ?? new Float64Array(size);
+      for (const index of this._resetIndices) b[index] = 0;
+      return b;
+    });
+    for (const { form } of dcSeeds) {
+      const b = new Float64Array(size);
+      addForm(b, form, 1);
+      dcRhs.push(b);
+    }
+    if (dcRhs.some(b => !isZero(b))) {
+      const { jacobian, mapping } = operatingPoint;
+      const sub = dcRhs.map(b => Vector.from(mapping.map(index => b[index]!)));
+      const solutions = jacobian.solveMany(sub, true);
+      const dcLambda = solutions.map(solution => {
+        const full = new Float64Array(size);
+        mapping.forEach((index, i) => { full[index] = solution.get(i); });
+        return full;
+      });
+      accumulator.accumulate({
+        nodeMap: circuit.nodeMap,
+        currentTime: 0,
+        dt: 0,
+        solutionVector: operatingPoint.solution,
+        getExtraVariableIndex: circuit.getExtraVariableIndex
+      }, dcLambda);
+    }
+
+    const names = [...active.map(a => a.name), ...dcSeeds.map(d => d.name)];
+    return accumulator.results(names);
+  }
+
+  /** 第 n 个轨迹点的导数上下文 */
+  private _context(circuit: AdjointCircuit, n: number): StampDerivativeContext {
+    const point = this._trajectory[n]!;
+    return {
+      nodeMap: circuit.nodeMap,
+      currentTime: point.time,
+      dt: point.dt,
+      solutionVector: point.solution,
+      previousSolutionVector: this._trajectory[n - 1]!.solution,
+      getExtraVariableIndex: circuit.getExtraVariableIndex
+    };
+  }
+
+  /** rhs_k -= (∂F_next/∂x_prev)ᵀ·λ_k */
+  private _subtractHistory(circuit: AdjointCircuit, next: number, lambda: readonly Float64Array[], rhs: Float64Array[]): void {
+    const context = this._context(circuit, next);
+    const ground = circuit.groundIndex;
+    for (const device of circuit.devices) {
+      device.stampHistoryDerivatives?.(context, (row, column, value) => {
+        if (row === ground || column === ground) return;
+        for (let k = 0; k < rhs.length; k++) {
+          rhs[k]![column]! -= value * lambda[k]![row]!;
+        }
+      });
+    }
+  }
+
+  /**
+   * 测量的样本序列：初始状态、FROM/TO/AT 补采样与每个接受步 (与引擎在线采样的时刻一致)
+   */
+  private _measurementSamples(circuit: AdjointCircuit): MeasurementSamples {
+    const trajectory = this._trajectory;
+    const breakpoints = measurementBreakpoints(circuit.measurements, circuit.startTime, circuit.endTime);
+    const times: number[] = [trajectory[0]!.time];
+    const n0: number[] = [0];
+    const w0: number[] = [1];
+    const n1: number[] = [0];
+    const w1: number[] = [0];
+
+    let next = 0;
+    for (let n = 1; n < trajectory.length; n++) {
+      const t0 = trajectory[n - 1]!.time;
+      const t1 = trajectory[n]!.time;
+      while (next < breakpoints.length && breakpoints[next]! < t1) {
+        const t = breakpoints[next++]!;
+        if (t > t0) {
+          const theta = (t - t0) / (t1 - t0);
+          times.push(t); n0.push(n - 1); w0.push(1 - theta); n1.push(n); w1.push(theta);
+        }
+      }
+      times.push(t1); n0.push(n); w0.push(1); n1.push(n); w1.push(0);
+    }
+    return {
+      times: Float64Array.from(times),
+      n0: Int32Array.from(n0), w0: Float64Array.from(w0),
+      n1: Int32Array.from(n1), w1: Float64Array.from(w1)
+    };
+  }
+
+  /**
+   * 测量对样本的梯度 -> 各轨迹点上每个信号的权重；信号显含参数的部分直接计入
+   */
+  private _measurementSeed(
+    circuit: AdjointCircuit,
+    definition: MeasureDefinition,
+    samples: MeasurementSamples,
+    accumulator: SensitivityAccumulator,
+    output: number
+  ): { forms: SignalForm[]; weights: Float64Array[] } | null {
+    const trajectory = this._trajectory;
+    const { times, n0, w0, n1, w1 } = samples;
+    const forms = new Map<string, SignalForm>();
+    const sampled = new Map<string, Float64Array>();
+    const values = (signal: string): Float64Array => {
+      let v = sampled.get(signal);
+      if (!v) {
+        const form = circuit.signal(signal);
+        const atPoint = trajectory.map(point => evaluate(form, point.solution));
+        v = new Float64Array(times.length);
+        for (let j = 0; j < times.length; j++) {
+          v[j] = w0[j]! * atPoint[n0[j]!]! + w1[j]! * atPoint[n1[j]!]!;
+        }
+        forms.set(signal, form);
+        sampled.set(signal, v);
+      }
+      return v;
+    };
+
+    const result = differentiateMeasurement(definition, circuit.startTime, circuit.endTime, times, values);
+    if (!result) return null;
+
+    const seedForms: SignalForm[] = [];
+    const weights: Float64Array[] = [];
+    for (const [signal, gradient] of result.gradients) {
+      const form = forms.get(signal)!;
+      const sampleValues = sampled.get(signal)!;
+      const weight = new Float64Array(trajectory.length);
+      let explicit = 0;
+      for (let j = 0; j < times.length; j++) {
+        const g = gradient[j]!;
+        if (g === 0) continue;
+        weight[n0[j]!]! += g * w0[j]!;
+        weight[n1[j]!]! += g * w1[j]!;
+        explicit += g * sampleValues[j]!;
+      }
+      accumulator.addExplicit(form, explicit, output);
+      seedForms.push(form);
+      weights.push(weight);
+    }
+    return { forms: seedForms, weights };
+  }
+
+  private _lastJacobian(): CSCMatrix | null {
+    for (let n = this._trajectory.length - 1; n >= 0; n--) {
+      const jacobian = this._trajectory[n]!.jacobian;
+      if (jacobian) return jacobian;
+    }
+    return null;
+  }
+}
+
+/**
+ * 参数导数累加：键 -> 每个输出的导数
+ */
+class SensitivityAccumulator {
+  private readonly _slots = new Map<string, number[]>();
+
+  // 每个组件按参数名缓存槽位，避免反向扫描中逐次拼接键
+  private readonly _deviceSlots: Map<string, number[]>[];
+
+  constructor(private readonly _devices: readonly ComponentInterface[]) {
+    this._deviceSlots = _devices.map(() => new Map());
+  }
+
+  /** 信号显含参数的导数：scale·(Σ g·s) */
+  addExplicit(form: SignalForm, weightedValue: number, output: number): void {
+    if (!form.parameter || weightedValue === 0) return;
+    const slot = this._slot(form.parameter.key);
+    slot[output] = (slot[output] ?? 0) + form.parameter.scale * weightedValue;
+  }
+
+  /** dG_k/dp += -λ_k[row]·∂F[row]/∂p */
+  accumulate(context: StampDerivativeContext, lambda: readonly Float64Array[]): void {
+    this._devices.forEach((device, d) => {
+      if (!device.stampParameterDerivatives) return;
+      const slots = this._deviceSlots[d]!;
+      device.stampParameterDerivatives(context, (parameter, row, value) => {
+        let slot = slots.get(parameter);
+        if (!slot) {
+          slot = this._slot(parameter ? `${device.name}.${parameter}` : device.name);
+          slots.set(parameter, slot);
+        }
+        for (let k = 0; k < lambda.length; k++) {
+          slot[k] = (slot[k] ?? 0) - lambda[k]![row]! * value;
+        }
+      });
+    });
+  }
+
+  results(names: readonly string[]): Map<string, Map<string, number>> {
+    const results = new Map<string, Map<string, number>>();
+    names.forEach((name, k) => {
+      const sensitivities = new Map<string, number>();
+      for (const [key, slot] of this._slots) {
+        sensitivities.set(key, slot[k] ?? 0);
+      }
+      results.set(name, sensitivities);
+    });
+    return results;
+  }
+
+  /** 槽位按输出下标稀疏存放，未写入的输出导数为 0 */
+  private _slot(key: string): number[] {
+    let slot = this._slots.get(key);
+    if (!slot) {
+      slot = [];
+      this._slots.set(key, slot);
+    }
+    return slot;
+  }
+}
+
+function evaluate(form: SignalForm, x: IVector): number {
+  let value = 0;
+  for (const [index, coefficient] of form.terms) value += coefficient * x.get(index);
+  return value;
+}
+
+function addForm(b: Float64Array, form: SignalForm, weight: number): void {
+  if (weight === 0) return;
+  for (const [index, coefficient] of form.terms) b[index]! += weight * coefficient;
+}
+
+function isZero(b: Float64Array): boolean {
+  for (let i = 0; i < b.length; i++) {
+    if (b[i] !== 0) return false;
+  }
+  return true;
+}
+
+function sameCSC(a: CSCMatrix, b: CSCMatrix): boolean {
+  if (a.nnz !== b.nnz || a.cols !== b.cols) return false;
+  for (let j = 0; j <= a.cols; j++) {
+    if (a.colPointers[j] !== b.colPointers[j]) return false;
+  }
+  for (let k = 0; k < a.nnz; k++) {
+    if (a.rowIndices[k] !== b.rowIndices[k] || a.values[k] !== b.values[k]) return false;
+  }
+  return true;
+}
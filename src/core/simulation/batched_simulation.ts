@@ -0,0 +1,1040 @@
+/**
+ * 🧬 锁步批量仿真 - AkingSPICE 2.1
+ *
+ * 在单线程上以锁步方式同时仿真 N 个同拓扑电路实例 (容差/参数扫描)：
+ * - 所有实例共享一个固定的结构稀疏模式 (每个器件节点/支路两两相连的并集)
+ * - 数值采用「实例最内层」排列: values[slot * N + s]
+ * - R/C/L/V 与二极管、MOSFET 使用 SoA 装配内核，参数与器件状态按实例最内层存放，内层循环遍历实例
+ * - 稀疏 LU 只对一个实例做带主元分解，其余实例共享主元序列走批量重分解与批量三角求解；
+ *   多数实例主元失效时重新选主元，少数失效的实例单独分解
+ * - 二极管/MOSFET 方程与单实例器件共用 device_equations
+ * - 不支持的器件类型，以及内核未建模的器件参数 (Rs/Cj0/tt/BV、Cgs/Cgd/Vmax/Imax)，在构造时抛出错误
+ *
+ * 🎯 与 CircuitSimulationEngine 的关系：
+ *   器件模型与 MNA 约定完全一致 (电容 GMIN、电感 DC 1nΩ、接地行列消去)，
+ *   瞬态采用固定步长的 Backward Euler 伴随模型与零初始条件 (UIC)。
+ */
+
+import type { IVector } from '../../types/index';
+import type { CSCMatrix } from '../../math/sparse/matrix';
+import { SparseLU } from '../../math/sparse/sparse_lu';
+import type { SymbolicFactorization, NumericFactorization } from '../../math/sparse/sparse_lu';
+import { ExtraVariableIndexManager, ExtraVariableType } from '../mna/extra_variable_manager';
+import type { ComponentInterface } from '../interfaces/component';
+import { Resistor } from '../../components/passive/resistor';
+import { Capacitor } from '../../components/passive/capacitor';
+import { Inductor } from '../../components/passive/inductor';
+import { VoltageSource } from '../../components/sources/voltage_source';
+import { IntelligentDiode } from '../devices/intelligent_diode';
+import { IntelligentMOSFET } from '../devices/intelligent_mosfet';
+import {
+  DiodeState,
+  MOSFETRegion,
+  LIMITING_VOLTAGE_TOL,
+  MIN_CONDUCTANCE,
+  evaluateDiode,
+  evaluateMOSFET,
+  limitDiodeVoltage
+} from '../devices/device_equations';
+import type { DiodeEvaluation, MOSFETEvaluation } from '../devices/device_equations';
+
+// 内核未建模的器件参数及其唯一可接受的取值 (其余取值在构造时拒绝，而不是静默忽略)
+const UNSUPPORTED_DIODE_PARAMETERS: Readonly<Record<string, number>> = {
+  Rs: 0,          // 串联电阻
+  Cj0: 0,         // 结电容
+  tt: 0,          // 渡越时间
+  BV: Infinity    // 可设击穿电压 (模型使用固定的 -5V 线性击穿)
+};
+const UNSUPPORTED_MOSFET_PARAMETERS: Readonly<Record<string, number>> = {
+  Cgs: 0,
+  Cgd: 0,
+  Vmax: Infinity, // 电压/电流额定值检查
+  Imax: Infinity
+};
+
+/**
+ * 批量仿真配置
+ */
+export interface BatchedSimulationConfig {
+  readonly voltageToleranceAbs: number;
+  readonly voltageToleranceRel: number;
+  readonly maxNewtonIterations: number;
+}
+
+/**
+ * 批量 DC 工作点结果
+ */
+export interface BatchedOperatingPoint {
+  /** 解向量 (完整 MNA 维度，实例最内层: solution[index * N + s]) */
+  readonly solution: Float64Array;
+
+  /** 每个实例是否收敛 */
+  readonly converged: Uint8Array;
+
+  /** 锁步 Newton 迭代次数 */
+  readonly iterations: number;
+}
+
+/**
+ * 批量瞬态结果
+ */
+export interface BatchedTransientResult {
+  readonly timePoints: readonly number[];
+
+  /** 节点名 -> 电压序列 (实例最内层: values[step * N + s]) */
+  readonly nodeVoltages: Map<string, Float64Array>;
+
+  /** 每个实例是否全程收敛 */
+  readonly converged: Uint8Array;
+}
+
+/**
+ * 双端电导类内核 (电阻、电容伴随电导)
+ */
+interface TwoTerminalKernel {
+  readonly a: Int32Array;     // 约化后节点索引 (-1 为接地)
+  readonly b: Int32Array;
+  readonly slotAA: Int32Array;
+  readonly slotAB: Int32Array;
+  readonly slotBA: Int32Array;
+  readonly slotBB: Int32Array;
+  readonly values: Float64Array; // [device * N + s]
+}
+
+/**
+ * 支路类内核 (电压源、电感)
+ */
+interface BranchKernel {
+  readonly a: Int32Array;
+  readonly b: Int32Array;
+  readonly branch: Int32Array;   // 约化后支路电流索引
+  readonly slotAK: Int32Array;
+  readonly slotBK: Int32Array;
+  readonly slotKA: Int32Array;
+  readonly slotKB: Int32Array;
+  readonly slotKK: Int32Array;
+  readonly values: Float64Array; // 电感: L；电压源不使用 (激励值按时间由 getValue 提供)
+}
+
+/**
+ * 二极管内核 (values 为 Is)
+ */
+interface DiodeKernel extends TwoTerminalKernel {
+  readonly ideality: Float64Array;        // n [device * N + s]
+  readonly junctionVoltage: Float64Array; // 上次装配的限幅后结电压 (电压限幅的参考点)
+}
+
+/**
+ * MOSFET 内核 (漏/源两行，栅/漏/源三列)
+ */
+interface MOSFETKernel {
+  readonly drain: Int32Array;
+  readonly gate: Int32Array;
+  readonly source: Int32Array;
+  readonly slotDG: Int32Array;
+  readonly slotDD: Int32Array;
+  readonly slotDS: Int32Array;
+  readonly slotSG: Int32Array;
+  readonly slotSD: Int32Array;
+  readonly slotSS: Int32Array;
+  readonly Vth: Float64Array;    // [device * N + s]
+  readonly Kp: Float64Array;
+  readonly lambda: Float64Array;
+  readonly Roff: Float64Array;
+}
+
+/**
+ * 🧬 锁步批量仿真器
+ */
+export class BatchedCircuitSimulator {
+  private readonly _config: BatchedSimulationConfig;
+  private readonly _count: number;
+  private readonly _nodeMapping: Map<string, number> = new Map();
+  private readonly _extraVariableManager: ExtraVariableIndexManager;
+  private readonly _size: number;        // 完整 MNA 维度 (含接地)
+  private readonly _reducedSize: number; // 去除接地后的维度
+  private readonly _ground: number;
+
+  // 共享稀疏模式 (约化空间，CSC)
+  private readonly _colPointers: Int32Array;
+  private readonly _rowIndices: Int32Array;
+  private readonly _slotLookup: Map<number, number> = new Map();
+  private _symbolic: SymbolicFactorization | null = null;
+  private _pivotFactor: NumericFactorization | null = null;
+  private _pivotRefreshes = 0;
+
+  // 批量数值存储
+  private readonly _values: Float64Array;
+  private readonly _rhs: Float64Array;
+
+  // 向量化内核
+  private readonly _resistors: TwoTerminalKernel;
+  private readonly _capacitors: TwoTerminalKernel;
+  private readonly _inductors: BranchKernel;
+  private readonly _sources: BranchKernel;
+  private readonly _sourceDevices: VoltageSource[][] = []; // [device][instance]
+  private readonly _diodes: DiodeKernel;
+  private readonly _mosfets: MOSFETKernel;
+
+  // 最近一次装配中是否有器件在限幅电压处线性化 (逐实例)
+  private readonly _limited: Uint8Array;
+
+  // 共享器件方程的求值输出 (内层循环复用)
+  private readonly _diodeEvaluation: DiodeEvaluation = { state: DiodeState.REVERSE_BIAS, current: 0, conductance: 0 };
+  private readonly _mosfetEvaluation: MOSFETEvaluation = { region: MOSFETRegion.CUTOFF, Id: 0, gm: 0, gds: MIN_CONDUCTANCE };
+
+  constructor(
+    instances: readonly (readonly ComponentInterface[])[],
+    config: Partial<BatchedSimulationConfig> = {}
+  ) {
+    this._config = {
+      voltageToleranceAbs: 1e-6,
+      voltageToleranceRel: 1e-9,
+      maxNewtonIterations: 50,
+      ...config
+    };
+
+    if (instances.length === 0 || instances[0]!.length === 0) {
+      throw new Error('Batched simulation requires at least one non-empty instance');
+    }
+    this._count = instances.length;
+    const template = instances[0]!;
+    BatchedCircuitSimulator._validateTopology(instances);
+
+    // 1. 节点映射 (与引擎相同的编号顺序)
+    for (const device of template) {
+      for (const nodeId of device.nodes) {
+        const nodeName = nodeId.toString();
+        if (!this._nodeMapping.has(nodeName)) {
+          this._nodeMapping.set(nodeName, this._nodeMapping.size);
+        }
+      }
+    }
+    const ground = this._nodeMapping.get('0');
+    if (ground === undefined) {
+      throw new Error('Batched simulation requires a ground node ("0")');
+    }
+    this._ground = ground;
+
+    // 2. 额外变数 (电压源/电感支路电流)，所有实例的同名器件共用同一索引
+    this._extraVariableManager = new ExtraVariableIndexManager(this._nodeMapping.size);
+    for (let d = 0; d < template.length; d++) {
+      const device = template[d]!;
+      if (device.type !== 'V' && device.type !== 'L') continue;
+      const index = this._extraVariableManager.allocateIndex(
+        device.type === 'V' ? ExtraVariableType.VOLTAGE_SOURCE_CURRENT : ExtraVariableType.INDUCTOR_CURRENT,
+        device.name
+      );
+      for (const instance of instances) {
+        const target = instance[d]!;
+        if ('setCurrentIndex' in target) (target as any).setCurrentIndex(index);
+      }
+    }
+    this._size = this._extraVariableManager.getTotalMatrixSize();
+    this._reducedSize = this._size - 1;
+
+    // 3. 结构稀疏模式
+    const pattern = this._buildPattern(template);
+    this._colPointers = pattern.colPointers;
+    this._rowIndices = pattern.rowIndices;
+    const nnz = this._rowIndices.length;
+    this._values = new Float64Array(nnz * this._count);
+    this._rhs = new Float64Array(this._reducedSize * this._count);
+
+    // 4. 内核分类
+    const resistors: number[] = [];
+    const capacitors: number[] = [];
+    const inductors: number[] = [];
+    const sources: number[] = [];
+    const diodes: number[] = [];
+    const mosfets: number[] = [];
+    template.forEach((device, d) => {
+      if (device instanceof Resistor) resistors.push(d);
+      else if (device instanceof Capacitor) capacitors.push(d);
+      else if (device instanceof Inductor) inductors.push(d);
+      else if (device instanceof VoltageSource) sources.push(d);
+      else if (device instanceof IntelligentDiode) diodes.push(d);
+      else if (device instanceof IntelligentMOSFET) mosfets.push(d);
+      else throw new Error(`Batched simulation does not support device ${device.name} (type ${device.type})`);
+    });
+    BatchedCircuitSimulator._rejectUnsupportedParameters(instances, diodes, UNSUPPORTED_DIODE_PARAMETERS);
+    BatchedCircuitSimulator._rejectUnsupportedParameters(instances, mosfets, UNSUPPORTED_MOSFET_PARAMETERS);
+
+    this._resistors = this._createTwoTerminalKernel(instances, resistors, device => (device as Resistor).conductance);
+    this._capacitors = this._createTwoTerminalKernel(instances, capacitors, device => (device as Capacitor).capacitance);
+    this._inductors = this._createBranchKernel(instances, inductors, device => (device as Inductor).inductance);
+    this._sources = this._createBranchKernel(instances, sources, () => 0);
+    for (const d of sources) {
+      this._sourceDevices.push(instances.map(instance => instance[d] as VoltageSource));
+    }
+    this._diodes = this._createDiodeKernel(instances, diodes);
+    this._mosfets = this._createMOSFETKernel(instances, mosfets);
+    this._limited = new Uint8Array(this._count);
+  }
+
+  /** 实例数量 */
+  get instanceCount(): number {
+    return this._count;
+  }
+
+  /** 完整 MNA 维度 */
+  get size(): number {
+    return this._size;
+  }
+
+  /** 线性 (R/C/L/V) 与非线性 (二极管/MOSFET) 内核覆盖的器件数，以及共享主元序列的重选次数 */
+  get kernelStatistics(): { linear: number; nonlinear: number; pivotRefreshes: number } {
+    return {
+      linear: this._resistors.a.length + this._capacitors.a.length + this._inductors.a.length + this._sources.a.length,
+      nonlinear: this._diodes.a.length + this._mosfets.drain.length,
+      pivotRefreshes: this._pivotRefreshes
+    };
+  }
+
+  /**
+   * 🆕 按名称获取节点 ID
+   */
+  getNodeIdByName(name: string): number | undefined {
+    return this._nodeMapping.get(name);
+  }
+
+  /**
+   * 📍 从批量解中提取某实例的某个未知量
+   */
+  getValue(solution: Float64Array, index: number, instance: number): number {
+    return solution[index * this._count + instance]!;
+  }
+
+  /**
+   * ⚙️ 批量 DC 工作点分析
+   *
+   * 与引擎相同的策略：给定初值时先直接锁步 Newton (热启动)，
+   * 其余实例以 Gmin Stepping 求解。
+   *
+   * @param initialGuess - 可选初值：单个完整解 (广播到所有实例) 或批量解
+   */
+  solveOperatingPoint(initialGuess?: IVector | Float64Array): BatchedOperatingPoint {
+    const N = this._count;
+    const x = new Float64Array(this._reducedSize * N);
+    const converged = new Uint8Array(N);
+    let iterations = 0;
+
+    if (initialGuess) {
+      this._loadInitialGuess(x, initialGuess);
+      iterations += this._newton(x, new Uint8Array(N).fill(1), converged, 0, 0, 0, null);
+    }
+
+    // Gmin Stepping：仅对未收敛的实例
+    const active = new Uint8Array(N);
+    for (let s = 0; s < N; s++) {
+      active[s] = converged[s] ? 0 : 1;
+      if (active[s]) {
+        for (let i = 0; i < this._reducedSize; i++) x[i * N + s] = 1e-6;
+      }
+    }
+    if (active.some(a => a === 1)) {
+      const stepConverged = new Uint8Array(N);
+      const gminSteps = 10;
+      for (let step = 0; step <= gminSteps + 1; step++) {
+        const gmin = step > gminSteps ? 0 : 1e-2 * Math.pow(1e-12 / 1e-2, step / gminSteps);
+        stepConverged.fill(0);
+        iterations += this._newton(x, active, stepConverged, 0, 0, gmin, null);
+        for (let s = 0; s < N; s++) {
+          if (active[s] && !stepConverged[s]) active[s] = 0; // 该实例失败，退出后续梯级
+        }
+      }
+      for (let s = 0; s < N; s++) {
+        if (active[s]) converged[s] = 1;
+      }
+    }
+
+    return { solution: this._expand(x), converged, iterations };
+  }
+
+  /**
+   * 🌊 批量瞬态分析 (固定步长 Backward Euler，锁步推进)
+   *
+   * @param endTime - 结束时间
+   * @param timeStep - 固定时间步长
+   * @param outputs - 记录的节点名 (默认全部非接地节点)
+   */
+  runTransient(endTime: number, timeStep: number, outputs?: readonly string[]): BatchedTransientResult {
+    if (!(timeStep > 0) || !(endTime > 0)) {
+      throw new Error(`Invalid transient settings: endTime=${endTime}, timeStep=${timeStep}`);
+    }
+    const N = this._count;
+    const op = this.solveOperatingPoint();
+    const x = this._reduce(op.solution);
+
+    // 零初始条件 (UIC)：与引擎一致，电容/电感节点电压与电感电流置零
+    this._applyZeroInitialConditions(x);
+
+    const nodes = (outputs ?? Array.from(this._nodeMapping.keys()).filter(name => name !== '0'))
+      .filter(name => this._nodeMapping.has(name));
+    const steps = Math.ceil(endTime / timeStep - 1e-9);
+    const timePoints: number[] = [0];
+    const nodeVoltages = new Map<string, Float64Array>();
+    for (const name of nodes) {
+      nodeVoltages.set(name, new Float64Array((steps + 1) * N));
+    }
+    this._recordOutputs(nodeVoltages, x, 0);
+
+    // DC 未收敛的实例不做瞬态推进
+    const converged = Uint8Array.from(op.converged);
+    const active = new Uint8Array(N);
+    const stepConverged = new Uint8Array(N);
+    let time = 0;
+    for (let step = 1; step <= steps; step++) {
+      const dt = Math.min(timeStep, endTime - time);
+      time = step === steps ? endTime : time + dt;
+      const previous = x.slice();
+      active.set(converged);
+      stepConverged.fill(0);
+      this._newton(x, active, stepConverged, time, dt, 0, previous);
+      for (let s = 0; s < N; s++) {
+        if (!stepConverged[s]) converged[s] = 0;
+      }
+      timePoints.push(time);
+      this._recordOutputs(nodeVoltages, x, step);
+    }
+
+    return { timePoints, nodeVoltages, converged };
+  }
+
+  // === 私有方法 ===
+
+  /**
+   * 锁步 Newton：active 实例同时迭代，收敛的实例冻结
+   *
+   * @returns 迭代次数
+   */
+  private _newton(
+    x: Float64Array,
+    active: Uint8Array,
+    converged: Uint8Array,
+    time: number,
+    dt: number,
+    gmin: number,
+    previous: Float64Array | null
+  ): number {
+    const N = this._count;
+    const n = this._reducedSize;
+    const live = active.slice();
+    let iteration = 0;
+
+    while (iteration < this._config.maxNewtonIterations && live.some(a => a === 1)) {
+      iteration++;
+      this._assemble(x, time, dt, gmin, previous);
+
+      // 残差 -F = b - A·x
+      const negF = this._rhs.slice();
+      this._multiplySubtract(x, negF);
+
+      const delta = this._solveBatch(negF, live);
+
+      // 更新与逐实例收敛判断
+      for (let s = 0; s < N; s++) {
+        if (!live[s]) continue;
+        let deltaNorm = 0;
+        let solutionNorm = 0;
+        let finite = true;
+        for (let i = 0; i < n; i++) {
+          const d = delta[i * N + s]!;
+          if (!isFinite(d)) {
+            finite = false;
+            break;
+          }
+          const v = x[i * N + s]! + d;
+          x[i * N + s] = v;
+          deltaNorm += d * d;
+          solutionNorm += v * v;
+        }
+        if (!finite) {
+          live[s] = 0;
+          continue;
+        }
+        if (Math.sqrt(deltaNorm) < this._config.voltageToleranceRel * Math.sqrt(solutionNorm) + this._config.voltageToleranceAbs &&
+            !this._limited[s]) {
+          converged[s] = 1;
+          live[s] = 0;
+        }
+      }
+    }
+    return iteration;
+  }
+
+  /**
+   * 批量装配: 各类器件的 SoA 内核
+   */
+  private _assemble(x: Float64Array, time: number, dt: number, gmin: number, previous: Float64Array | null): void {
+    const N = this._count;
+    const values = this._values;
+    const rhs = this._rhs;
+    values.fill(0);
+    rhs.fill(0);
+
+    // 电阻
+    this._stampConductances(this._resistors, 1);
+
+    // 电容: GMIN + (瞬态) C/dt 伴随电导与历史电流源
+    {
+      const k = this._capacitors;
+      const GMIN = 1e-12;
+      for (let d = 0; d < k.a.length; d++) {
+        this._addConstant(k.slotAA[d]!, GMIN);
+        this._addConstant(k.slotBB[d]!, GMIN);
+      }
+      if (dt > 0 && previous) {
+        this._stampConductances(k, 1 / dt);
+        for (let d = 0; d < k.a.length; d++) {
+          const a = k.a[d]!;
+          const b = k.b[d]!;
+          const vo = d * N;
+          for (let s = 0; s < N; s++) {
+            const vPrev = (a >= 0 ? previous[a * N + s]! : 0) - (b >= 0 ? previous[b * N + s]! : 0);
+            const ieq = k.values[vo + s]! / dt * vPrev;
+            if (a >= 0) rhs[a * N + s]! += ieq;
+            if (b >= 0) rhs[b * N + s]! -= ieq;
+          }
+        }
+      }
+    }
+
+    // 电感: 关联矩阵 + 支路阻抗 (DC 为 1nΩ 短路)
+    {
+      const k = this._inductors;
+      this._stampIncidence(k);
+      for (let d = 0; d < k.a.length; d++) {
+        const kk = k.slotKK[d]! * N;
+        const branch = k.branch[d]! * N;
+        const vo = d * N;
+        if (dt > 0 && previous) {
+          for (let s = 0; s < N; s++) {
+            const req = k.values[vo + s]! / dt;
+            values[kk + s]! -= req;
+            rhs[branch + s]! -= req * previous[branch + s]!;
+          }
+        } else {
+          for (let s = 0; s < N; s++) values[kk + s]! -= 1e-9;
+        }
+      }
+    }
+
+    // 电压源: 关联矩阵 + 激励值
+    {
+      const k = this._sources;
+      this._stampIncidence(k);
+      for (let d = 0; d < k.a.length; d++) {
+        const branch = k.branch[d]! * N;
+        const devices = this._sourceDevices[d]!;
+        for (let s = 0; s < N; s++) {
+          rhs[branch + s]! += devices[s]!.getValue(time);
+        }
+      }
+    }
+
+    this._limited.fill(0);
+    this._stampDiodes(x, gmin);
+    this._stampMOSFETs(x, gmin);
+  }
+
+  /**
+   * 二极管: 结电压限幅 + 分段伴随模型 (与 IntelligentDiode.assemble 共用 device_equations)
+   */
+  private _stampDiodes(x: Float64Array, gmin: number): void {
+    const N = this._count;
+    const values = this._values;
+    const rhs = this._rhs;
+    const k = this._diodes;
+    const evaluation = this._diodeEvaluation;
+    for (let d = 0; d < k.a.length; d++) {
+      const a = k.a[d]!;
+      const b = k.b[d]!;
+      const aa = k.slotAA[d]! * N;
+      const ab = k.slotAB[d]! * N;
+      const ba = k.slotBA[d]! * N;
+      const bb = k.slotBB[d]! * N;
+      const vo = d * N;
+      for (let s = 0; s < N; s++) {
+        const Is = k.values[vo + s]!;
+        const n = k.ideality[vo + s]!;
+        const rawVd = (a >= 0 ? x[a * N + s]! : 0) - (b >= 0 ? x[b * N + s]! : 0);
+
+        // 超过临界电压时相对上次结电压做对数限幅
+        const Vd = limitDiodeVoltage(rawVd, k.junctionVoltage[vo + s]!, Is, n);
+        if (Math.abs(Vd - rawVd) > LIMITING_VOLTAGE_TOL) this._limited[s] = 1;
+        k.junctionVoltage[vo + s] = Vd;
+
+        const { current, conductance } = evaluateDiode(Vd, Is, n, evaluation);
+        const g = conductance + gmin;
+        const error = current - conductance * Vd;
+        if (aa >= 0) values[aa + s]! += g;
+        if (bb >= 0) values[bb + s]! += g;
+        if (ab >= 0) values[ab + s]! -= g;
+        if (ba >= 0) values[ba + s]! -= g;
+        if (a >= 0) rhs[a * N + s]! -= error;
+        if (b >= 0) rhs[b * N + s]! += error;
+      }
+    }
+  }
+
+  /**
+   * MOSFET: Level 1 截止/亚阈值/线性/饱和分区模型 (与 IntelligentMOSFET.assemble 共用 device_equations)
+   */
+  private _stampMOSFETs(x: Float64Array, gmin: number): void {
+    const N = this._count;
+    const values = this._values;
+    const rhs = this._rhs;
+    const k = this._mosfets;
+    const evaluation = this._mosfetEvaluation;
+    const voltage = (index: number, s: number) => (index >= 0 ? x[index * N + s]! : 0);
+    for (let m = 0; m < k.drain.length; m++) {
+      const drain = k.drain[m]!;
+      const gate = k.gate[m]!;
+      const source = k.source[m]!;
+      const dg = k.slotDG[m]! * N;
+      const dd = k.slotDD[m]! * N;
+      const ds = k.slotDS[m]! * N;
+      const sg = k.slotSG[m]! * N;
+      const sd = k.slotSD[m]! * N;
+      const ss = k.slotSS[m]! * N;
+      const vo = m * N;
+      for (let s = 0; s < N; s++) {
+        const Vgs = voltage(gate, s) - voltage(source, s);
+        const Vds = voltage(drain, s) - voltage(source, s);
+        const { Id, gm, gds } = evaluateMOSFET(
+          Vgs, Vds, k.Vth[vo + s]!, k.Kp[vo + s]!, k.lambda[vo + s]!, k.Roff[vo + s]!, evaluation
+        );
+
+        const totalGds = gds + gmin;
+        const Ieq = Id - (gm * Vgs + gds * Vds);
+        if (dg >= 0) values[dg + s]! += gm;
+        if (dd >= 0) values[dd + s]! += totalGds;
+        if (ds >= 0) values[ds + s]! -= gm + totalGds;
+        if (sg >= 0) values[sg + s]! -= gm;
+        if (sd >= 0) values[sd + s]! -= totalGds;
+        if (ss >= 0) values[ss + s]! += gm + totalGds;
+        if (drain >= 0) rhs[drain * N + s]! -= Ieq;
+        if (source >= 0) rhs[source * N + s]! += Ieq;
+      }
+    }
+  }
+
+  private _stampConductances(k: TwoTerminalKernel, scale: number): void {
+    const N = this._count;
+    const values = this._values;
+    for (let d = 0; d < k.a.length; d++) {
+      const vo = d * N;
+      const aa = k.slotAA[d]!;
+      const bb = k.slotBB[d]!;
+      const ab = k.slotAB[d]!;
+      const ba = k.slotBA[d]!;
+      if (aa >= 0) for (let s = 0; s < N; s++) values[aa * N + s]! += scale * k.values[vo + s]!;
+      if (bb >= 0) for (let s = 0; s < N; s++) values[bb * N + s]! += scale * k.values[vo + s]!;
+      if (ab >= 0) for (let s = 0; s < N; s++) values[ab * N + s]! -= scale * k.values[vo + s]!;
+      if (ba >= 0) for (let s = 0; s < N; s++) values[ba * N + s]! -= scale * k.values[vo + s]!;
+    }
+  }
+
+  private _stampIncidence(k: BranchKernel): void {
+    for (let d = 0; d < k.a.length; d++) {
+      this._addConstant(k.slotAK[d]!, 1);
+      this._addConstant(k.slotKA[d]!, 1);
+      this._addConstant(k.slotBK[d]!, -1);
+      this._addConstant(k.slotKB[d]!, -1);
+    }
+  }
+
+  private _addConstant(slot: number, value: number): void {
+    if (slot < 0) return;
+    const N = this._count;
+    const offset = slot * N;
+    for (let s = 0; s < N; s++) this._values[offset + s]! += value;
+  }
+
+  /**
+   * rhs -= A·x (批量 CSC 矩阵向量乘)
+   */
+  private _multiplySubtract(x: Float64Array, rhs: Float64Array): void {
+    const N = this._count;
+    for (let col = 0; col < this._reducedSize; col++) {
+      const xo = col * N;
+      for (let p = this._colPointers[col]!; p < this._colPointers[col + 1]!; p++) {
+        const ro = this._rowIndices[p]! * N;
+        const vo = p * N;
+        for (let s = 0; s < N; s++) {
+          rhs[ro + s]! -= this._values[vo + s]! * x[xo + s]!;
+        }
+      }
+    }
+  }
+
+  /**
+   * 批量求解: 共享主元序列的批量重分解；主元失效的实例单独分解
+   */
+  private _solveBatch(b: Float64Array, live: Uint8Array): Float64Array {
+    const N = this._count;
+    const n = this._reducedSize;
+
+    if (!this._symbolic) {
+      this._symbolic = SparseLU.analyze(this._instanceCSC(0));
+    }
+    if (!this._pivotFactor) {
+      this._pivotFactor = this._factorFirstSolvable(live);
+    }
+
+    let result = new Float64Array(n * N);
+    const status = new Uint8Array(N);
+    if (this._pivotFactor) {
+      result = this._refactorAndSolve(b, status);
+
+      // 多数活跃实例主元失效 (例如二极管整体换向)：以失效实例重新选主元后再批量分解一次
+      let failed = 0;
+      let liveCount = 0;
+      for (let s = 0; s < N; s++) {
+        if (!live[s]) continue;
+        liveCount++;
+        if (!status[s]) failed++;
+      }
+      if (failed > 0 && 2 * failed >= liveCount) {
+        const refreshed = this._factorFirstSolvable(live.map((a, s) => (a && !status[s] ? 1 : 0)));
+        if (refreshed) {
+          this._pivotFactor = refreshed;
+          this._pivotRefreshes++;
+          result = this._refactorAndSolve(b, status);
+        }
+      }
+    }
+
+    // 其余主元失效的实例单独分解
+    for (let s = 0; s < N; s++) {
+      if (status[s] || !live[s]) continue;
+      try {
+        const numeric = SparseLU.factor(this._symbolic, this._instanceCSC(s));
+        const rhs = new Float64Array(n);
+        for (let i = 0; i < n; i++) rhs[i] = b[i * N + s]!;
+        const x = SparseLU.solve(numeric, rhs);
+        for (let i = 0; i < n; i++) result[i * N + s] = x[i]!;
+      } catch {
+        for (let i = 0; i < n; i++) result[i * N + s] = NaN;
+      }
+    }
+    return result;
+  }
+
+  /** 以当前共享主元序列批量重分解并求解 (status 输出逐实例成败) */
+  private _refactorAndSolve(b: Float64Array, status: Uint8Array): Float64Array {
+    const N = this._count;
+    const pivotFactor = this._pivotFactor!;
+    const Lx = new Float64Array(pivotFactor.Lx.length * N);
+    const Ux = new Float64Array(pivotFactor.Ux.length * N);
+    SparseLU.refactorBatch(pivotFactor, this._values, N, Lx, Ux, status);
+    return SparseLU.solveBatch(pivotFactor, Lx, Ux, N, b);
+  }
+
+  private _factorFirstSolvable(live: Uint8Array): NumericFactorization | null {
+    for (let s = 0; s < this._count; s++) {
+      if (!live[s]) continue;
+      try {
+        return SparseLU.factor(this._symbolic!, this._instanceCSC(s));
+      } catch {
+        // 该实例奇异，尝试下一个
+      }
+    }
+    return null;
+  }
+
+  private _instanceCSC(instance: number): CSCMatrix {
+    const N = this._count;
+    const nnz = this._rowIndices.length;
+    const values = new Array<number>(nnz);
+    for (let p = 0; p < nnz; p++) values[p] = this._values[p * N + instance]!;
+    return {
+      rows: this._reducedSize,
+      cols: this._reducedSize,
+      nnz,
+      colPointers: Array.from(this._colPointers),
+      rowIndices: Array.from(this._rowIndices),
+      values
+    };
+  }
+
+  /**
+   * 结构稀疏模式: 每个器件的全部节点与支路索引两两相连，外加全部对角元
+   */
+  private _buildPattern(template: readonly ComponentInterface[]): { colPointers: Int32Array; rowIndices: Int32Array } {
+    const n = this._reducedSize;
+    const columns: Set<number>[] = [];
+    for (let j = 0; j < n; j++) columns.push(new Set([j]));
+
+    for (const device of template) {
+      const indices: number[] = [];
+      for (const nodeId of device.nodes) {
+        const r = this._reducedIndex(this._nodeMapping.get(nodeId.toString())!);
+        if (r >= 0) indices.push(r);
+      }
+      for (const type of [ExtraVariableType.VOLTAGE_SOURCE_CURRENT, ExtraVariableType.INDUCTOR_CURRENT]) {
+        const index = this._extraVariableManager.getIndex(device.name, type);
+        if (index !== undefined) indices.push(this._reducedIndex(index));
+      }
+      for (const r of indices) {
+        for (const c of indices) columns[c]!.add(r);
+      }
+    }
+
+    const colPointers = new Int32Array(n + 1);
+    const rows: number[] = [];
+    for (let j = 0; j < n; j++) {
+      const sorted = Array.from(columns[j]!).sort((a, b) => a - b);
+      for (const r of sorted) {
+        this._slotLookup.set(r * n + j, rows.length);
+        rows.push(r);
+      }
+      colPointers[j + 1] = rows.length;
+    }
+    return { colPointers, rowIndices: Int32Array.from(rows) };
+  }
+
+  private _createTwoTerminalKernel(
+    instances: readonly (readonly ComponentInterface[])[],
+    devices: readonly number[],
+    parameter: (device: ComponentInterface) => number
+  ): TwoTerminalKernel {
+    const N = this._count;
+    const count = devices.length;
+    const kernel: TwoTerminalKernel = {
+      a: new Int32Array(count),
+      b: new Int32Array(count),
+      slotAA: new Int32Array(count),
+      slotAB: new Int32Array(count),
+      slotBA: new Int32Array(count),
+      slotBB: new Int32Array(count),
+      values: new Float64Array(count * N)
+    };
+    devices.forEach((d, k) => {
+      const template = instances[0]![d]!;
+      const a = this._reducedIndex(this._nodeMapping.get(template.nodes[0]!.toString())!);
+      const b = this._reducedIndex(this._nodeMapping.get(template.nodes[1]!.toString())!);
+      kernel.a[k] = a;
+      kernel.b[k] = b;
+      kernel.slotAA[k] = this._slot(a, a);
+      kernel.slotAB[k] = this._slot(a, b);
+      kernel.slotBA[k] = this._slot(b, a);
+      kernel.slotBB[k] = this._slot(b, b);
+      for (let s = 0; s < N; s++) kernel.values[k * N + s] = parameter(instances[s]![d]!);
+    });
+    return kernel;
+  }
+
+  private _createBranchKernel(
+    instances: readonly (readonly ComponentInterface[])[],
+    devices: readonly number[],
+    parameter: (device: ComponentInterface) => number
+  ): BranchKernel {
+    const N = this._count;
+    const count = devices.length;
+    const kernel: BranchKernel = {
+      a: new Int32Array(count),
+      b: new Int32Array(count),
+      branch: new Int32Array(count),
+      slotAK: new Int32Array(count),
+      slotBK: new Int32Array(count),
+      slotKA: new Int32Array(count),
+      slotKB: new Int32Array(count),
+      slotKK: new Int32Array(count),
+      values: new Float64Array(count * N)
+    };
+    devices.forEach((d, k) => {
+      const template = instances[0]![d]!;
+      const type = template.type === 'V' ? ExtraVariableType.VOLTAGE_SOURCE_CURRENT : ExtraVariableType.INDUCTOR_CURRENT;
+      const a = this._reducedIndex(this._nodeMapping.get(template.nodes[0]!.toString())!);
+      const b = this._reducedIndex(this._nodeMapping.get(template.nodes[1]!.toString())!);
+      const branch = this._reducedIndex(this._extraVariableManager.getIndex(template.name, type)!);
+      kernel.a[k] = a;
+      kernel.b[k] = b;
+      kernel.branch[k] = branch;
+      kernel.slotAK[k] = this._slot(a, branch);
+      kernel.slotBK[k] = this._slot(b, branch);
+      kernel.slotKA[k] = this._slot(branch, a);
+      kernel.slotKB[k] = this._slot(branch, b);
+      kernel.slotKK[k] = this._slot(branch, branch);
+      for (let s = 0; s < N; s++) kernel.values[k * N + s] = parameter(instances[s]![d]!);
+    });
+    return kernel;
+  }
+
+  private _createDiodeKernel(
+    instances: readonly (readonly ComponentInterface[])[],
+    devices: readonly number[]
+  ): DiodeKernel {
+    const N = this._count;
+    const base = this._createTwoTerminalKernel(instances, devices, device => (device as IntelligentDiode).parameters['Is']!);
+    const ideality = new Float64Array(devices.length * N);
+    devices.forEach((d, k) => {
+      for (let s = 0; s < N; s++) ideality[k * N + s] = (instances[s]![d] as IntelligentDiode).parameters['n']!;
+    });
+    return { ...base, ideality, junctionVoltage: new Float64Array(devices.length * N) };
+  }
+
+  private _createMOSFETKernel(
+    instances: readonly (readonly ComponentInterface[])[],
+    devices: readonly number[]
+  ): MOSFETKernel {
+    const N = this._count;
+    const count = devices.length;
+    const kernel: MOSFETKernel = {
+      drain: new Int32Array(count),
+      gate: new Int32Array(count),
+      source: new Int32Array(count),
+      slotDG: new Int32Array(count),
+      slotDD: new Int32Array(count),
+      slotDS: new Int32Array(count),
+      slotSG: new Int32Array(count),
+      slotSD: new Int32Array(count),
+      slotSS: new Int32Array(count),
+      Vth: new Float64Array(count * N),
+      Kp: new Float64Array(count * N),
+      lambda: new Float64Array(count * N),
+      Roff: new Float64Array(count * N)
+    };
+    devices.forEach((d, k) => {
+      const template = instances[0]![d]!;
+      const [drain, gate, source] = template.nodes.map(node => this._reducedIndex(this._nodeMapping.get(node.toString())!)) as [number, number, number];
+      kernel.drain[k] = drain;
+      kernel.gate[k] = gate;
+      kernel.source[k] = source;
+      kernel.slotDG[k] = this._slot(drain, gate);
+      kernel.slotDD[k] = this._slot(drain, drain);
+      kernel.slotDS[k] = this._slot(drain, source);
+      kernel.slotSG[k] = this._slot(source, gate);
+      kernel.slotSD[k] = this._slot(source, drain);
+      kernel.slotSS[k] = this._slot(source, source);
+      for (let s = 0; s < N; s++) {
+        const parameters = (instances[s]![d] as IntelligentMOSFET).parameters;
+        kernel.Vth[k * N + s] = parameters['Vth']!;
+        kernel.Kp[k * N + s] = parameters['Kp']!;
+        kernel.lambda[k * N + s] = parameters['lambda']!;
+        kernel.Roff[k * N + s] = parameters['Roff']!;
+      }
+    });
+    return kernel;
+  }
+
+  private _slot(row: number, col: number): number {
+    if (row < 0 || col < 0) return -1;
+    return this._slotLookup.get(row * this._reducedSize + col) ?? -1;
+  }
+
+  private _reducedIndex(index: number): number {
+    if (index === this._ground) return -1;
+    return index < this._ground ? index : index - 1;
+  }
+
+  /** 约化批量解 -> 完整批量解 (接地为 0) */
+  private _expand(x: Float64Array): Float64Array {
+    const N = this._count;
+    const full = new Float64Array(this._size * N);
+    for (let i = 0; i < this._size; i++) {
+      const r = this._reducedIndex(i);
+      if (r >= 0) full.set(x.subarray(r * N, (r + 1) * N), i * N);
+    }
+    return full;
+  }
+
+  /** 完整批量解 -> 约化批量解 */
+  private _reduce(full: Float64Array): Float64Array {
+    const N = this._count;
+    const x = new Float64Array(this._reducedSize * N);
+    for (let i = 0; i < this._size; i++) {
+      const r = this._reducedIndex(i);
+      if (r >= 0) x.set(full.subarray(i * N, (i + 1) * N), r * N);
+    }
+    return x;
+  }
+
+  private _loadInitialGuess(x: Float64Array, guess: IVector | Float64Array): void {
+    const N = this._count;
+    if (guess instanceof Float64Array) {
+      if (guess.length !== this._size * N) {
+        throw new Error(`Batched initial guess has length ${guess.length}, expected ${this._size * N}`);
+      }
+      x.set(this._reduce(guess));
+      return;
+    }
+    if (guess.size !== this._size) {
+      throw new Error(`Initial guess has size ${guess.size}, expected ${this._size}`);
+    }
+    for (let i = 0; i < this._size; i++) {
+      const r = this._reducedIndex(i);
+      if (r >= 0) x.fill(guess.get(i), r * N, (r + 1) * N);
+    }
+  }
+
+  private _applyZeroInitialConditions(x: Float64Array): void {
+    const N = this._count;
+    const zero = (r: number) => {
+      if (r >= 0) x.fill(0, r * N, (r + 1) * N);
+    };
+    for (const k of [this._capacitors, this._inductors]) {
+      for (let d = 0; d < k.a.length; d++) {
+        zero(k.a[d]!);
+        zero(k.b[d]!);
+      }
+    }
+    for (let d = 0; d < this._inductors.branch.length; d++) {
+      zero(this._inductors.branch[d]!);
+    }
+  }
+
+  private _recordOutputs(outputs: Map<string, Float64Array>, x: Float64Array, step: number): void {
+    const N = this._count;
+    for (const [name, series] of outputs) {
+      const r = this._reducedIndex(this._nodeMapping.get(name)!);
+      if (r < 0) continue;
+      series.set(x.subarray(r * N, (r + 1) * N), step * N);
+    }
+  }
+
+  /**
+   * 内核未建模的参数必须取其中性值 (任一实例违反即拒绝)
+   */
+  private static _rejectUnsupportedParameters(
+    instances: readonly (readonly ComponentInterface[])[],
+    devices: readonly number[],
+    unsupported: Readonly<Record<string, number>>
+  ): void {
+    for (const d of devices) {
+      for (const instance of instances) {
+        const device = instance[d] as IntelligentDiode | IntelligentMOSFET;
+        for (const [name, neutral] of Object.entries(unsupported)) {
+          const value = device.parameters[name];
+          if (value !== undefined && value !== neutral) {
+            throw new Error(`Batched simulation does not support ${device.name} parameter ${name}=${value} (requires ${neutral})`);
+          }
+        }
+      }
+    }
+  }
+
+  /**
+   * 所有实例的器件序列必须逐一对应 (名称、类型、节点)
+   */
+  private static _validateTopology(instances: readonly (readonly ComponentInterface[])[]): void {
+    const template = instances[0]!;
+    for (let s = 1; s < instances.length; s++) {
+      const instance = instances[s]!;
+      if (instance.length !== template.length) {
+        throw new Error(`Instance ${s} has ${instance.length} devices, expected ${template.length}`);
+      }
+      for (let d = 0; d < template.length; d++) {
+        const a = template[d]!;
+        const b = instance[d]!;
+        const sameNodes = a.nodes.length === b.nodes.length &&
+          a.nodes.every((node, i) => node.toString() === b.nodes[i]!.toString());
+        if (a.name !== b.name || a.type !== b.type || a.constructor !== b.constructor || !sameNodes) {
+          throw new Error(`Instance ${s} device ${b.name} does not match template device ${a.name}`);
+        }
+      }
+    }
+  }
+}
@@ -31,16 +31,40 @@ import type {
   ISparseMatrix,
   IVector,
   IEvent,
-  IMNASystem
+  IMNASystem,
+  IntegratorResult
 } from '../../types/index';
 import { Vector } from '../../math/sparse/vector';
-import { SparseMatrix } from '../../math/sparse/matrix';
+import { SparseMatrix, createSolverStatistics, accumulateSolverStatistics } from '../../math/sparse/matrix';
+import type { SolverStatistics, SolverPhaseListener, SolverMode } from '../../math/sparse/matrix';
+import type { SymbolicFactorization } from '../../math/sparse/sparse_lu';
+import type { DCOperatingPointCache } from './dc_operating_point_cache';
+import { WaveformStore } from './waveform_store';
+import { MeasurementSet } from './measurement';
+import type { MeasureDefinition } from '../parser/spice_netlist_parser';
+import type { WaveformChunkSink, WaveformCompressionOptions } from './waveform_store';
+import type { WaveformEnvelopeOptions } from './waveform_envelope';
+import { StreamBuffer } from './simulation_stream';
+import type { SimulationStreamChunk, SimulationStreamOptions } from './simulation_stream';
+import { SimulationCheckpoint } from './simulation_checkpoint';
+import { PerformanceProfiler, createPerformanceMetrics } from './performance_profiler';
+import { SimulationEventLog, SimulationEventType } from './simulation_event_log';
+import type { SimulationEvent } from './simulation_event_log';
+import { Logger, LogLevel, getLogger } from '../logging/logger';
+import { SimulationTracer } from './simulation_tracer';
+import type { SimulationTracerOptions } from './simulation_tracer';
+import type { SolverRecorder } from '../../math/sparse/solver_recording';
+import { AdjointRecorder } from './adjoint_sensitivity';
+import type { SensitivityOutput, SignalForm } from './adjoint_sensitivity';
 import { GeneralizedAlphaIntegrator } from '../integrator/generalized_alpha';
+import type { GeneralizedAlphaSnapshot } from '../integrator/generalized_alpha';
 import { ExtraVariableIndexManager, ExtraVariableType } from '../mna/extra_variable_manager';
 // CHANGED: 导入统一的接口和新的类型守卫
 import { ComponentInterface, AssemblyContext } from '../interfaces/component';
+import type { SourceScaleState } from '../interfaces/component';
 import type { 
-  DeviceState 
+  DeviceState,
+  DeviceStateSnapshot
 } from '../devices/intelligent_device_model';
 import { isIntelligentDeviceModel } from '../devices/intelligent_device_model';
 import { EventDetector } from '../events/detector';
@@ -55,9 +79,19 @@ export enum SimulationState {
   PAUSED = 'paused',               // 暂停
   CONVERGED = 'converged',         // 收敛完成
   FAILED = 'failed',               // 仿真失败
-  COMPLETED = 'completed'          // 完成
+  COMPLETED = 'completed',         // 完成 (含 stopSimulation() 提前停止)
+  ABORTED = 'aborted'              // stream() 被 AbortSignal 取消
 }
 
+/**
+ * DC 工作点同伦策略
+ * - gmin:   Gmin Stepping
+ * - source: 源步进
+ * - newton: 标准 Newton-Raphson
+ * - ptc:    伪瞬态连续 (pseudo-transient continuation)
+ */
+export type DCStrategy = 'auto' | 'gmin' | 'source' | 'newton' | 'ptc';
+
 /**
  * 仿真配置参数
  */
@@ -87,11 +121,25 @@ export interface SimulationConfig {
   readonly enablePredictiveAnalysis: boolean; // 预测性分析
   readonly enableParallelization: boolean;   // 并行化
   readonly maxMemoryUsage: number;           // 最大内存使用 (MB)
+  readonly waveformChunkBytes: number;       // 波形存储每块字节数
+  readonly retainWaveformChunks: boolean;    // 封存的波形块是否留在内存 (false: 交给 sink 后释放)
+  readonly waveformCompression: WaveformCompressionOptions | null; // 保留块的误差有界压缩 (null: 不压缩)
+  readonly waveformEnvelope: WaveformEnvelopeOptions | null; // 绘图用 min/max 包络金字塔 (null: 不维护)
+  readonly probes: readonly string[];        // 记录的信号 (.SAVE/.PROBE：V(node)、I(device)、ALL)，空表示全部
+  readonly outputTimeStep: number;           // 输出时间网格步长 (.TRAN tstep)，0 表示每个接受步都记录
+  readonly outputTimes: readonly Time[];     // 显式输出时间点 (递增，优先于 outputTimeStep)
+  readonly measurements: readonly MeasureDefinition[]; // .MEAS 在线测量 (只需测量时可关闭 saveIntermediateResults)
+  readonly solverMode: SolverMode;           // 线性求解器 (auto: 按规模与结构自动选择)
+  readonly mixedPrecision: boolean;          // 稀疏 LU 因子以 Float32 存储，迭代精化恢复双精度
+  readonly dcStrategy: DCStrategy;           // DC 同伦策略 (auto: Gmin → 源步进 → PTC → Newton)
+  readonly adjointSensitivity: boolean;      // 记录伴随灵敏度所需的解轨迹与雅可比 (computeSensitivities)
   
   // 调试选项
-  readonly verboseLogging: boolean;          // 详细日志
+  readonly verboseLogging: boolean;          // 详细日志 (引擎与积分器日志提升到 DEBUG 级)
+  readonly eventLogCapacity: number;         // 事件日志环形缓冲容量 (条)
   readonly saveIntermediateResults: boolean; // 保存中间结果
   readonly enablePerformanceMonitoring: boolean; // 性能监控
+  readonly trace: SimulationTracerOptions | null; // 执行轨迹 (Chrome Trace 导出，null: 不记录)
 }
 
 /**
@@ -106,6 +154,7 @@ export interface SimulationResult {
   readonly peakMemoryUsage: number;
   readonly waveformData: WaveformData;
   readonly performanceMetrics: PerformanceMetrics;
+  readonly measurements?: ReadonlyMap<string, number | null>; // .MEAS 结果 (条件未满足为 null)
   readonly errorMessage?: string;
 }
 
@@ -124,25 +173,51 @@ export interface WaveformData {
  */
 export interface PerformanceMetrics {
   totalSimulationTime: number;    // 总仿真时间 (ms)
-  matrixAssemblyTime: number;     // 矩阵装配时间 (ms)
-  matrixSolutionTime: number;     // 矩阵求解时间 (ms)
+  matrixAssemblyTime: number;     // 矩阵装配时间 (ms，不含设备评估)
+  matrixFactorizationTime: number; // 矩阵数值分解时间 (ms，稠密 LU 含回代)
+  matrixSolutionTime: number;     // 矩阵三角求解时间 (ms)
   deviceEvaluationTime: number;   // 设备评估时间 (ms)
-  convergenceCheckTime: number;   // 收敛检查时间 (ms)
-  memoryPeakUsage: number;        // 内存峰值使用 (MB)
-  averageIterationsPerStep: number; // 平均每步迭代次数
-  failedSteps: number;            // 失败步数
+  convergenceCheckTime: number;   // 收敛检查时间 (ms，残差/LTE 判定等积分器内其余耗时)
+  eventDetectionTime: number;     // 事件检测与定位时间 (ms)
+  waveformSaveTime: number;       // 波形保存时间 (ms)
+  memoryPeakUsage: number;        // 波形存储峰值 (MB)
+  heapPeakUsage: number;          // JS 堆峰值 (MB，采样)
+  averageIterationsPerStep: number; // 瞬态平均每接受步 Newton 迭代次数
+  failedSteps: number;            // 被拒绝的步数 (Newton 不收敛或 LTE 超限)
   adaptiveStepChanges: number;    // 自适应步长变化次数
+  newtonIterations: number;       // Newton 迭代总数 (DC + 瞬态)
+  matrixFactorizations: number;   // 矩阵完整数值分解次数
+  matrixRefactorizations: number; // 沿用主元顺序的数值重分解次数
 }
 
+export { SimulationEventType } from './simulation_event_log';
+export type { SimulationEvent } from './simulation_event_log';
+
 /**
- * 仿真事件
+ * DC 扫描配置 (对应 `.DC source start stop step`)
  */
-export interface SimulationEvent {
-  readonly time: Time;
-  readonly type: string;
-  readonly deviceId?: string | undefined;  // 明确允许undefined
-  readonly description: string;
-  readonly data?: any;
+export interface DCSweepConfig {
+  readonly source: string;         // 扫描的电压源名称 (不区分大小写)
+  readonly start: number;          // 起始值
+  readonly stop: number;           // 终止值
+  readonly step: number;           // 步长 (符号须与 stop - start 一致)
+  readonly predictor?: 'tangent' | 'secant' | 'none'; // 初值预测器 (默认 tangent)
+  readonly maxStepHalvings?: number; // 失败时的最大步长减半次数 (默认 4)
+}
+
+/**
+ * DC 扫描结果
+ */
+export interface DCSweepResult {
+  readonly success: boolean;
+  readonly source: string;
+  readonly sweepValues: readonly number[];
+  readonly solutions: readonly IVector[];              // 每个扫描点的完整解 (含额外变数)
+  readonly nodeVoltages: Map<string, readonly number[]>; // 节点名 -> 电压序列
+  readonly newtonIterations: readonly number[];        // 每个扫描点消耗的 Newton 迭代次数
+  readonly homotopyPoints: readonly number[];          // 回退到同伦方法的扫描点索引
+  readonly totalTime: number; // ms
+  readonly errorMessage?: string;
 }
 
 interface ScalableSource {
@@ -150,6 +225,45 @@ interface ScalableSource {
   restoreSource(): void;
 }
 
+/**
+ * 检查点内容 (Float64Array 字段以二进制存储)
+ */
+interface EngineCheckpoint {
+  readonly nodes: readonly [string, number][];
+  readonly systemSize: number;
+  readonly time: Time;
+  readonly timeStep: number;
+  readonly stepCount: number;
+  readonly solution: Float64Array;
+  readonly previousSolution: Float64Array;
+  readonly lastAcceptedTime: Time;
+  readonly lastAcceptedSolution: Float64Array | null;
+  readonly nextOutputIndex: number;
+  readonly integrator: GeneralizedAlphaSnapshot;
+  readonly devices: Record<string, DeviceStateSnapshot>;
+  readonly sources: Record<string, SourceScaleState>;
+  readonly waveform: { readonly rowCount: number; readonly sealedChunkCount: number } | null;
+}
+
+interface SweepableSource {
+  readonly dcValue: number;
+  setDcValue(value: number): void;
+}
+
+/** DC 扫描的已收敛点 (slope = dx/dV，供下一点预测初值) */
+interface SweepPoint {
+  readonly value: number;
+  readonly solution: Vector;
+  readonly slope: Vector | null;
+}
+
+/** 自适应同伦的种类及其步进/失败事件 */
+type ContinuationLabel = 'gmin' | 'source';
+const CONTINUATION_EVENTS: Record<ContinuationLabel, readonly [SimulationEventType, SimulationEventType]> = {
+  gmin: [SimulationEventType.GMIN_STEP, SimulationEventType.GMIN_STEP_FAILED],
+  source: [SimulationEventType.SOURCE_STEP, SimulationEventType.SOURCE_STEP_FAILED]
+};
+
 /**
  * 🚀 电路仿真引擎核心类
  * 
@@ -157,6 +271,17 @@ interface ScalableSource {
  * 提供工业级的大规模电路仿真能力
  */
 export class CircuitSimulationEngine implements IMNASystem { // <--- 實現介面
+  // 自适应同伦：Newton 迭代不超过此次数视为"容易"，步长加倍
+  private static readonly HOMOTOPY_EASY_ITERATIONS = 4;
+  // 自适应同伦：最小步长 (λ ∈ [0, 1])
+  private static readonly HOMOTOPY_MIN_STEP = 1e-3;
+  // 伪瞬态连续：初始伪电导 C/h、低于此值即以纯 Newton 确认、超过此值 (伪步长过小) 宣告失败
+  private static readonly PTC_INITIAL_CONDUCTANCE = 1e-2;
+  private static readonly PTC_FINAL_CONDUCTANCE = 1e-12;
+  private static readonly PTC_MAX_CONDUCTANCE = 1e4;
+  // 伪瞬态连续：最大伪时间步数
+  private static readonly PTC_MAX_STEPS = 200;
+
   // 核心组件
   // @ts-ignore - 将在瞬态分析实现中使用
   private readonly _integrator: GeneralizedAlphaIntegrator;
@@ -181,13 +306,60 @@ export class CircuitSimulationEngine implements IMNASystem { // <--- 實現介
   private _solutionVector: IVector;
   private _previousSolutionVector: IVector;  // 🔧 保存上一个时间步的解
 
+  // 🔁 批量仿真复用 (蒙特卡罗/角点分析)
+  private _symbolicFactorization: SymbolicFactorization | null = null; // 同拓扑共享的符号分解
+  private _initialGuess: IVector | null = null;   // DC 热启动初值
+  private _operatingPoint: IVector | null = null; // 最近一次 DC 工作点
+  private _newtonIterationCount: number = 0;      // DC Newton 累计迭代次数
+  private _operatingPointCache: DCOperatingPointCache | null = null; // 持久化 DC 工作点缓存
+  private _operatingPointCacheKey: string | null = null;             // 网表内容哈希
+  private _operatingPointFromCache: boolean = false;                 // 本次工作点由缓存一步验证得到
+  private _warmStartFailed: boolean = false;                         // 本次热启动未收敛，回退到同伦方法
+  private _stopRequested: boolean = false;        // 外部请求停止 (中断 DC 迭代)
+
+  // 伪瞬态连续：每个节点到参考解的伪电导 C/h
+  private _ptcConductance: number = 0;
+  private _ptcReference: IVector | null = null;
+
   // 性能监控
   private _performanceMetrics: PerformanceMetrics;
+  private _profiler: PerformanceProfiler;
+  private _dcSolverStatistics: SolverStatistics = createSolverStatistics(); // DC 子矩阵的分解/求解统计
+  private _transientNewtonIterations: number = 0;
+  private _tracer: SimulationTracer | null = null;  // 执行轨迹 (config.trace 开启时每次运行新建)
+  private _solverRecorder: SolverRecorder | null = null; // 线性求解序列录制
+  private _adjointRecorder: AdjointRecorder | null = null; // 伴随灵敏度轨迹 (config.adjointSensitivity 开启时每次运行新建)
+  private _dcJacobian: { matrix: SparseMatrix; mapping: number[] } | null = null; // 最近一次 DC Newton 分解的去地子矩阵
+  private _reducedSystem: { matrix: SparseMatrix; mapping: number[] } | null = null; // 去地子矩阵 (原地更新，跨迭代保留求解器缓存)
   private _startTime: number = 0;
-  private _events: SimulationEvent[] = [];
+  private _events: SimulationEventLog;
+  private readonly _log: Logger;
   
-  // 波形数据存储
+  // 波形数据存储 (分块列式存储 + 按需物化的 WaveformData 视图)
   private _waveformData: WaveformData;
+  private _waveformStore: WaveformStore | null = null;
+  private _waveformSink: WaveformChunkSink | null = null;
+  private _waveformRow: Float64Array = new Float64Array(0);       // 行缓冲：选中的解向量分量 + 器件电流
+  private _waveformUnknowns: Int32Array = new Int32Array(0);      // 行缓冲前段对应的解向量索引
+  private _waveformStateCodes: Int32Array = new Int32Array(0);    // 器件状态编码
+  private _resistorCurrentProbes: { column: number; n1: number; n2: number; resistance: number }[] = [];
+
+  // 输出网格：在接受步之间用积分器的稠密输出插值
+  private _nextOutputIndex: number = 0;
+  private _lastAcceptedTime: Time = 0;
+  private _lastAcceptedSolution: IVector | null = null;
+
+  // 在线 .MEAS 测量
+  private _measurementSet: MeasurementSet<IVector> | null = null;
+  private _nextMeasureBreakpoint: number = 0;
+
+  // 流式输出 (stream() 运行期间)
+  private _streamOptions: SimulationStreamOptions | null = null;
+  private _streamBuffer: StreamBuffer | null = null;
+  private _resumeWaiters: (() => void)[] = [];
+
+  // 待恢复的检查点 (下一次 runSimulation()/stream() 初始化时应用)
+  private _pendingCheckpoint: EngineCheckpoint | null = null;
   
   // 内存管理
   private _memoryUsage: number = 0;
@@ -214,12 +386,29 @@ export class CircuitSimulationEngine implements IMNASystem { // <--- 實現介
       enablePredictiveAnalysis: true,   // 启用预测分析
       enableParallelization: false,     // 暂不启用并行化
       maxMemoryUsage: 1024,             // 1GB 内存限制
+      waveformChunkBytes: 1 << 20,      // 每块 1 MiB
+      retainWaveformChunks: true,       // 保留全部波形块
+      waveformCompression: null,        // 不压缩
+      waveformEnvelope: null,           // 不维护包络
+      probes: [],                       // 记录全部节点电压与器件电流
+      outputTimeStep: 0,                // 在内部接受步上记录
+      outputTimes: [],                  // 无显式输出网格
+      measurements: [],                 // 无在线测量
+      solverMode: 'numeric',            // 稠密求解 (klu: 稀疏 LU，可共享符号分解；auto: 按规模自动选择)
+      mixedPrecision: false,            // 双精度因子
+      dcStrategy: 'auto',               // 依次尝试全部 DC 同伦策略
+      adjointSensitivity: false,        // 不记录伴随轨迹
       verboseLogging: false,            // 简洁日志
+      eventLogCapacity: 4096,           // 保留最近 4096 条事件
       saveIntermediateResults: true,    // 保存中间结果
       enablePerformanceMonitoring: true, // 启用性能监控
+      trace: null,                      // 不记录执行轨迹
       ...config
     };
     
+    this._events = new SimulationEventLog(this._config.eventLogCapacity);
+    this._log = this._config.verboseLogging ? new Logger('engine', LogLevel.DEBUG) : getLogger('engine');
+    
     this._eventDetector = new EventDetector({
       minTimestep: this._config.minTimeStep,
     });
@@ -242,18 +431,9 @@ export class CircuitSimulationEngine implements IMNASystem { // <--- 實現介
     this._solutionVector = new Vector(estimatedSize);
     this._previousSolutionVector = new Vector(estimatedSize);  // 🔧 初始化历史解向量
     
-    // 初始化性能指标
-    this._performanceMetrics = {
-      totalSimulationTime: 0,
-      matrixAssemblyTime: 0,
-      matrixSolutionTime: 0,
-      deviceEvaluationTime: 0,
-      convergenceCheckTime: 0,
-      memoryPeakUsage: 0,
-      averageIterationsPerStep: 0,
-      failedSteps: 0,
-      adaptiveStepChanges: 0
-    };
+    // 初始化性能指标 (每次建立系统时重置)
+    this._performanceMetrics = createPerformanceMetrics();
+    this._profiler = new PerformanceProfiler(this._performanceMetrics, this._config.enablePerformanceMonitoring);
     
     // 初始化波形数据
     this._waveformData = {
@@ -286,7 +466,7 @@ export class CircuitSimulationEngine implements IMNASystem { // <--- 實現介
       }
     });
     
-    this._logEvent('DEVICE_ADDED', device.name, `Added ${device.type} device`);
+    this._logEvent(SimulationEventType.DEVICE_ADDED, device.name, `Added ${device.type} device`);
   }
 
   /**
@@ -305,64 +485,133 @@ export class CircuitSimulationEngine implements IMNASystem { // <--- 實現介
     return this._nodeMapping.get(name);
   }
 
+  /**
+   * 🔥 设置 DC 热启动初值
+   * 
+   * 设置后 DC 分析先从该初值直接执行 Newton，失败时才回退到
+   * Gmin → 源步进 → 伪瞬态连续 → Newton 的完整流程。长度与系统大小不符时忽略。
+   */
+  setInitialGuess(guess: IVector | readonly number[] | null): void {
+    this._initialGuess = guess === null ? null
+      : Array.isArray(guess) ? Vector.from([...guess]) : (guess as IVector).clone();
+  }
+
+  /**
+   * 📍 获取最近一次 DC 分析得到的工作点 (含额外变数)
+   */
+  getOperatingPoint(): IVector | null {
+    return this._operatingPoint ? this._operatingPoint.clone() : null;
+  }
+
+  /**
+   * 💾 设置 DC 工作点缓存
+   * 
+   * 命中时以缓存的解与器件工作模式为初值，一次 Newton 迭代验证通过即采用；
+   * DC 分析收敛后 (非缓存命中) 写回缓存。
+   * 
+   * @param key 网表内容哈希 (DCOperatingPointCache.hashNetlist)
+   */
+  setOperatingPointCache(cache: DCOperatingPointCache | null, key: string | null = null): void {
+    this._operatingPointCache = cache;
+    this._operatingPointCacheKey = cache ? key : null;
+  }
+
+  /**
+   * 💾 最近一次 DC 工作点是否来自缓存
+   */
+  isOperatingPointFromCache(): boolean {
+    return this._operatingPointFromCache;
+  }
+
+  /**
+   * 🔥 最近一次 DC 分析的热启动是否失败并回退到同伦方法 (不依赖事件日志容量)
+   */
+  isWarmStartFailed(): boolean {
+    return this._warmStartFailed;
+  }
+
+  /**
+   * 🗄️ 设置波形块封存回调 (如磁盘写入器)，须在仿真开始前调用
+   */
+  setWaveformSink(sink: WaveformChunkSink | null): void {
+    this._waveformSink = sink;
+  }
+
+  /**
+   * 🗄️ 获取底层波形存储 (仿真开始后可用)
+   */
+  getWaveformStore(): WaveformStore | null {
+    return this._waveformStore;
+  }
+
+  /**
+   * 🔗 设置共享的符号分解 (solverMode = 'klu'，或 'auto' 选中稀疏 LU 时生效)
+   * 
+   * 同一拓扑的多次仿真可共享列排序与稀疏模式分析，
+   * 模式不一致时求解器会自动重新分析。
+   */
+  setSymbolicFactorization(symbolic: SymbolicFactorization | null): void {
+    this._symbolicFactorization = symbolic;
+  }
+
+  /**
+   * 🔗 获取当前使用的符号分解
+   */
+  getSymbolicFactorization(): SymbolicFactorization | null {
+    return this._symbolicFactorization;
+  }
+
+  /**
+   * 🎞️ 设置线性求解录制器 (DC 与瞬态 Newton 的每次线性求解记录一帧)，null 关闭
+   */
+  setSolverRecorder(recorder: SolverRecorder | null): void {
+    this._solverRecorder = recorder;
+    this._integrator.setSolverRecorder(recorder);
+  }
+
+  /**
+   * 🧵 获取本次运行的执行轨迹 (config.trace 为 null 时返回 null)
+   */
+  getTracer(): SimulationTracer | null {
+    return this._tracer;
+  }
+
   /**
    * ⚙️ 初始化仿真系统 (重构版本)
    * 
    * 整合了额外变数管理器，现在支持电感、电压源和变压器
    */
   private async _initializeSimulation(): Promise<void> {
-    this._logEvent('INFO', undefined, '� Initializing simulation system...');
+    this._logEvent(SimulationEventType.INFO, undefined, '� Initializing simulation system...');
     
     try {
       // Note: Don't set state here, let runSimulation() manage it
       // this._state = SimulationState.INITIALIZING;
       // const initStartTime = performance.now();
       
-      this._validateCircuit();
-  
-      // 1. 預掃描以確定系統總大小
-      const baseNodeCount = this._nodeMapping.size;
-      let extraVarsCount = 0;
-      for (const device of this._devices.values()) {
-        if ('getExtraVariableCount' in device && typeof (device as any).getExtraVariableCount === 'function') {
-          extraVarsCount += (device as any).getExtraVariableCount();
-        }
-      }
-  
-      // 2. 初始化管理器
-      this._extraVariableManager = new ExtraVariableIndexManager(baseNodeCount);
-      const totalSystemSize = baseNodeCount + extraVarsCount;
-  
-      // 3. 創建正確大小的矩陣和向量
-      this._systemMatrix = new SparseMatrix(totalSystemSize, totalSystemSize);
-      this._rhsVector = new Vector(totalSystemSize);
-      this._solutionVector = new Vector(totalSystemSize);
-      this._previousSolutionVector = new Vector(totalSystemSize);  // 🔧 重新初始化历史解向量
-      
-      // 4. 第二次掃描，為元件分配索引
-      for (const device of this._devices.values()) {
-          if ('getExtraVariableCount' in device && typeof (device as any).getExtraVariableCount === 'function') {
-              if (device.type === 'V' || device.type === 'L') {
-                  const index = this._extraVariableManager.allocateIndex(
-                      device.type === 'V' ? ExtraVariableType.VOLTAGE_SOURCE_CURRENT : ExtraVariableType.INDUCTOR_CURRENT,
-                      device.name
-                  );
-                  if ('setCurrentIndex' in device) (device as any).setCurrentIndex(index);
-              } else if (device.type === 'K') {
-                  const pIdx = this._extraVariableManager.allocateIndex(ExtraVariableType.TRANSFORMER_PRIMARY_CURRENT, device.name);
-                  const sIdx = this._extraVariableManager.allocateIndex(ExtraVariableType.TRANSFORMER_SECONDARY_CURRENT, device.name);
-                  if ('setCurrentIndices' in device) (device as any).setCurrentIndices(pIdx, sIdx);
-              }
-          }
+      this._setupSystem();
+      this._adjointRecorder = this._config.adjointSensitivity ? new AdjointRecorder() : null;
+      this._dcJacobian = null;
+
+      // 从检查点恢复时跳过 DC 分析与 UIC 初始化
+      if (this._pendingCheckpoint) {
+        const checkpoint = this._pendingCheckpoint;
+        this._pendingCheckpoint = null;
+        this._applyCheckpoint(checkpoint);
+        return;
       }
-  
-            this._logEvent('INIT', undefined, `System size: ${totalSystemSize} (${baseNodeCount} nodes + ${extraVarsCount} extra vars).`);
-  
-      // 关键修复：在开始 DC 分析之前，确保解向量是一个干净的全零向量
-      this._solutionVector.fill(0);
 
       // 5. 計算 DC 工作點 (所有仿真類型都需要)
       await this._performDCAnalysis();
+      this._profiler.sampleHeap();
+      this._operatingPoint = this._solutionVector.clone();
+      if (!this._operatingPointFromCache) {
+        this._storeCachedOperatingPoint();
+      }
+      if (this._adjointRecorder && this._dcJacobian) {
+        // 去地子矩阵之后还会被扫描等求解覆盖：伴随分析保留一份副本
+        this._adjointRecorder.recordOperatingPoint(this._dcJacobian.matrix.clone(), this._dcJacobian.mapping, this._solutionVector);
+      }
       
       // 🔧 初始化历史解向量为 DC 工作点 (瞬态分析的初始条件)
       this._previousSolutionVector = this._solutionVector.clone();
@@ -378,6 +627,7 @@ export class CircuitSimulationEngine implements IMNASystem { // <--- 實現介
       // 🎯 瞬态分析：使用零初始条件 (UIC)
       // 对于电容和电感，将其节点电压重置为 0
       // 这模拟了 SPICE 的 .TRAN UIC 行为
+      const resetIndices: number[] = [];
       for (const device of this._devices.values()) {
         if (device.type === 'C' || device.type === 'L') {
           // 对于电容/电感，将其节点设为 0（保持电压源节点不变）
@@ -390,6 +640,7 @@ export class CircuitSimulationEngine implements IMNASystem { // <--- 實現介
                 // 只重置电路节点，不重置额外变量
                 this._solutionVector.set(nodeIndex, 0);
                 this._previousSolutionVector.set(nodeIndex, 0);
+                resetIndices.push(nodeIndex);
               }
             }
           }
@@ -400,20 +651,24 @@ export class CircuitSimulationEngine implements IMNASystem { // <--- 實現介
             if (currentIndex !== undefined && currentIndex >= 0 && currentIndex < this._solutionVector.size) {
               this._solutionVector.set(currentIndex, 0);
               this._previousSolutionVector.set(currentIndex, 0);
+              resetIndices.push(currentIndex);
             }
           }
         }
       }
       
-      this._logEvent('INIT', undefined, '⚡ Applied zero initial conditions (UIC) for capacitors and inductors.');
+      this._logEvent(SimulationEventType.INIT, undefined, '⚡ Applied zero initial conditions (UIC) for capacitors and inductors.');
+      this._adjointRecorder?.recordInitialState(this._config.startTime, this._solutionVector, resetIndices);
   
       // 6. 用零初始狀態來啟動積分器
+      const restartStart = this._tracer?.begin() ?? 0;
       await this._integrator.restart({
           time: this._config.startTime,
           solution: this._solutionVector as Vector,
           derivative: Vector.zeros(this._solutionVector.size) // 假設 t=0 時導數為 0
       });
-      console.log('🔄 Generalized-α integrator restarted with UIC.');
+      this._tracer?.end('integrator_restart', restartStart, this._config.startTime, 0);
+      this._log.info('🔄 Generalized-α integrator restarted with UIC.');
 
       // 6. 初始化波形数据存储
       this._initializeWaveformStorage();
@@ -422,71 +677,147 @@ export class CircuitSimulationEngine implements IMNASystem { // <--- 實現介
       this._currentTime = this._config.startTime;
       this._currentTimeStep = this._config.initialTimeStep;
       this._stepCount = 0;
+      this._nextOutputIndex = 0;
+      this._lastAcceptedTime = this._currentTime;
+      this._lastAcceptedSolution = this._solutionVector.clone();
+      this._initializeMeasurements();
         
     } catch (error) {
       this._state = SimulationState.FAILED;
       // 增加更详细的错误日志
-      console.error('Detailed error in _initializeSimulation:', error);
+      this._log.error('Detailed error in _initializeSimulation:', error);
       // Re-throw the error to be caught by the main runSimulation catch block
       throw new Error(`Simulation initialization failed: ${error}`);
     }
   }
 
+  /**
+   * 📸 应用检查点 (系统已建立)
+   */
+  private _applyCheckpoint(checkpoint: EngineCheckpoint): void {
+    const nodes = Array.from(this._nodeMapping);
+    const sameNodes = nodes.length === checkpoint.nodes.length
+      && nodes.every(([name, index], i) => checkpoint.nodes[i]![0] === name && checkpoint.nodes[i]![1] === index);
+    if (!sameNodes || checkpoint.systemSize !== this._solutionVector.size) {
+      throw new Error('Checkpoint does not match the circuit topology');
+    }
+
+    this._solutionVector = Vector.from(Array.from(checkpoint.solution));
+    this._previousSolutionVector = Vector.from(Array.from(checkpoint.previousSolution));
+    this._operatingPoint = this._solutionVector.clone();
+    for (const device of this._devices.values()) {
+      const snapshot = checkpoint.devices[device.name];
+      if (snapshot && 'restoreStateSnapshot' in device) {
+        (device as ComponentInterface & { restoreStateSnapshot(s: DeviceStateSnapshot): void }).restoreStateSnapshot(snapshot);
+      }
+      const source = checkpoint.sources[device.name];
+      if (source && 'restoreScaleState' in device) {
+        (device as ComponentInterface & { restoreScaleState(s: SourceScaleState): void }).restoreScaleState(source);
+      }
+    }
+    this._integrator.loadState(checkpoint.integrator);
+
+    this._initializeWaveformStorage();
+    if (checkpoint.waveform) {
+      this._waveformStore!.resumeAt(checkpoint.waveform.rowCount, checkpoint.waveform.sealedChunkCount);
+    }
+
+    this._currentTime = checkpoint.time;
+    this._currentTimeStep = checkpoint.timeStep;
+    this._stepCount = checkpoint.stepCount;
+    this._nextOutputIndex = checkpoint.nextOutputIndex;
+    this._lastAcceptedTime = checkpoint.lastAcceptedTime;
+    this._lastAcceptedSolution = checkpoint.lastAcceptedSolution
+      ? Vector.from(Array.from(checkpoint.lastAcceptedSolution))
+      : this._solutionVector.clone();
+    this._initializeMeasurements();
+    this._logEvent(SimulationEventType.CHECKPOINT_RESTORED, undefined, `Resumed from checkpoint at t=${this._currentTime}`);
+  }
+
+  /**
+   * 🧱 建立 MNA 系统 (验证电路、分配额外变数、创建矩阵与向量)
+   */
+  private _setupSystem(): void {
+    this._validateCircuit();
+
+    // 1. 預掃描以確定系統總大小
+    const baseNodeCount = this._nodeMapping.size;
+    let extraVarsCount = 0;
+    for (const device of this._devices.values()) {
+      if ('getExtraVariableCount' in device && typeof (device as any).getExtraVariableCount === 'function') {
+        extraVarsCount += (device as any).getExtraVariableCount();
+      }
+    }
+
+    // 2. 初始化管理器
+    this._extraVariableManager = new ExtraVariableIndexManager(baseNodeCount);
+    const totalSystemSize = baseNodeCount + extraVarsCount;
+
+    // 3. 創建正確大小的矩陣和向量
+    this._systemMatrix = new SparseMatrix(totalSystemSize, totalSystemSize);
+    (this._systemMatrix as SparseMatrix).setSolverMode(this._config.solverMode);
+    (this._systemMatrix as SparseMatrix).setMixedPrecision(this._config.mixedPrecision);
+    (this._systemMatrix as SparseMatrix).setTimingEnabled(this._config.enablePerformanceMonitoring);
+    this._rhsVector = new Vector(totalSystemSize);
+    this._solutionVector = new Vector(totalSystemSize);
+    this._previousSolutionVector = new Vector(totalSystemSize);  // 🔧 重新初始化历史解向量
+
+    // 性能指标按次运行重置
+    this._performanceMetrics = createPerformanceMetrics();
+    this._profiler = new PerformanceProfiler(this._performanceMetrics, this._config.enablePerformanceMonitoring);
+    this._dcSolverStatistics = createSolverStatistics();
+    this._reducedSystem = null;
+    this._transientNewtonIterations = 0;
+
+    // 执行轨迹按次运行新建
+    this._tracer = this._config.trace ? new SimulationTracer(this._config.trace) : null;
+    this._integrator.setTracer(this._tracer);
+    (this._systemMatrix as SparseMatrix).setPhaseListener(this._solverPhaseListener());
+    
+    // 4. 第二次掃描，為元件分配索引
+    for (const device of this._devices.values()) {
+        if ('getExtraVariableCount' in device && typeof (device as any).getExtraVariableCount === 'function') {
+            if (device.type === 'V' || device.type === 'L') {
+                const index = this._extraVariableManager.allocateIndex(
+                    device.type === 'V' ? ExtraVariableType.VOLTAGE_SOURCE_CURRENT : ExtraVariableType.INDUCTOR_CURRENT,
+                    device.name
+                );
+                if ('setCurrentIndex' in device) (device as any).setCurrentIndex(index);
+            } else if (device.type === 'K') {
+                const pIdx = this._extraVariableManager.allocateIndex(ExtraVariableType.TRANSFORMER_PRIMARY_CURRENT, device.name);
+                const sIdx = this._extraVariableManager.allocateIndex(ExtraVariableType.TRANSFORMER_SECONDARY_CURRENT, device.name);
+                if ('setCurrentIndices' in device) (device as any).setCurrentIndices(pIdx, sIdx);
+            }
+        }
+    }
+
+    this._logEvent(SimulationEventType.INIT, undefined, `System size: ${totalSystemSize} (${baseNodeCount} nodes + ${extraVarsCount} extra vars).`);
+
+    // 关键修复：在开始 DC 分析之前，确保解向量是一个干净的全零向量
+    this._solutionVector.fill(0);
+  }
+
   /**
    * 🚀 运行主要仿真循环
    */
   async runSimulation(): Promise<SimulationResult> {
     this._startTime = performance.now();
     this._state = SimulationState.RUNNING;
+    this._stopRequested = false;
     
     try {
       // 1. 初始化仿真
       await this._initializeSimulation();
       
-      this._logEvent('INFO', undefined, '✅ Simulation initialization complete.');
+      this._logEvent(SimulationEventType.INFO, undefined, '✅ Simulation initialization complete.');
 
       // 2. 主仿真循环
       while (this._currentTime < this._config.endTime && this._state === SimulationState.RUNNING) {
-        try {
-          const stepSuccess = await this._performTimeStep();
-        
-          if (!stepSuccess) {
-            // 步长减半重试
-            if (this._currentTimeStep > this._config.minTimeStep * 2) {
-              this._currentTimeStep *= 0.5;
-              this._performanceMetrics.adaptiveStepChanges++;
-              continue;
-            } else {
-              // 无法继续，仿真失败
-              this._state = SimulationState.FAILED;
-              this._logEvent('FATAL', undefined, 'Time step fell below minimum and could not recover.');
-              break;
-            }
-          }
-        } catch (stepError) {
-            console.error(`💥 Error within simulation loop at t=${this._currentTime}:`, stepError);
-            throw stepError; // Re-throw to be caught by the main catch block
-        }
-        
-        // 3. 保存波形数据
-        if (this._config.saveIntermediateResults) {
-          this._saveWaveformPoint();
-        }
-        
-        // 5. 内存使用检查
-        if (this._memoryUsage > this._config.maxMemoryUsage * 1024 * 1024) {
-          this._logEvent('MEMORY_WARNING', undefined, 'Memory usage exceeded limit');
-          break;
-        }
-        
-        this._stepCount++;
+        if (!(await this._advance())) break;
       }
       
       // Mark simulation as completed if we reached the end time normally
-      if (this._currentTime >= this._config.endTime && this._state === SimulationState.RUNNING) {
-        this._state = SimulationState.COMPLETED;
-        this._logEvent('INFO', undefined, '✅ Simulation completed successfully.');
-      }
+      this._markCompleted();
       
       // 3. 生成最终结果
       return this._generateFinalResult();
@@ -494,8 +825,9 @@ export class CircuitSimulationEngine implements IMNASystem { // <--- 實現介
     } catch (error) {
       this._state = SimulationState.FAILED;
       // 增加更详细的错误日志
-      console.error('🔥 Detailed error object in runSimulation:', error);
+      this._log.error('🔥 Detailed error object in runSimulation:', error);
       const errorMessage = error instanceof Error ? error.message : String(error);
+      this._finalizePerformanceMetrics();
       return {
         success: false,
         finalTime: this._currentTime,
@@ -510,13 +842,172 @@ export class CircuitSimulationEngine implements IMNASystem { // <--- 實現介
     }
   }
 
+  /**
+   * 📡 流式运行瞬态仿真
+   * 
+   * 以异步迭代器逐块交付已记录的样本 (遵循 probes 与输出网格)，迭代结束时返回 SimulationResult。
+   * 消费者取走上一块之前仿真不再推进；没有样本可交付时也至少每 maxLatency 毫秒让出一次事件循环，
+   * pauseSimulation() 与取消因此及时生效，resumeSimulation() 后继续。
+   * 提前 break 会停止仿真；signal 中止时停止仿真 (状态为 ABORTED) 并以 signal.reason 拒绝。
+   */
+  async *stream(options: SimulationStreamOptions = {}): AsyncGenerator<SimulationStreamChunk, SimulationResult, undefined> {
+    const signal = options.signal;
+    signal?.throwIfAborted();
+
+    this._startTime = performance.now();
+    this._state = SimulationState.RUNNING;
+    this._stopRequested = false;
+
+    try {
+      // 存储在初始化期间创建，缓冲区须在记录初始 DC 点之前就绪
+      this._streamOptions = options;
+      await this._initializeSimulation();
+      const buffer = this._streamBuffer!;
+
+      while (this._currentTime < this._config.endTime
+        && (this._state === SimulationState.RUNNING || this._state === SimulationState.PAUSED)) {
+        if (signal?.aborted) break;
+        if (this._state === SimulationState.PAUSED) {
+          await this._waitForResume(signal);
+          continue;
+        }
+        if (!(await this._advance())) break;
+
+        if (buffer.ready) {
+          await buffer.yieldToEventLoop();
+          yield buffer.take();
+        } else if (buffer.yieldDue) {
+          await buffer.yieldToEventLoop();
+        }
+      }
+
+      if (signal?.aborted) {
+        this.stopSimulation();
+        this._state = SimulationState.ABORTED;
+        signal.throwIfAborted();
+      }
+      this._markCompleted();
+      const result = this._generateFinalResult();
+      if (buffer.rowCount > 0) {
+        yield buffer.take();
+      }
+      return result;
+    } catch (error) {
+      this._state = signal?.aborted ? SimulationState.ABORTED : SimulationState.FAILED;
+      throw error;
+    } finally {
+      // 消费者提前退出 (break/return) 时停止仿真
+      if (this._state === SimulationState.RUNNING || this._state === SimulationState.PAUSED) {
+        this.stopSimulation();
+      }
+      this._streamOptions = null;
+      this._streamBuffer = null;
+    }
+  }
+
+  /**
+   * 📈 执行 DC 扫描分析 (`.DC source start stop step`)
+   * 
+   * 连续性方法：每个扫描点以上一点的解为初值，并沿切线 dx/dV 外推
+   * (J·dx/dV = e_k，复用上一点收敛时的雅可比矩阵)，光滑区域内
+   * 通常 1~2 次 Newton 迭代即收敛。预测失败时退回上一点的解，
+   * 再对步长减半，仍失败才回退到 Gmin / 源步进同伦方法。
+   */
+  async runDCSweep(config: DCSweepConfig): Promise<DCSweepResult> {
+    const startTime = performance.now();
+    const sourceName = config.source.toUpperCase();
+    const device = Array.from(this._devices.values()).find(d => d.name.toUpperCase() === sourceName);
+    if (!device || !('setDcValue' in device)) {
+      throw new Error(`DC sweep source not found: ${config.source}`);
+    }
+    const source = device as ComponentInterface & SweepableSource;
+
+    const span = config.stop - config.start;
+    if (config.step === 0 || !isFinite(config.step) || (span !== 0 && Math.sign(span) !== Math.sign(config.step))) {
+      throw new Error(`Invalid DC sweep step: ${config.step}`);
+    }
+    const pointCount = Math.floor(span / config.step + 1e-9) + 1;
+    const predictor = config.predictor ?? 'tangent';
+    const maxHalvings = config.maxStepHalvings ?? 4;
+    const originalValue = source.dcValue;
+
+    const sweepValues: number[] = [];
+    const solutions: IVector[] = [];
+    const newtonIterations: number[] = [];
+    const homotopyPoints: number[] = [];
+    let errorMessage: string | undefined;
+
+    this._state = SimulationState.RUNNING;
+    this._stopRequested = false;
+    try {
+      this._setupSystem();
+
+      let previous: SweepPoint | null = null;
+      for (let i = 0; i < pointCount; i++) {
+        const value = config.start + i * config.step;
+        const iterationsBefore = this._newtonIterationCount;
+        source.setDcValue(value);
+
+        let point: SweepPoint | null = null;
+        if (previous) {
+          point = await this._continueDCSweep(source, previous, value, predictor, maxHalvings);
+        } else {
+          // 第一个点：完整 DC 分析 (有初值时热启动)
+          await this._performDCAnalysis();
+          point = await this._makeSweepPoint(source, null, value, predictor);
+        }
+
+        if (!point) {
+          this._logEvent(SimulationEventType.DC_SWEEP_HOMOTOPY, source.name, `连续性失败，在 ${value} 处回退到同伦方法`);
+          homotopyPoints.push(i);
+          source.setDcValue(value);
+          if (!(await this._solveDCHomotopy())) {
+            throw new Error(`DC sweep failed to converge at ${source.name} = ${value}`);
+          }
+          point = await this._makeSweepPoint(source, null, value, predictor);
+        }
+
+        sweepValues.push(value);
+        solutions.push(point.solution.clone());
+        newtonIterations.push(this._newtonIterationCount - iterationsBefore);
+        previous = point;
+      }
+
+      this._state = SimulationState.COMPLETED;
+      this._logEvent(SimulationEventType.DC_SWEEP, source.name, `DC sweep completed: ${pointCount} points, ${this._newtonIterationCount} Newton iterations`);
+    } catch (error) {
+      this._state = SimulationState.FAILED;
+      errorMessage = error instanceof Error ? error.message : String(error);
+      this._logEvent(SimulationEventType.DC_SWEEP_FAILED, source.name, errorMessage);
+    } finally {
+      source.setDcValue(originalValue);
+    }
+
+    const nodeVoltages = new Map<string, readonly number[]>();
+    for (const [nodeName, nodeIndex] of this._nodeMapping) {
+      nodeVoltages.set(nodeName, solutions.map(solution => solution.get(nodeIndex)));
+    }
+
+    return {
+      success: errorMessage === undefined,
+      source: source.name,
+      sweepValues,
+      solutions,
+      nodeVoltages,
+      newtonIterations,
+      homotopyPoints,
+      totalTime: performance.now() - startTime,
+      ...(errorMessage !== undefined ? { errorMessage } : {})
+    };
+  }
+
   /**
    * ⏸️ 暂停仿真
    */
   pauseSimulation(): void {
     if (this._state === SimulationState.RUNNING) {
       this._state = SimulationState.PAUSED;
-      this._logEvent('SIMULATION_PAUSED', undefined, `Paused at t=${this._currentTime}`);
+      this._logEvent(SimulationEventType.SIMULATION_PAUSED, undefined, `Paused at t=${this._currentTime}`);
     }
   }
 
@@ -526,7 +1017,8 @@ export class CircuitSimulationEngine implements IMNASystem { // <--- 實現介
   resumeSimulation(): void {
     if (this._state === SimulationState.PAUSED) {
       this._state = SimulationState.RUNNING;
-      this._logEvent('SIMULATION_RESUMED', undefined, `Resumed at t=${this._currentTime}`);
+      this._logEvent(SimulationEventType.SIMULATION_RESUMED, undefined, `Resumed at t=${this._currentTime}`);
+      this._wakeResumeWaiters();
     }
   }
 
@@ -534,8 +1026,66 @@ export class CircuitSimulationEngine implements IMNASystem { // <--- 實現介
    * ⏹️ 停止仿真
    */
   stopSimulation(): void {
+    this._stopRequested = true;
     this._state = SimulationState.COMPLETED;
-    this._logEvent('SIMULATION_STOPPED', undefined, `Stopped at t=${this._currentTime}`);
+    this._logEvent(SimulationEventType.SIMULATION_STOPPED, undefined, `Stopped at t=${this._currentTime}`);
+    this._wakeResumeWaiters();
+  }
+
+  /**
+   * 📸 保存完整仿真状态为二进制检查点
+   * 
+   * 包含时间与步长、当前/上一步解向量、Generalized-α 积分器状态、器件工作状态、
+   * 激励源缩放因子与波形存储的行号/块号。可在 stream() 的块之间、暂停时或仿真结束后调用。
+   */
+  checkpoint(): Uint8Array {
+    if (this._state === SimulationState.IDLE || this._state === SimulationState.INITIALIZING) {
+      throw new Error('No simulation state to checkpoint');
+    }
+
+    const devices: Record<string, DeviceStateSnapshot> = {};
+    const sources: Record<string, SourceScaleState> = {};
+    for (const device of this._devices.values()) {
+      if ('getStateSnapshot' in device) {
+        devices[device.name] = (device as ComponentInterface & { getStateSnapshot(): DeviceStateSnapshot }).getStateSnapshot();
+      }
+      if ('getScaleState' in device) {
+        sources[device.name] = (device as ComponentInterface & { getScaleState(): SourceScaleState }).getScaleState();
+      }
+    }
+
+    const store = this._waveformStore;
+    const state: EngineCheckpoint = {
+      nodes: Array.from(this._nodeMapping),
+      systemSize: this._solutionVector.size,
+      time: this._currentTime,
+      timeStep: this._currentTimeStep,
+      stepCount: this._stepCount,
+      solution: Float64Array.from(this._solutionVector.toArray()),
+      previousSolution: Float64Array.from(this._previousSolutionVector.toArray()),
+      lastAcceptedTime: this._lastAcceptedTime,
+      lastAcceptedSolution: this._lastAcceptedSolution ? Float64Array.from(this._lastAcceptedSolution.toArray()) : null,
+      nextOutputIndex: this._nextOutputIndex,
+      integrator: this._integrator.saveState(),
+      devices,
+      sources,
+      waveform: store ? { rowCount: store.rowCount, sealedChunkCount: store.sealedChunkCount } : null
+    };
+    this._logEvent(SimulationEventType.CHECKPOINT_SAVED, undefined, `Checkpoint at t=${this._currentTime}`);
+    return SimulationCheckpoint.encode(state);
+  }
+
+  /**
+   * 📸 从检查点恢复，下一次 runSimulation()/stream() 从检查点时刻继续到 endTime
+   * 
+   * 引擎须已添加与保存时相同的器件 (节点映射与系统规模不符时初始化失败)。
+   * 其余配置可以不同，用于从稳态分叉 what-if 分支；.MEAS 测量从恢复时刻重新累积。
+   */
+  restore(checkpoint: Uint8Array): void {
+    if (this._state === SimulationState.RUNNING || this._state === SimulationState.PAUSED) {
+      throw new Error('Cannot restore while a simulation is running');
+    }
+    this._pendingCheckpoint = SimulationCheckpoint.decode<EngineCheckpoint>(checkpoint);
   }
 
   /**
@@ -582,6 +1132,8 @@ export class CircuitSimulationEngine implements IMNASystem { // <--- 實現介
       // 因此 _assembleSystem 也需要改成同步
       // 🎯 瞬態分析時使用 this._currentTimeStep，DC 分析時使用 0
       this._assembleSystem(time, 0, this._currentTimeStep); 
+      this._performanceMetrics.newtonIterations++;
+      this._transientNewtonIterations++;
   }
 
   // === 私有方法实现 ===
@@ -607,7 +1159,7 @@ export class CircuitSimulationEngine implements IMNASystem { // <--- 實現介
     });
     
     if (connectedNodes.size !== this._nodeMapping.size) {
-      console.warn('Warning: Some nodes may not be connected');
+      this._log.warn('Warning: Some nodes may not be connected');
     }
   }
 
@@ -616,118 +1168,352 @@ export class CircuitSimulationEngine implements IMNASystem { // <--- 實現介
    * 实现了源步进 (外部循环) 和带步长阻尼的 Newton-Raphson (内部循环)
    */
   private async _performDCAnalysis(): Promise<void> {
-    console.log('📊 開始 DC 工作點分析...');
+    this._log.info('📊 開始 DC 工作點分析...');
+    this._operatingPointFromCache = false;
+    this._warmStartFailed = false;
+
+    // 步骤 -1: 工作点缓存 (相同网表内容的上一次收敛解)
+    if (this._restoreCachedOperatingPoint()) {
+      if (await this._solveDCNewtonRaphson(0, 1)) {
+        this._operatingPointFromCache = true;
+        this._logEvent(SimulationEventType.DC_CONVERGED, undefined, '缓存工作点一步验证通过');
+        return;
+      }
+      // 一步未验证通过：缓存解仍是很好的初值，继续 Newton
+      if (await this._solveDCNewtonRaphson(0)) {
+        this._logEvent(SimulationEventType.DC_CONVERGED, undefined, '从缓存工作点出发 Newton 收敛');
+        return;
+      }
+      this._logEvent(SimulationEventType.DC_CACHE_REJECTED, undefined, '缓存工作点无效，回退到常规流程');
+    }
+
+    // 步骤 0: 热启动 (蒙特卡罗样本等从标称解出发，通常数次迭代即收敛)
+    if (this._initialGuess && this._initialGuess.size === this._solutionVector.size) {
+      for (let i = 0; i < this._solutionVector.size; i++) {
+        this._solutionVector.set(i, this._initialGuess.get(i));
+      }
+      if (await this._solveDCNewtonRaphson(0)) {
+        this._logEvent(SimulationEventType.DC_CONVERGED, undefined, '热启动 Newton 收敛');
+        return;
+      }
+      this._warmStartFailed = true;
+      this._logEvent(SimulationEventType.DC_WARM_START_FAILED, undefined, '热启动失败，回退到同伦方法');
+    }
+
+    if (await this._solveDCHomotopy()) {
+      return;
+    }
+    
+    // 最终失败
+    this._logEvent(SimulationEventType.DC_FAILED, undefined, '所有 DC 方法失敗');
+    throw new Error('DC 工作點分析失敗');
+  }
+
+  /**
+   * 🔄 同伦求解 DC 工作点
+   * 
+   * dcStrategy = 'auto' 时依次尝试 Gmin Stepping → 源步进 → 伪瞬态连续 → 标准 Newton，
+   * 否则只执行指定的单一策略 (供 DCStrategyRace 并行竞速使用)。
+   */
+  private async _solveDCHomotopy(): Promise<boolean> {
+    const strategy = this._config.dcStrategy;
+    if (strategy !== 'auto') {
+      this._solutionVector.fill(strategy === 'source' ? 0 : 1e-6);
+      const converged =
+        strategy === 'gmin' ? await this._gminSteppingHomotopy()
+        : strategy === 'source' ? await this._sourceSteppingHomotopy()
+        : strategy === 'ptc' ? await this._pseudoTransientHomotopy()
+        : await this._solveDCNewtonRaphson(0);
+      if (converged) {
+        this._logEvent(SimulationEventType.DC_CONVERGED, undefined, `${strategy} 策略收敛`);
+      }
+      return converged;
+    }
 
     // 关键修复：在整个 DC 分析开始时，提供一个初始的非零猜测。
     // 这可以避免在 v=0 时的数值奇点（例如，在半导体器件模型中）。
     this._solutionVector.fill(1e-6);
     
     // 步骤 1: Gmin Stepping (作为首选的鲁棒方法)
-    console.log('🔄 优先尝试 Gmin Stepping...');
+    this._log.info('🔄 优先尝试 Gmin Stepping...');
     let dcResult = await this._gminSteppingHomotopy();
     if (dcResult) {
-      this._logEvent('dc_converged', undefined, 'Gmin Stepping 收敛');
-      return;
+      this._logEvent(SimulationEventType.DC_CONVERGED, undefined, 'Gmin Stepping 收敛');
+      return true;
     }
 
     // 步骤 2: 源步进 (作为备用方法)
-    console.log('🔄 Gmin Stepping 失败，尝试源步进...');
+    this._log.info('🔄 Gmin Stepping 失败，尝试源步进...');
     // 在尝试源步进之前，重置解向量，因为 Gmin 可能已将其带入一个不好的区域
     this._solutionVector.fill(1e-6); 
     dcResult = await this._sourceSteppingHomotopy();
     if (dcResult) {
-      this._logEvent('dc_converged', undefined, '源步进收敛');
-      return;
+      this._logEvent(SimulationEventType.DC_CONVERGED, undefined, '源步进收敛');
+      return true;
+    }
+    
+    // 步骤 3: 伪瞬态连续
+    this._log.info('🔄 源步进失败，尝试伪瞬态连续...');
+    this._solutionVector.fill(1e-6);
+    dcResult = await this._pseudoTransientHomotopy();
+    if (dcResult) {
+      this._logEvent(SimulationEventType.DC_CONVERGED, undefined, '伪瞬态连续收敛');
+      return true;
     }
     
-    // 步骤 3: 标准 Newton-Raphson (最后的尝试)
-    console.log('🔄 源步进失败，最后尝试标准 Newton...');
+    // 步骤 4: 标准 Newton-Raphson (最后的尝试)
+    this._log.info('🔄 伪瞬态连续失败，最后尝试标准 Newton...');
     this._solutionVector.fill(1e-6); // 再次重置
     dcResult = await this._solveDCNewtonRaphson();
     if (dcResult) {
-      this._logEvent('dc_converged', undefined, '標準 Newton 收斂');
-      return;
+      this._logEvent(SimulationEventType.DC_CONVERGED, undefined, '標準 Newton 收斂');
+      return true;
     }
-    
-    // 最终失败
-    this._logEvent('dc_failed', undefined, '所有 DC 方法失敗');
-    throw new Error('DC 工作點分析失敗');
+    return false;
   }
 
-  private async _sourceSteppingHomotopy(): Promise<boolean> {
-    const sources = Array.from(this._devices.values()).filter(d => 'scaleSource' in d) as (ComponentInterface & ScalableSource)[];
-    const stepFactors = [0.0, 0.25, 0.5, 0.75, 1.0];
-    let converged = false;
-
-    for (const factor of stepFactors) {
-      this._logEvent('DC_SOURCE_STEP', undefined, `Setting source factor to ${(factor * 100).toFixed(0)}%`);      
-      // 🧠 智能初始猜测：当所有源为0时，最佳猜测就是0向量
-      if (factor === 0.0) {
-        this._solutionVector.fill(0);
+  /**
+   * 📈 DC 扫描的连续性步进：从已收敛点 from 推进到扫描值 to
+   * 
+   * 依次尝试：预测初值 → 上一点的解 → 步长减半递归；
+   * 全部失败返回 null，由调用方回退到同伦方法。
+   */
+  private async _continueDCSweep(
+    source: ComponentInterface & SweepableSource,
+    from: SweepPoint,
+    to: number,
+    predictor: NonNullable<DCSweepConfig['predictor']>,
+    halvings: number
+  ): Promise<SweepPoint | null> {
+    source.setDcValue(to);
+
+    // 1. 预测初值 x(to) ≈ x(from) + (to - from)·dx/dV
+    if (from.slope) {
+      this._solutionVector = from.solution.plus(from.slope.scale(to - from.value));
+      if (await this._solveDCNewtonRaphson(0)) {
+        return this._makeSweepPoint(source, from, to, predictor);
       }
+    }
 
-      for (const source of sources) {
-        source.scaleSource(factor);
+    // 2. 零阶预测：上一点的解
+    this._solutionVector = from.solution.clone();
+    if (await this._solveDCNewtonRaphson(0)) {
+      return this._makeSweepPoint(source, from, to, predictor);
+    }
+
+    // 3. 步长减半
+    if (halvings > 0) {
+      const middle = await this._continueDCSweep(source, from, (from.value + to) / 2, predictor, halvings - 1);
+      if (middle) {
+        return this._continueDCSweep(source, middle, to, predictor, halvings - 1);
+      }
+    }
+    return null;
+  }
+
+  /**
+   * 记录当前收敛解，并计算下一点预测所需的斜率 dx/dV
+   */
+  private async _makeSweepPoint(
+    source: ComponentInterface & SweepableSource,
+    from: SweepPoint | null,
+    value: number,
+    predictor: NonNullable<DCSweepConfig['predictor']>
+  ): Promise<SweepPoint> {
+    const solution = (this._solutionVector as Vector).clone();
+    let slope: Vector | null = null;
+
+    const branchIndex = this._extraVariableManager?.getIndex(source.name, ExtraVariableType.VOLTAGE_SOURCE_CURRENT);
+    if (predictor === 'tangent' && branchIndex !== undefined) {
+      // 电压源约束 V+ - V- = Vs 对 Vs 求导：J·dx/dV = e_k
+      const tangent = await this._solveLinearSystem(this._systemMatrix, Vector.basis(solution.size, branchIndex), false);
+      if (isFinite(tangent.norm())) {
+        slope = tangent as Vector;
       }
+    }
+    if (!slope && predictor !== 'none' && from && value !== from.value) {
+      slope = solution.minus(from.solution).scale(1 / (value - from.value));
+    }
+
+    return { value, solution, slope };
+  }
 
-      // 🧠 使用更鲁棒的阻尼策略进行源步进
-      converged = await this._solveDCNewtonRaphson(0);
+  /**
+   * 🔌 源步进：所有独立源从 0 自适应地放大到 100%
+   */
+  private async _sourceSteppingHomotopy(): Promise<boolean> {
+    const sources = Array.from(this._devices.values()).filter(d => 'scaleSource' in d) as (ComponentInterface & ScalableSource)[];
 
-      if (!converged) {
-        this._logEvent('DC_STEP_FAILED', undefined, `Newton-Raphson failed to converge at source factor ${factor}`);
+    // 🧠 智能初始猜测：当所有源为0时，最佳猜测就是0向量
+    this._solutionVector.fill(0);
+    try {
+      return await this._adaptiveContinuation('source', 0.25, async factor => {
         for (const source of sources) {
-          source.restoreSource();
+          source.scaleSource(factor);
         }
-        return false;
+        return this._solveDCNewtonRaphson(0);
+      });
+    } finally {
+      for (const source of sources) {
+        source.restoreSource();
       }
     }
+  }
+
+  /**
+   * 🕰️ 伪瞬态连续 (PTC)
+   * 
+   * 以后向 Euler 推进伪时间方程 C·dx/dτ = -F(x)：每个伪时间步在各节点挂一个
+   * 指向上一伪时间步解的伪电导 C/h，求解 F(x) + (C/h)·(x − x_prev) = 0。
+   * 伪步长按 SER (switched evolution relaxation) 随残差下降而放大：
+   * h_{k+1} = h_k·‖F_k‖/‖F_{k+1}‖，其中 ‖F_{k+1}‖ = (C/h_k)·‖x_{k+1} − x_k‖。
+   * Newton 失败时退回上一伪时间步 (解与器件线性化点) 并将 h 减半。
+   * 伪电导足够小或解不再随伪时间变化 (已达稳态) 后以纯 Newton 做最终确认。
+   */
+  private async _pseudoTransientHomotopy(): Promise<boolean> {
+    const finalConductance = CircuitSimulationEngine.PTC_FINAL_CONDUCTANCE;
+    const maxConductance = CircuitSimulationEngine.PTC_MAX_CONDUCTANCE;
+
+    let conductance = CircuitSimulationEngine.PTC_INITIAL_CONDUCTANCE;
+    let accepted = this._solutionVector.clone();
+    let acceptedStates = this._captureDeviceStates();
+    let previousResidual = Infinity;
+    let steady = false;
 
-    for (const source of sources) {
-      source.restoreSource();
+    try {
+      for (let step = 0; step < CircuitSimulationEngine.PTC_MAX_STEPS && !steady; step++) {
+        if (this._stopRequested) return false;
+
+        this._ptcConductance = conductance;
+        this._ptcReference = accepted;
+        if (await this._solveDCNewtonRaphson(0)) {
+          const change = this._solutionVector.minus(accepted).norm();
+          const residual = conductance * change;
+          accepted = this._solutionVector.clone();
+          acceptedStates = this._captureDeviceStates();
+          this._logEvent(SimulationEventType.PTC_STEP, undefined,
+            `C/h=${conductance.toExponential(2)}, ‖F‖=${residual.toExponential(2)}`, conductance);
+
+          steady = conductance <= finalConductance
+            || change < this._config.voltageToleranceRel * accepted.norm() + this._config.voltageToleranceAbs;
+          // SER：首步没有残差历史，伪步长固定放大 10 倍；之后按残差比调整 (每步至多放大 100 倍、缩小一半)
+          const ratio = previousResidual === Infinity ? 0.1 : residual / previousResidual;
+          conductance *= Math.min(Math.max(ratio, 1e-2), 2);
+          previousResidual = residual;
+        } else {
+          this._solutionVector = accepted.clone();
+          this._restoreDeviceStates(acceptedStates);
+          conductance *= 2;
+          this._logEvent(SimulationEventType.PTC_STEP_FAILED, undefined,
+            `Newton-Raphson failed, pseudo-conductance raised to ${conductance.toExponential(2)}`, conductance);
+          if (conductance > maxConductance) return false;
+        }
+      }
+    } finally {
+      this._ptcConductance = 0;
+      this._ptcReference = null;
     }
-    
-    return converged;
+    if (!steady) return false;
+
+    this._logEvent(SimulationEventType.PTC_STEP, undefined, 'Final convergence check without pseudo-capacitance');
+    return await this._solveDCNewtonRaphson(0);
   }
 
-  // 新方法: Gmin Stepping
+  /**
+   * 🧪 Gmin Stepping：Gmin 从 1e-2 按对数自适应地减小到 1e-12
+   */
   private async _gminSteppingHomotopy(): Promise<boolean> {
-    const gminSteps = 10;
     const initialGmin = 1e-2;
     const finalGmin = 1e-12;
-    
-    for (let step = 0; step <= gminSteps; step++) {
-      const factor = step / gminSteps;
-      // Use logarithmic stepping for gmin
-      const currentGmin = initialGmin * Math.pow(finalGmin / initialGmin, factor);
-      
-      this._logEvent('gmin_step', undefined, `Gmin=${currentGmin.toExponential(2)}, Step ${step}/${gminSteps}`);
 
-      // Pass the current Gmin value to the Newton-Raphson solver
-      const newtonResult = await this._solveDCNewtonRaphson(currentGmin);
-      
-      if (!newtonResult) {
-        this._logEvent('gmin_step_failed', undefined, `Newton-Raphson failed with Gmin = ${currentGmin.toExponential(2)}`);
-        return false;
-      }
-    }
+    const converged = await this._adaptiveContinuation('gmin', 0.1, lambda =>
+      this._solveDCNewtonRaphson(initialGmin * Math.pow(finalGmin / initialGmin, lambda))
+    );
+    if (!converged) return false;
     
     // Final check with zero Gmin
-    this._logEvent('gmin_step', undefined, 'Final convergence check with Gmin = 0');
+    this._logEvent(SimulationEventType.GMIN_STEP, undefined, 'Final convergence check with Gmin = 0');
     return await this._solveDCNewtonRaphson(0);
   }
 
+  /**
+   * 📐 自适应同伦连续：参数 λ 从 0 推进到 1
+   * 
+   * 每步 Newton 迭代次数不超过 HOMOTOPY_EASY_ITERATIONS 时步长加倍；
+   * 失败时回到上一个收敛点 (解与器件线性化点) 并将步长减半，而不是整体放弃。
+   * 步长小于 HOMOTOPY_MIN_STEP 才宣告失败。
+   * 
+   * @param solveAt 在给定 λ 处求解
+   */
+  private async _adaptiveContinuation(
+    label: ContinuationLabel,
+    initialStep: number,
+    solveAt: (lambda: number) => Promise<boolean>
+  ): Promise<boolean> {
+    const easyIterations = CircuitSimulationEngine.HOMOTOPY_EASY_ITERATIONS;
+    const minStep = CircuitSimulationEngine.HOMOTOPY_MIN_STEP;
+    const [stepEvent, failedEvent] = CONTINUATION_EVENTS[label];
+
+    // 起点 λ = 0 必须先收敛
+    if (!(await solveAt(0))) {
+      this._logEvent(failedEvent, undefined, 'Newton-Raphson failed at λ = 0');
+      return false;
+    }
+    let accepted = this._solutionVector.clone();
+    let acceptedStates = this._captureDeviceStates();
+
+    let lambda = 0;
+    let step = initialStep;
+    while (lambda < 1) {
+      if (this._stopRequested) return false;
+
+      const target = Math.min(1, lambda + step);
+      const iterationsBefore = this._newtonIterationCount;
+      if (await solveAt(target)) {
+        const iterations = this._newtonIterationCount - iterationsBefore;
+        lambda = target;
+        accepted = this._solutionVector.clone();
+        acceptedStates = this._captureDeviceStates();
+        this._logEvent(stepEvent, undefined, `step=${step.toExponential(2)}, ${iterations} iterations`, lambda);
+        if (iterations <= easyIterations) {
+          step = Math.min(2 * step, 1);
+        }
+      } else {
+        // 失败的尝试已改写器件的限幅线性化点，与解一并退回
+        this._solutionVector = accepted.clone();
+        this._restoreDeviceStates(acceptedStates);
+        step *= 0.5;
+        this._logEvent(failedEvent, undefined, `Newton-Raphson failed, step reduced to ${step.toExponential(2)}`, target);
+        if (step < minStep) {
+          return false;
+        }
+      }
+    }
+    return true;
+  }
+
   // 替換原有的 _solveDCNewtonRaphson 方法
-private async _solveDCNewtonRaphson(gmin: number = 0): Promise<boolean> {
+private async _solveDCNewtonRaphson(gmin: number = 0, maxIterations: number = this._config.maxNewtonIterations): Promise<boolean> {
     let iterations = 0;
     const x_k = this._solutionVector as Vector;
 
-    while (iterations < this._config.maxNewtonIterations) {
+    while (iterations < maxIterations) {
+        if (this._stopRequested) {
+            this._logEvent(SimulationEventType.DC_NR_ABORTED, undefined, 'Newton-Raphson aborted by stop request.');
+            return false;
+        }
+        this._newtonIterationCount++;
+        this._performanceMetrics.newtonIterations++;
+        const spanStart = this._tracer?.begin() ?? 0;
+
         // 1. 根據當前的解 x_k 組裝雅可比矩陣 J(x_k) 和非線性函數 F(x_k)
         // F(x_k) = J(x_k) * x_k - b(x_k)
         this._assembleSystem(0, gmin, 0); // 🎯 time=0, gmin, dt=0 for DC analysis
         const J = this._systemMatrix;
         const b = this._rhsVector;
+        const residualStart = this._profiler.begin();
         const F = (J.multiply(x_k) as Vector).minus(b);
+        this._profiler.end('convergenceCheckTime', residualStart);
 
         // 2. 求解線性系統 J(x_k) * Δx = -F(x_k)
         const F_neg = F.scale(-1);
@@ -735,7 +1521,7 @@ private async _solveDCNewtonRaphson(gmin: number = 0): Promise<boolean> {
 
         // 檢查求解器是否返回了無效值
         if (isNaN(delta_x.norm())) {
-            this._logEvent('DC_SOLVER_ERROR', undefined, `[Iter ${iterations}] Linear solver returned NaN.`);
+            this._logEvent(SimulationEventType.DC_SOLVER_ERROR, undefined, `[Iter ${iterations}] Linear solver returned NaN.`);
             return false;
         }
 
@@ -744,27 +1530,98 @@ private async _solveDCNewtonRaphson(gmin: number = 0): Promise<boolean> {
         (this._solutionVector as Vector).addInPlace(delta_x);
         
         // 4. 檢查收斂性
+        const checkStart = this._profiler.begin();
         const deltaNorm = delta_x.norm();
         const solutionNorm = this._solutionVector.norm();
+        const limited = this._isVoltageLimited();
+        this._profiler.end('convergenceCheckTime', checkStart);
+        this._tracer?.end('newton', spanStart, this._currentTime, 0, deltaNorm, iterations);
 
-        if (this._config.verboseLogging) {
-            console.log(`  [DC Iter ${iterations}] Update Norm (||Δx||) = ${deltaNorm.toExponential(4)}`);
+        if (this._log.debugEnabled) {
+            this._log.debug(`  [DC Iter ${iterations}] Update Norm (||Δx||) = ${deltaNorm.toExponential(4)}`);
         }
 
-        if (deltaNorm < (this._config.voltageToleranceRel * solutionNorm + this._config.voltageToleranceAbs)) {
-            this._logEvent('DC_NR_CONVERGED', undefined, `Newton-Raphson converged in ${iterations + 1} iterations.`);
+        if (deltaNorm < (this._config.voltageToleranceRel * solutionNorm + this._config.voltageToleranceAbs) &&
+            !limited) {
+            this._logEvent(SimulationEventType.DC_NR_CONVERGED, undefined, 'Newton-Raphson converged, value = iterations', iterations + 1);
             return true;
         }
         
         iterations++;
     }
 
-    this._logEvent('DC_NR_FAILED', undefined, `Newton-Raphson exceeded max iterations (${this._config.maxNewtonIterations}).`);
+    this._logEvent(SimulationEventType.DC_NR_FAILED, undefined, `Newton-Raphson exceeded max iterations (${maxIterations}).`);
     return false;
 }
 
 
 
+  /**
+   * 💾 从缓存恢复解向量与器件工作模式 (未命中或尺寸不符返回 false)
+   */
+  private _restoreCachedOperatingPoint(): boolean {
+    if (!this._operatingPointCache || !this._operatingPointCacheKey) return false;
+
+    const entry = this._operatingPointCache.load(this._operatingPointCacheKey);
+    if (!entry || entry.solution.length !== this._solutionVector.size) return false;
+
+    for (let i = 0; i < entry.solution.length; i++) {
+      this._solutionVector.set(i, entry.solution[i]!);
+    }
+    this._restoreDeviceStates(entry.deviceStates);
+    this._logEvent(SimulationEventType.DC_CACHE_HIT, undefined, `DC operating point cache hit (${this._operatingPointCacheKey.substring(0, 12)})`);
+    return true;
+  }
+
+  /**
+   * 💾 将当前 DC 解与器件工作模式写入缓存
+   */
+  private _storeCachedOperatingPoint(): void {
+    if (!this._operatingPointCache || !this._operatingPointCacheKey) return;
+
+    try {
+      this._operatingPointCache.store(this._operatingPointCacheKey, this._solutionVector.toArray(), this._captureDeviceStates());
+    } catch (error) {
+      // 缓存写入失败不影响仿真
+      this._logEvent(SimulationEventType.DC_CACHE_STORE_FAILED, undefined, `${error}`);
+    }
+  }
+
+  /**
+   * 💾 导出全部器件的工作状态快照 (工作模式与限幅线性化点)
+   */
+  private _captureDeviceStates(): Record<string, DeviceStateSnapshot> {
+    const states: Record<string, DeviceStateSnapshot> = {};
+    for (const device of this._devices.values()) {
+      if ('getStateSnapshot' in device) {
+        states[device.name] = (device as ComponentInterface & { getStateSnapshot(): DeviceStateSnapshot }).getStateSnapshot();
+      }
+    }
+    return states;
+  }
+
+  /**
+   * 💾 恢复器件工作状态快照 (快照中缺失的器件保持不变)
+   */
+  private _restoreDeviceStates(states: Readonly<Record<string, DeviceStateSnapshot>>): void {
+    for (const device of this._devices.values()) {
+      const snapshot = states[device.name];
+      if (snapshot && 'restoreStateSnapshot' in device) {
+        (device as ComponentInterface & { restoreStateSnapshot(s: DeviceStateSnapshot): void }).restoreStateSnapshot(snapshot);
+      }
+    }
+  }
+
+  /**
+   * 是否有器件在限幅电压处线性化 (此时更新量小不代表已收敛)
+   */
+  private _isVoltageLimited(): boolean {
+    for (const device of this._devices.values()) {
+      if (device.hasLimitedVoltage?.()) return true;
+    }
+    return false;
+  }
+
   /**
    * 🚀 執行一個時間步進 (事件驅動重構版)
    * 
@@ -784,20 +1641,21 @@ private async _solveDCNewtonRaphson(gmin: number = 0): Promise<boolean> {
     let integratorResult;
     try {
       // 1. 執行一個「暫定」的積分步驟
-      integratorResult = await this._integrator.step(this, t_start, dt, this._solutionVector);
+      integratorResult = await this._integratorStep(t_start, dt);
     } catch (error) {
-        console.error(`💥 Integrator step failed at t=${t_start}:`, error);
+        this._log.error(`💥 Integrator step failed at t=${t_start}:`, error);
         throw new Error(`Integrator error: ${error}`);
     }
   
     if (!integratorResult.converged) {
-      this._logEvent('INTEGRATOR_FAILURE', undefined, `Integrator failed at t=${t_start.toExponential(3)}s`);
+      this._logEvent(SimulationEventType.INTEGRATOR_FAILURE, undefined, 'Integrator failed, value = dt', dt);
       return false; // 告知外部循環需要減小步長重試
     }
     const tentativeSolution = integratorResult.solution;
   
     // 2. 檢測在此時間區間內是否發生了事件
     let events: IEvent[] = [];
+    const detectionStart = this._profiler.begin();
     try {
         const eventfulComponents = Array.from(this._devices.values()).filter(d => d.hasEvents && d.hasEvents());
         events = this._eventDetector.detectEvents(
@@ -805,8 +1663,10 @@ private async _solveDCNewtonRaphson(gmin: number = 0): Promise<boolean> {
           t_start, t_end, this._solutionVector, tentativeSolution
         );
     } catch (error) {
-        console.error(`💥 Event detection failed at t=${t_start}:`, error);
+        this._log.error(`💥 Event detection failed at t=${t_start}:`, error);
         throw new Error(`Event detection error: ${error}`);
+    } finally {
+        this._profiler.end('eventDetectionTime', detectionStart);
     }
   
     // 3. 根據是否有事件來決定下一步
@@ -822,7 +1682,7 @@ private async _solveDCNewtonRaphson(gmin: number = 0): Promise<boolean> {
       
       // 使用積分器建議的下一步長
       this._currentTimeStep = this._adaptTimeStep(integratorResult.nextDt); 
-      this._logEvent('STEP_ACCEPTED', undefined, `Step to ${t_end.toExponential(3)}s. Next dt: ${this._currentTimeStep.toExponential(3)}s.`);
+      this._logEvent(SimulationEventType.STEP_ACCEPTED, undefined, 'Step accepted, value = next dt', this._currentTimeStep);
       return true;
   
     } else {
@@ -833,10 +1693,14 @@ private async _solveDCNewtonRaphson(gmin: number = 0): Promise<boolean> {
       }
   
       // 4. 使用二分法精確定位事件時間
+      const locateStart = this._profiler.begin();
+      const spanStart = this._tracer?.begin() ?? 0;
       const eventTime = await this._eventDetector.locateEventTime(
         firstEvent,
         (time: Time) => this._integrator.interpolate(time) // 傳遞插值函數
       );
+      this._tracer?.end('event_locate', spanStart, eventTime, dt);
+      this._profiler.end('eventDetectionTime', locateStart);
   
       // 如果事件發生在一個極小的時間步內，先處理事件再說
       if (this._eventDetector.isTimestepTooSmall(eventTime - t_start)) {
@@ -846,10 +1710,10 @@ private async _solveDCNewtonRaphson(gmin: number = 0): Promise<boolean> {
   
       // 5. 精確積分到事件發生點
       const eventDt = eventTime - t_start;
-      const finalResult = await this._integrator.step(this, t_start, eventDt, this._solutionVector);
+      const finalResult = await this._integratorStep(t_start, eventDt);
   
       if (!finalResult.converged) {
-        this._logEvent('INTEGRATOR_FAILURE_TO_EVENT', firstEvent.component.name, `Integrator failed to step to event at t=${eventTime.toExponential(3)}s`);
+        this._logEvent(SimulationEventType.INTEGRATOR_FAILURE_TO_EVENT, firstEvent.component.name, `Integrator failed to step to event at t=${eventTime.toExponential(3)}s`);
         return false; // 連到事件點都失敗，情況很糟
       }
   
@@ -869,6 +1733,33 @@ private async _solveDCNewtonRaphson(gmin: number = 0): Promise<boolean> {
     }
   }
 
+  /**
+   * ⏱️ 执行一次积分器步进；积分器内除装配与矩阵分解/求解以外的耗时 (预测、残差、LTE) 计为收敛检查
+   */
+  private async _integratorStep(t: Time, dt: Time): Promise<IntegratorResult> {
+    const start = this._profiler.begin();
+    const nested = this._profiler.enabled ? this._nestedSolverTime() : 0;
+    const result = await this._integrator.step(this, t, dt, this._solutionVector);
+    if (this._profiler.enabled) {
+      this._profiler.end('convergenceCheckTime', start, this._nestedSolverTime() - nested);
+    }
+    return result;
+  }
+
+  /** 矩阵分解/求解跨度写入执行轨迹 (未开启轨迹时为 null) */
+  private _solverPhaseListener(): SolverPhaseListener | null {
+    const tracer = this._tracer;
+    if (!tracer) return null;
+    return (phase, start, duration) => tracer.record(phase, start, duration, this._currentTime, this._currentTimeStep);
+  }
+
+  /** 已单独计时的装配、设备评估与系统矩阵分解/求解耗时之和 */
+  private _nestedSolverTime(): number {
+    const metrics = this._performanceMetrics;
+    const statistics = (this._systemMatrix as SparseMatrix).statistics;
+    return metrics.matrixAssemblyTime + metrics.deviceEvaluationTime + statistics.factorTime + statistics.solveTime;
+  }
+
   // Step 3: 新增一個處理事件的輔助方法
   private _handleEvent(event: IEvent): void {
     const device = event.component as ComponentInterface;
@@ -889,13 +1780,15 @@ private async _solveDCNewtonRaphson(gmin: number = 0): Promise<boolean> {
 
     // 關鍵步驟：事件處理後，必須重啟積分器！
     // 因為系統的行為（例如一個開關的狀態）已經改變。
+    const restartStart = this._tracer?.begin() ?? 0;
     this._integrator.restart({
       time: this._currentTime,
       solution: this._solutionVector as Vector,
       derivative: Vector.zeros(this._solutionVector.size), // 發生突變，導數重設為0
     });
+    this._tracer?.end('integrator_restart', restartStart, this._currentTime, this._currentTimeStep);
     
-    this._logEvent('INTEGRATOR_RESTART', device.name, `Integrator restarted after event ${event.type}.`);
+    this._logEvent(SimulationEventType.INTEGRATOR_RESTART, device.name, `Integrator restarted after event ${event.type}.`);
   }
 
   /**
@@ -909,7 +1802,8 @@ private async _solveDCNewtonRaphson(gmin: number = 0): Promise<boolean> {
    * @param dt - 时间步长 (默认使用当前时间步长，DC 分析时应传入 0)
    */
   private _assembleSystem(time: number = this._currentTime, gmin: number = 0, dt: number = this._currentTimeStep): void {
-    const assemblyStartTime = performance.now();
+    const assemblyStartTime = this._profiler.begin();
+    const spanStart = this._tracer?.begin() ?? 0;
     
     // 清空矩阵和向量
     this._systemMatrix.clear();
@@ -930,6 +1824,7 @@ private async _solveDCNewtonRaphson(gmin: number = 0): Promise<boolean> {
     };
     
     // ✅ 這就是先進架構的威力：一個簡單、統一的迴圈！
+    const evaluationStartTime = this._profiler.begin();
     for (const device of this._devices.values()) {
       try {
         device.assemble(assemblyContext);
@@ -937,6 +1832,16 @@ private async _solveDCNewtonRaphson(gmin: number = 0): Promise<boolean> {
         throw new Error(`Assembly failed for component ${device.name}: ${error}`);
       }
     }
+    const evaluationTime = this._profiler.end('deviceEvaluationTime', evaluationStartTime);
+
+    // 🕰️ 伪瞬态连续：节点到参考解的伪电导
+    if (this._ptcConductance > 0 && this._ptcReference) {
+      const g = this._ptcConductance;
+      for (const nodeIndex of this._nodeMapping.values()) {
+        this._systemMatrix.add(nodeIndex, nodeIndex, g);
+        this._rhsVector.add(nodeIndex, g * this._ptcReference.get(nodeIndex));
+      }
+    }
 
     // 🧠 **关键修复：强制执行接地节点 (Node 0) 约束**
     // 这是 MNA 方法中的标准实践，用于消除矩阵的奇异性。
@@ -955,21 +1860,33 @@ private async _solveDCNewtonRaphson(gmin: number = 0): Promise<boolean> {
       this._rhsVector.set(groundNodeIndex, 0.0);  // RHS = 0
     }
     
-    this._performanceMetrics.matrixAssemblyTime += performance.now() - assemblyStartTime;
+    this._profiler.end('matrixAssemblyTime', assemblyStartTime, evaluationTime);
+    this._tracer?.end('assemble', spanStart, time, dt);
   }
 
-  private async _solveLinearSystem(A: ISparseMatrix, b: IVector): Promise<IVector> {
+  /**
+   * 去地求解 A·x = b
+   *
+   * @param newtonStep - false 表示辅助求解 (扫描切线)：不录制、不更新伴随 DC 雅可比与共享符号分解
+   */
+  private async _solveLinearSystem(A: ISparseMatrix, b: IVector, newtonStep: boolean = true): Promise<IVector> {
     const groundNodeIndex = this._nodeMapping.get('0');
 
     if (groundNodeIndex === undefined) {
-      console.warn('⚠️ No ground node ("0") found. Matrix may be singular.');
+      this._log.warn('⚠️ No ground node ("0") found. Matrix may be singular.');
       // Proceed with the original matrix, but it's likely to fail.
-      return (A as SparseMatrix).solve(b);
+      if (newtonStep) this._solverRecorder?.record(A as SparseMatrix, b, 'dc', this._currentTime);
+      const solution = (A as SparseMatrix).solve(b);
+      if (newtonStep && this._adjointRecorder) {
+        // 系统矩阵下次装配会被覆盖：伴随分析保留一份副本 (转置求解时再分解)
+        this._dcJacobian = { matrix: (A as SparseMatrix).clone(), mapping: Array.from({ length: b.size }, (_, i) => i) };
+      }
+      return solution;
     }
 
     // 🧠 **The Submatrix Method: The Correct Way to Handle Ground**
     // 1. Extract the submatrix and sub-vector by removing the ground node's row/column.
-    const { matrix: subMatrix, mapping: inverseMapping } = A.submatrix([groundNodeIndex], [groundNodeIndex]);
+    const { matrix: subMatrix, mapping: inverseMapping } = this._reduceSystem(A as SparseMatrix, groundNodeIndex);
     
     const subRhs = new Vector(b.size - 1);
     let subIndex = 0;
@@ -982,9 +1899,20 @@ private async _solveDCNewtonRaphson(gmin: number = 0): Promise<boolean> {
     // 2. Solve the smaller, non-singular system.
     let subSolution: IVector;
     try {
-      subSolution = (subMatrix as SparseMatrix).solve(subRhs);
+      if (this._config.solverMode === 'klu' || this._config.solverMode === 'auto') {
+        // 同拓扑共享列排序，只做数值分解 (与当前符号分解相同时不作废数值因子)
+        subMatrix.setSymbolicFactorization(this._symbolicFactorization);
+      }
+      if (newtonStep) this._solverRecorder?.record(subMatrix, subRhs, 'dc', this._currentTime);
+      subSolution = subMatrix.solve(subRhs);
+      if (newtonStep && (this._config.solverMode === 'klu' || this._config.solverMode === 'auto')) {
+        this._symbolicFactorization = subMatrix.getSymbolicFactorization();
+      }
+      if (newtonStep && this._adjointRecorder) {
+        this._dcJacobian = { matrix: subMatrix, mapping: inverseMapping };
+      }
     } catch (error) {
-      console.error(`[Submatrix Solver] ABORT: Linear solver failed on the submatrix. Error: ${error}`);
+      this._log.error(`[Submatrix Solver] ABORT: Linear solver failed on the submatrix. Error: ${error}`);
       const nanVector = new Vector(b.size);
       nanVector.fill(NaN);
       return nanVector;
@@ -1002,6 +1930,28 @@ private async _solveDCNewtonRaphson(gmin: number = 0): Promise<boolean> {
     return fullSolution;
   }
 
+  /**
+   * 🧩 去地子矩阵：首次求解时创建，之后从 A 原地装载
+   *
+   * 同一矩阵跨 Newton 迭代复用，auto 选择、稠密缓冲区与数值因子 (含单精度因子) 得以保留，
+   * 模式不变时只做数值重分解。
+   */
+  private _reduceSystem(A: SparseMatrix, groundNodeIndex: number): { matrix: SparseMatrix; mapping: number[] } {
+    const reduced = this._reducedSystem;
+    if (reduced && reduced.matrix.rows === A.rows - 1) {
+      reduced.mapping = reduced.matrix.loadSubmatrix(A, [groundNodeIndex], [groundNodeIndex]);
+      return reduced;
+    }
+    if (reduced) accumulateSolverStatistics(this._dcSolverStatistics, reduced.matrix.statistics);
+
+    const { matrix, mapping } = A.submatrix([groundNodeIndex], [groundNodeIndex]);
+    const created = { matrix: matrix as SparseMatrix, mapping };
+    created.matrix.setTimingEnabled(this._profiler.enabled);
+    created.matrix.setPhaseListener(this._solverPhaseListener());
+    this._reducedSystem = created;
+    return created;
+  }
+
   /**
    * CHANGED: 状态更新 - 只为智能设备更新状态
    */
@@ -1035,84 +1985,310 @@ private _adaptTimeStep(suggestedDt: number): number {
     return newDt;
 }
 
-  private _saveWaveformPoint(): void {
-    // 保存当前时间点的波形数据
-    (this._waveformData.timePoints as Time[]).push(this._currentTime);
-    
-    // 保存节点电压
-    for (let i = 0; i < this._solutionVector.size; i++) {
-      if (!this._waveformData.nodeVoltages.has(i)) {
-        (this._waveformData.nodeVoltages as Map<number, number[]>).set(i, []);
+  /**
+   * 👣 推进一个接受步 (失败时减半步长重试)，返回 false 表示主循环应结束
+   */
+  private async _advance(): Promise<boolean> {
+    const time = this._currentTime;
+    const dt = this._currentTimeStep; // 装配伴随模型所用步长 (事件步亦然)
+    try {
+      const spanStart = this._tracer?.begin() ?? 0;
+      const stepSuccess = await this._performTimeStep();
+      this._tracer?.end('timestep', spanStart, time, dt);
+
+      if (!stepSuccess) {
+        this._performanceMetrics.failedSteps++;
+        // 步长减半重试
+        if (this._currentTimeStep > this._config.minTimeStep * 2) {
+          this._currentTimeStep *= 0.5;
+          this._performanceMetrics.adaptiveStepChanges++;
+          return true;
+        }
+        // 无法继续，仿真失败
+        this._state = SimulationState.FAILED;
+        this._logEvent(SimulationEventType.FATAL, undefined, 'Time step fell below minimum and could not recover.');
+        return false;
       }
-      (this._waveformData.nodeVoltages.get(i) as number[]).push(this._solutionVector.get(i));
+    } catch (stepError) {
+      this._log.error(`💥 Error within simulation loop at t=${this._currentTime}:`, stepError);
+      throw stepError; // Re-throw to be caught by the main catch block
     }
-    
-    // 保存设备电流和状态 (简化实现) - 只对智能设备
-    const devices = Array.from(this._devices.values());
-    for (const device of devices) {
-      if (isIntelligentDeviceModel(device)) {
-        const deviceId = device.deviceId;
-        
-        if (!this._waveformData.deviceCurrents.has(deviceId)) {
-          (this._waveformData.deviceCurrents as Map<string, number[]>).set(deviceId, []);
-          (this._waveformData.deviceStates as Map<string, string[]>).set(deviceId, []);
-        }
-        
-        // TODO: 获取实际设备电流
-        (this._waveformData.deviceCurrents.get(deviceId) as number[]).push(0);
-        (this._waveformData.deviceStates.get(deviceId) as string[]).push('normal');
+
+    // 伴随轨迹：本步收敛解与组装时的步长、雅可比 (时间未推进时忽略)
+    this._adjointRecorder?.recordStep(this._currentTime, dt, this._solutionVector, this._systemMatrix as SparseMatrix);
+
+    // 保存波形数据 (内部步或输出网格) 并更新在线测量
+    this._processAcceptedStep();
+
+    // 内存使用检查
+    if (this._memoryUsage > this._config.maxMemoryUsage * 1024 * 1024) {
+      this._logEvent(SimulationEventType.MEMORY_WARNING, undefined, 'Memory usage exceeded limit');
+      return false;
+    }
+
+    this._stepCount++;
+    return true;
+  }
+
+  private _markCompleted(): void {
+    if (this._currentTime >= this._config.endTime && this._state === SimulationState.RUNNING) {
+      this._state = SimulationState.COMPLETED;
+      this._logEvent(SimulationEventType.INFO, undefined, '✅ Simulation completed successfully.');
+    }
+  }
+
+  /**
+   * ⏸️ 暂停期间等待 resumeSimulation()/stopSimulation() 或取消信号
+   */
+  private _waitForResume(signal: AbortSignal | undefined): Promise<void> {
+    return new Promise(resolve => {
+      if (signal?.aborted) return resolve();
+      const wake = (): void => {
+        signal?.removeEventListener('abort', wake);
+        resolve();
+      };
+      signal?.addEventListener('abort', wake, { once: true });
+      this._resumeWaiters.push(wake);
+    });
+  }
+
+  private _wakeResumeWaiters(): void {
+    const waiters = this._resumeWaiters;
+    this._resumeWaiters = [];
+    waiters.forEach(wake => wake());
+  }
+
+  /**
+   * ✅ 接受步后处理：记录输出、更新在线测量，并保存本步解供下一步插值
+   */
+  private _processAcceptedStep(): void {
+    const usesGrid = this._config.outputTimes.length > 0 || this._config.outputTimeStep > 0;
+    if (this._config.saveIntermediateResults) {
+      if (usesGrid) {
+        this._recordOutput();
       } else {
-        // 对基础组件，使用统一的 name 属性
-        const deviceId = device.name;
-        
-        if (!this._waveformData.deviceCurrents.has(deviceId)) {
-          (this._waveformData.deviceCurrents as Map<string, number[]>).set(deviceId, []);
-          (this._waveformData.deviceStates as Map<string, string[]>).set(deviceId, []);
-        }
-        
-        // 🎯 获取实际设备电流
-        let current = 0;
-        // 对于电感，电流存储在 extraVariable 中
-        if (device.type === 'L') {
-          const currentIndex = this._extraVariableManager?.getIndex(device.name, ExtraVariableType.INDUCTOR_CURRENT);
-          if (currentIndex !== undefined && currentIndex >= 0) {
-            current = this._solutionVector.get(currentIndex);
-          }
-        }
-        // 对于电压源，电流也存储在 extraVariable 中
-        else if (device.type === 'V') {
-          const currentIndex = this._extraVariableManager?.getIndex(device.name, ExtraVariableType.VOLTAGE_SOURCE_CURRENT);
-          if (currentIndex !== undefined && currentIndex >= 0) {
-            current = this._solutionVector.get(currentIndex);
-          }
-        }
-        // 对于电阻，计算通过的电流 I = (V1 - V2) / R
-        else if (device.type === 'R' && 'nodes' in device && 'resistance' in device) {
-          const nodes = device.nodes as readonly [string, string];
-          const n1 = this._nodeMapping.get(nodes[0]);
-          const n2 = this._nodeMapping.get(nodes[1]);
-          const v1 = (n1 !== undefined && n1 >= 0) ? this._solutionVector.get(n1) : 0;
-          const v2 = (n2 !== undefined && n2 >= 0) ? this._solutionVector.get(n2) : 0;
-          const resistance = (device as any).resistance;
-          current = (v1 - v2) / resistance;
-        }
-        // 对于电容，使用伴侣模型计算瞬时电流 I = C * dV/dt
-        // 这里简化处理，使用历史电压差除以时间步
-        else if (device.type === 'C' && 'nodes' in device) {
-          // 电容电流在瞬态中为 I = C * dV/dt
-          // 暂时设为 0，需要更复杂的实现
-          current = 0;
-        }
-        
-        (this._waveformData.deviceCurrents.get(deviceId) as number[]).push(current);
-        (this._waveformData.deviceStates.get(deviceId) as string[]).push('normal');
+        this._saveWaveformPoint();
+      }
+    }
+    if (this._measurementSet) {
+      this._updateMeasurements();
+    }
+
+    if (usesGrid || this._measurementSet) {
+      this._lastAcceptedTime = this._currentTime;
+      this._lastAcceptedSolution = this._solutionVector.clone();
+    }
+  }
+
+  /**
+   * 📤 记录落在 (上一接受步, 当前时间] 内的全部输出网格点，步长控制不受输出密度约束
+   */
+  private _recordOutput(): void {
+    const t0 = this._lastAcceptedTime;
+    const t1 = this._currentTime;
+    const tolerance = 1e-12 * Math.max(Math.abs(t1), this._config.minTimeStep);
+    for (let t = this._outputTime(this._nextOutputIndex); t !== undefined && t <= t1 + tolerance;
+         t = this._outputTime(++this._nextOutputIndex)) {
+      this._saveWaveformPoint(t, this._interpolateOutput(t, t0, t1));
+    }
+  }
+
+  /**
+   * 📏 以初始解为首个样本创建测量集合
+   */
+  private _initializeMeasurements(): void {
+    this._measurementSet = null;
+    this._nextMeasureBreakpoint = 0;
+    if (this._config.measurements.length === 0) return;
+
+    this._measurementSet = new MeasurementSet<IVector>(
+      this._config.measurements,
+      this._config.startTime,
+      this._config.endTime,
+      signal => this._signalReader(signal)
+    );
+    this._measurementSet.sample(this._currentTime, this._solutionVector);
+  }
+
+  /**
+   * 📏 先在落入本步的 FROM/TO/AT 时刻插值补采样，再以本步解采样
+   */
+  private _updateMeasurements(): void {
+    const set = this._measurementSet!;
+    const t0 = this._lastAcceptedTime;
+    const t1 = this._currentTime;
+    const breakpoints = set.breakpoints;
+    while (this._nextMeasureBreakpoint < breakpoints.length && breakpoints[this._nextMeasureBreakpoint]! < t1) {
+      const t = breakpoints[this._nextMeasureBreakpoint++]!;
+      if (t > t0) {
+        set.sample(t, this._interpolateOutput(t, t0, t1));
+      }
+    }
+    set.sample(t1, this._solutionVector);
+  }
+
+  /**
+   * 🔌 信号 V(node) / I(device) 的解向量读取函数
+   */
+  private _signalReader(signal: string): (solution: IVector) => number {
+    const { terms } = this._signalForm(signal);
+    return solution => terms.reduce((sum, [index, coefficient]) => sum + coefficient * solution.get(index), 0);
+  }
+
+  /**
+   * 🔌 信号的线性形式 (解向量分量的加权和；I(R) 另含对 R 的显式依赖)
+   */
+  private _signalForm(signal: string): SignalForm {
+    const name = this._normalizeProbe(signal);
+    const argument = name.slice(2, -1);
+
+    if (name.startsWith('V(')) {
+      if (argument === '0' || argument.toUpperCase() === 'GND') return { terms: [] };
+      const index = this._nodeMapping.get(argument);
+      if (index === undefined) throw new Error(`Unknown measurement signal: ${signal}`);
+      return { terms: [[index, 1]] };
+    }
+
+    const device = Array.from(this._devices.values()).find(d => d.name.toUpperCase() === argument);
+    if (device && !isIntelligentDeviceModel(device)) {
+      const branchType = device.type === 'V' ? ExtraVariableType.VOLTAGE_SOURCE_CURRENT
+        : device.type === 'L' ? ExtraVariableType.INDUCTOR_CURRENT : undefined;
+      const branch = branchType !== undefined ? this._extraVariableManager?.getIndex(device.name, branchType) : undefined;
+      if (branch !== undefined) {
+        return { terms: [[branch, 1]] };
+      }
+      if (device.type === 'R' && 'resistance' in device) {
+        const n1 = this._nodeMapping.get(device.nodes[0]!.toString()) ?? -1;
+        const n2 = this._nodeMapping.get(device.nodes[1]!.toString()) ?? -1;
+        const resistance = (device as ComponentInterface & { resistance: number }).resistance;
+        const terms: [number, number][] = [];
+        if (n1 >= 0) terms.push([n1, 1 / resistance]);
+        if (n2 >= 0) terms.push([n2, -1 / resistance]);
+        return { terms, parameter: { key: device.name, scale: -1 / resistance } };
       }
     }
+    throw new Error(`Unsupported measurement signal: ${signal}`);
+  }
+
+  /**
+   * 🎯 伴随灵敏度：输出对全部元件参数的导数 (需 config.adjointSensitivity 并已运行仿真)
+   *
+   * 与 .MEAS 同名的输出对整个瞬态轨迹求导，其余按信号名在 DC 工作点求导。
+   * 参数键与蒙特卡罗一致 (R1、D1.IS)；条件未满足的测量不在结果中。
+   */
+  computeSensitivities(
+    outputs: readonly string[] = this._config.measurements.map(m => m.name)
+  ): Map<string, Map<string, number>> {
+    const recorder = this._adjointRecorder;
+    if (!recorder) {
+      throw new Error('Adjoint sensitivity requires config.adjointSensitivity and a completed simulation');
+    }
+    const resolved = outputs.map((output): SensitivityOutput => {
+      const definition = this._config.measurements.find(m => m.name.toLowerCase() === output.toLowerCase());
+      return definition ? { kind: 'measure', definition } : { kind: 'signal', signal: output };
+    });
+    return recorder.compute({
+      devices: Array.from(this._devices.values()),
+      nodeMap: this._nodeMapping,
+      groundIndex: this._nodeMapping.get('0') ?? -1,
+      getExtraVariableIndex: (componentName: string, variableType: string) =>
+        this._extraVariableManager?.getIndex(componentName, variableType as ExtraVariableType),
+      solverMode: this._config.solverMode,
+      startTime: this._config.startTime,
+      endTime: this._config.endTime,
+      measurements: this._config.measurements,
+      signal: name => this._signalForm(name)
+    }, resolved);
+  }
+
+  /**
+   * 📊 获取 .MEAS 测量结果 (条件未满足的测量为 null)
+   */
+  getMeasurements(): Map<string, number | null> {
+    return this._measurementSet?.results() ?? new Map();
+  }
+
+  /**
+   * 第 k 个输出时间点 (超出网格返回 undefined)
+   */
+  private _outputTime(k: number): Time | undefined {
+    const explicit = this._config.outputTimes;
+    if (explicit.length > 0) {
+      return explicit[k];
+    }
+
+    // .TRAN 网格：tstart, tstart + tstep, ...，最后一点落在 tstop
+    const { startTime, endTime, outputTimeStep } = this._config;
+    const count = Math.floor((endTime - startTime) / outputTimeStep + 1e-9);
+    if (k <= count) {
+      return Math.min(startTime + k * outputTimeStep, endTime);
+    }
+    const lastGridTime = startTime + count * outputTimeStep;
+    return k === count + 1 && endTime - lastGridTime > 1e-9 * outputTimeStep ? endTime : undefined;
+  }
+
+  /**
+   * 求 t ∈ [t0, t1] 处的解：积分器历史覆盖该区间时使用其三次 Hermite 稠密输出，
+   * 否则 (首步、事件后重启) 在两个接受解之间线性插值
+   */
+  private _interpolateOutput(t: Time, t0: Time, t1: Time): IVector {
+    const span = t1 - t0;
+    if (span <= 0 || t >= t1) {
+      return this._solutionVector;
+    }
+
+    const [current, previous] = this._integrator.history;
+    const tolerance = 1e-12 * Math.max(Math.abs(t1), this._config.minTimeStep);
+    if (current && previous && Math.abs(current.time - t1) <= tolerance && previous.time <= t + tolerance) {
+      return this._integrator.interpolate(Math.max(t, previous.time));
+    }
+
+    const weight = Math.max(0, (t - t0) / span);
+    const start = this._lastAcceptedSolution ?? this._solutionVector;
+    return start.scale(1 - weight).plus(this._solutionVector.scale(weight));
+  }
+
+  private _saveWaveformPoint(time: Time = this._currentTime, solution: IVector = this._solutionVector): void {
+    if (!this._waveformStore) {
+      this._initializeWaveformStorage();
+    }
+    const saveStartTime = this._profiler.begin();
+    const store = this._waveformStore!;
+    const row = this._waveformRow;
+
+    // 选中的解向量分量 (节点电压 + 额外变数)，索引在初始化时预先计算
+    const unknowns = this._waveformUnknowns;
+    for (let c = 0; c < unknowns.length; c++) {
+      row[c] = solution.get(unknowns[c]!);
+    }
+
+    // 电阻电流 I = (V1 - V2) / R，仅计算被探测的电阻；电压源/电感电流即其支路变数，其余器件暂记为 0
+    for (const probe of this._resistorCurrentProbes) {
+      const v1 = probe.n1 >= 0 ? solution.get(probe.n1) : 0;
+      const v2 = probe.n2 >= 0 ? solution.get(probe.n2) : 0;
+      row[probe.column] = (v1 - v2) / probe.resistance;
+    }
+
+    store.append(time, row, this._waveformStateCodes);
+    this._streamBuffer?.append(time, row);
+    this._profiler.end('waveformSaveTime', saveStartTime);
+
+    // 每封存一块更新一次内存统计并采样堆
+    if (store.rowCount % store.chunkRows === 0) {
+      this._memoryUsage = store.memoryUsage();
+      this._performanceMetrics.memoryPeakUsage = Math.max(
+        this._performanceMetrics.memoryPeakUsage,
+        this._memoryUsage / (1024 * 1024)
+      );
+      this._profiler.sampleHeap();
+    }
   }
 
   private _generateFinalResult(): SimulationResult {
-    const totalTime = performance.now() - this._startTime;
-    this._performanceMetrics.totalSimulationTime = totalTime;
+    // 封存最后一个未满的波形块，使 sink 收到完整数据
+    this._waveformStore?.flush();
+
+    const totalTime = this._finalizePerformanceMetrics();
     
     const convergenceRate = 1 - (this._performanceMetrics.failedSteps / Math.max(this._stepCount, 1));
     
@@ -1124,49 +2300,158 @@ private _adaptTimeStep(suggestedDt: number): number {
       averageStepTime: totalTime / Math.max(this._stepCount, 1),
       peakMemoryUsage: this._performanceMetrics.memoryPeakUsage,
       waveformData: this._waveformData,
-      performanceMetrics: this._performanceMetrics
+      performanceMetrics: this._performanceMetrics,
+      ...(this._measurementSet ? { measurements: this._measurementSet.results() } : {})
     };
   }
 
+  /**
+   * 📊 汇总矩阵分解/求解统计与平均迭代次数，返回总耗时
+   */
+  private _finalizePerformanceMetrics(): number {
+    const metrics = this._performanceMetrics;
+    const statistics = createSolverStatistics();
+    accumulateSolverStatistics(statistics, this._dcSolverStatistics);
+    if (this._reducedSystem) accumulateSolverStatistics(statistics, this._reducedSystem.matrix.statistics);
+    accumulateSolverStatistics(statistics, (this._systemMatrix as SparseMatrix).statistics);
+
+    const totalTime = performance.now() - this._startTime;
+    metrics.totalSimulationTime = totalTime;
+    metrics.matrixFactorizations = statistics.factorizations;
+    metrics.matrixRefactorizations = statistics.refactorizations;
+    metrics.matrixFactorizationTime = statistics.factorTime;
+    metrics.matrixSolutionTime = statistics.solveTime;
+    metrics.averageIterationsPerStep = this._transientNewtonIterations / Math.max(this._stepCount, 1);
+    this._profiler.sampleHeap();
+    return totalTime;
+  }
+
   private _initializeWaveformStorage(): void {
-    // 预分配波形数据存储
-    // 开始瞬态分析 (暂时跳过，集中精力于DC分析)
-    
-    // 节点电压存储
-    for (let nodeId = 0; nodeId < this._nodeMapping.size; nodeId++) {
-      (this._waveformData.nodeVoltages as Map<number, number[]>).set(nodeId, []);
+    // 0. 探测选择：空列表或含 ALL 时记录全部信号
+    const probes = new Set(this._config.probes.map(probe => this._normalizeProbe(probe)));
+    const recordAll = probes.size === 0 || probes.has('ALL');
+    const matched = new Set<string>();
+    const selected = (name: string): boolean => {
+      if (recordAll) return true;
+      if (!probes.has(name)) return false;
+      matched.add(name);
+      return true;
+    };
+
+    // 1. 解向量列：节点 V(name)，额外变数 I(component)
+    const size = this._solutionVector.size;
+    const unknownNames: string[] = new Array(size);
+    for (const [nodeName, nodeIndex] of this._nodeMapping) {
+      unknownNames[nodeIndex] = `V(${nodeName})`;
     }
-    
-    // 设备电流和状态存储
-    const devices = Array.from(this._devices.values());
-    for (const device of devices) {
+    for (const variable of this._extraVariableManager?.getAllVariables() ?? []) {
+      const prefix = variable.type === ExtraVariableType.TRANSFORMER_PRIMARY_CURRENT ? 'I1'
+        : variable.type === ExtraVariableType.TRANSFORMER_SECONDARY_CURRENT ? 'I2' : 'I';
+      unknownNames[variable.index] = `${prefix}(${variable.componentName})`;
+    }
+    const numericColumns: string[] = [];
+    const nodeColumns = new Map<number, string>();
+    const unknowns: number[] = [];
+    for (let i = 0; i < size; i++) {
+      const name = unknownNames[i] ?? `X(${i})`;
+      if (!selected(name)) continue;
+      numericColumns.push(name);
+      nodeColumns.set(i, name);
+      unknowns.push(i);
+    }
+
+    // 2. 被探测器件的电流列 (电压源/电感复用支路变数列) 与状态列
+    const currentColumns = new Map<string, string>();
+    const stateColumns = new Map<string, string>();
+    const enumColumns: string[] = [];
+    this._resistorCurrentProbes = [];
+    for (const device of this._devices.values()) {
       const deviceId = isIntelligentDeviceModel(device) ? device.deviceId : device.name;
-      (this._waveformData.deviceCurrents as Map<string, number[]>).set(deviceId, []);
-      (this._waveformData.deviceStates as Map<string, string[]>).set(deviceId, []);
+      const column = `I(${deviceId})`;
+      if (!selected(column)) continue;
+
+      const branchType = device.type === 'V' ? ExtraVariableType.VOLTAGE_SOURCE_CURRENT
+        : device.type === 'L' ? ExtraVariableType.INDUCTOR_CURRENT : undefined;
+      const branchIndex = branchType !== undefined ? this._extraVariableManager?.getIndex(device.name, branchType) : undefined;
+
+      if (branchIndex !== undefined && !isIntelligentDeviceModel(device) && nodeColumns.has(branchIndex)) {
+        currentColumns.set(deviceId, nodeColumns.get(branchIndex)!);
+      } else {
+        if (!numericColumns.includes(column)) {
+          numericColumns.push(column);
+        }
+        currentColumns.set(deviceId, column);
+        if (device.type === 'R' && 'resistance' in device && !isIntelligentDeviceModel(device)) {
+          this._resistorCurrentProbes.push({
+            column: numericColumns.indexOf(column),
+            n1: this._nodeMapping.get(device.nodes[0]!.toString()) ?? -1,
+            n2: this._nodeMapping.get(device.nodes[1]!.toString()) ?? -1,
+            resistance: (device as ComponentInterface & { resistance: number }).resistance
+          });
+        }
+      }
+      const stateColumn = `S(${deviceId})`;
+      enumColumns.push(stateColumn);
+      stateColumns.set(deviceId, stateColumn);
+    }
+
+    for (const probe of probes) {
+      if (probe !== 'ALL' && !matched.has(probe)) {
+        this._logEvent(SimulationEventType.PROBE_UNKNOWN, undefined, `No signal matches probe ${probe}`);
+      }
+    }
+
+    // 3. 创建存储与按需物化的 WaveformData 视图
+    this._waveformStore = new WaveformStore(numericColumns, enumColumns, {
+      chunkBytes: this._config.waveformChunkBytes,
+      retainChunks: this._config.retainWaveformChunks,
+      ...(this._waveformSink ? { sink: this._waveformSink } : {}),
+      ...(this._config.waveformCompression ? { compression: this._config.waveformCompression } : {}),
+      ...(this._config.waveformEnvelope ? { envelope: this._config.waveformEnvelope } : {})
+    });
+    this._waveformRow = new Float64Array(numericColumns.length);
+    this._waveformUnknowns = Int32Array.from(unknowns);
+    this._waveformStateCodes = new Int32Array(enumColumns.length).fill(this._waveformStore.encode('normal'));
+    this._waveformData = this._waveformStore.createWaveformData(nodeColumns, currentColumns, stateColumns);
+    if (this._streamOptions) {
+      this._streamBuffer = new StreamBuffer(
+        numericColumns, this._streamOptions.chunkRows ?? 1024, this._streamOptions.maxLatency ?? 50
+      );
     }
   }
 
-  private _logEvent(type: string, deviceId?: string, description: string = ''): void {
-    const event: SimulationEvent = {
-      time: this._currentTime,
-      type,
-      deviceId,
-      description,
-      data: null
-    };
-    
-    this._events.push(event);
+  /**
+   * 规整探测信号名：V(node) 保留节点名大小写，I(device) 器件名大写，裸节点名视为 V(node)
+   */
+  private _normalizeProbe(probe: string): string {
+    const trimmed = probe.trim();
+    if (trimmed.toUpperCase() === 'ALL') return 'ALL';
+    const call = trimmed.match(/^([VvIi])\(\s*([^)\s]+)\s*\)$/);
+    if (!call) return `V(${trimmed})`;
+    return call[1]!.toUpperCase() === 'V' ? `V(${call[2]!})` : `I(${call[2]!.toUpperCase()})`;
+  }
+
+  private _logEvent(type: SimulationEventType, deviceId?: string, description: string = '', value: number = NaN): void {
+    this._events.record(type, this._currentTime, deviceId, description, value);
     
-    if (this._config.verboseLogging) {
-      console.log(`[${type}] t=${this._currentTime.toExponential(3)} ${deviceId ? `[${deviceId}]` : ''}: ${description}`);
+    if (this._log.debugEnabled) {
+      const payload = Number.isNaN(value) ? '' : ` (value=${value})`;
+      this._log.debug(`[${SimulationEventType[type]}] t=${this._currentTime.toExponential(3)} ${deviceId ? `[${deviceId}]` : ''}: ${description}${payload}`);
     }
   }
 
   /**
-   * 📊 获取仿真事件日志
+   * 📊 获取仿真事件日志 (最近 eventLogCapacity 条，按时间顺序)
    */
   getSimulationEvents(): readonly SimulationEvent[] {
-    return this._events;
+    return this._events.toArray();
+  }
+
+  /**
+   * 📊 因事件日志写满而被覆盖的事件数
+   */
+  getDroppedEventCount(): number {
+    return this._events.droppedEvents;
   }
 
   /**
@@ -1181,7 +2466,11 @@ private _adaptTimeStep(suggestedDt: number): number {
       }
     });
     this._devices.clear();
-    this._events = [];
+    this._events.clear();
+    this._adjointRecorder?.clear();
+    this._adjointRecorder = null;
+    this._dcJacobian = null;
+    this._reducedSystem = null;
     this._state = SimulationState.IDLE;
   }
 }
\ No newline at end of file
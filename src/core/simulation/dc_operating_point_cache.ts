@@ -0,0 +1,143 @@
+/**
+ * 💾 DC 工作点缓存 - AkingSPICE 2.1
+ *
+ * 以网表内容哈希为键，持久化已收敛的 DC 解与器件工作模式：
+ * - 键只覆盖元件、模型与 .PARAM 参数，与 .TRAN 等分析命令、注释、行号无关
+ * - 命中时作为初值，引擎以一次 Newton 迭代验证；验证失败才继续迭代或回退同伦
+ * - 内存 + 磁盘两级存储，磁盘写入先写临时文件再原子重命名
+ *
+ * 📋 用法：
+ *   const cache = new DCOperatingPointCache('.akingspice-cache');
+ *   engine.setOperatingPointCache(cache, DCOperatingPointCache.hashNetlist(netlist));
+ */
+
+import { createHash } from 'crypto';
+import { existsSync, mkdirSync, readFileSync, renameSync, writeFileSync } from 'fs';
+import { join } from 'path';
+import type { ParsedNetlist } from '../parser/spice_netlist_parser';
+import type { DeviceStateSnapshot } from '../devices/intelligent_device_model';
+
+/**
+ * 缓存条目
+ */
+export interface DCCacheEntry {
+  readonly version: number;
+  readonly key: string;
+
+  /** 完整解向量 (含额外变数) */
+  readonly solution: readonly number[];
+
+  /** 器件名 -> 工作模式与内部状态 */
+  readonly deviceStates: Readonly<Record<string, DeviceStateSnapshot>>;
+}
+
+/**
+ * 💾 DC 工作点缓存
+ */
+export class DCOperatingPointCache {
+  /** 条目格式版本，格式变化时旧条目自动失效 */
+  static readonly FORMAT_VERSION = 1;
+
+  private readonly _memory = new Map<string, DCCacheEntry>();
+  private _hits = 0;
+  private _misses = 0;
+
+  /**
+   * @param _directory 磁盘缓存目录 (null 时仅使用内存)
+   */
+  constructor(private readonly _directory: string | null = null) {}
+
+  /**
+   * 🔑 计算网表内容哈希 (SHA-256)
+   *
+   * 元件顺序决定解向量布局，因此按网表顺序参与哈希；
+   * 参数与模型按名称排序，与书写顺序无关。
+   */
+  static hashNetlist(netlist: ParsedNetlist): string {
+    const sortedEntries = <V>(map: Map<string, V>): [string, V][] =>
+      Array.from(map.entries()).sort(([a], [b]) => (a < b ? -1 : a > b ? 1 : 0));
+
+    const canonical = {
+      version: DCOperatingPointCache.FORMAT_VERSION,
+      elements: netlist.elements.map(element => [
+        element.type,
+        element.name,
+        element.nodes,
+        element.value ?? null,
+        element.modelName ?? null,
+        sortedEntries(element.parameters)
+      ]),
+      models: sortedEntries(netlist.models).map(([name, model]) => [
+        name,
+        model.type,
+        model.level ?? null,
+        sortedEntries(model.parameters)
+      ]),
+      parameters: sortedEntries(netlist.parameters)
+    };
+
+    return createHash('sha256').update(JSON.stringify(canonical)).digest('hex');
+  }
+
+  /**
+   * 📥 读取条目 (未命中或格式不符返回 null)
+   */
+  load(key: string): DCCacheEntry | null {
+    let entry = this._memory.get(key) ?? null;
+
+    if (!entry && this._directory) {
+      const file = this._filePath(key);
+      if (existsSync(file)) {
+        try {
+          const parsed = JSON.parse(readFileSync(file, 'utf8')) as DCCacheEntry;
+          if (parsed.version === DCOperatingPointCache.FORMAT_VERSION && parsed.key === key) {
+            entry = parsed;
+            this._memory.set(key, entry);
+          }
+        } catch {
+          // 损坏的条目视为未命中，下次写入时覆盖
+          entry = null;
+        }
+      }
+    }
+
+    if (entry) {
+      this._hits++;
+    } else {
+      this._misses++;
+    }
+    return entry;
+  }
+
+  /**
+   * 📤 写入条目
+   */
+  store(key: string, solution: readonly number[], deviceStates: Readonly<Record<string, DeviceStateSnapshot>>): void {
+    const entry: DCCacheEntry = {
+      version: DCOperatingPointCache.FORMAT_VERSION,
+      key,
+      solution: [...solution],
+      deviceStates
+    };
+    this._memory.set(key, entry);
+
+    if (this._directory) {
+      mkdirSync(this._directory, { recursive: true });
+      const file = this._filePath(key);
+      const temporary = `${file}.${process.pid}.tmp`;
+      writeFileSync(temporary, JSON.stringify(entry));
+      renameSync(temporary, file);
+    }
+  }
+
+  /**
+   * 📊 命中统计
+   */
+  getStatistics(): { hits: number; misses: number; entries: number } {
+    return { hits: this._hits, misses: this._misses, entries: this._memory.size };
+  }
+
+  private _filePath(key: string): string {
+    return join(this._directory!, `${key}.json`);
+  }
+}
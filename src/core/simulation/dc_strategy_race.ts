@@ -0,0 +1,253 @@
+/**
+ * 🏁 DC 同伦策略并行竞速 - AkingSPICE 2.1
+ *
+ * 顺序回退链 (Gmin → 源步进 → Newton) 中，先尝试的策略失败时其耗时全部浪费。
+ * 本模块把各策略 (含伪瞬态连续) 同时放到 worker 线程中运行：
+ * - 每个 worker 独立解析网表、只执行一种 dcStrategy
+ * - 第一个收敛的工作点胜出，其余 worker 立即终止
+ * - 胜出的完整解可交给 engine.setInitialGuess()，后续仿真热启动一次 Newton 即收敛
+ *
+ * 找不到编译后的 worker 脚本时 (如直接运行 TS 源码) 退化为进程内执行：
+ * 单线程上 Newton 迭代不让出事件循环，因此各策略按顺序运行，首个收敛的策略胜出，
+ * 超时只在策略之间检查。
+ */
+
+import { existsSync } from 'fs';
+import { join } from 'path';
+import { Worker } from 'worker_threads';
+import { SpiceNetlistParser } from '../parser/spice_netlist_parser';
+import { CircuitSimulationEngine } from './circuit_simulation_engine';
+import type { DCStrategy, SimulationConfig } from './circuit_simulation_engine';
+
+/** 参与竞速的策略 ('auto' 即顺序回退链，不参与竞速) */
+export type RaceStrategy = Exclude<DCStrategy, 'auto'>;
+
+/**
+ * 单个策略任务 (作为 workerData 传给 worker)
+ */
+export interface DCStrategyTask {
+  readonly netlist: string;
+  readonly strategy: RaceStrategy;
+  readonly simulation: Partial<SimulationConfig>;
+}
+
+/**
+ * 单个策略的执行结果
+ */
+export interface DCStrategyOutcome {
+  readonly strategy: RaceStrategy;
+  readonly success: boolean;
+
+  /** 节点名 -> DC 工作点电压 */
+  readonly operatingPoint: Map<string, number>;
+
+  /** 完整解向量 (含额外变数)，可作为热启动初值 */
+  readonly solution: number[] | null;
+
+  readonly elapsed: number; // ms
+  readonly errorMessage?: string;
+}
+
+/**
+ * 竞速配置
+ */
+export interface DCRaceOptions {
+  /** 参与竞速的策略 (默认全部四种) */
+  readonly strategies?: readonly RaceStrategy[];
+
+  /** 单次仿真配置 (endTime 与 dcStrategy 由竞速器覆盖) */
+  readonly simulation?: Partial<SimulationConfig>;
+
+  /** 执行方式 (默认：worker 脚本存在时用 workers，否则 inline) */
+  readonly mode?: 'workers' | 'inline';
+
+  /** worker 脚本路径 (默认为编译输出中的 dc_strategy_worker.js) */
+  readonly workerScript?: string;
+
+  /** 超时 (ms)：workers 模式下到时终止全部 worker；inline 模式只在策略之间检查 */
+  readonly timeout?: number;
+}
+
+/**
+ * 竞速结果
+ */
+export interface DCRaceResult {
+  readonly success: boolean;
+  readonly winner: RaceStrategy | null;
+  readonly operatingPoint: Map<string, number>;
+  readonly solution: readonly number[] | null;
+
+  /** 取消前已完成的尝试 (按完成顺序) */
+  readonly outcomes: readonly DCStrategyOutcome[];
+
+  readonly totalTime: number; // ms
+}
+
+const DEFAULT_STRATEGIES: readonly RaceStrategy[] = ['gmin', 'source', 'newton', 'ptc'];
+
+/**
+ * 🏁 DC 策略竞速器
+ */
+export class DCStrategyRace {
+  constructor(private readonly _netlist: string) {}
+
+  /**
+   * 🚀 执行全部策略 (workers 模式并行)，返回第一个收敛的工作点
+   */
+  run(options: DCRaceOptions = {}): Promise<DCRaceResult> {
+    const startTime = performance.now();
+    const strategies = options.strategies ?? DEFAULT_STRATEGIES;
+    if (strategies.length === 0) {
+      throw new Error('DC strategy race requires at least one strategy');
+    }
+
+    const workerScript = options.workerScript ?? DCStrategyRace.defaultWorkerScript();
+    const mode = options.mode ?? (workerScript && existsSync(workerScript) ? 'workers' : 'inline');
+    if (mode === 'workers' && !workerScript) {
+      throw new Error('DC strategy race: worker script not found');
+    }
+
+    const simulation = options.simulation ?? {};
+    if (mode === 'inline') {
+      return this._runSequentially(strategies, simulation, options.timeout, startTime);
+    }
+
+    return new Promise<DCRaceResult>(resolve => {
+      const outcomes: DCStrategyOutcome[] = [];
+      const workers: Worker[] = [];
+      let pending = strategies.length;
+      let settled = false;
+      let timer: ReturnType<typeof setTimeout> | undefined;
+
+      const finish = (winner: DCStrategyOutcome | null): void => {
+        if (settled) return;
+        settled = true;
+        if (timer !== undefined) clearTimeout(timer);
+        workers.forEach(worker => void worker.terminate());
+        resolve(DCStrategyRace._result(winner, outcomes, startTime));
+      };
+
+      const onOutcome = (outcome: DCStrategyOutcome): void => {
+        if (settled) return;
+        outcomes.push(outcome);
+        if (outcome.success) {
+          finish(outcome);
+        } else if (--pending === 0) {
+          finish(null);
+        }
+      };
+
+      if (options.timeout !== undefined) {
+        timer = setTimeout(() => finish(null), options.timeout);
+      }
+
+      for (const strategy of strategies) {
+        const task: DCStrategyTask = { netlist: this._netlist, strategy, simulation };
+        const worker = new Worker(workerScript!, { workerData: task });
+        workers.push(worker);
+
+        // 每个 worker 只计一次：结果、异常或未回传结果就退出 (OOM、process.exit) 三者取先到者
+        let reported = false;
+        const report = (outcome: DCStrategyOutcome): void => {
+          if (reported) return;
+          reported = true;
+          onOutcome(outcome);
+        };
+        worker.once('message', (outcome: DCStrategyOutcome) => report(outcome));
+        worker.once('error', error => report(DCStrategyRace._failure(strategy, error, startTime)));
+        worker.once('exit', code => report(DCStrategyRace._failure(
+          strategy, new Error(`DC strategy worker exited with code ${code} before reporting`), startTime
+        )));
+      }
+    });
+  }
+
+  /**
+   * 🔧 执行单个策略 (worker 与 inline 模式共用)
+   */
+  static async runStrategy(task: DCStrategyTask): Promise<DCStrategyOutcome> {
+    const startTime = performance.now();
+    const parser = new SpiceNetlistParser();
+    const netlist = parser.parseNetlist(task.netlist);
+
+    const engine = new CircuitSimulationEngine({
+      ...task.simulation,
+      endTime: 0,
+      dcStrategy: task.strategy
+    });
+    engine.addDevices(parser.createDevicesFromNetlist(netlist));
+
+    const result = await engine.runSimulation();
+    const solution = result.success ? engine.getOperatingPoint() : null;
+
+    const operatingPoint = new Map<string, number>();
+    if (solution) {
+      for (const node of netlist.nodeList) {
+        const nodeIndex = engine.getNodeIdByName(node);
+        if (nodeIndex !== undefined) {
+          operatingPoint.set(node, solution.get(nodeIndex));
+        }
+      }
+    }
+
+    return {
+      strategy: task.strategy,
+      success: solution !== null,
+      operatingPoint,
+      solution: solution ? solution.toArray() : null,
+      elapsed: performance.now() - startTime,
+      ...(result.errorMessage !== undefined ? { errorMessage: result.errorMessage } : {})
+    };
+  }
+
+  /**
+   * 编译输出中与本模块同目录的 worker 脚本
+   */
+  static defaultWorkerScript(): string | null {
+    return typeof __dirname !== 'undefined' ? join(__dirname, 'dc_strategy_worker.js') : null;
+  }
+
+  /**
+   * 进程内按顺序执行，首个收敛的策略胜出
+   */
+  private async _runSequentially(
+    strategies: readonly RaceStrategy[],
+    simulation: Partial<SimulationConfig>,
+    timeout: number | undefined,
+    startTime: number
+  ): Promise<DCRaceResult> {
+    const outcomes: DCStrategyOutcome[] = [];
+    for (const strategy of strategies) {
+      if (timeout !== undefined && performance.now() - startTime >= timeout) break;
+      const outcome = await DCStrategyRace.runStrategy({ netlist: this._netlist, strategy, simulation })
+        .catch(error => DCStrategyRace._failure(strategy, error, startTime));
+      outcomes.push(outcome);
+      if (outcome.success) {
+        return DCStrategyRace._result(outcome, outcomes, startTime);
+      }
+    }
+    return DCStrategyRace._result(null, outcomes, startTime);
+  }
+
+  private static _result(winner: DCStrategyOutcome | null, outcomes: readonly DCStrategyOutcome[], startTime: number): DCRaceResult {
+    return {
+      success: winner !== null,
+      winner: winner?.strategy ?? null,
+      operatingPoint: winner?.operatingPoint ?? new Map(),
+      solution: winner?.solution ?? null,
+      outcomes,
+      totalTime: performance.now() - startTime
+    };
+  }
+
+  private static _failure(strategy: RaceStrategy, error: unknown, startTime: number): DCStrategyOutcome {
+    return {
+      strategy,
+      success: false,
+      operatingPoint: new Map(),
+      solution: null,
+      elapsed: performance.now() - startTime,
+      errorMessage: error instanceof Error ? error.message : String(error)
+    };
+  }
+}
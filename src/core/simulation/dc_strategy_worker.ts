@@ -0,0 +1,15 @@
+/**
+ * 🏁 DC 策略竞速 worker 入口
+ *
+ * 接收 DCStrategyTask (workerData)，执行单一 DC 策略后回传 DCStrategyOutcome。
+ * 由 DCStrategyRace 启动；胜负已分时被主线程直接终止。
+ */
+
+import { parentPort, workerData } from 'worker_threads';
+import { DCStrategyRace } from './dc_strategy_race';
+import type { DCStrategyTask } from './dc_strategy_race';
+
+const task = workerData as DCStrategyTask;
+
+// 未捕获的异常会以 'error' 事件通知主线程
+void DCStrategyRace.runStrategy(task).then(outcome => parentPort?.postMessage(outcome));
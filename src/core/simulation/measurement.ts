@@ -0,0 +1,473 @@
+/**
+ * 📏 在线 .MEAS 测量 - AkingSPICE 2.1
+ *
+ * 在瞬态步进循环中逐段累积标量结果，无需保存完整波形：
+ * - 窗口类 (AVG/RMS/MIN/MAX/PP/INTEG)：相邻样本之间按线性段精确积分，窗口边界处线性裁剪
+ * - 过零类 (TRIG/TARG、WHEN)：线性插值定位第 n 次上升/下降/任意过零时刻
+ * - FIND ... AT：在 AT 时刻取值
+ *
+ * 引擎在每个接受步末尾调用 sample()，并在 breakpoints (FROM/TO/AT) 落入步内时
+ * 先以积分器的稠密输出插值补采样，使窗口边界与 AT 时刻精确对齐。
+ *
+ * differentiateMeasurement() 在记录的样本序列上重放同一语义并求梯度，供伴随灵敏度分析使用。
+ */
+
+import type { Time } from '../../types/index';
+import type { MeasureCrossing, MeasureDefinition } from '../parser/spice_netlist_parser';
+
+/**
+ * 需要精确采样的时刻 (落在仿真区间内的 FROM/TO/AT)，递增
+ */
+export function measurementBreakpoints(definitions: readonly MeasureDefinition[], startTime: Time, endTime: Time): Time[] {
+  const breakpoints = new Set<Time>();
+  for (const definition of definitions) {
+    for (const t of [definition.from, definition.to, definition.at]) {
+      if (t !== undefined && t > startTime && t < endTime) breakpoints.add(t);
+    }
+  }
+  return Array.from(breakpoints).sort((a, b) => a - b);
+}
+
+/**
+ * 过零检测器
+ */
+class CrossingDetector {
+  private _count = 0;
+  private _time: Time | null = null;
+
+  constructor(private readonly _spec: MeasureCrossing) {}
+
+  get time(): Time | null {
+    return this._time;
+  }
+
+  segment(t0: Time, v0: number, t1: Time, v1: number): void {
+    const spec = this._spec;
+    if (spec.count > 0 && this._count >= spec.count) return;
+
+    const rising = v0 < spec.value && v1 >= spec.value;
+    const falling = v0 > spec.value && v1 <= spec.value;
+    const matches = spec.edge === 'RISE' ? rising : spec.edge === 'FALL' ? falling : rising || falling;
+    if (!matches) return;
+
+    const crossing = t0 + (spec.value - v0) / (v1 - v0) * (t1 - t0);
+    if (crossing < spec.delay) return;
+
+    this._count++;
+    if (spec.count < 0 || this._count === spec.count) {
+      this._time = crossing;
+    }
+  }
+}
+
+/**
+ * 单个测量的累加状态
+ */
+class Measurement {
+  private readonly _from: Time;
+  private readonly _to: Time;
+  private _integral = 0;
+  private _squareIntegral = 0;
+  private _covered = 0;
+  private _min = Infinity;
+  private _max = -Infinity;
+  private _found: number | null = null;
+  private readonly _trigger: CrossingDetector | null;
+  private readonly _target: CrossingDetector | null;
+
+  constructor(readonly definition: MeasureDefinition, startTime: Time, endTime: Time) {
+    this._from = definition.from ?? startTime;
+    this._to = definition.to ?? endTime;
+    this._trigger = definition.trigger ? new CrossingDetector(definition.trigger) : null;
+    this._target = definition.target ? new CrossingDetector(definition.target) : null;
+  }
+
+  /** 窗口内的单点 (首个样本) */
+  point(t: Time, v: number): void {
+    if (t >= this._from && t <= this._to) {
+      this._extremes(v);
+    }
+    if (this.definition.kind === 'FIND' && t === this.definition.at) {
+      this._found = v;
+    }
+  }
+
+  /** 样本 (t0, v0) → (t1, v1) 之间的线性段 */
+  segment(t0: Time, v0: number, t1: Time, v1: number): void {
+    const kind = this.definition.kind;
+    if (kind === 'FIND') {
+      const at = this.definition.at!;
+      if (at > t0 && at <= t1) {
+        this._found = v0 + (v1 - v0) * (at - t0) / (t1 - t0);
+      }
+      return;
+    }
+
+    const lo = Math.max(t0, this._from);
+    const hi = Math.min(t1, this._to);
+    if (hi < lo) return;
+
+    const slope = (v1 - v0) / (t1 - t0);
+    const a = v0 + slope * (lo - t0);
+    const b = v0 + slope * (hi - t0);
+    const width = hi - lo;
+    this._integral += 0.5 * (a + b) * width;
+    this._squareIntegral += (a * a + a * b + b * b) / 3 * width;
+    this._covered += width;
+    this._extremes(a);
+    this._extremes(b);
+  }
+
+  crossing(signalIndex: 0 | 1, t0: Time, v0: number, t1: Time, v1: number): void {
+    (signalIndex === 0 ? this._trigger : this._target)?.segment(t0, v0, t1, v1);
+  }
+
+  result(): number | null {
+    switch (this.definition.kind) {
+      case 'AVG':
+        return this._covered > 0 ? this._integral / this._covered : null;
+      case 'RMS':
+        return this._covered > 0 ? Math.sqrt(this._squareIntegral / this._covered) : null;
+      case 'INTEG':
+        return this._covered > 0 ? this._integral : null;
+      case 'MIN':
+        return this._min <= this._max ? this._min : null;
+      case 'MAX':
+        return this._min <= this._max ? this._max : null;
+      case 'PP':
+        return this._min <= this._max ? this._max - this._min : null;
+      case 'FIND':
+        return this._found;
+      case 'WHEN':
+        return this._trigger?.time ?? null;
+      case 'TRIG_TARG': {
+        const trig = this._trigger?.time ?? null;
+        const targ = this._target?.time ?? null;
+        return trig !== null && targ !== null ? targ - trig : null;
+      }
+    }
+  }
+
+  private _extremes(v: number): void {
+    if (v < this._min) this._min = v;
+    if (v > this._max) this._max = v;
+  }
+}
+
+/**
+ * 📏 测量集合
+ *
+ * 信号值由引擎提供的读取函数从解向量中取出，每个信号每个样本只读取一次。
+ */
+export class MeasurementSet<TSolution> {
+  private readonly _measurements: Measurement[];
+  private readonly _signals: string[] = [];
+  private readonly _readers: ((solution: TSolution) => number)[];
+  private readonly _breakpoints: Time[];
+
+  // 每个测量用到的信号下标：[主信号, TRIG/WHEN 信号, TARG 信号]
+  private readonly _bindings: { main: number; trigger: number; target: number }[];
+
+  private _previousTime: Time | null = null;
+  private _previousValues: Float64Array;
+  private _values: Float64Array;
+
+  /**
+   * @param resolve 信号名 -> 解向量读取函数 (未知信号应抛出错误)
+   */
+  constructor(
+    definitions: readonly MeasureDefinition[],
+    startTime: Time,
+    endTime: Time,
+    resolve: (signal: string) => (solution: TSolution) => number
+  ) {
+    const signalIndex = (signal: string | undefined): number => {
+      if (signal === undefined) return -1;
+      let index = this._signals.indexOf(signal);
+      if (index < 0) {
+        index = this._signals.length;
+        this._signals.push(signal);
+      }
+      return index;
+    };
+
+    this._measurements = definitions.map(definition => new Measurement(definition, startTime, endTime));
+    this._bindings = definitions.map(definition => ({
+      main: signalIndex(definition.signal),
+      trigger: signalIndex(definition.trigger?.signal),
+      target: signalIndex(definition.target?.signal)
+    }));
+    this._readers = this._signals.map(signal => resolve(signal));
+    this._previousValues = new Float64Array(this._signals.length);
+    this._values = new Float64Array(this._signals.length);
+
+    this._breakpoints = measurementBreakpoints(definitions, startTime, endTime);
+  }
+
+  /** 需要精确采样的时刻 (FROM/TO/AT)，递增 */
+  get breakpoints(): readonly Time[] {
+    return this._breakpoints;
+  }
+
+  /** 涉及的信号名 */
+  get signals(): readonly string[] {
+    return this._signals;
+  }
+
+  /**
+   * ➕ 追加一个样本 (时间须严格递增；相同时间的样本被忽略)
+   */
+  sample(time: Time, solution: TSolution): void {
+    if (this._previousTime !== null && time <= this._previousTime) return;
+
+    const values = this._values;
+    for (let i = 0; i < this._readers.length; i++) {
+      values[i] = this._readers[i]!(solution);
+    }
+
+    const t0 = this._previousTime;
+    const previous = this._previousValues;
+    this._measurements.forEach((measurement, m) => {
+      const { main, trigger, target } = this._bindings[m]!;
+      if (t0 === null) {
+        if (main >= 0) measurement.point(time, values[main]!);
+        return;
+      }
+      if (main >= 0) measurement.segment(t0, previous[main]!, time, values[main]!);
+      if (trigger >= 0) measurement.crossing(0, t0, previous[trigger]!, time, values[trigger]!);
+      if (target >= 0) measurement.crossing(1, t0, previous[target]!, time, values[target]!);
+    });
+
+    this._previousTime = time;
+    this._values = previous;
+    this._previousValues = values;
+  }
+
+  /**
+   * 📊 当前结果 (条件未满足的测量为 null)
+   */
+  results(): Map<string, number | null> {
+    const results = new Map<string, number | null>();
+    for (const measurement of this._measurements) {
+      results.set(measurement.definition.name, measurement.result());
+    }
+    return results;
+  }
+}
+
+/**
+ * 📐 测量结果及其对样本信号值的梯度
+ */
+export interface MeasurementGradient {
+  readonly value: number;
+
+  /** 信号名 -> ∂result/∂(各样本的信号值) */
+  readonly gradients: Map<string, Float64Array>;
+}
+
+/**
+ * 📐 在样本序列上重放测量并求梯度 (伴随灵敏度的输出种子)
+ *
+ * 与在线测量相同的分段线性语义：样本时间视为常数，
+ * 窗口积分与极值对端点值求导，过零时刻经线性插值对相邻两个样本求导。
+ *
+ * @param times 严格递增的样本时间
+ * @param values 信号名 -> 各样本的值
+ * @returns 条件未满足时为 null
+ */
+export function differentiateMeasurement(
+  definition: MeasureDefinition,
+  startTime: Time,
+  endTime: Time,
+  times: ArrayLike<number>,
+  values: (signal: string) => ArrayLike<number>
+): MeasurementGradient | null {
+  const count = times.length;
+  const gradients = new Map<string, Float64Array>();
+  const gradient = (signal: string): Float64Array => {
+    let g = gradients.get(signal);
+    if (!g) {
+      g = new Float64Array(count);
+      gradients.set(signal, g);
+    }
+    return g;
+  };
+
+  switch (definition.kind) {
+    case 'FIND': {
+      const v = values(definition.signal!);
+      const at = definition.at!;
+      if (count > 0 && times[0] === at) {
+        gradient(definition.signal!)[0] = 1;
+        return { value: v[0]!, gradients };
+      }
+      for (let k = 1; k < count; k++) {
+        const t0 = times[k - 1]!;
+        const t1 = times[k]!;
+        if (at > t0 && at <= t1) {
+          const theta = (at - t0) / (t1 - t0);
+          const g = gradient(definition.signal!);
+          g[k - 1] = 1 - theta;
+          g[k] = theta;
+          return { value: v[k - 1]! + (v[k]! - v[k - 1]!) * theta, gradients };
+        }
+      }
+      return null;
+    }
+
+    case 'WHEN':
+    case 'TRIG_TARG': {
+      const trigger = locateCrossing(definition.trigger!, times, values(definition.trigger!.signal));
+      if (!trigger) return null;
+      if (definition.kind === 'WHEN') {
+        applyCrossing(gradient(definition.trigger!.signal), trigger, 1);
+        return { value: trigger.time, gradients };
+      }
+      const target = locateCrossing(definition.target!, times, values(definition.target!.signal));
+      if (!target) return null;
+      applyCrossing(gradient(definition.trigger!.signal), trigger, -1);
+      applyCrossing(gradient(definition.target!.signal), target, 1);
+      return { value: target.time - trigger.time, gradients };
+    }
+
+    default:
+      return differentiateWindow(definition, startTime, endTime, times, values(definition.signal!), gradient(definition.signal!));
+  }
+}
+
+/** 样本 k-1、k 之间的过零时刻及其对两端信号值的偏导 */
+interface LocatedCrossing {
+  readonly time: Time;
+  readonly index: number;
+  readonly d0: number;
+  readonly d1: number;
+}
+
+function locateCrossing(spec: MeasureCrossing, times: ArrayLike<number>, v: ArrayLike<number>): LocatedCrossing | null {
+  let found: LocatedCrossing | null = null;
+  let crossings = 0;
+  for (let k = 1; k < times.length; k++) {
+    const v0 = v[k - 1]!;
+    const v1 = v[k]!;
+    const rising = v0 < spec.value && v1 >= spec.value;
+    const falling = v0 > spec.value && v1 <= spec.value;
+    const matches = spec.edge === 'RISE' ? rising : spec.edge === 'FALL' ? falling : rising || falling;
+    if (!matches) continue;
+
+    const t0 = times[k - 1]!;
+    const span = times[k]! - t0;
+    const time = t0 + (spec.value - v0) / (v1 - v0) * span;
+    if (time < spec.delay) continue;
+
+    crossings++;
+    if (spec.count < 0 || crossings === spec.count) {
+      const denominator = (v1 - v0) * (v1 - v0);
+      found = { time, index: k, d0: span * (spec.value - v1) / denominator, d1: span * (v0 - spec.value) / denominator };
+      if (spec.count > 0) break;
+    }
+  }
+  return found;
+}
+
+function applyCrossing(g: Float64Array, crossing: LocatedCrossing, sign: number): void {
+  g[crossing.index - 1]! += sign * crossing.d0;
+  g[crossing.index]! += sign * crossing.d1;
+}
+
+/** 极值点 [值, k0, w0, k1, w1]：值 = w0·v[k0] + w1·v[k1] */
+type Extreme = readonly [number, number, number, number, number];
+
+/** 窗口类测量 (AVG/RMS/INTEG/MIN/MAX/PP) */
+function differentiateWindow(
+  definition: MeasureDefinition,
+  startTime: Time,
+  endTime: Time,
+  times: ArrayLike<number>,
+  v: ArrayLike<number>,
+  g: Float64Array
+): MeasurementGradient | null {
+  const count = times.length;
+  const from = definition.from ?? startTime;
+  const to = definition.to ?? endTime;
+  const dIntegral = new Float64Array(count);
+  const dSquare = new Float64Array(count);
+  let integral = 0;
+  let square = 0;
+  let covered = 0;
+
+  const extreme: { min: Extreme | null; max: Extreme | null } = { min: null, max: null };
+  const extremes = (value: number, k0: number, w0: number, k1: number, w1: number): void => {
+    if (!extreme.min || value < extreme.min[0]) extreme.min = [value, k0, w0, k1, w1];
+    if (!extreme.max || value > extreme.max[0]) extreme.max = [value, k0, w0, k1, w1];
+  };
+
+  if (count > 0 && times[0]! >= from && times[0]! <= to) {
+    extremes(v[0]!, 0, 1, 0, 0);
+  }
+  for (let k = 1; k < count; k++) {
+    const t0 = times[k - 1]!;
+    const t1 = times[k]!;
+    const lo = Math.max(t0, from);
+    const hi = Math.min(t1, to);
+    if (hi < lo) continue;
+
+    const v0 = v[k - 1]!;
+    const slope = (v[k]! - v0) / (t1 - t0);
+    const a = v0 + slope * (lo - t0);
+    const b = v0 + slope * (hi - t0);
+    const alpha = (lo - t0) / (t1 - t0);
+    const beta = (hi - t0) / (t1 - t0);
+    const width = hi - lo;
+
+    integral += 0.5 * (a + b) * width;
+    dIntegral[k - 1]! += 0.5 * width * (2 - alpha - beta);
+    dIntegral[k]! += 0.5 * width * (alpha + beta);
+
+    square += (a * a + a * b + b * b) / 3 * width;
+    const da = (2 * a + b) / 3 * width;
+    const db = (a + 2 * b) / 3 * width;
+    dSquare[k - 1]! += da * (1 - alpha) + db * (1 - beta);
+    dSquare[k]! += da * alpha + db * beta;
+
+    covered += width;
+    extremes(a, k - 1, 1 - alpha, k, alpha);
+    extremes(b, k - 1, 1 - beta, k, beta);
+  }
+
+  const addExtreme = ([, k0, w0, k1, w1]: Extreme, sign: number): void => {
+    g[k0]! += sign * w0;
+    g[k1]! += sign * w1;
+  };
+  const gradients = new Map([[definition.signal!, g]]);
+
+  switch (definition.kind) {
+    case 'AVG':
+    case 'INTEG': {
+      if (covered <= 0) return null;
+      const scale = definition.kind === 'AVG' ? 1 / covered : 1;
+      for (let k = 0; k < count; k++) g[k] = dIntegral[k]! * scale;
+      return { value: integral * scale, gradients };
+    }
+    case 'RMS': {
+      if (covered <= 0) return null;
+      const rms = Math.sqrt(square / covered);
+      const scale = rms > 0 ? 1 / (2 * covered * rms) : 0;
+      for (let k = 0; k < count; k++) g[k] = dSquare[k]! * scale;
+      return { value: rms, gradients };
+    }
+    default: {
+      const { min: lowest, max: highest } = extreme;
+      if (!lowest || !highest) return null;
+      if (definition.kind === 'MIN') {
+        addExtreme(lowest, 1);
+        return { value: lowest[0], gradients };
+      }
+      addExtreme(highest, 1);
+      if (definition.kind === 'MAX') {
+        return { value: highest[0], gradients };
+      }
+      addExtreme(lowest, -1);
+      return { value: highest[0] - lowest[0], gradients };
+    }
+  }
+}
@@ -0,0 +1,340 @@
+/**
+ * 🎲 蒙特卡罗 / 角点分析 - AkingSPICE 2.1
+ *
+ * 对同一拓扑的大量参数变体进行批量仿真：
+ * - 网表只解析一次，每个样本只重建数值 (元件值、器件参数)
+ * - 所有样本共享稀疏模式、列排序与符号分解 (solverMode = 'klu')
+ * - 每个样本的 DC 工作点从标称解热启动，失败时才回退到同伦方法
+ *
+ * 📋 容差目标语法 (不区分大小写)：
+ *   R1        元件 R1 的值
+ *   R         所有电阻的值 (类型字母)
+ *   D1.IS     元件 D1 的参数 IS (实例参数优先，否则取 .MODEL 参数)
+ *   DMOD.IS   使用模型 DMOD 的所有元件的参数 IS
+ */
+
+import type { IVector } from '../../types/index';
+import type { SymbolicFactorization } from '../../math/sparse/sparse_lu';
+import { SpiceNetlistParser } from '../parser/spice_netlist_parser';
+import type { ParsedNetlist, NetlistElement } from '../parser/spice_netlist_parser';
+import { CircuitSimulationEngine } from './circuit_simulation_engine';
+import type { SimulationConfig } from './circuit_simulation_engine';
+
+/**
+ * 容差规格
+ */
+export interface ToleranceSpec {
+  /** 目标 (见文件头说明) */
+  readonly target: string;
+
+  /** 相对容差 (0.05 = ±5%)；高斯分布时视为 3σ */
+  readonly tolerance: number;
+
+  /** 分布类型 (默认 gaussian) */
+  readonly distribution?: 'gaussian' | 'uniform';
+}
+
+/**
+ * 蒙特卡罗配置
+ */
+export interface MonteCarloConfig {
+  /** 样本数量 */
+  readonly samples: number;
+
+  /** 随机种子 (相同种子得到相同样本序列) */
+  readonly seed?: number;
+
+  /** 容差列表 */
+  readonly tolerances: readonly ToleranceSpec[];
+
+  /** 记录的节点 (默认网表中的全部节点) */
+  readonly outputs?: readonly string[];
+
+  /** 单次仿真配置 (默认 endTime = 0，solverMode = 'klu') */
+  readonly simulation?: Partial<SimulationConfig>;
+}
+
+/**
+ * 角点定义：目标 -> 相对倍率 (如 { R: 1.05, 'D1.IS': 0.9 })
+ */
+export interface CornerDefinition {
+  readonly name: string;
+  readonly scale: Readonly<Record<string, number>>;
+}
+
+/**
+ * 单个样本结果
+ */
+export interface MonteCarloSample {
+  readonly index: number;
+  readonly name: string;
+  readonly success: boolean;
+
+  /** 实际使用的扰动值 (目标键 -> 数值) */
+  readonly parameters: Map<string, number>;
+
+  /** 节点名 -> DC 工作点电压 */
+  readonly operatingPoint: Map<string, number>;
+
+  /** 热启动失败、回退到同伦方法 */
+  readonly homotopyFallback: boolean;
+
+  readonly errorMessage?: string;
+}
+
+/**
+ * 输出统计量
+ */
+export interface MonteCarloStatistics {
+  readonly mean: number;
+  readonly stdDev: number;
+  readonly min: number;
+  readonly max: number;
+}
+
+/**
+ * 蒙特卡罗 / 角点分析结果
+ */
+export interface MonteCarloResult {
+  readonly nominal: MonteCarloSample;
+  readonly samples: readonly MonteCarloSample[];
+  readonly statistics: Map<string, MonteCarloStatistics>;
+  readonly failedSamples: number;
+  readonly totalTime: number; // ms
+}
+
+/**
+ * 🎲 蒙特卡罗 / 角点分析驱动
+ */
+export class MonteCarloAnalysis {
+  private _symbolic: SymbolicFactorization | null = null;
+  private _nominalSolution: IVector | null = null;
+
+  constructor(
+    private readonly _netlist: ParsedNetlist,
+    private readonly _parser: SpiceNetlistParser = new SpiceNetlistParser()
+  ) {}
+
+  /**
+   * 🚀 执行蒙特卡罗分析
+   */
+  async run(config: MonteCarloConfig): Promise<MonteCarloResult> {
+    if (config.samples < 0 || !Number.isInteger(config.samples)) {
+      throw new Error(`Invalid Monte Carlo sample count: ${config.samples}`);
+    }
+    const startTime = performance.now();
+    const random = MonteCarloAnalysis.createRandom(config.seed ?? 1);
+    const outputs = config.outputs ?? this._netlist.nodeList;
+
+    const nominal = await this._runNominal(outputs, config.simulation);
+    const samples: MonteCarloSample[] = [];
+
+    for (let i = 0; i < config.samples; i++) {
+      const factors = new Map<string, number>();
+      for (const spec of config.tolerances) {
+        factors.set(spec.target.toUpperCase(), MonteCarloAnalysis._drawFactor(spec, random));
+      }
+      samples.push(await this._runSample(i + 1, `mc${i + 1}`, factors, outputs, config.simulation));
+    }
+
+    return this._buildResult(nominal, samples, outputs, startTime);
+  }
+
+  /**
+   * 📐 执行角点分析
+   */
+  async runCorners(
+    corners: readonly CornerDefinition[],
+    options: Pick<MonteCarloConfig, 'outputs' | 'simulation'> = {}
+  ): Promise<MonteCarloResult> {
+    const startTime = performance.now();
+    const outputs = options.outputs ?? this._netlist.nodeList;
+
+    const nominal = await this._runNominal(outputs, options.simulation);
+    const samples: MonteCarloSample[] = [];
+
+    for (let i = 0; i < corners.length; i++) {
+      const corner = corners[i]!;
+      const factors = new Map<string, number>();
+      for (const [target, scale] of Object.entries(corner.scale)) {
+        factors.set(target.toUpperCase(), scale);
+      }
+      samples.push(await this._runSample(i + 1, corner.name, factors, outputs, options.simulation));
+    }
+
+    return this._buildResult(nominal, samples, outputs, startTime);
+  }
+
+  /**
+   * 🔢 可复现的伪随机数发生器 (mulberry32)，返回 [0, 1) 均匀分布
+   */
+  static createRandom(seed: number): () => number {
+    let state = seed >>> 0;
+    return () => {
+      state = (state + 0x6D2B79F5) >>> 0;
+      let t = state;
+      t = Math.imul(t ^ (t >>> 15), t | 1);
+      t ^= t + Math.imul(t ^ (t >>> 7), t | 61);
+      return ((t ^ (t >>> 14)) >>> 0) / 4294967296;
+    };
+  }
+
+  // === 私有方法 ===
+
+  /**
+   * 标称仿真：求出热启动初值与共享的符号分解
+   */
+  private async _runNominal(
+    outputs: readonly string[],
+    simulation: Partial<SimulationConfig> | undefined
+  ): Promise<MonteCarloSample> {
+    this._symbolic = null;
+    this._nominalSolution = null;
+    return this._runSample(0, 'nominal', new Map(), outputs, simulation);
+  }
+
+  private async _runSample(
+    index: number,
+    name: string,
+    factors: Map<string, number>,
+    outputs: readonly string[],
+    simulation: Partial<SimulationConfig> | undefined
+  ): Promise<MonteCarloSample> {
+    const parameters = new Map<string, number>();
+    const elements = this._netlist.elements.map(element => this._perturbElement(element, factors, parameters));
+    const devices = this._parser.createDevicesFromNetlist({ ...this._netlist, elements });
+
+    const engine = new CircuitSimulationEngine({
+      endTime: 0,
+      solverMode: 'klu',
+      ...simulation
+    });
+    engine.addDevices(devices);
+    engine.setSymbolicFactorization(this._symbolic);
+    if (this._nominalSolution) {
+      engine.setInitialGuess(this._nominalSolution);
+    }
+
+    const result = await engine.runSimulation();
+    const solution = engine.getOperatingPoint();
+
+    // 第一个成功的样本 (标称) 提供后续样本共享的符号分解与初值
+    if (result.success && solution && !this._nominalSolution) {
+      this._nominalSolution = solution;
+      this._symbolic = engine.getSymbolicFactorization();
+    }
+
+    const operatingPoint = new Map<string, number>();
+    if (solution) {
+      for (const node of outputs) {
+        const nodeIndex = engine.getNodeIdByName(node);
+        if (nodeIndex !== undefined) {
+          operatingPoint.set(node, solution.get(nodeIndex));
+        }
+      }
+    }
+
+    const homotopyFallback = index > 0 && engine.isWarmStartFailed();
+
+    return {
+      index,
+      name,
+      success: result.success,
+      parameters,
+      operatingPoint,
+      homotopyFallback,
+      ...(result.errorMessage !== undefined ? { errorMessage: result.errorMessage } : {})
+    };
+  }
+
+  /**
+   * 按容差目标生成扰动后的元件 (未命中的元件原样返回)
+   */
+  private _perturbElement(
+    element: NetlistElement,
+    factors: Map<string, number>,
+    applied: Map<string, number>
+  ): NetlistElement {
+    if (factors.size === 0) return element;
+
+    const name = element.name.toUpperCase();
+    let result = element;
+
+    // 1. 元件值：元件名优先于类型字母
+    const valueFactor = factors.get(name) ?? factors.get(element.type);
+    if (valueFactor !== undefined && typeof element.value === 'number') {
+      const value = element.value * valueFactor;
+      result = { ...result, value };
+      applied.set(name, value);
+    }
+
+    // 2. 器件参数：NAME.PARAM 或 MODEL.PARAM
+    let parameters: Map<string, string | number> | null = null;
+    const model = element.modelName ? this._netlist.models.get(element.modelName) : undefined;
+    for (const [target, factor] of factors) {
+      const dot = target.indexOf('.');
+      if (dot <= 0) continue;
+      const owner = target.substring(0, dot);
+      const param = target.substring(dot + 1);
+      if (owner !== name && owner !== element.modelName) continue;
+
+      const base = element.parameters.get(param) ?? model?.parameters.get(param);
+      if (typeof base !== 'number') continue;
+
+      parameters ??= new Map(element.parameters);
+      const value = base * factor;
+      parameters.set(param, value);
+      applied.set(`${name}.${param}`, value);
+    }
+    if (parameters) {
+      result = { ...result, parameters };
+    }
+
+    return result;
+  }
+
+  private static _drawFactor(spec: ToleranceSpec, random: () => number): number {
+    if (spec.distribution === 'uniform') {
+      return 1 + spec.tolerance * (2 * random() - 1);
+    }
+    // Box-Muller，容差对应 3σ
+    const u1 = Math.max(random(), Number.MIN_VALUE);
+    const u2 = random();
+    const z = Math.sqrt(-2 * Math.log(u1)) * Math.cos(2 * Math.PI * u2);
+    return 1 + (spec.tolerance / 3) * z;
+  }
+
+  private _buildResult(
+    nominal: MonteCarloSample,
+    samples: readonly MonteCarloSample[],
+    outputs: readonly string[],
+    startTime: number
+  ): MonteCarloResult {
+    const statistics = new Map<string, MonteCarloStatistics>();
+    const succeeded = samples.filter(sample => sample.success);
+
+    for (const node of outputs) {
+      const values = succeeded
+        .map(sample => sample.operatingPoint.get(node))
+        .filter((value): value is number => value !== undefined);
+      if (values.length === 0) continue;
+
+      const mean = values.reduce((sum, v) => sum + v, 0) / values.length;
+      const variance = values.reduce((sum, v) => sum + (v - mean) * (v - mean), 0) / Math.max(values.length - 1, 1);
+      statistics.set(node, {
+        mean,
+        stdDev: Math.sqrt(variance),
+        min: Math.min(...values),
+        max: Math.max(...values)
+      });
+    }
+
+    return {
+      nominal,
+      samples,
+      statistics,
+      failedSamples: samples.length - succeeded.length,
+      totalTime: performance.now() - startTime
+    };
+  }
+}
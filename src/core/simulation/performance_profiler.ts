@@ -0,0 +1,86 @@
+/**
+ * ⏱️ 仿真性能剖析 - AkingSPICE 2.1
+ *
+ * 为 PerformanceMetrics 提供单调计时 (performance.now) 与堆内存采样：
+ * - 启用时各阶段以 begin()/end() 包围，耗时 (毫秒) 累加到对应字段
+ * - 禁用时 begin() 返回 0、end() 立即返回，不调用计时器，开销仅一次分支
+ * - 矩阵分解/求解的计时与计数由 SparseMatrix.statistics 提供，运行结束时汇总
+ */
+
+import type { PerformanceMetrics } from './circuit_simulation_engine';
+
+/**
+ * 由剖析器直接计时的阶段 (PerformanceMetrics 中的毫秒字段)
+ */
+export type ProfiledPhase =
+  | 'matrixAssemblyTime'
+  | 'deviceEvaluationTime'
+  | 'convergenceCheckTime'
+  | 'eventDetectionTime'
+  | 'waveformSaveTime';
+
+/**
+ * 创建全零的性能指标
+ */
+export function createPerformanceMetrics(): PerformanceMetrics {
+  return {
+    totalSimulationTime: 0,
+    matrixAssemblyTime: 0,
+    matrixFactorizationTime: 0,
+    matrixSolutionTime: 0,
+    deviceEvaluationTime: 0,
+    convergenceCheckTime: 0,
+    eventDetectionTime: 0,
+    waveformSaveTime: 0,
+    memoryPeakUsage: 0,
+    heapPeakUsage: 0,
+    averageIterationsPerStep: 0,
+    failedSteps: 0,
+    adaptiveStepChanges: 0,
+    newtonIterations: 0,
+    matrixFactorizations: 0,
+    matrixRefactorizations: 0
+  };
+}
+
+export class PerformanceProfiler {
+  constructor(
+    private readonly _metrics: PerformanceMetrics,
+    readonly enabled: boolean
+  ) {}
+
+  /** 开始计时 (禁用时返回 0) */
+  begin(): number {
+    return this.enabled ? performance.now() : 0;
+  }
+
+  /**
+   * 结束计时并累加到 phase，返回计入的毫秒数
+   * @param excluded - 期间已计入其他阶段的耗时 (嵌套阶段不重复计算)
+   */
+  end(phase: ProfiledPhase, start: number, excluded: number = 0): number {
+    if (!this.enabled) return 0;
+    const elapsed = performance.now() - start - excluded;
+    this._metrics[phase] += elapsed;
+    return elapsed;
+  }
+
+  /** 采样 JS 堆使用量并更新峰值 */
+  sampleHeap(): void {
+    if (!this.enabled) return;
+    const bytes = heapUsedBytes();
+    this._metrics.heapPeakUsage = Math.max(this._metrics.heapPeakUsage, bytes / (1024 * 1024));
+  }
+}
+
+/**
+ * 当前 JS 堆使用量 (字节)：Node 取 process.memoryUsage()，浏览器取 performance.memory，均不可用时为 0
+ */
+export function heapUsedBytes(): number {
+  const runtime = globalThis as { process?: { memoryUsage?: () => { heapUsed: number } } };
+  if (typeof runtime.process?.memoryUsage === 'function') {
+    return runtime.process.memoryUsage().heapUsed;
+  }
+  const memory = (performance as Performance & { memory?: { usedJSHeapSize: number } }).memory;
+  return memory?.usedJSHeapSize ?? 0;
+}
@@ -0,0 +1,109 @@
+/**
+ * 📸 仿真检查点二进制格式 - AkingSPICE 2.1
+ *
+ * 长时间仿真的崩溃恢复与从稳态分叉 what-if 分支：
+ * - 状态对象中的标量与器件状态写入 JSON 头 (JS 数值的 JSON 表示可精确往返)
+ * - 其中的 Float64Array (解向量、积分器状态) 以小端 Float64 原样存储，恢复后逐位相同
+ *
+ * 布局：'AKCP' | u32 版本 | u32 头长度 | JSON 头 (补齐到 8 字节) | 向量数据
+ */
+
+const MAGIC = 'AKCP';
+const VERSION = 1;
+const PREAMBLE_BYTES = 12;
+
+// JSON 头中代替 Float64Array 的引用
+interface VectorReference {
+  readonly $vector: number;
+  readonly length: number;
+}
+
+const isVectorReference = (value: unknown): value is VectorReference =>
+  typeof value === 'object' && value !== null && '$vector' in value;
+
+export namespace SimulationCheckpoint {
+  /**
+   * 📦 编码为二进制 (state 须为可 JSON 化的对象，可含 Float64Array)
+   */
+  export function encode(state: object): Uint8Array {
+    const vectors: Float64Array[] = [];
+    const json = new TextEncoder().encode(JSON.stringify(state, (_key, value: unknown) => {
+      if (!(value instanceof Float64Array)) return value;
+      vectors.push(value);
+      return { $vector: vectors.length - 1, length: value.length };
+    }));
+    const headerBytes = align8(PREAMBLE_BYTES + json.length) - PREAMBLE_BYTES;
+    const dataOffset = PREAMBLE_BYTES + headerBytes;
+    const total = dataOffset + 8 * vectors.reduce((sum, values) => sum + values.length, 0);
+
+    const bytes = new Uint8Array(total);
+    const view = new DataView(bytes.buffer);
+    for (let i = 0; i < MAGIC.length; i++) bytes[i] = MAGIC.charCodeAt(i);
+    view.setUint32(4, VERSION, true);
+    view.setUint32(8, headerBytes, true);
+    bytes.set(json, PREAMBLE_BYTES);
+    bytes.fill(0x20, PREAMBLE_BYTES + json.length, dataOffset);
+
+    let offset = dataOffset;
+    for (const values of vectors) {
+      for (let i = 0; i < values.length; i++, offset += 8) {
+        view.setFloat64(offset, values[i]!, true);
+      }
+    }
+    return bytes;
+  }
+
+  /**
+   * 📦 从二进制解码 (格式或版本不符时抛出错误)
+   */
+  export function decode<TState>(bytes: Uint8Array): TState {
+    const view = new DataView(bytes.buffer, bytes.byteOffset, bytes.byteLength);
+    const magic = String.fromCharCode(...bytes.subarray(0, MAGIC.length));
+    if (bytes.byteLength < PREAMBLE_BYTES || magic !== MAGIC) {
+      throw new Error('Not a simulation checkpoint');
+    }
+    const version = view.getUint32(4, true);
+    if (version !== VERSION) {
+      throw new Error(`Unsupported checkpoint version: ${version}`);
+    }
+
+    const headerBytes = view.getUint32(8, true);
+    const json = new TextDecoder().decode(bytes.subarray(PREAMBLE_BYTES, PREAMBLE_BYTES + headerBytes));
+
+    // 向量按引用编号顺序连续存放，先收集引用再按序读取
+    const references: VectorReference[] = [];
+    const state = JSON.parse(json, (_key, value: unknown) => {
+      if (isVectorReference(value)) references.push(value);
+      return value;
+    }) as TState;
+    references.sort((a, b) => a.$vector - b.$vector);
+
+    const vectors: Float64Array[] = [];
+    let offset = PREAMBLE_BYTES + headerBytes;
+    for (const { length } of references) {
+      if (offset + 8 * length > bytes.byteLength) {
+        throw new Error('Truncated simulation checkpoint');
+      }
+      const values = new Float64Array(length);
+      for (let i = 0; i < length; i++, offset += 8) {
+        values[i] = view.getFloat64(offset, true);
+      }
+      vectors.push(values);
+    }
+    return resolveVectors(state, vectors) as TState;
+  }
+}
+
+// 将 JSON 头中的向量引用替换为已读取的 Float64Array
+function resolveVectors(value: unknown, vectors: readonly Float64Array[]): unknown {
+  if (isVectorReference(value)) return vectors[value.$vector];
+  if (Array.isArray(value)) return value.map(item => resolveVectors(item, vectors));
+  if (typeof value === 'object' && value !== null) {
+    const result: Record<string, unknown> = {};
+    for (const [key, item] of Object.entries(value)) result[key] = resolveVectors(item, vectors);
+    return result;
+  }
+  return value;
+}
+
+const align8 = (n: number): number => (n + 7) & ~7;
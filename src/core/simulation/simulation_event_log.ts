@@ -0,0 +1,133 @@
+/**
+ * 📒 仿真事件日志 - AkingSPICE 2.1
+ *
+ * 定长环形缓冲 (列式存储)，写满后覆盖最旧的事件：
+ * - 事件类型为整数枚举，记录时不做字符串拼接
+ * - 热路径事件 (如接受步) 只记录数值负载 value，描述为常量
+ * - getSimulationEvents() 读取时才物化为对象数组
+ */
+
+import type { Time } from '../../types/index';
+
+/**
+ * 仿真事件类型
+ */
+export enum SimulationEventType {
+  DEVICE_ADDED,
+  INFO,
+  INIT,
+  CHECKPOINT_SAVED,
+  CHECKPOINT_RESTORED,
+  SIMULATION_PAUSED,
+  SIMULATION_RESUMED,
+  SIMULATION_STOPPED,
+  DC_CONVERGED,
+  DC_FAILED,
+  DC_CACHE_HIT,
+  DC_CACHE_REJECTED,
+  DC_CACHE_STORE_FAILED,
+  DC_WARM_START_FAILED,
+  DC_NR_CONVERGED,
+  DC_NR_FAILED,
+  DC_NR_ABORTED,
+  DC_SOLVER_ERROR,
+  GMIN_STEP,
+  GMIN_STEP_FAILED,
+  SOURCE_STEP,
+  SOURCE_STEP_FAILED,
+  PTC_STEP,
+  PTC_STEP_FAILED,
+  DC_SWEEP,
+  DC_SWEEP_HOMOTOPY,
+  DC_SWEEP_FAILED,
+  STEP_ACCEPTED,
+  INTEGRATOR_FAILURE,
+  INTEGRATOR_FAILURE_TO_EVENT,
+  INTEGRATOR_RESTART,
+  FATAL,
+  MEMORY_WARNING,
+  PROBE_UNKNOWN
+}
+
+/**
+ * 仿真事件
+ */
+export interface SimulationEvent {
+  readonly time: Time;
+  readonly type: SimulationEventType;
+  readonly deviceId?: string | undefined;  // 明确允许undefined
+  readonly description: string;
+  readonly value: number;                  // 数值负载 (如接受步的下一步长)，无则为 NaN
+}
+
+export class SimulationEventLog {
+  readonly capacity: number;
+  private readonly _type: Uint8Array;
+  private readonly _time: Float64Array;
+  private readonly _value: Float64Array;
+  private readonly _deviceId: (string | undefined)[];
+  private readonly _description: string[];
+  private _next = 0;
+  private _count = 0;
+  private _dropped = 0;
+
+  constructor(capacity: number = 4096) {
+    this.capacity = Math.max(1, Math.floor(capacity));
+    this._type = new Uint8Array(this.capacity);
+    this._time = new Float64Array(this.capacity);
+    this._value = new Float64Array(this.capacity);
+    this._deviceId = new Array(this.capacity).fill(undefined);
+    this._description = new Array(this.capacity).fill('');
+  }
+
+  /** 缓冲中的事件数 */
+  get size(): number {
+    return this._count;
+  }
+
+  /** 因缓冲写满被覆盖的事件数 */
+  get droppedEvents(): number {
+    return this._dropped;
+  }
+
+  record(type: SimulationEventType, time: Time, deviceId: string | undefined, description: string, value: number = NaN): void {
+    const k = this._next;
+    this._type[k] = type;
+    this._time[k] = time;
+    this._value[k] = value;
+    this._deviceId[k] = deviceId;
+    this._description[k] = description;
+
+    this._next = (k + 1) % this.capacity;
+    if (this._count < this.capacity) {
+      this._count++;
+    } else {
+      this._dropped++;
+    }
+  }
+
+  clear(): void {
+    this._next = 0;
+    this._count = 0;
+    this._dropped = 0;
+    this._deviceId.fill(undefined);
+    this._description.fill('');
+  }
+
+  /** 按记录顺序物化为事件数组 */
+  toArray(): SimulationEvent[] {
+    const events: SimulationEvent[] = new Array(this._count);
+    const first = (this._next - this._count + this.capacity) % this.capacity;
+    for (let i = 0; i < this._count; i++) {
+      const k = (first + i) % this.capacity;
+      events[i] = {
+        time: this._time[k]!,
+        type: this._type[k]! as SimulationEventType,
+        deviceId: this._deviceId[k],
+        description: this._description[k]!,
+        value: this._value[k]!
+      };
+    }
+    return events;
+  }
+}
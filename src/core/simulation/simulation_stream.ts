@@ -0,0 +1,137 @@
+/**
+ * 📡 瞬态仿真流式输出 - AkingSPICE 2.1
+ *
+ * engine.stream() 以异步迭代器逐块交付已记录的样本 (时间 + 探测信号)：
+ * - 拉取式：消费者请求下一块前仿真循环挂起，缓冲区上限约为一块 (背压)
+ * - 每块交付前、以及距上次让出超过 maxLatency 时 (即使没有待交付样本) 让出事件循环，
+ *   暂停/恢复、取消与 UI 事件得以及时处理
+ * - 攒满 chunkRows 行或距上次交付超过 maxLatency 毫秒即交付，延迟有界
+ */
+
+import type { Time } from '../../types/index';
+
+/**
+ * 流式输出配置
+ */
+export interface SimulationStreamOptions {
+  /** 取消信号：中止后仿真停止，迭代器以 signal.reason 拒绝 */
+  readonly signal?: AbortSignal;
+
+  /** 每块目标行数 (默认 1024) */
+  readonly chunkRows?: number;
+
+  /** 最长交付间隔，也是最长不让出事件循环的时间 (墙钟毫秒，默认 50) */
+  readonly maxLatency?: number;
+}
+
+/**
+ * 流式输出的一块样本
+ */
+export interface SimulationStreamChunk {
+  /** 本块第一行在整个输出中的行号 */
+  readonly startRow: number;
+  readonly rowCount: number;
+
+  /** 数值列名 (与波形存储一致) */
+  readonly columns: readonly string[];
+  readonly time: Float64Array;
+
+  /** 列优先：values[column * rowCount + row] */
+  readonly values: Float64Array;
+}
+
+/**
+ * 待交付样本的缓冲 (列优先，容量按需翻倍；通常不超过一块)
+ */
+export class StreamBuffer {
+  private _capacity: number;
+  private _time: Float64Array;
+  private _values: Float64Array;
+  private _rows = 0;
+  private _startRow = 0;
+  private _lastDelivery = performance.now();
+  private _lastYield = performance.now();
+
+  constructor(
+    readonly columns: readonly string[],
+    readonly chunkRows: number,
+    readonly maxLatency: number
+  ) {
+    this._capacity = chunkRows;
+    this._time = new Float64Array(chunkRows);
+    this._values = new Float64Array(chunkRows * columns.length);
+  }
+
+  get rowCount(): number {
+    return this._rows;
+  }
+
+  /** 攒满一块或超过最长交付间隔 */
+  get ready(): boolean {
+    return this._rows >= this.chunkRows
+      || (this._rows > 0 && performance.now() - this._lastDelivery >= this.maxLatency);
+  }
+
+  /** 距上次让出事件循环超过最长交付间隔 (与是否有待交付样本无关) */
+  get yieldDue(): boolean {
+    return performance.now() - this._lastYield >= this.maxLatency;
+  }
+
+  /** 让出事件循环并重新计时 */
+  async yieldToEventLoop(): Promise<void> {
+    await yieldToEventLoop();
+    this._lastYield = performance.now();
+  }
+
+  append(time: Time, row: ArrayLike<number>): void {
+    if (this._rows === this._capacity) this._grow();
+    const k = this._rows++;
+    const stride = this._capacity;
+    this._time[k] = time;
+    for (let c = 0; c < this.columns.length; c++) {
+      this._values[c * stride + k] = row[c]!;
+    }
+  }
+
+  /** 取出全部缓冲样本 */
+  take(): SimulationStreamChunk {
+    const rows = this._rows;
+    const stride = this._capacity;
+    const values = new Float64Array(rows * this.columns.length);
+    for (let c = 0; c < this.columns.length; c++) {
+      values.set(this._values.subarray(c * stride, c * stride + rows), c * rows);
+    }
+    const chunk: SimulationStreamChunk = {
+      startRow: this._startRow,
+      rowCount: rows,
+      columns: this.columns,
+      time: this._time.slice(0, rows),
+      values
+    };
+    this._startRow += rows;
+    this._rows = 0;
+    this._lastDelivery = performance.now();
+    return chunk;
+  }
+
+  private _grow(): void {
+    const stride = this._capacity;
+    const capacity = stride * 2;
+    const time = new Float64Array(capacity);
+    const values = new Float64Array(capacity * this.columns.length);
+    time.set(this._time);
+    for (let c = 0; c < this.columns.length; c++) {
+      values.set(this._values.subarray(c * stride, (c + 1) * stride), c * capacity);
+    }
+    this._capacity = capacity;
+    this._time = time;
+    this._values = values;
+  }
+}
+
+/**
+ * 让出事件循环 (宏任务)，使定时器、I/O 与 UI 事件先于下一块仿真执行
+ */
+export function yieldToEventLoop(): Promise<void> {
+  return new Promise(resolve => setTimeout(resolve, 0));
+}
@@ -0,0 +1,176 @@
+/**
+ * 🧵 仿真执行轨迹 - AkingSPICE 2.1
+ *
+ * 按需开启的跨度记录器，导出 Chrome Trace Event JSON (可在 Perfetto / chrome://tracing 打开)：
+ * - 跨度：时间步、Newton 迭代、装配、分解、求解、事件定位、积分器重启
+ * - 每个跨度标注仿真时间、步长，以及 (如有) 残差与迭代序号
+ * - 定长环形缓冲 (列式 TypedArray)，写满后覆盖最旧的跨度，内存占用恒定
+ */
+
+import type { Time } from '../../types/index';
+
+/**
+ * 跨度类型
+ */
+export type TraceSpanName =
+  | 'timestep'
+  | 'newton'
+  | 'assemble'
+  | 'factor'
+  | 'solve'
+  | 'event_locate'
+  | 'integrator_restart';
+
+const SPAN_NAMES: readonly TraceSpanName[] = [
+  'timestep', 'newton', 'assemble', 'factor', 'solve', 'event_locate', 'integrator_restart'
+];
+const SPAN_INDEX = new Map(SPAN_NAMES.map((name, index) => [name, index] as const));
+
+/**
+ * 轨迹配置
+ */
+export interface SimulationTracerOptions {
+  /** 环形缓冲容量 (跨度数，默认 65536) */
+  readonly capacity?: number;
+}
+
+/**
+ * Chrome Trace Event (仅用到的字段)
+ */
+export interface ChromeTraceEvent {
+  readonly name: string;
+  readonly cat: string;
+  readonly ph: 'X' | 'M';
+  readonly ts: number;
+  readonly dur?: number;
+  readonly pid: number;
+  readonly tid: number;
+  readonly args: Record<string, number | string>;
+}
+
+/**
+ * Chrome Trace JSON 对象格式
+ */
+export interface ChromeTrace {
+  readonly traceEvents: ChromeTraceEvent[];
+  readonly displayTimeUnit: 'ms';
+  readonly otherData: { readonly droppedSpans: number };
+}
+
+const TRACE_PID = 1;
+const TRACE_TID = 1;
+
+export class SimulationTracer {
+  readonly capacity: number;
+  private readonly _origin = performance.now();
+  private readonly _span: Uint8Array;
+  private readonly _start: Float64Array;
+  private readonly _duration: Float64Array;
+  private readonly _time: Float64Array;
+  private readonly _dt: Float64Array;
+  private readonly _residual: Float64Array;
+  private readonly _iteration: Int32Array;
+  private _next = 0;
+  private _count = 0;
+  private _dropped = 0;
+
+  constructor(options: SimulationTracerOptions = {}) {
+    this.capacity = Math.max(1, Math.floor(options.capacity ?? 65536));
+    this._span = new Uint8Array(this.capacity);
+    this._start = new Float64Array(this.capacity);
+    this._duration = new Float64Array(this.capacity);
+    this._time = new Float64Array(this.capacity);
+    this._dt = new Float64Array(this.capacity);
+    this._residual = new Float64Array(this.capacity);
+    this._iteration = new Int32Array(this.capacity);
+  }
+
+  /** 缓冲中的跨度数 */
+  get spanCount(): number {
+    return this._count;
+  }
+
+  /** 因缓冲写满被覆盖的跨度数 */
+  get droppedSpans(): number {
+    return this._dropped;
+  }
+
+  /** 跨度起点 (墙钟毫秒) */
+  begin(): number {
+    return performance.now();
+  }
+
+  /** 以当前时刻结束跨度并记录 */
+  end(span: TraceSpanName, start: number, time: Time, dt: Time, residual: number = NaN, iteration: number = -1): void {
+    this.record(span, start, performance.now() - start, time, dt, residual, iteration);
+  }
+
+  /** 记录一个已完成的跨度 (start/duration 为墙钟毫秒) */
+  record(
+    span: TraceSpanName,
+    start: number,
+    duration: number,
+    time: Time,
+    dt: Time,
+    residual: number = NaN,
+    iteration: number = -1
+  ): void {
+    const k = this._next;
+    this._span[k] = SPAN_INDEX.get(span)!;
+    this._start[k] = start;
+    this._duration[k] = duration;
+    this._time[k] = time;
+    this._dt[k] = dt;
+    this._residual[k] = residual;
+    this._iteration[k] = iteration;
+
+    this._next = (k + 1) % this.capacity;
+    if (this._count < this.capacity) {
+      this._count++;
+    } else {
+      this._dropped++;
+    }
+  }
+
+  /** 清空缓冲 */
+  clear(): void {
+    this._next = 0;
+    this._count = 0;
+    this._dropped = 0;
+  }
+
+  /**
+   * 📤 导出为 Chrome Trace 对象 (按记录顺序，时间戳为相对追踪器创建时刻的微秒)
+   */
+  toChromeTrace(): ChromeTrace {
+    const traceEvents: ChromeTraceEvent[] = [
+      { name: 'process_name', cat: '__metadata', ph: 'M', ts: 0, pid: TRACE_PID, tid: TRACE_TID, args: { name: 'AkingSPICE' } },
+      { name: 'thread_name', cat: '__metadata', ph: 'M', ts: 0, pid: TRACE_PID, tid: TRACE_TID, args: { name: 'simulation' } }
+    ];
+    const first = (this._next - this._count + this.capacity) % this.capacity;
+    for (let i = 0; i < this._count; i++) {
+      const k = (first + i) % this.capacity;
+      const args: Record<string, number> = { time: this._time[k]!, dt: this._dt[k]! };
+      const residual = this._residual[k]!;
+      if (!Number.isNaN(residual)) args['residual'] = residual;
+      const iteration = this._iteration[k]!;
+      if (iteration >= 0) args['iteration'] = iteration;
+      traceEvents.push({
+        name: SPAN_NAMES[this._span[k]!]!,
+        cat: 'simulation',
+        ph: 'X',
+        ts: (this._start[k]! - this._origin) * 1000,
+        dur: this._duration[k]! * 1000,
+        pid: TRACE_PID,
+        tid: TRACE_TID,
+        args
+      });
+    }
+    return { traceEvents, displayTimeUnit: 'ms', otherData: { droppedSpans: this._dropped } };
+  }
+
+  /** 📤 导出为 Chrome Trace JSON 文本 */
+  exportChromeTrace(): string {
+    return JSON.stringify(this.toChromeTrace());
+  }
+}
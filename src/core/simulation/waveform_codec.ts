@@ -0,0 +1,349 @@
+/**
+ * 🗜️ 波形列编解码 - AkingSPICE 2.1
+ *
+ * 开关电源波形大多是平台段加陡峭边沿，逐点存储浪费严重：
+ * - 分段线性化 (PLA)：可行斜率锥贪心延长线段，保证每个被丢弃的样本
+ *   与相邻保留点之间线性插值的误差不超过 max(abs, rel·|v|)
+ * - 保留样本的行号以 Elias-γ 码存储间隔，数值以 XOR 编码 (与前值异或，
+ *   只写有效位)，平台段的重复值只占 1 位
+ * - 时间列无损编码：与线性外推 (delta) 预测值异或，解码后用于插值重建
+ */
+
+const WORD_BITS = 32;
+
+// Float64 <-> (lo, hi) 32 位字 (小端主机：lo 在前)
+const scratchFloat = new Float64Array(1);
+const scratchWords = new Uint32Array(scratchFloat.buffer);
+
+const ctz32 = (x: number): number => 31 - Math.clz32(x & -x);
+
+/**
+ * 位流写入器
+ */
+class BitWriter {
+  private _words = new Uint32Array(64);
+  private _bits = 0;
+
+  /** 写入 value 的低 count 位 (count ≤ 32)，高位在前 */
+  write(value: number, count: number): void {
+    if (count === 0) return;
+    this._reserve(count);
+    const word = this._bits >>> 5;
+    const used = this._bits & 31;
+    const free = WORD_BITS - used;
+    const bits = count === 32 ? value >>> 0 : (value & ((1 << count) - 1)) >>> 0;
+    if (count <= free) {
+      this._words[word] = (this._words[word]! | ((bits << (free - count)) >>> 0)) >>> 0;
+    } else {
+      const spill = count - free;
+      this._words[word] = (this._words[word]! | (bits >>> spill)) >>> 0;
+      this._words[word + 1] = (bits << (WORD_BITS - spill)) >>> 0;
+    }
+    this._bits += count;
+  }
+
+  finish(): Uint32Array {
+    return this._words.slice(0, (this._bits + 31) >>> 5);
+  }
+
+  private _reserve(count: number): void {
+    const needed = ((this._bits + count) >>> 5) + 1;
+    if (needed > this._words.length) {
+      const grown = new Uint32Array(Math.max(needed, this._words.length * 2));
+      grown.set(this._words);
+      this._words = grown;
+    }
+  }
+}
+
+/**
+ * 位流读取器
+ */
+class BitReader {
+  private _position = 0;
+
+  constructor(private readonly _words: Uint32Array) {}
+
+  read(count: number): number {
+    if (count === 0) return 0;
+    const word = this._position >>> 5;
+    const used = this._position & 31;
+    const free = WORD_BITS - used;
+    let value: number;
+    if (count <= free) {
+      value = (this._words[word]! << used) >>> 0 >>> (WORD_BITS - count);
+    } else {
+      const spill = count - free;
+      const head = ((this._words[word]! << used) >>> 0) >>> used;
+      value = ((head << spill) | (this._words[word + 1]! >>> (WORD_BITS - spill))) >>> 0;
+    }
+    this._position += count;
+    return value;
+  }
+}
+
+/**
+ * XOR 浮点编码器 (Gorilla 风格)
+ *
+ * 每个值与参考值 (前值或线性外推的预测值) 的位模式异或，只写有效位。
+ * 控制位：0 = 与参考相同；10 = 沿用上次的有效位窗口；11 = 6 位前导零 + 6 位 (长度-1) + 有效位
+ */
+class XorEncoder {
+  private _leading = -1;
+  private _trailing = 0;
+
+  constructor(private readonly _writer: BitWriter) {}
+
+  write(value: number, reference: number): void {
+    scratchFloat[0] = reference;
+    const rlo = scratchWords[0]!;
+    const rhi = scratchWords[1]!;
+    scratchFloat[0] = value;
+    const xlo = (scratchWords[0]! ^ rlo) >>> 0;
+    const xhi = (scratchWords[1]! ^ rhi) >>> 0;
+    const writer = this._writer;
+
+    if (xhi === 0 && xlo === 0) {
+      writer.write(0, 1);
+      return;
+    }
+    const leading = Math.min(63, xhi !== 0 ? Math.clz32(xhi) : 32 + Math.clz32(xlo));
+    const trailing = xlo !== 0 ? ctz32(xlo) : 32 + ctz32(xhi);
+    if (this._leading >= 0 && leading >= this._leading && trailing >= this._trailing) {
+      writer.write(0b10, 2);
+      writeMeaningful(writer, xhi, xlo, this._trailing, 64 - this._leading - this._trailing);
+    } else {
+      const length = 64 - leading - trailing;
+      writer.write(0b11, 2);
+      writer.write(leading, 6);
+      writer.write(length - 1, 6);
+      writeMeaningful(writer, xhi, xlo, trailing, length);
+      this._leading = leading;
+      this._trailing = trailing;
+    }
+  }
+}
+
+/**
+ * XOR 浮点解码器
+ */
+class XorDecoder {
+  private _leading = 0;
+  private _trailing = 0;
+
+  constructor(private readonly _reader: BitReader) {}
+
+  read(reference: number): number {
+    const reader = this._reader;
+    if (reader.read(1) === 0) {
+      return reference;
+    }
+    if (reader.read(1) === 1) {
+      this._leading = reader.read(6);
+      this._trailing = 64 - this._leading - (reader.read(6) + 1);
+    }
+    const [xhi, xlo] = readMeaningful(reader, this._trailing, 64 - this._leading - this._trailing);
+    scratchFloat[0] = reference;
+    scratchWords[0] = (scratchWords[0]! ^ xlo) >>> 0;
+    scratchWords[1] = (scratchWords[1]! ^ xhi) >>> 0;
+    return scratchFloat[0]!;
+  }
+}
+
+// 线性外推预测 (非有限时退回前值)，编码与解码两端由相同的精确历史值计算
+function predict(previous: number, beforePrevious: number): number {
+  const prediction = 2 * previous - beforePrevious;
+  return Number.isFinite(prediction) ? prediction : previous;
+}
+
+// 写出 (hi, lo) >> trailing 的低 length 位
+function writeMeaningful(writer: BitWriter, hi: number, lo: number, trailing: number, length: number): void {
+  let shiftedHi: number;
+  let shiftedLo: number;
+  if (trailing >= 32) {
+    shiftedHi = 0;
+    shiftedLo = hi >>> (trailing - 32);
+  } else if (trailing > 0) {
+    shiftedHi = hi >>> trailing;
+    shiftedLo = ((lo >>> trailing) | (hi << (32 - trailing))) >>> 0;
+  } else {
+    shiftedHi = hi;
+    shiftedLo = lo;
+  }
+  if (length > 32) {
+    writer.write(shiftedHi, length - 32);
+    writer.write(shiftedLo, 32);
+  } else {
+    writer.write(shiftedLo, length);
+  }
+}
+
+// 读取 length 位有效位并左移 trailing 位，返回 [hi, lo]
+function readMeaningful(reader: BitReader, trailing: number, length: number): [number, number] {
+  let hi = length > 32 ? reader.read(length - 32) : 0;
+  let lo = reader.read(Math.min(length, 32));
+  if (trailing >= 32) {
+    hi = (lo << (trailing - 32)) >>> 0;
+    lo = 0;
+  } else if (trailing > 0) {
+    hi = ((hi << trailing) | (lo >>> (32 - trailing))) >>> 0;
+    lo = (lo << trailing) >>> 0;
+  }
+  return [hi, lo];
+}
+
+// Elias-γ 码 (n ≥ 1)
+function writeGamma(writer: BitWriter, n: number): void {
+  const bits = 32 - Math.clz32(n);
+  writer.write(0, bits - 1);
+  writer.write(n, bits);
+}
+
+function readGamma(reader: BitReader): number {
+  let zeros = 0;
+  while (reader.read(1) === 0) zeros++;
+  return zeros === 0 ? 1 : ((1 << zeros) | reader.read(zeros)) >>> 0;
+}
+
+/**
+ * 编码后的列
+ */
+export interface EncodedColumn {
+  readonly words: Uint32Array;
+
+  /** 保留的样本数 (无损编码时等于行数) */
+  readonly retained: number;
+}
+
+/**
+ * 单列误差界
+ */
+export interface ErrorBound {
+  readonly absoluteTolerance: number;
+  readonly relativeTolerance: number;
+}
+
+export namespace WaveformCodec {
+  /**
+   * 🗜️ 无损编码：与线性外推预测值异或 (均匀或缓变的时间列残差只剩最低几位)
+   */
+  export function encodeLossless(values: ArrayLike<number>): EncodedColumn {
+    const writer = new BitWriter();
+    const encoder = new XorEncoder(writer);
+    for (let i = 0; i < values.length; i++) {
+      const reference = i === 0 ? 0 : i === 1 ? values[0]! : predict(values[i - 1]!, values[i - 2]!);
+      encoder.write(values[i]!, reference);
+    }
+    return { words: writer.finish(), retained: values.length };
+  }
+
+  export function decodeLossless(column: EncodedColumn, out: Float64Array): void {
+    const decoder = new XorDecoder(new BitReader(column.words));
+    for (let i = 0; i < column.retained; i++) {
+      const reference = i === 0 ? 0 : i === 1 ? out[0]! : predict(out[i - 1]!, out[i - 2]!);
+      out[i] = decoder.read(reference);
+    }
+  }
+
+  /**
+   * 🗜️ 误差有界的分段线性编码
+   *
+   * 首末样本总是保留；线段端点存储拟合直线上的值 (与原样本之差在误差界内)，
+   * 下一段从该端点继续，重建曲线连续。
+   *
+   * @param time 时间列 (递增)
+   * @param values 数值列 (与时间列等长)
+   */
+  export function encodePiecewiseLinear(time: ArrayLike<number>, values: ArrayLike<number>, bound: ErrorBound): EncodedColumn {
+    const count = values.length;
+    const writer = new BitWriter();
+    const encoder = new XorEncoder(writer);
+    let retained = 0;
+    let previousRow = 0;
+    let previousValue = 0;
+
+    const keep = (row: number, value: number): void => {
+      if (retained > 0) writeGamma(writer, row - previousRow);
+      encoder.write(value, previousValue);
+      previousRow = row;
+      previousValue = value;
+      retained++;
+    };
+    if (count === 0) return { words: writer.finish(), retained: 0 };
+
+    const tolerance = (v: number): number => Math.max(bound.absoluteTolerance, bound.relativeTolerance * Math.abs(v));
+    let anchorRow = 0;
+    let anchorValue = values[0]!;
+    let last = 0;
+    let lo = -Infinity;
+    let hi = Infinity;
+    keep(0, anchorValue);
+
+    // 尝试把第 k 个样本并入当前线段 (更新可行斜率区间)
+    const extend = (k: number): boolean => {
+      const dt = time[k]! - time[anchorRow]!;
+      const v = values[k]!;
+      const tol = tolerance(v);
+      const newLo = Math.max(lo, (v - tol - anchorValue) / dt);
+      const newHi = Math.min(hi, (v + tol - anchorValue) / dt);
+      if (!(dt > 0 && newLo <= newHi)) return false;
+      lo = newLo;
+      hi = newHi;
+      last = k;
+      return true;
+    };
+
+    for (let k = 1; k < count; k++) {
+      if (extend(k)) continue;
+
+      // 线段在 last 处结束，端点取可行斜率区间中点所在直线的值
+      if (last > anchorRow) {
+        anchorValue = anchorValue + 0.5 * (lo + hi) * (time[last]! - time[anchorRow]!);
+        anchorRow = last;
+        keep(anchorRow, anchorValue);
+      }
+      lo = -Infinity;
+      hi = Infinity;
+      if (!extend(k)) {
+        // 时间不增或非有限值：原样保留
+        anchorRow = k;
+        anchorValue = values[k]!;
+        last = k;
+        keep(k, anchorValue);
+      }
+    }
+
+    if (last > anchorRow) {
+      keep(last, anchorValue + 0.5 * (lo + hi) * (time[last]! - time[anchorRow]!));
+    }
+    return { words: writer.finish(), retained };
+  }
+
+  /**
+   * 解码分段线性列，在保留样本之间按时间线性插值
+   *
+   * @param time 已解码的时间列
+   * @param out 输出 (长度 = 行数)
+   */
+  export function decodePiecewiseLinear(column: EncodedColumn, time: ArrayLike<number>, out: Float64Array): void {
+    if (column.retained === 0) return;
+    const reader = new BitReader(column.words);
+    const decoder = new XorDecoder(reader);
+
+    let row = 0;
+    let value = decoder.read(0);
+    out[0] = value;
+    for (let i = 1; i < column.retained; i++) {
+      const next = row + readGamma(reader);
+      const nextValue = decoder.read(value);
+      const t0 = time[row]!;
+      const span = time[next]! - t0;
+      for (let r = row + 1; r < next; r++) {
+        out[r] = value + (nextValue - value) * ((time[r]! - t0) / span);
+      }
+      out[next] = nextValue;
+      row = next;
+      value = nextValue;
+    }
+  }
+}
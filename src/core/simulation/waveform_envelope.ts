@@ -0,0 +1,234 @@
+/**
+ * 📉 多分辨率 min/max 包络金字塔 - AkingSPICE 2.1
+ *
+ * 绘制百万点波形时，缩小视图的每个像素只需要该时间段的最小/最大值：
+ * - 第 ℓ 层每个桶覆盖 2^ℓ 个样本 (最细层为 2^minLevel)，追加样本时逐层增量合并
+ * - 查询时选择窗口内桶数不少于像素数的最粗层，按像素归并，代价 O(像素数 + log N)
+ * - 包络与原始数据的保留/压缩无关，释放块后仍可绘制缩小视图
+ */
+
+import type { Time } from '../../types/index';
+
+/**
+ * 包络配置
+ */
+export interface WaveformEnvelopeOptions {
+  /** 最细层每桶 2^minLevel 个样本 (默认 1，即 2×)；增大可按 2^-minLevel 缩减内存 */
+  readonly minLevel?: number;
+}
+
+/**
+ * 包络查询结果 (每个像素一个区间；无数据的像素为 NaN)
+ */
+export interface EnvelopeQueryResult {
+  /** 像素区间起始时间 */
+  readonly time: Float64Array;
+  readonly min: Float64Array;
+  readonly max: Float64Array;
+
+  /** 使用的层 (0 = 原始样本) */
+  readonly level: number;
+}
+
+/**
+ * 单层桶序列 (桶内 min/max 按列交错存储：[bucket * columns + column])
+ */
+class EnvelopeLevel {
+  count = 0;
+  start = new Float64Array(64);
+  end = new Float64Array(64);
+  min: Float64Array;
+  max: Float64Array;
+
+  // 未满的桶
+  pendingCount = 0;
+  pendingStart = 0;
+  pendingEnd = 0;
+  readonly pendingMin: Float64Array;
+  readonly pendingMax: Float64Array;
+
+  constructor(readonly level: number, readonly fanIn: number, private readonly _columns: number) {
+    this.min = new Float64Array(64 * _columns);
+    this.max = new Float64Array(64 * _columns);
+    this.pendingMin = new Float64Array(_columns).fill(Infinity);
+    this.pendingMax = new Float64Array(_columns).fill(-Infinity);
+  }
+
+  /** 并入一个样本或下层桶，桶满时返回 true */
+  accumulate(start: Time, end: Time, min: ArrayLike<number>, max: ArrayLike<number>, offset: number): boolean {
+    if (this.pendingCount === 0) this.pendingStart = start;
+    this.pendingEnd = end;
+    for (let c = 0; c < this._columns; c++) {
+      const lo = min[offset + c]!;
+      const hi = max[offset + c]!;
+      if (lo < this.pendingMin[c]!) this.pendingMin[c] = lo;
+      if (hi > this.pendingMax[c]!) this.pendingMax[c] = hi;
+    }
+    return ++this.pendingCount === this.fanIn;
+  }
+
+  /** 封存当前桶 */
+  commit(): void {
+    if (this.count === this.start.length) this._grow();
+    const k = this.count++;
+    const columns = this._columns;
+    this.start[k] = this.pendingStart;
+    this.end[k] = this.pendingEnd;
+    this.min.set(this.pendingMin, k * columns);
+    this.max.set(this.pendingMax, k * columns);
+    this.pendingCount = 0;
+    this.pendingMin.fill(Infinity);
+    this.pendingMax.fill(-Infinity);
+  }
+
+  /** 第一个 end ≥ time 的桶 */
+  firstEndingAfter(time: Time): number {
+    let lo = 0;
+    let hi = this.count;
+    while (lo < hi) {
+      const mid = (lo + hi) >> 1;
+      if (this.end[mid]! < time) lo = mid + 1; else hi = mid;
+    }
+    return lo;
+  }
+
+  /** 第一个 start > time 的桶 */
+  firstStartingAfter(time: Time): number {
+    let lo = 0;
+    let hi = this.count;
+    while (lo < hi) {
+      const mid = (lo + hi) >> 1;
+      if (this.start[mid]! <= time) lo = mid + 1; else hi = mid;
+    }
+    return lo;
+  }
+
+  byteLength(): number {
+    return this.start.byteLength + this.end.byteLength + this.min.byteLength + this.max.byteLength;
+  }
+
+  private _grow(): void {
+    const grow = (array: Float64Array, size: number): Float64Array => {
+      const grown = new Float64Array(size);
+      grown.set(array);
+      return grown;
+    };
+    const capacity = this.start.length * 2;
+    this.start = grow(this.start, capacity);
+    this.end = grow(this.end, capacity);
+    this.min = grow(this.min, capacity * this._columns);
+    this.max = grow(this.max, capacity * this._columns);
+  }
+}
+
+/**
+ * 📉 包络金字塔
+ */
+export class EnvelopePyramid {
+  private readonly _levels: EnvelopeLevel[] = [];
+  private readonly _minLevel: number;
+
+  constructor(private readonly _columns: number, options: WaveformEnvelopeOptions = {}) {
+    this._minLevel = Math.max(1, Math.floor(options.minLevel ?? 1));
+    this._levels.push(new EnvelopeLevel(this._minLevel, 1 << this._minLevel, _columns));
+  }
+
+  /** 最细层的层号 */
+  get minLevel(): number {
+    return this._minLevel;
+  }
+
+  /** 当前层数 */
+  get levelCount(): number {
+    return this._levels.length;
+  }
+
+  /**
+   * ➕ 追加一行 (与存储的 append 同步调用)
+   */
+  append(time: Time, values: ArrayLike<number>): void {
+    let level = 0;
+    if (!this._levels[0]!.accumulate(time, time, values, values, 0)) return;
+
+    // 桶满：逐层向上合并
+    for (;;) {
+      const current = this._levels[level]!;
+      const start = current.pendingStart;
+      const end = current.pendingEnd;
+      current.commit();
+      const index = current.count - 1;
+
+      if (level + 1 === this._levels.length) {
+        this._levels.push(new EnvelopeLevel(current.level + 1, 2, this._columns));
+      }
+      const parent = this._levels[level + 1]!;
+      const offset = index * this._columns;
+      if (!parent.accumulate(start, end, current.min, current.max, offset)) return;
+      level++;
+    }
+  }
+
+  byteLength(): number {
+    return this._levels.reduce((sum, level) => sum + level.byteLength(), 0);
+  }
+
+  /**
+   * 🎯 窗口内桶数不少于 pixels 的最粗层 (下标)，最细层也不足时返回 -1
+   */
+  levelFor(start: Time, end: Time, pixels: number): number {
+    for (let l = this._levels.length - 1; l >= 0; l--) {
+      const level = this._levels[l]!;
+      if (level.firstStartingAfter(end) - level.firstEndingAfter(start) >= pixels) return l;
+    }
+    return -1;
+  }
+
+  /**
+   * 🔍 用第 index 层查询某列在 [start, end] 内按 pixels 个像素归并的包络
+   */
+  query(column: number, start: Time, end: Time, pixels: number, index: number): EnvelopeQueryResult {
+    const level = this._levels[index]!;
+    const result = EnvelopePyramid.createResult(start, end, pixels, level.level);
+    const last = level.firstStartingAfter(end);
+    for (let k = level.firstEndingAfter(start); k < last; k++) {
+      const offset = k * this._columns + column;
+      EnvelopePyramid.merge(result, start, end, Math.max(level.start[k]!, start), level.min[offset]!, level.max[offset]!);
+    }
+
+    // 尾部：不高于所选层的各层未满桶 (合起来恰好覆盖该层最后一个完整桶之后的样本)
+    for (let l = 0; l <= index; l++) {
+      const pending = this._levels[l]!;
+      if (pending.pendingCount > 0 && pending.pendingEnd >= start && pending.pendingStart <= end) {
+        EnvelopePyramid.merge(
+          result, start, end, Math.max(pending.pendingStart, start),
+          pending.pendingMin[column]!, pending.pendingMax[column]!
+        );
+      }
+    }
+    return result;
+  }
+
+  /** 创建全 NaN 的像素区间 */
+  static createResult(start: Time, end: Time, pixels: number, level: number): EnvelopeQueryResult {
+    const time = new Float64Array(pixels);
+    const width = (end - start) / pixels;
+    for (let p = 0; p < pixels; p++) time[p] = start + p * width;
+    return {
+      time,
+      min: new Float64Array(pixels).fill(NaN),
+      max: new Float64Array(pixels).fill(NaN),
+      level
+    };
+  }
+
+  /** 将 (min, max) 归并到 time 所在的像素 */
+  static merge(result: EnvelopeQueryResult, start: Time, end: Time, time: Time, min: number, max: number): void {
+    const pixels = result.min.length;
+    const span = end - start;
+    const pixel = span > 0 ? Math.min(pixels - 1, Math.max(0, Math.floor((time - start) / span * pixels))) : 0;
+    const lo = result.min[pixel]!;
+    const hi = result.max[pixel]!;
+    result.min[pixel] = Number.isNaN(lo) || min < lo ? min : lo;
+    result.max[pixel] = Number.isNaN(hi) || max > hi ? max : hi;
+  }
+}
@@ -0,0 +1,535 @@
+/**
+ * 💽 二进制列式波形文件 - AkingSPICE 2.1
+ *
+ * 仿真结果可大于内存，且重新打开时只读取需要的部分：
+ * - 文件头：魔数 + JSON 头 (数值列名、枚举列名、块行数、字节序)
+ * - 数据块：与 WaveformStore 的封存块一一对应，块内列优先 Float64，8 字节对齐
+ * - 块索引：文件尾的 JSON 索引 (偏移、起止时间、枚举游程数) + 定长尾标
+ *
+ * WaveformFileWriter 作为 WaveformChunkSink 挂到引擎的步进循环上流式写入；
+ * WaveformFileReader 只读取尾标与索引，按信号与时间范围定位块，以定位读取 (pread)
+ * 取出单列的连续字节区间，无需加载整个文件。SpiceRawfileWriter 复用同一 sink 接口，
+ * 输出 SPICE 二进制 rawfile 供现有波形查看器使用。
+ *
+ * 📋 用法：
+ *   const writer = new WaveformFileWriter('run.akw');
+ *   engine.setWaveformSink(writer.sink);
+ *   await engine.runSimulation();
+ *   writer.close();
+ *   const reader = WaveformFileReader.open('run.akw');
+ *   const { time, values } = reader.readSignal('V(out)', 1e-3, 2e-3);
+ */
+
+import { closeSync, fstatSync, openSync, readSync, writeSync } from 'fs';
+import { endianness } from 'os';
+import type { Time } from '../../types/index';
+import type { WaveformChunk, WaveformChunkSink, WaveformStore } from './waveform_store';
+
+const FILE_MAGIC = 'AKWF';
+const INDEX_MAGIC = 'AKWI';
+const FORMAT_VERSION = 1;
+const PREAMBLE_BYTES = 16;   // 魔数 + 版本 + 头长度 + 保留
+const TRAILER_BYTES = 16;    // 索引偏移 (u64) + 索引长度 (u32) + 魔数
+
+/**
+ * 文件头
+ */
+export interface WaveformFileHeader {
+  readonly version: number;
+  readonly endianness: 'LE' | 'BE';
+  readonly numericColumns: readonly string[];
+  readonly enumColumns: readonly string[];
+  readonly chunkRows: number;
+}
+
+/**
+ * 块索引条目
+ */
+export interface WaveformFileChunkEntry {
+  readonly offset: number;
+  readonly startRow: number;
+  readonly rowCount: number;
+  readonly timeStart: Time;
+  readonly timeEnd: Time;
+
+  /** 每个枚举列的游程数 (游程紧跟数值数据：Int32 codes，Uint32 ends) */
+  readonly runCounts: readonly number[];
+}
+
+/**
+ * 文件尾索引
+ */
+export interface WaveformFileIndex {
+  readonly rowCount: number;
+  readonly labels: readonly string[];
+  readonly chunks: readonly WaveformFileChunkEntry[];
+}
+
+const align8 = (bytes: number): number => (bytes + 7) & ~7;
+
+/**
+ * 💽 流式写入器 (WaveformChunkSink)
+ */
+export class WaveformFileWriter {
+  private readonly _fd: number;
+  private _position = 0;
+  private _store: WaveformStore | null = null;
+  private _header: WaveformFileHeader | null = null;
+  private readonly _entries: WaveformFileChunkEntry[] = [];
+  private _rowCount = 0;
+  private _closed = false;
+
+  /** 传给 engine.setWaveformSink() 的回调 */
+  readonly sink: WaveformChunkSink = (chunk, store) => {
+    if (!this._header) {
+      this._store = store;
+      this.begin(store.numericColumns, store.enumColumns, store.chunkRows);
+    }
+    this.writeChunk(chunk);
+  };
+
+  constructor(readonly path: string) {
+    this._fd = openSync(path, 'w');
+  }
+
+  /**
+   * 📝 写入文件头 (通过 sink 使用时自动调用)
+   */
+  begin(numericColumns: readonly string[], enumColumns: readonly string[] = [], chunkRows: number = 0): void {
+    if (this._header) throw new Error(`Waveform file ${this.path} already started`);
+
+    this._header = {
+      version: FORMAT_VERSION,
+      endianness: endianness(),
+      numericColumns: [...numericColumns],
+      enumColumns: [...enumColumns],
+      chunkRows
+    };
+    const json = Buffer.from(JSON.stringify(this._header), 'utf8');
+    const headerBytes = align8(json.length);
+
+    const preamble = Buffer.alloc(PREAMBLE_BYTES + headerBytes, 0x20);
+    preamble.write(FILE_MAGIC, 0, 'latin1');
+    preamble.writeUInt32LE(FORMAT_VERSION, 4);
+    preamble.writeUInt32LE(headerBytes, 8);
+    preamble.writeUInt32LE(0, 12);
+    json.copy(preamble, PREAMBLE_BYTES);
+    this._write(preamble);
+  }
+
+  /**
+   * ➕ 追加一个数据块
+   */
+  writeChunk(chunk: WaveformChunk): void {
+    if (!this._header) throw new Error(`Waveform file ${this.path} has no header; call begin() first`);
+    if (this._closed) throw new Error(`Waveform file ${this.path} is closed`);
+
+    const offset = this._position;
+    this._write(chunk.time);
+    this._write(chunk.values);
+    const runCounts: number[] = [];
+    for (const runs of chunk.enums) {
+      runCounts.push(runs.codes.length);
+      this._write(runs.codes);
+      this._write(runs.ends);
+    }
+    this._pad();
+
+    this._entries.push({
+      offset,
+      startRow: chunk.startRow,
+      rowCount: chunk.rowCount,
+      timeStart: chunk.time[0] ?? 0,
+      timeEnd: chunk.time[chunk.rowCount - 1] ?? 0,
+      runCounts
+    });
+    this._rowCount = Math.max(this._rowCount, chunk.startRow + chunk.rowCount);
+  }
+
+  /**
+   * 🔒 写入块索引与尾标并关闭文件
+   *
+   * @param labels 枚举编码表 (通过 sink 使用时取自存储)
+   */
+  close(labels?: readonly string[]): void {
+    if (this._closed) return;
+    if (!this._header) this.begin([], []);
+
+    const index: WaveformFileIndex = {
+      rowCount: this._rowCount,
+      labels: [...(labels ?? this._store?.labels ?? [])],
+      chunks: this._entries
+    };
+    const json = Buffer.from(JSON.stringify(index), 'utf8');
+    const indexOffset = this._position;
+    this._write(json);
+
+    const trailer = Buffer.alloc(TRAILER_BYTES);
+    trailer.writeBigUInt64LE(BigInt(indexOffset), 0);
+    trailer.writeUInt32LE(json.length, 8);
+    trailer.write(INDEX_MAGIC, 12, 'latin1');
+    this._write(trailer);
+
+    closeSync(this._fd);
+    this._closed = true;
+  }
+
+  private _write(data: ArrayBufferView): void {
+    const bytes = new Uint8Array(data.buffer, data.byteOffset, data.byteLength);
+    let written = 0;
+    while (written < bytes.length) {
+      written += writeSync(this._fd, bytes, written, bytes.length - written, this._position + written);
+    }
+    this._position += bytes.length;
+  }
+
+  private _pad(): void {
+    const padding = align8(this._position) - this._position;
+    if (padding > 0) this._write(new Uint8Array(padding));
+  }
+}
+
+/**
+ * 📖 随机访问读取器
+ */
+export class WaveformFileReader {
+  private readonly _numericIndex = new Map<string, number>();
+  private readonly _enumIndex = new Map<string, number>();
+  private _closed = false;
+
+  private constructor(
+    readonly path: string,
+    private readonly _fd: number,
+    readonly header: WaveformFileHeader,
+    readonly index: WaveformFileIndex
+  ) {
+    header.numericColumns.forEach((name, i) => this._numericIndex.set(name, i));
+    header.enumColumns.forEach((name, i) => this._enumIndex.set(name, i));
+  }
+
+  /**
+   * 📂 打开文件：只读取文件头、尾标与块索引
+   */
+  static open(path: string): WaveformFileReader {
+    const fd = openSync(path, 'r');
+    try {
+      const size = fstatSync(fd).size;
+      if (size < PREAMBLE_BYTES + TRAILER_BYTES) throw new Error(`Waveform file ${path} is truncated`);
+
+      const preamble = WaveformFileReader._read(fd, 0, PREAMBLE_BYTES);
+      if (preamble.toString('latin1', 0, 4) !== FILE_MAGIC) throw new Error(`${path} is not a waveform file`);
+      if (preamble.readUInt32LE(4) !== FORMAT_VERSION) {
+        throw new Error(`Unsupported waveform file version ${preamble.readUInt32LE(4)} in ${path}`);
+      }
+      const header = JSON.parse(
+        WaveformFileReader._read(fd, PREAMBLE_BYTES, preamble.readUInt32LE(8)).toString('utf8')
+      ) as WaveformFileHeader;
+      if (header.endianness !== endianness()) {
+        throw new Error(`Waveform file ${path} was written with ${header.endianness} byte order`);
+      }
+
+      const trailer = WaveformFileReader._read(fd, size - TRAILER_BYTES, TRAILER_BYTES);
+      if (trailer.toString('latin1', 12, 16) !== INDEX_MAGIC) {
+        throw new Error(`Waveform file ${path} has no chunk index (writer not closed?)`);
+      }
+      const index = JSON.parse(
+        WaveformFileReader._read(fd, Number(trailer.readBigUInt64LE(0)), trailer.readUInt32LE(8)).toString('utf8')
+      ) as WaveformFileIndex;
+
+      return new WaveformFileReader(path, fd, header, index);
+    } catch (error) {
+      closeSync(fd);
+      throw error;
+    }
+  }
+
+  get numericColumns(): readonly string[] {
+    return this.header.numericColumns;
+  }
+
+  get enumColumns(): readonly string[] {
+    return this.header.enumColumns;
+  }
+
+  get rowCount(): number {
+    return this.index.rowCount;
+  }
+
+  get chunkCount(): number {
+    return this.index.chunks.length;
+  }
+
+  /**
+   * ⏱️ 读取时间范围 [start, end] 内的时间列
+   */
+  readTime(start: Time = -Infinity, end: Time = Infinity): Float64Array {
+    return this._readRange(start, end, null).time;
+  }
+
+  /**
+   * 📈 读取单个信号在时间范围 [start, end] 内的数据 (只读取该列所在的字节区间)
+   */
+  readSignal(name: string, start: Time = -Infinity, end: Time = Infinity): { time: Float64Array; values: Float64Array } {
+    const column = this._numericIndex.get(name);
+    if (column === undefined) throw new Error(`Unknown waveform column: ${name}`);
+    const { time, values } = this._readRange(start, end, column);
+    return { time, values: values! };
+  }
+
+  /**
+   * 🏷️ 读取枚举列在时间范围 [start, end] 内的标签序列
+   */
+  readStates(name: string, start: Time = -Infinity, end: Time = Infinity): { time: Float64Array; states: string[] } {
+    const column = this._enumIndex.get(name);
+    if (column === undefined) throw new Error(`Unknown waveform column: ${name}`);
+
+    const times: Float64Array[] = [];
+    const states: string[] = [];
+    for (const entry of this._chunksInRange(start, end)) {
+      const chunkTime = this._readFloat64(entry.offset, entry.rowCount);
+      const { codes, ends } = this._readRuns(entry, column);
+      const [first, last] = WaveformFileReader._rowsInRange(chunkTime, start, end);
+      let run = 0;
+      for (let row = first; row < last; row++) {
+        while (ends[run]! <= row) run++;
+        states.push(this.index.labels[codes[run]!] ?? '');
+      }
+      times.push(chunkTime.subarray(first, last));
+    }
+    return { time: WaveformFileReader._concat(times), states };
+  }
+
+  /**
+   * 📦 读取完整数据块
+   */
+  readChunk(chunkIndex: number): WaveformChunk {
+    const entry = this.index.chunks[chunkIndex];
+    if (!entry) throw new Error(`Chunk ${chunkIndex} out of range (0..${this.chunkCount - 1})`);
+
+    const rows = entry.rowCount;
+    const columns = this.header.numericColumns.length;
+    return {
+      index: chunkIndex,
+      startRow: entry.startRow,
+      rowCount: rows,
+      time: this._readFloat64(entry.offset, rows),
+      values: this._readFloat64(entry.offset + 8 * rows, rows * columns),
+      enums: this.header.enumColumns.map((_, column) => this._readRuns(entry, column))
+    };
+  }
+
+  /**
+   * 📤 导出为 SPICE 二进制 rawfile (逐块流式转换)
+   */
+  exportRawfile(path: string, options: SpiceRawfileOptions = {}): void {
+    const writer = new SpiceRawfileWriter(path, options);
+    writer.begin(this.header.numericColumns);
+    for (let i = 0; i < this.chunkCount; i++) {
+      writer.writeChunk(this.readChunk(i));
+    }
+    writer.close();
+  }
+
+  close(): void {
+    if (!this._closed) {
+      closeSync(this._fd);
+      this._closed = true;
+    }
+  }
+
+  // === 私有方法 ===
+
+  private _chunksInRange(start: Time, end: Time): WaveformFileChunkEntry[] {
+    const chunks = this.index.chunks;
+    // 二分查找第一个 timeEnd >= start 的块
+    let lo = 0;
+    let hi = chunks.length;
+    while (lo < hi) {
+      const mid = (lo + hi) >> 1;
+      if (chunks[mid]!.timeEnd < start) lo = mid + 1; else hi = mid;
+    }
+    const result: WaveformFileChunkEntry[] = [];
+    for (let i = lo; i < chunks.length && chunks[i]!.timeStart <= end; i++) {
+      result.push(chunks[i]!);
+    }
+    return result;
+  }
+
+  private _readRange(start: Time, end: Time, column: number | null): { time: Float64Array; values: Float64Array | null } {
+    const times: Float64Array[] = [];
+    const values: Float64Array[] = [];
+    for (const entry of this._chunksInRange(start, end)) {
+      const chunkTime = this._readFloat64(entry.offset, entry.rowCount);
+      const [first, last] = WaveformFileReader._rowsInRange(chunkTime, start, end);
+      if (last <= first) continue;
+      times.push(chunkTime.subarray(first, last));
+      if (column !== null) {
+        // 列优先：该列在块内是一段连续字节，只读取范围内的行
+        const columnOffset = entry.offset + 8 * entry.rowCount * (1 + column);
+        values.push(this._readFloat64(columnOffset + 8 * first, last - first));
+      }
+    }
+    return {
+      time: WaveformFileReader._concat(times),
+      values: column !== null ? WaveformFileReader._concat(values) : null
+    };
+  }
+
+  private _readRuns(entry: WaveformFileChunkEntry, column: number): { codes: Int32Array; ends: Uint32Array } {
+    let offset = entry.offset + 8 * entry.rowCount * (1 + this.header.numericColumns.length);
+    for (let e = 0; e < column; e++) {
+      offset += 8 * entry.runCounts[e]!;
+    }
+    const count = entry.runCounts[column]!;
+    const codes = new Int32Array(count);
+    const ends = new Uint32Array(count);
+    this._readInto(codes, offset);
+    this._readInto(ends, offset + 4 * count);
+    return { codes, ends };
+  }
+
+  private _readFloat64(offset: number, count: number): Float64Array {
+    const result = new Float64Array(count);
+    this._readInto(result, offset);
+    return result;
+  }
+
+  private _readInto(target: ArrayBufferView, position: number): void {
+    const bytes = new Uint8Array(target.buffer, target.byteOffset, target.byteLength);
+    let read = 0;
+    while (read < bytes.length) {
+      const n = readSync(this._fd, bytes, read, bytes.length - read, position + read);
+      if (n === 0) throw new Error(`Unexpected end of waveform file ${this.path}`);
+      read += n;
+    }
+  }
+
+  private static _read(fd: number, position: number, length: number): Buffer {
+    const buffer = Buffer.alloc(length);
+    const n = readSync(fd, buffer, 0, length, position);
+    if (n !== length) throw new Error('Unexpected end of waveform file');
+    return buffer;
+  }
+
+  private static _rowsInRange(time: Float64Array, start: Time, end: Time): [number, number] {
+    let first = 0;
+    while (first < time.length && time[first]! < start) first++;
+    let last = time.length;
+    while (last > first && time[last - 1]! > end) last--;
+    return [first, last];
+  }
+
+  private static _concat(parts: Float64Array[]): Float64Array {
+    if (parts.length === 1) return parts[0]!;
+    const result = new Float64Array(parts.reduce((sum, part) => sum + part.length, 0));
+    let offset = 0;
+    for (const part of parts) {
+      result.set(part, offset);
+      offset += part.length;
+    }
+    return result;
+  }
+}
+
+/**
+ * SPICE rawfile 选项
+ */
+export interface SpiceRawfileOptions {
+  readonly title?: string;
+  readonly plotname?: string;
+}
+
+// 点数占位宽度，关闭时原地改写
+const RAW_POINTS_WIDTH = 16;
+
+/**
+ * 📤 SPICE 二进制 rawfile 写入器 (WaveformChunkSink)
+ *
+ * 变量按列写出：time 之后依次为 V(...) (voltage) 与 I(...) (current)；
+ * 数据区逐点行优先写出 Float64，块内列优先数据在写出时转置。
+ */
+export class SpiceRawfileWriter {
+  private readonly _fd: number;
+  private _position = 0;
+  private _columns: number | null = null;
+  private _pointsOffset = 0;
+  private _points = 0;
+  private _closed = false;
+
+  /** 传给 engine.setWaveformSink() 的回调 */
+  readonly sink: WaveformChunkSink = (chunk, store) => {
+    if (this._columns === null) this.begin(store.numericColumns);
+    this.writeChunk(chunk);
+  };
+
+  constructor(readonly path: string, private readonly _options: SpiceRawfileOptions = {}) {
+    this._fd = openSync(path, 'w');
+  }
+
+  /**
+   * 📝 写入 rawfile 头
+   */
+  begin(numericColumns: readonly string[]): void {
+    if (this._columns !== null) throw new Error(`Rawfile ${this.path} already started`);
+    this._columns = numericColumns.length;
+
+    const head = [
+      `Title: ${this._options.title ?? 'AkingSPICE simulation'}`,
+      `Date: ${new Date().toUTCString()}`,
+      `Plotname: ${this._options.plotname ?? 'Transient Analysis'}`,
+      'Flags: real',
+      `No. Variables: ${numericColumns.length + 1}`,
+      'No. Points: '
+    ].join('\n');
+    const variables = ['Variables:', '\t0\ttime\ttime'];
+    numericColumns.forEach((name, i) => {
+      const kind = name.startsWith('V(') ? 'voltage' : name.startsWith('I') ? 'current' : 'notype';
+      const rawName = name.startsWith('V(') || name.startsWith('I(') ? name[0]!.toLowerCase() + name.slice(1) : name;
+      variables.push(`\t${i + 1}\t${rawName}\t${kind}`);
+    });
+
+    this._write(Buffer.from(head, 'latin1'));
+    this._pointsOffset = this._position;
+    this._write(Buffer.from(`${'0'.padEnd(RAW_POINTS_WIDTH)}\n${variables.join('\n')}\nBinary:\n`, 'latin1'));
+  }
+
+  /**
+   * ➕ 追加一个数据块 (转置为逐点记录)
+   */
+  writeChunk(chunk: WaveformChunk): void {
+    if (this._columns === null) throw new Error(`Rawfile ${this.path} has no header; call begin() first`);
+    const rows = chunk.rowCount;
+    const columns = this._columns;
+    const record = columns + 1;
+    const data = new Float64Array(rows * record);
+    for (let row = 0; row < rows; row++) {
+      data[row * record] = chunk.time[row]!;
+      for (let c = 0; c < columns; c++) {
+        data[row * record + c + 1] = chunk.values[c * rows + row]!;
+      }
+    }
+    this._write(data);
+    this._points += rows;
+  }
+
+  /**
+   * 🔒 回填点数并关闭文件
+   */
+  close(): void {
+    if (this._closed) return;
+    if (this._columns === null) this.begin([]);
+    const points = Buffer.from(String(this._points).padEnd(RAW_POINTS_WIDTH), 'latin1');
+    writeSync(this._fd, points, 0, points.length, this._pointsOffset);
+    closeSync(this._fd);
+    this._closed = true;
+  }
+
+  private _write(data: ArrayBufferView): void {
+    const bytes = new Uint8Array(data.buffer, data.byteOffset, data.byteLength);
+    let written = 0;
+    while (written < bytes.length) {
+      written += writeSync(this._fd, bytes, written, bytes.length - written, this._position + written);
+    }
+    this._position += bytes.length;
+  }
+}
@@ -0,0 +1,555 @@
+/**
+ * 🗄️ 分块列式波形存储 - AkingSPICE 2.1
+ *
+ * 取代逐点 push 的 JS 数组：
+ * - 数值列按固定大小的块存入 Float64Array (块内列优先)，每行只写入预分配缓冲区
+ * - 枚举列 (器件状态) 编码为整数并做游程编码，恒定状态每块只占一个游程
+ * - 块写满后封存，可交给 sink (如磁盘写入器) 并随即释放，长仿真内存有界
+ * - WaveformData 视图按需物化，只在首次访问某个字段时拼接已保留的块
+ * - 可选压缩：保留的块以误差有界的分段线性 + XOR 编码存储，物化时透明解码
+ * - 可选包络：追加时增量维护 min/max 金字塔，缩小视图的绘图查询代价 O(像素数)
+ */
+
+import type { Time } from '../../types/index';
+import type { WaveformData } from './circuit_simulation_engine';
+import { WaveformCodec } from './waveform_codec';
+import type { EncodedColumn, ErrorBound } from './waveform_codec';
+import { EnvelopePyramid } from './waveform_envelope';
+import type { EnvelopeQueryResult, WaveformEnvelopeOptions } from './waveform_envelope';
+
+/**
+ * 枚举列的游程 (codes[i] 持续到块内行号 ends[i]，不含)
+ */
+export interface EnumRuns {
+  readonly codes: Int32Array;
+  readonly ends: Uint32Array;
+}
+
+/**
+ * 已封存的数据块
+ */
+export interface WaveformChunk {
+  readonly index: number;
+  readonly startRow: number;
+  readonly rowCount: number;
+  readonly time: Float64Array;
+
+  /** 数值列，列优先：values[column * rowCount + row] */
+  readonly values: Float64Array;
+
+  /** 每个枚举列的游程 */
+  readonly enums: readonly EnumRuns[];
+}
+
+/**
+ * 压缩后保留在内存中的块 (时间列无损，数值列误差有界)
+ */
+interface CompressedChunk {
+  readonly index: number;
+  readonly startRow: number;
+  readonly rowCount: number;
+  readonly timeStart: Time;
+  readonly timeEnd: Time;
+  readonly time: EncodedColumn;
+  readonly columns: readonly EncodedColumn[];
+  readonly enums: readonly EnumRuns[];
+}
+
+type StoredChunk = WaveformChunk | CompressedChunk;
+
+const isCompressed = (chunk: StoredChunk): chunk is CompressedChunk => 'columns' in chunk;
+
+/**
+ * 压缩配置：误差界 max(abs, rel·|v|)，可按列覆盖
+ */
+export interface WaveformCompressionOptions {
+  readonly absoluteTolerance?: number;   // 默认 1e-6
+  readonly relativeTolerance?: number;   // 默认 1e-4
+  readonly columns?: Readonly<Record<string, Partial<ErrorBound>>>;
+}
+
+/**
+ * 块封存回调 (持久化等；sink 收到的总是未压缩的块)
+ */
+export type WaveformChunkSink = (chunk: WaveformChunk, store: WaveformStore) => void;
+
+/**
+ * 存储配置
+ */
+export interface WaveformStoreOptions {
+  /** 每块数值数据的目标字节数 (默认 1 MiB) */
+  readonly chunkBytes?: number;
+
+  /** 封存的块是否留在内存中 (默认 true；false 时交给 sink 后即释放) */
+  readonly retainChunks?: boolean;
+
+  /** 块封存回调 */
+  readonly sink?: WaveformChunkSink;
+
+  /** 保留块的压缩 (默认不压缩) */
+  readonly compression?: WaveformCompressionOptions;
+
+  /** min/max 包络金字塔 (默认不维护) */
+  readonly envelope?: WaveformEnvelopeOptions;
+}
+
+const DEFAULT_CHUNK_BYTES = 1 << 20;
+const MIN_CHUNK_ROWS = 16;
+const DEFAULT_ABSOLUTE_TOLERANCE = 1e-6;
+const DEFAULT_RELATIVE_TOLERANCE = 1e-4;
+
+/**
+ * 🗄️ 分块列式波形存储
+ */
+export class WaveformStore {
+  private readonly _numericIndex = new Map<string, number>();
+  private readonly _enumIndex = new Map<string, number>();
+  private readonly _labels: string[] = [];
+  private readonly _labelCodes = new Map<string, number>();
+
+  private readonly _chunkRows: number;
+  private readonly _retainChunks: boolean;
+  private readonly _sink: WaveformChunkSink | undefined;
+  private readonly _bounds: ErrorBound[] | null;
+  private readonly _envelope: EnvelopePyramid | null;
+
+  private readonly _chunks: StoredChunk[] = [];
+  private _sealedChunkCount = 0;
+  private _rowCount = 0;
+  private _firstRetainedRow = 0;
+
+  // 当前未封存的块
+  private _openTime: Float64Array;
+  private _openValues: Float64Array;
+  private _openRuns: { codes: number[]; ends: number[] }[];
+  private _openRows = 0;
+
+  constructor(
+    readonly numericColumns: readonly string[],
+    readonly enumColumns: readonly string[] = [],
+    options: WaveformStoreOptions = {}
+  ) {
+    numericColumns.forEach((name, i) => {
+      if (this._numericIndex.has(name)) throw new Error(`Duplicate waveform column: ${name}`);
+      this._numericIndex.set(name, i);
+    });
+    enumColumns.forEach((name, i) => {
+      if (this._enumIndex.has(name)) throw new Error(`Duplicate waveform column: ${name}`);
+      this._enumIndex.set(name, i);
+    });
+
+    const chunkBytes = options.chunkBytes ?? DEFAULT_CHUNK_BYTES;
+    this._chunkRows = Math.max(MIN_CHUNK_ROWS, Math.floor(chunkBytes / (8 * (numericColumns.length + 1))));
+    this._retainChunks = options.retainChunks ?? true;
+    this._sink = options.sink;
+
+    const compression = options.compression;
+    this._bounds = compression ? numericColumns.map(name => ({
+      absoluteTolerance: compression.columns?.[name]?.absoluteTolerance
+        ?? compression.absoluteTolerance ?? DEFAULT_ABSOLUTE_TOLERANCE,
+      relativeTolerance: compression.columns?.[name]?.relativeTolerance
+        ?? compression.relativeTolerance ?? DEFAULT_RELATIVE_TOLERANCE
+    })) : null;
+
+    this._envelope = options.envelope ? new EnvelopePyramid(numericColumns.length, options.envelope) : null;
+
+    this._openTime = new Float64Array(this._chunkRows);
+    this._openValues = new Float64Array(this._chunkRows * numericColumns.length);
+    this._openRuns = enumColumns.map(() => ({ codes: [], ends: [] }));
+  }
+
+  /** 总行数 (含已释放的块) */
+  get rowCount(): number {
+    return this._rowCount;
+  }
+
+  /** 内存中保留的第一行 */
+  get firstRetainedRow(): number {
+    return this._firstRetainedRow;
+  }
+
+  /** 已封存的块数 (含已释放的块) */
+  get sealedChunkCount(): number {
+    return this._sealedChunkCount;
+  }
+
+  /** 每块行数 */
+  get chunkRows(): number {
+    return this._chunkRows;
+  }
+
+  /** 枚举编码表 (code -> 标签) */
+  get labels(): readonly string[] {
+    return this._labels;
+  }
+
+  /** 内存中保留的已封存块 (压缩块在此解码) */
+  get chunks(): readonly WaveformChunk[] {
+    return this._chunks.map(chunk => (isCompressed(chunk) ? this._decompress(chunk) : chunk));
+  }
+
+  columnIndex(name: string): number | undefined {
+    return this._numericIndex.get(name);
+  }
+
+  enumColumnIndex(name: string): number | undefined {
+    return this._enumIndex.get(name);
+  }
+
+  /**
+   * 🔢 将状态标签编码为整数 (同一标签始终得到同一编码)
+   */
+  encode(label: string): number {
+    let code = this._labelCodes.get(label);
+    if (code === undefined) {
+      code = this._labels.length;
+      this._labels.push(label);
+      this._labelCodes.set(label, code);
+    }
+    return code;
+  }
+
+  /**
+   * ➕ 追加一行
+   *
+   * @param values 数值列 (按 numericColumns 顺序)
+   * @param enumCodes 枚举列编码 (按 enumColumns 顺序，见 encode)
+   */
+  append(time: Time, values: ArrayLike<number>, enumCodes?: ArrayLike<number>): void {
+    const row = this._openRows;
+    const stride = this._chunkRows;
+    this._openTime[row] = time;
+    for (let c = 0; c < this.numericColumns.length; c++) {
+      this._openValues[c * stride + row] = values[c]!;
+    }
+    for (let e = 0; e < this._openRuns.length; e++) {
+      const runs = this._openRuns[e]!;
+      const code = enumCodes ? enumCodes[e]! : 0;
+      const last = runs.codes.length - 1;
+      if (last >= 0 && runs.codes[last] === code) {
+        runs.ends[last] = row + 1;
+      } else {
+        runs.codes.push(code);
+        runs.ends.push(row + 1);
+      }
+    }
+
+    this._envelope?.append(time, values);
+
+    this._openRows++;
+    this._rowCount++;
+    if (this._openRows === stride) {
+      this._seal();
+    }
+  }
+
+  /**
+   * 📸 从检查点的行号与块号继续 (仅限空存储)，之前的行视为已释放
+   */
+  resumeAt(rowCount: number, sealedChunkCount: number): void {
+    if (this._rowCount > 0) throw new Error('Waveform store can only resume before the first append');
+    this._rowCount = rowCount;
+    this._firstRetainedRow = rowCount;
+    this._sealedChunkCount = sealedChunkCount;
+  }
+
+  /**
+   * 💧 封存当前未满的块 (仿真结束或检查点时调用)
+   */
+  flush(): void {
+    if (this._openRows > 0) {
+      this._seal();
+    }
+  }
+
+  /**
+   * 🧹 释放内存中全部已封存的块 (其内容应已由 sink 持久化)
+   */
+  releaseChunks(): void {
+    this._chunks.length = 0;
+    this._firstRetainedRow = this._rowCount - this._openRows;
+  }
+
+  /**
+   * 📏 当前内存占用 (字节)
+   */
+  memoryUsage(): number {
+    let bytes = this._openTime.byteLength + this._openValues.byteLength + (this._envelope?.byteLength() ?? 0);
+    for (const chunk of this._chunks) {
+      if (isCompressed(chunk)) {
+        bytes += chunk.time.words.byteLength;
+        for (const column of chunk.columns) bytes += column.words.byteLength;
+      } else {
+        bytes += chunk.time.byteLength + chunk.values.byteLength;
+      }
+      for (const runs of chunk.enums) {
+        bytes += runs.codes.byteLength + runs.ends.byteLength;
+      }
+    }
+    return bytes;
+  }
+
+  /**
+   * 🗜️ 保留块的压缩比 (原始字节 / 存储字节，未压缩时为 1)
+   */
+  compressionRatio(): number {
+    let raw = 0;
+    let stored = 0;
+    for (const chunk of this._chunks) {
+      const bytes = 8 * chunk.rowCount * (this.numericColumns.length + 1);
+      raw += bytes;
+      if (isCompressed(chunk)) {
+        stored += chunk.time.words.byteLength;
+        for (const column of chunk.columns) stored += column.words.byteLength;
+      } else {
+        stored += bytes;
+      }
+    }
+    return stored > 0 ? raw / stored : 1;
+  }
+
+  /**
+   * ⏱️ 物化时间列 (仅内存中保留的行)
+   */
+  getTime(): Float64Array {
+    const result = new Float64Array(this._rowCount - this._firstRetainedRow);
+    let offset = 0;
+    for (const chunk of this._chunks) {
+      if (isCompressed(chunk)) {
+        WaveformCodec.decodeLossless(chunk.time, result.subarray(offset, offset + chunk.rowCount));
+      } else {
+        result.set(chunk.time, offset);
+      }
+      offset += chunk.rowCount;
+    }
+    result.set(this._openTime.subarray(0, this._openRows), offset);
+    return result;
+  }
+
+  /**
+   * 📈 物化数值列 (仅内存中保留的行)
+   */
+  getColumn(name: string): Float64Array {
+    const column = this._numericIndex.get(name);
+    if (column === undefined) throw new Error(`Unknown waveform column: ${name}`);
+
+    const result = new Float64Array(this._rowCount - this._firstRetainedRow);
+    let offset = 0;
+    for (const chunk of this._chunks) {
+      if (isCompressed(chunk)) {
+        const time = new Float64Array(chunk.rowCount);
+        WaveformCodec.decodeLossless(chunk.time, time);
+        WaveformCodec.decodePiecewiseLinear(chunk.columns[column]!, time, result.subarray(offset, offset + chunk.rowCount));
+      } else {
+        result.set(chunk.values.subarray(column * chunk.rowCount, (column + 1) * chunk.rowCount), offset);
+      }
+      offset += chunk.rowCount;
+    }
+    const stride = this._chunkRows;
+    result.set(this._openValues.subarray(column * stride, column * stride + this._openRows), offset);
+    return result;
+  }
+
+  /**
+   * 📉 时间窗口 [start, end] 内按 pixels 个像素归并的 min/max 包络
+   *
+   * 取窗口内桶数不少于像素数的最粗包络层，代价 O(pixels)；
+   * 放大到最细层也不足一像素一桶时改用内存中保留的原始样本 (此时样本数本就很少)，
+   * 原始样本已释放则退回最细层。未启用包络时总是扫描原始样本。
+   */
+  getEnvelope(name: string, start: Time, end: Time, pixels: number): EnvelopeQueryResult {
+    const column = this._numericIndex.get(name);
+    if (column === undefined) throw new Error(`Unknown waveform column: ${name}`);
+    if (!(pixels >= 1) || !(end >= start)) throw new Error(`Invalid envelope query: [${start}, ${end}] x ${pixels}`);
+    pixels = Math.floor(pixels);
+
+    if (this._envelope) {
+      const level = this._envelope.levelFor(start, end, pixels);
+      if (level >= 0 || !this._retainsTime(start)) {
+        return this._envelope.query(column, start, end, pixels, Math.max(level, 0));
+      }
+    }
+
+    const result = EnvelopePyramid.createResult(start, end, pixels, 0);
+    this._scanRows(column, start, end, (t, v) => EnvelopePyramid.merge(result, start, end, t, v, v));
+    return result;
+  }
+
+  /**
+   * 🏷️ 物化枚举列为标签序列 (仅内存中保留的行)
+   */
+  getEnumColumn(name: string): string[] {
+    const column = this._enumIndex.get(name);
+    if (column === undefined) throw new Error(`Unknown waveform column: ${name}`);
+
+    const result: string[] = [];
+    const expand = (codes: ArrayLike<number>, ends: ArrayLike<number>, count: number): void => {
+      let row = 0;
+      for (let i = 0; i < count; i++) {
+        const label = this._labels[codes[i]!] ?? '';
+        for (; row < ends[i]!; row++) result.push(label);
+      }
+    };
+    for (const chunk of this._chunks) {
+      const runs = chunk.enums[column]!;
+      expand(runs.codes, runs.ends, runs.codes.length);
+    }
+    const open = this._openRuns[column]!;
+    expand(open.codes, open.ends, open.codes.length);
+    return result;
+  }
+
+  /**
+   * 🪟 创建按需物化的 WaveformData 视图
+   *
+   * @param nodeColumns 解向量索引 -> 数值列名
+   * @param currentColumns 器件 ID -> 电流数值列名
+   * @param stateColumns 器件 ID -> 状态枚举列名
+   */
+  createWaveformData(
+    nodeColumns: ReadonlyMap<number, string>,
+    currentColumns: ReadonlyMap<string, string>,
+    stateColumns: ReadonlyMap<string, string>
+  ): WaveformData {
+    const store = this;
+    let timePoints: Time[] | null = null;
+    let nodeVoltages: Map<number, readonly number[]> | null = null;
+    let deviceCurrents: Map<string, readonly number[]> | null = null;
+    let deviceStates: Map<string, readonly string[]> | null = null;
+
+    const materialize = <K>(columns: ReadonlyMap<K, string>): Map<K, readonly number[]> => {
+      const result = new Map<K, readonly number[]>();
+      for (const [key, name] of columns) {
+        result.set(key, Array.from(store.getColumn(name)));
+      }
+      return result;
+    };
+
+    return {
+      get timePoints(): readonly Time[] {
+        return (timePoints ??= Array.from(store.getTime()));
+      },
+      get nodeVoltages(): Map<number, readonly number[]> {
+        return (nodeVoltages ??= materialize(nodeColumns));
+      },
+      get deviceCurrents(): Map<string, readonly number[]> {
+        return (deviceCurrents ??= materialize(currentColumns));
+      },
+      get deviceStates(): Map<string, readonly string[]> {
+        if (!deviceStates) {
+          deviceStates = new Map();
+          for (const [key, name] of stateColumns) {
+            deviceStates.set(key, store.getEnumColumn(name));
+          }
+        }
+        return deviceStates;
+      }
+    };
+  }
+
+  // === 私有方法 ===
+
+  private _seal(): void {
+    const rows = this._openRows;
+    const stride = this._chunkRows;
+    const columns = this.numericColumns.length;
+
+    let time: Float64Array;
+    let values: Float64Array;
+    if (rows === stride) {
+      // 满块：直接移交缓冲区
+      time = this._openTime;
+      values = this._openValues;
+      this._openTime = new Float64Array(stride);
+      this._openValues = new Float64Array(stride * columns);
+    } else {
+      time = this._openTime.slice(0, rows);
+      values = new Float64Array(rows * columns);
+      for (let c = 0; c < columns; c++) {
+        values.set(this._openValues.subarray(c * stride, c * stride + rows), c * rows);
+      }
+    }
+
+    const chunk: WaveformChunk = {
+      index: this._sealedChunkCount++,
+      startRow: this._rowCount - rows,
+      rowCount: rows,
+      time,
+      values,
+      enums: this._openRuns.map(runs => ({
+        codes: Int32Array.from(runs.codes),
+        ends: Uint32Array.from(runs.ends)
+      }))
+    };
+    this._openRuns = this.enumColumns.map(() => ({ codes: [], ends: [] }));
+    this._openRows = 0;
+
+    this._sink?.(chunk, this);
+    if (this._retainChunks) {
+      this._chunks.push(this._bounds ? this._compress(chunk) : chunk);
+    } else {
+      this._firstRetainedRow = this._rowCount;
+    }
+  }
+
+  // 时刻 time 之后的样本是否都还在内存中
+  private _retainsTime(time: Time): boolean {
+    if (this._firstRetainedRow === 0) return true;
+    const first = this._chunks[0];
+    if (first) return (isCompressed(first) ? first.timeStart : first.time[0]!) <= time;
+    return this._openRows > 0 && this._openTime[0]! <= time;
+  }
+
+  // 按时间顺序访问 [start, end] 内保留的样本 (跳过时间范围不相交的块，不解码)
+  private _scanRows(column: number, start: Time, end: Time, visit: (time: Time, value: number) => void): void {
+    const scan = (time: ArrayLike<number>, values: ArrayLike<number>, offset: number, rows: number): void => {
+      for (let r = 0; r < rows; r++) {
+        const t = time[r]!;
+        if (t >= start && t <= end) visit(t, values[offset + r]!);
+      }
+    };
+
+    for (const chunk of this._chunks) {
+      const rows = chunk.rowCount;
+      if (isCompressed(chunk)) {
+        if (chunk.timeEnd < start || chunk.timeStart > end) continue;
+        const time = new Float64Array(rows);
+        const values = new Float64Array(rows);
+        WaveformCodec.decodeLossless(chunk.time, time);
+        WaveformCodec.decodePiecewiseLinear(chunk.columns[column]!, time, values);
+        scan(time, values, 0, rows);
+      } else {
+        if (chunk.time[rows - 1]! < start || chunk.time[0]! > end) continue;
+        scan(chunk.time, chunk.values, column * rows, rows);
+      }
+    }
+    scan(this._openTime, this._openValues, column * this._chunkRows, this._openRows);
+  }
+
+  private _compress(chunk: WaveformChunk): CompressedChunk {
+    const rows = chunk.rowCount;
+    return {
+      index: chunk.index,
+      startRow: chunk.startRow,
+      rowCount: rows,
+      timeStart: chunk.time[0]!,
+      timeEnd: chunk.time[rows - 1]!,
+      time: WaveformCodec.encodeLossless(chunk.time),
+      columns: this._bounds!.map((bound, c) =>
+        WaveformCodec.encodePiecewiseLinear(chunk.time, chunk.values.subarray(c * rows, (c + 1) * rows), bound)
+      ),
+      enums: chunk.enums
+    };
+  }
+
+  private _decompress(chunk: CompressedChunk): WaveformChunk {
+    const rows = chunk.rowCount;
+    const time = new Float64Array(rows);
+    WaveformCodec.decodeLossless(chunk.time, time);
+    const values = new Float64Array(rows * chunk.columns.length);
+    chunk.columns.forEach((column, c) => {
+      WaveformCodec.decodePiecewiseLinear(column, time, values.subarray(c * rows, (c + 1) * rows));
+    });
+    return { index: chunk.index, startRow: chunk.startRow, rowCount: rows, time, values, enums: chunk.enums };
+  }
+}
@@ -0,0 +1,266 @@
+/**
+ * 🧮 原地稠密 LU 分解 - AkingSPICE 2.1
+ *
+ * 小規模系統 (數十個未知量) 的快速路徑：
+ * - 矩陣以行優先存放在單一 Float64Array 中，分解結果覆蓋原矩陣
+ * - 部分主元 (按列選取絕對值最大的行)，L 為單位下三角
+ * - 緩衝區可在多次分解間重用，不產生陣列的陣列
+ *
+ * 分解形式: P·A = L·U
+ */
+
+/**
+ * 稠密 LU 分解結果 (lu 與 pivots 在分解時原地覆寫)
+ */
+export interface DenseFactorization {
+  /** 矩陣維度 */
+  readonly n: number;
+
+  /** 行優先 n×n：裝載 A，分解後嚴格下三角為 L，上三角為 U */
+  readonly lu: Float64Array;
+
+  /** 第 k 步消去時與第 k 行交換的行 */
+  readonly pivots: Int32Array;
+}
+
+/**
+ * 🚀 原地稠密 LU
+ */
+export namespace DenseLU {
+  const SOLVE_BLOCK_SIZE = 32;  // solveMany 每塊的右側向量數
+
+  /**
+   * 🆕 分配 n×n 分解緩衝區
+   */
+  export function allocate(n: number): DenseFactorization {
+    return { n, lu: new Float64Array(n * n), pivots: new Int32Array(n) };
+  }
+
+  /**
+   * 🔢 原地分解 factorization.lu (部分主元)
+   *
+   * @throws 主元為零或出現非有限值時拋出
+   */
+  export function factor(factorization: DenseFactorization): void {
+    const { n, lu, pivots } = factorization;
+    for (let k = 0; k < n; k++) {
+      // 選主元
+      let pivotRow = k;
+      let pivotMagnitude = Math.abs(lu[k * n + k]!);
+      for (let i = k + 1; i < n; i++) {
+        const magnitude = Math.abs(lu[i * n + k]!);
+        if (magnitude > pivotMagnitude) {
+          pivotMagnitude = magnitude;
+          pivotRow = i;
+        }
+      }
+      if (pivotMagnitude === 0 || !Number.isFinite(pivotMagnitude)) {
+        throw new Error(`稠密 LU 主元無效 (第 ${k} 列: ${pivotMagnitude})`);
+      }
+      pivots[k] = pivotRow;
+
+      const rowK = k * n;
+      if (pivotRow !== k) {
+        const rowP = pivotRow * n;
+        for (let j = 0; j < n; j++) {
+          const t = lu[rowK + j]!;
+          lu[rowK + j] = lu[rowP + j]!;
+          lu[rowP + j] = t;
+        }
+      }
+
+      // 消去：更新右下子矩陣
+      const pivot = lu[rowK + k]!;
+      for (let i = k + 1; i < n; i++) {
+        const rowI = i * n;
+        const lik = lu[rowI + k]! / pivot;
+        lu[rowI + k] = lik;
+        if (lik === 0) continue;
+        for (let j = k + 1; j < n; j++) {
+          lu[rowI + j]! -= lik * lu[rowK + j]!;
+        }
+      }
+    }
+  }
+
+  /**
+   * 🎯 求解 A·x = b (b 不被修改)
+   */
+  export function solve(factorization: DenseFactorization, b: ArrayLike<number>): Float64Array {
+    const { n, lu, pivots } = factorization;
+    const x = Float64Array.from(b);
+
+    // P·b
+    for (let k = 0; k < n; k++) {
+      const p = pivots[k]!;
+      if (p !== k) {
+        const t = x[k]!;
+        x[k] = x[p]!;
+        x[p] = t;
+      }
+    }
+
+    // L·y = P·b (單位下三角)
+    for (let i = 1; i < n; i++) {
+      const rowI = i * n;
+      let sum = x[i]!;
+      for (let j = 0; j < i; j++) {
+        sum -= lu[rowI + j]! * x[j]!;
+      }
+      x[i] = sum;
+    }
+
+    // U·x = y
+    for (let i = n - 1; i >= 0; i--) {
+      const rowI = i * n;
+      let sum = x[i]!;
+      for (let j = i + 1; j < n; j++) {
+        sum -= lu[rowI + j]! * x[j]!;
+      }
+      x[i] = sum / lu[rowI + i]!;
+    }
+    return x;
+  }
+
+  /**
+   * 🎯 求解 Aᵀ·x = b (Aᵀ = Uᵀ·Lᵀ·P)
+   */
+  export function solveTranspose(factorization: DenseFactorization, b: ArrayLike<number>): Float64Array {
+    const { n, lu, pivots } = factorization;
+    const x = Float64Array.from(b);
+
+    // Uᵀ·z = b
+    for (let i = 0; i < n; i++) {
+      let sum = x[i]!;
+      for (let j = 0; j < i; j++) {
+        sum -= lu[j * n + i]! * x[j]!;
+      }
+      x[i] = sum / lu[i * n + i]!;
+    }
+
+    // Lᵀ·w = z (單位上三角)
+    for (let i = n - 1; i >= 0; i--) {
+      let sum = x[i]!;
+      for (let j = i + 1; j < n; j++) {
+        sum -= lu[j * n + i]! * x[j]!;
+      }
+      x[i] = sum;
+    }
+
+    // Pᵀ·w：逆序撤銷行交換
+    for (let k = n - 1; k >= 0; k--) {
+      const p = pivots[k]!;
+      if (p !== k) {
+        const t = x[k]!;
+        x[k] = x[p]!;
+        x[p] = t;
+      }
+    }
+    return x;
+  }
+
+  /**
+   * 🎯 多右側向量求解 (transpose 時求解 Aᵀ·X = B)
+   *
+   * 右側向量按塊交錯存放 (x[i * count + s])，每個因子元素每塊只讀取一次。
+   */
+  export function solveMany(
+    factorization: DenseFactorization,
+    B: readonly ArrayLike<number>[],
+    transpose: boolean = false
+  ): Float64Array[] {
+    const { n, lu, pivots } = factorization;
+    const results: Float64Array[] = [];
+    const x = new Float64Array(n * Math.min(SOLVE_BLOCK_SIZE, B.length));
+
+    const swapRows = (k: number, count: number): void => {
+      const p = pivots[k]!;
+      if (p === k) return;
+      for (let s = 0; s < count; s++) {
+        const t = x[k * count + s]!;
+        x[k * count + s] = x[p * count + s]!;
+        x[p * count + s] = t;
+      }
+    };
+
+    for (let first = 0; first < B.length; first += SOLVE_BLOCK_SIZE) {
+      const count = Math.min(SOLVE_BLOCK_SIZE, B.length - first);
+      for (let s = 0; s < count; s++) {
+        const b = B[first + s]!;
+        for (let i = 0; i < n; i++) x[i * count + s] = b[i]!;
+      }
+
+      if (!transpose) {
+        for (let k = 0; k < n; k++) swapRows(k, count);
+        // L·Y = P·B
+        for (let i = 1; i < n; i++) {
+          const ic = i * count;
+          for (let j = 0; j < i; j++) {
+            const l = lu[i * n + j]!;
+            if (l === 0) continue;
+            const jc = j * count;
+            for (let s = 0; s < count; s++) x[ic + s]! -= l * x[jc + s]!;
+          }
+        }
+        // U·X = Y
+        for (let i = n - 1; i >= 0; i--) {
+          const ic = i * count;
+          for (let j = i + 1; j < n; j++) {
+            const u = lu[i * n + j]!;
+            if (u === 0) continue;
+            const jc = j * count;
+            for (let s = 0; s < count; s++) x[ic + s]! -= u * x[jc + s]!;
+          }
+          const pivot = lu[i * n + i]!;
+          for (let s = 0; s < count; s++) x[ic + s]! /= pivot;
+        }
+      } else {
+        // Uᵀ·Z = B
+        for (let i = 0; i < n; i++) {
+          const ic = i * count;
+          for (let j = 0; j < i; j++) {
+            const u = lu[j * n + i]!;
+            if (u === 0) continue;
+            const jc = j * count;
+            for (let s = 0; s < count; s++) x[ic + s]! -= u * x[jc + s]!;
+          }
+          const pivot = lu[i * n + i]!;
+          for (let s = 0; s < count; s++) x[ic + s]! /= pivot;
+        }
+        // Lᵀ·W = Z
+        for (let i = n - 1; i >= 0; i--) {
+          const ic = i * count;
+          for (let j = i + 1; j < n; j++) {
+            const l = lu[j * n + i]!;
+            if (l === 0) continue;
+            const jc = j * count;
+            for (let s = 0; s < count; s++) x[ic + s]! -= l * x[jc + s]!;
+          }
+        }
+        for (let k = n - 1; k >= 0; k--) swapRows(k, count);
+      }
+
+      for (let s = 0; s < count; s++) {
+        const solution = new Float64Array(n);
+        for (let i = 0; i < n; i++) solution[i] = x[i * count + s]!;
+        results.push(solution);
+      }
+    }
+    return results;
+  }
+
+  /**
+   * 📏 U 對角元 (主元) 絕對值的範圍，O(n)
+   */
+  export function pivotRange(factorization: DenseFactorization): { min: number; max: number } {
+    const { n, lu } = factorization;
+    let min = Infinity;
+    let max = 0;
+    for (let k = 0; k < n; k++) {
+      const pivot = Math.abs(lu[k * n + k]!);
+      min = Math.min(min, pivot);
+      max = Math.max(max, pivot);
+    }
+    return { min, max };
+  }
+}
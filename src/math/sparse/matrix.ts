@@ -12,7 +12,92 @@
 
 import type { ISparseMatrix, IVector } from '../../types/index';
 import { Vector } from './vector';
+import { SparseLU } from './sparse_lu';
+import type { SymbolicFactorization, NumericFactorization } from './sparse_lu';
+import { DenseLU } from './dense_lu';
+import type { DenseFactorization } from './dense_lu';
+import { ConditionEstimate } from './condition_estimate';
+import type { FactorizationDiagnostics } from './condition_estimate';
 import * as numeric from 'numeric';
+import { getLogger } from '../../core/logging/logger';
+
+const log = getLogger('sparse');
+
+/**
+ * 🎛️ 線性求解器模式
+ * - numeric:   numeric.js 稠密求解
+ * - klu:       稀疏 LU (KLU 風格，可共享符號分解)
+ * - iterative: Gauss-Seidel 迭代
+ * - auto:      首次分解時依規模與結構選擇，稀疏模式改變時重新選擇
+ */
+export type SolverMode = 'iterative' | 'numeric' | 'klu' | 'auto';
+
+/**
+ * auto 模式的候選求解器 (dense 為原地稠密 LU 快速路徑)
+ */
+export type AutoSolverChoice = 'dense' | 'klu' | 'iterative';
+
+/**
+ * 🔍 auto 模式的選擇結果與依據
+ */
+export interface SolverSelection {
+  readonly solver: AutoSolverChoice;
+  readonly n: number;
+  readonly nnz: number;
+  /** nnz / n² */
+  readonly density: number;
+  /** 非對角元中 (i,j) 與 (j,i) 同時存在的比例 (無非對角元時為 1) */
+  readonly patternSymmetry: number;
+  /** minᵢ |aᵢᵢ| / Σⱼ≠ᵢ |aᵢⱼ| (> 1 為嚴格行對角佔優) */
+  readonly diagonalDominance: number;
+}
+
+// auto 模式門檻：小系統稠密 LU 的常數開銷最低；中等規模但非零元密集時仍用稠密
+const AUTO_DENSE_MAX_SIZE = 40;
+const AUTO_DENSE_MAX_SIZE_DENSE_PATTERN = 200;
+const AUTO_DENSE_MIN_DENSITY = 0.15;
+// 迭代法僅用於大規模且強對角佔優 (Gauss-Seidel 收縮因子 ≤ 1/2) 的系統
+const AUTO_ITERATIVE_MIN_SIZE = 2000;
+const AUTO_ITERATIVE_MIN_DOMINANCE = 2;
+
+// 混合精度：最多精化步數；每步殘差至少減半，否則視為停滯
+const MAX_REFINEMENT_STEPS = 10;
+const REFINEMENT_MIN_REDUCTION = 0.5;
+
+/**
+ * 📊 線性求解統計 (計數始終累計，耗時僅在 setTimingEnabled(true) 後累計)
+ */
+export interface SolverStatistics {
+  factorizations: number;     // 完整數值分解 (稠密 LU 每次求解一次)
+  refactorizations: number;   // 沿用主元順序的稀疏數值重分解
+  solves: number;             // 三角求解次數
+  refinementSteps: number;    // 單精度因子的迭代精化步數
+  precisionFallbacks: number; // 精化停滯後改用雙精度重分解的次數
+  factorTime: number;         // 分解耗時 (ms，稠密 LU 含回代)
+  solveTime: number;          // 三角求解耗時 (ms，含迭代精化)
+}
+
+/**
+ * 分解/求解階段回調 (start、duration 為墻鐘毫秒)，用於執行軌迹
+ */
+export type SolverPhaseListener = (phase: 'factor' | 'solve', start: number, duration: number) => void;
+
+export function createSolverStatistics(): SolverStatistics {
+  return { factorizations: 0, refactorizations: 0, solves: 0, refinementSteps: 0, precisionFallbacks: 0, factorTime: 0, solveTime: 0 };
+}
+
+/**
+ * 將 source 的統計累加到 target
+ */
+export function accumulateSolverStatistics(target: SolverStatistics, source: Readonly<SolverStatistics>): void {
+  target.factorizations += source.factorizations;
+  target.refactorizations += source.refactorizations;
+  target.solves += source.solves;
+  target.refinementSteps += source.refinementSteps;
+  target.precisionFallbacks += source.precisionFallbacks;
+  target.factorTime += source.factorTime;
+  target.solveTime += source.solveTime;
+}
 
 /**
  * CSR 格式稀疏矩陣
@@ -27,13 +112,32 @@ export class SparseMatrix implements ISparseMatrix {
   private _colIndices: number[] = [];
   private _rowPointers: number[];
   private _factorized = false;
+  private _statistics: SolverStatistics = createSolverStatistics();
+  private _timing = false;
+  private _phaseListener: SolverPhaseListener | null = null;
   
   // 求解器模式: 'iterative' | 'numeric' | 'klu'
-  private _solverMode: 'iterative' | 'numeric' | 'klu' = 'numeric';
+  private _solverMode: SolverMode = 'numeric';
   
   // KLU 求解器實例 (未來使用)
   private _kluSolver: any | null = null;
 
+  // 稀疏 LU 的符號/數值分解 (klu 模式，模式不變時跨 clear() 保留)
+  private _symbolic: SymbolicFactorization | null = null;
+  private _numeric: NumericFactorization | null = null;
+
+  // auto 模式：選擇結果、選擇時的稀疏模式與稠密 LU 緩衝區
+  private _selection: SolverSelection | null = null;
+  private _selectionPattern: { rowPointers: Int32Array; colIndices: Int32Array } | null = null;
+  private _dense: DenseFactorization | null = null;
+
+  // 混合精度：稀疏 LU 因子以 Float32 存儲，精化停滯後改用雙精度直到模式改變
+  private _mixedPrecision = false;
+  private _mixedPrecisionStalled = false;
+
+  // numeric 模式最近一次 numeric.LU 的結果 (診斷時按需轉換)
+  private _numericLU: { LU: number[][]; P: number[] } | null = null;
+
   constructor(
     public readonly rows: number,
     public readonly cols: number
@@ -120,6 +224,39 @@ export class SparseMatrix implements ISparseMatrix {
     this._factorized = false;
   }
 
+  /**
+   * 📥 以 CSC 數據覆蓋矩陣內容 (保留符號分解，模式不變時可直接重分解)
+   */
+  loadCSC(csc: CSCMatrix): void {
+    if (csc.rows !== this.rows || csc.cols !== this.cols) {
+      throw new Error(`矩陣維度不匹配: ${csc.rows}x${csc.cols} vs ${this.rows}x${this.cols}`);
+    }
+    const rowPointers = new Array<number>(this.rows + 1).fill(0);
+    for (let k = 0; k < csc.nnz; k++) {
+      rowPointers[csc.rowIndices[k]! + 1]!++;
+    }
+    for (let i = 0; i < this.rows; i++) {
+      rowPointers[i + 1]! += rowPointers[i]!;
+    }
+
+    // 按列遍歷，各行內列索引自然遞增
+    const next = rowPointers.slice(0, this.rows);
+    const colIndices = new Array<number>(csc.nnz);
+    const values = new Array<number>(csc.nnz);
+    for (let j = 0; j < this.cols; j++) {
+      for (let k = csc.colPointers[j]!; k < csc.colPointers[j + 1]!; k++) {
+        const position = next[csc.rowIndices[k]!]!++;
+        colIndices[position] = j;
+        values[position] = csc.values[k]!;
+      }
+    }
+
+    this._rowPointers = rowPointers;
+    this._colIndices = colIndices;
+    this._values = values;
+    this._factorized = false;
+  }
+
   /**
    * 累加元素值
    */
@@ -172,14 +309,17 @@ export class SparseMatrix implements ISparseMatrix {
     }
 
     try {
-      console.log(`🧮 使用 ${this._solverMode} 求解器 求解 ${this.rows}x${this.cols} 線性系統...`);
+      if (log.debugEnabled) log.debug(`🧮 使用 ${this._solverMode} 求解器 求解 ${this.rows}x${this.cols} 線性系統...`);
       
       switch (this._solverMode) {
         case 'numeric':
           return this._solveWithNumeric(b);
           
         case 'klu':
-          throw new Error('KLU 求解器需要異步調用 solveAsync()');
+          return this._solveWithSparseLU(b);
+          
+        case 'auto':
+          return this._solveAuto(b);
           
         case 'iterative':
         default:
@@ -187,11 +327,11 @@ export class SparseMatrix implements ISparseMatrix {
       }
       
     } catch (error) {
-      console.error('❌ 主求解器失敗，嘗試回退策略...', error);
+      log.warn('❌ 主求解器失敗，嘗試回退策略...', error);
       
       // 回退到迭代求解器
       if (this._solverMode !== 'iterative') {
-        console.log('🔄 回退到迭代求解器...');
+        log.warn('🔄 回退到迭代求解器...');
         return this._solveIterative(b);
       }
       
@@ -214,7 +354,7 @@ export class SparseMatrix implements ISparseMatrix {
     }
 
     try {
-      console.log(`🧮 使用 ${this._solverMode} 求解器 求解 ${this.rows}x${this.cols} 線性系統...`);
+      if (log.debugEnabled) log.debug(`🧮 使用 ${this._solverMode} 求解器 求解 ${this.rows}x${this.cols} 線性系統...`);
       
       switch (this._solverMode) {
         case 'numeric':
@@ -223,17 +363,20 @@ export class SparseMatrix implements ISparseMatrix {
         case 'klu':
           return await this._solveWithKLU(b);
           
+        case 'auto':
+          return this._solveAuto(b);
+          
         case 'iterative':
         default:
           return this._solveIterative(b);
       }
       
     } catch (error) {
-      console.error('❌ 主求解器失敗，嘗試回退策略...', error);
+      log.warn('❌ 主求解器失敗，嘗試回退策略...', error);
       
       // 回退到迭代求解器
       if (this._solverMode !== 'iterative') {
-        console.log('🔄 回退到迭代求解器...');
+        log.warn('🔄 回退到迭代求解器...');
         return this._solveIterative(b);
       }
       
@@ -241,25 +384,89 @@ export class SparseMatrix implements ISparseMatrix {
     }
   }
 
+  /**
+   * 📊 累計的分解/求解統計
+   */
+  get statistics(): Readonly<SolverStatistics> {
+    return this._statistics;
+  }
+
+  /**
+   * ⏱️ 啟用/停用分解與求解計時 (停用時不調用計時器)
+   */
+  setTimingEnabled(enabled: boolean): void {
+    this._timing = enabled;
+  }
+
+  /**
+   * 🧵 設置分解/求解階段回調 (null 取消)
+   */
+  setPhaseListener(listener: SolverPhaseListener | null): void {
+    this._phaseListener = listener;
+  }
+
   /**
    * LU 分解預處理 (兼容接口)
    */
   factorize(): void {
-    // 對於 numeric 求解器，不需要預分解
-    if (this._solverMode === 'numeric' || this._solverMode === 'iterative') {
+    const solver = this._solverMode === 'auto' ? this._resolveAutoSolver() : this._solverMode;
+
+    // 對於 numeric 求解器，不需要預分解 (求解時一併分解，舊因子作廢)
+    if (solver === 'numeric' || solver === 'iterative') {
+      this._numericLU = null;
       this._factorized = true;
       return;
     }
     
-    // 對於 KLU，在第一次 solve 時進行分解
+    const start = this._timed ? performance.now() : 0;
+    if (solver === 'dense') {
+      this._factorDense();
+    } else {
+      // 對於 KLU：模式不變時沿用符號分析，並優先嘗試數值重分解
+      const csc = this.toCSC();
+      if (!this._symbolic || !SparseLU.matchesPattern(this._symbolic, csc)) {
+        this._symbolic = SparseLU.analyze(csc);
+        this._numeric = null;
+        this._mixedPrecisionStalled = false;
+      }
+      const precision = this._mixedPrecision && !this._mixedPrecisionStalled ? 'single' : 'double';
+      if (this._numeric && this._numeric.symbolic === this._symbolic
+          && SparseLU.precision(this._numeric) === precision && SparseLU.refactor(this._numeric, csc)) {
+        this._statistics.refactorizations++;
+      } else {
+        this._numeric = SparseLU.factor(this._symbolic, csc, { precision });
+        this._statistics.factorizations++;
+      }
+    }
     this._factorized = true;
+    if (this._timed) this._endPhase('factor', start);
+  }
+
+  /**
+   * 🔗 獲取符號分解 (可供相同拓撲的其他矩陣共享)
+   */
+  getSymbolicFactorization(): SymbolicFactorization | null {
+    return this._symbolic;
+  }
+
+  /**
+   * 🔗 設置共享的符號分解
+   * 
+   * 若稀疏模式不一致，下一次分解時會自動重新分析。
+   */
+  setSymbolicFactorization(symbolic: SymbolicFactorization | null): void {
+    if (symbolic !== this._symbolic) {
+      this._symbolic = symbolic;
+      this._numeric = null;
+      this._factorized = false;
+    }
   }
 
   /**
    * 使用 numeric.js 庫求解 (短期方案)
    */
   private _solveWithNumeric(b: IVector): IVector {
-    console.log('📊 使用 numeric.js 求解稠密線性系統...');
+    log.debug('📊 使用 numeric.js 求解稠密線性系統...');
     
     // 轉換為稠密矩阵
     const denseA = this.toDense();
@@ -270,37 +477,42 @@ export class SparseMatrix implements ISparseMatrix {
     const hasNaNInRHS = denseB.some(v => isNaN(v));
     
     if (hasNaNInMatrix) {
-      console.error('🔥 Matrix contains NaN before solve!');
+      log.error('🔥 Matrix contains NaN before solve!');
       throw new Error('Matrix contains NaN values');
     }
     if (hasNaNInRHS) {
-      console.error('🔥 RHS contains NaN before solve!');
+      log.error('🔥 RHS contains NaN before solve!');
       throw new Error('RHS contains NaN values');
     }
     
     try {
-      // 使用 numeric.solve 求解
-      const solution = numeric.solve(denseA, denseB);
+      // 與 numeric.solve 相同的 LU + 回代，保留因子供診斷 (合併計入分解)
+      const start = this._timed ? performance.now() : 0;
+      this._numericLU = numeric.LU(denseA);
+      const solution = numeric.LUsolve(this._numericLU, denseB);
+      this._factorized = true;
+      this._statistics.factorizations++;
+      this._statistics.solves++;
+      if (this._timed) this._endPhase('factor', start);
       
       // 檢查解是否包含 NaN 或 Infinity
       const hasNaNInSolution = solution.some((v: number) => isNaN(v) || !isFinite(v));
       if (hasNaNInSolution) {
-        console.error('🔥 Solution contains NaN/Infinity! Matrix may be singular.');
-        console.log('Matrix condition check needed...');
-        // 輸出矩陣診斷信息
-        const det = numeric.det(denseA);
-        console.log(`   Determinant: ${det}`);
-        if (Math.abs(det) < 1e-10) {
-          throw new Error(`Matrix is singular or near-singular (det=${det})`);
+        log.error('🔥 Solution contains NaN/Infinity! Matrix may be singular.');
+        // 由既有因子輸出主元與條件數診斷
+        const diagnostics = this.getFactorizationDiagnostics()!;
+        log.error(`   Pivots: min ${diagnostics.minPivot}, max ${diagnostics.maxPivot}; κ₁ ≈ ${diagnostics.conditionEstimate}`);
+        if (diagnostics.reciprocalCondition < Number.EPSILON) {
+          throw new Error(`Matrix is singular or near-singular (κ₁≈${diagnostics.conditionEstimate})`);
         }
         throw new Error('Solution contains NaN or Infinity');
       }
       
-      console.log('✅ numeric.js 求解成功');
+      log.debug('✅ numeric.js 求解成功');
       return Vector.from(solution);
       
     } catch (error) {
-      console.error('❌ numeric.js 求解失敗:', error);
+      log.error('❌ numeric.js 求解失敗:', error);
       throw new Error(`numeric.solve failed: ${error}`);
     }
   }
@@ -309,22 +521,136 @@ export class SparseMatrix implements ISparseMatrix {
    * 使用 KLU WASM 求解稀疏線性系統
    */
   private async _solveWithKLU(b: IVector): Promise<IVector> {
-    console.log('🔬 KLU WASM 不可用，使用迭代求解器...');
-    
-    // 暫時使用迭代求解器作作为 KLU 的替代方案
-    // 這確保了通用電力電子模擬器的穩定性
-    return this._solveIterative(b);
+    // KLU WASM 尚未接入，使用同介面的 TypeScript 稀疏 LU
+    return this._solveWithSparseLU(b);
+  }
+
+  /**
+   * 使用稀疏 LU (KLU 風格) 求解
+   */
+  private _solveWithSparseLU(b: IVector): IVector {
+    if (!this._factorized || !this._numeric) {
+      this.factorize();
+    }
+    if (SparseLU.precision(this._numeric!) === 'single') {
+      return this._solveWithRefinement([b], false)[0]!;
+    }
+    const start = this._timed ? performance.now() : 0;
+    const solution = SparseLU.solve(this._numeric!, b.toArray());
+    this._statistics.solves++;
+    if (this._timed) this._endPhase('solve', start);
+    return Vector.from(Array.from(solution));
+  }
+
+  /**
+   * 單精度因子 + 迭代精化 (全部右側向量共用分塊求解)
+   *
+   * 以 Float64 計算殘差 r = b − A·x (轉置時 b − Aᵀ·x)，再用同一因子求修正量。
+   * ‖r‖∞ ≤ √n·ε·‖A‖∞·‖x‖∞ (LAPACK dsgesv 準則) 時收斂；
+   * 任一向量殘差下降不足一半或步數用盡時，改用雙精度重新分解並求解。
+   */
+  private _solveWithRefinement(B: readonly IVector[], transpose: boolean): IVector[] {
+    const start = this._timed ? performance.now() : 0;
+    const numeric = this._numeric!;
+    const solutions = SparseLU.solveMany(numeric, B.map(b => b.toArray()), transpose)
+      .map(x => Vector.from(Array.from(x)));
+    this._statistics.solves += B.length;
+
+    const norm = transpose ? this._oneNorm() : this._infinityNorm();
+    const tolerance = Math.sqrt(this.rows) * Number.EPSILON * norm;
+    const previousNorms = new Array<number>(B.length).fill(Infinity);
+    let active = B.map((_, s) => s);
+    let stalled = false;
+    for (let step = 0; active.length > 0 && !stalled; step++) {
+      const refining: number[] = [];
+      const residuals: number[][] = [];
+      for (const s of active) {
+        const x = solutions[s]!;
+        const residual = B[s]!.minus(transpose ? this._multiplyTranspose(x) : this.multiply(x)).toArray();
+        const residualNorm = maxAbs(residual);
+        if (residualNorm <= tolerance * maxAbs(x.toArray())) continue;
+        if (step === MAX_REFINEMENT_STEPS || !(residualNorm < previousNorms[s]! * REFINEMENT_MIN_REDUCTION)) {
+          stalled = true;
+          break;
+        }
+        previousNorms[s] = residualNorm;
+        refining.push(s);
+        residuals.push(residual);
+      }
+      if (stalled || refining.length === 0) break;
+
+      const corrections = SparseLU.solveMany(numeric, residuals, transpose);
+      refining.forEach((s, r) => {
+        const correction = corrections[r]!;
+        for (let i = 0; i < this.rows; i++) solutions[s]!.add(i, correction[i]!);
+      });
+      this._statistics.solves += refining.length;
+      this._statistics.refinementSteps += refining.length;
+      active = refining;
+    }
+    if (this._timed) this._endPhase('solve', start);
+    if (!stalled) return solutions;
+
+    log.debug('🔁 單精度因子迭代精化停滯，改用雙精度分解');
+    this._statistics.precisionFallbacks++;
+    this._mixedPrecisionStalled = true;
+    this._factorized = false;
+    return this._solveManyFactored(B, transpose);
+  }
+
+  /**
+   * 使用原地稠密 LU 求解 (auto 模式的小系統快速路徑)
+   */
+  private _solveWithDenseLU(b: IVector): IVector {
+    if (!this._factorized || !this._dense) {
+      this.factorize();
+    }
+    const start = this._timed ? performance.now() : 0;
+    const solution = DenseLU.solve(this._dense!, b.toArray());
+    this._statistics.solves++;
+    if (this._timed) this._endPhase('solve', start);
+    return Vector.from(Array.from(solution));
+  }
+
+  /**
+   * auto 模式求解：按選擇結果分派，迭代未收斂時改用稀疏 LU 直到模式改變
+   */
+  private _solveAuto(b: IVector): IVector {
+    if (!this._factorized) {
+      this.factorize();
+    }
+    switch (this._selection!.solver) {
+      case 'dense':
+        return this._solveWithDenseLU(b);
+
+      case 'klu':
+        return this._solveWithSparseLU(b);
+
+      case 'iterative': {
+        const { solution, converged } = this._gaussSeidel(b);
+        if (converged) return solution;
+        log.debug('🔄 auto: 迭代未收斂，改用稀疏 LU');
+        this._selection = { ...this._selection!, solver: 'klu' };
+        this._factorized = false;
+        return this._solveWithSparseLU(b);
+      }
+    }
   }
 
   /**
    * 迭代求解器 (Gauss-Seidel)
    */
   private _solveIterative(b: IVector): IVector {
-    console.log('🔄 使用 Gauss-Seidel 迭代求解...');
+    return this._gaussSeidel(b).solution;
+  }
+
+  private _gaussSeidel(b: IVector): { solution: IVector; converged: boolean } {
+    log.debug('🔄 使用 Gauss-Seidel 迭代求解...');
     
     const x = new Vector(this.rows);
     const maxIterations = 100;
     const tolerance = 1e-12;
+    let converged = false;
     
     for (let iter = 0; iter < maxIterations; iter++) {
       let maxChange = 0;
@@ -359,24 +685,105 @@ export class SparseMatrix implements ISparseMatrix {
       
       // 檢查收敛
       if (maxChange < tolerance) {
-        if (iter > 0) {
-          console.log(`✅ 迭代求解收敛: ${iter + 1} 次, 誤差: ${maxChange.toExponential(2)}`);
+        if (iter > 0 && log.debugEnabled) {
+          log.debug(`✅ 迭代求解收敛: ${iter + 1} 次, 誤差: ${maxChange.toExponential(2)}`);
         }
+        converged = true;
         break;
       }
     }
     
-    return x;
+    return { solution: x, converged };
   }
 
   /**
    * 設置求解器模式
    */
-  setSolverMode(mode: 'iterative' | 'numeric' | 'klu'): void {
+  setSolverMode(mode: SolverMode): void {
     this._solverMode = mode;
+    this._selection = null;
+    this._selectionPattern = null;
+    this._numericLU = null;
+    this._factorized = false;
+  }
+
+  /**
+   * 🚀 多右側向量求解 A·X = B (transpose 時 Aᵀ·X = B)
+   *
+   * 直接求解器只分解一次，並以分塊三角求解處理全部右側向量；
+   * 迭代模式逐個求解。直接求解失敗時與 solve() 相同回退到迭代求解。
+   */
+  solveMany(B: readonly IVector[], transpose: boolean = false): IVector[] {
+    if (this.rows !== this.cols) {
+      throw new Error('求解器僅支持方陣');
+    }
+    for (const b of B) {
+      if (b.size !== this.rows) {
+        throw new Error(`右側向量維度不匹配: ${b.size} vs ${this.rows}`);
+      }
+    }
+    if (B.length === 0) return [];
+
+    try {
+      return this._solveManyFactored(B, transpose);
+    } catch (error) {
+      log.warn('❌ 主求解器失敗，回退到迭代求解器...', error);
+      return this._solveManyIterative(B, transpose);
+    }
+  }
+
+  /**
+   * 🔁 求解 Aᵀ·x = b (伴隨/靈敏度分析)，沿用 A 的分解
+   */
+  solveTranspose(b: IVector): IVector {
+    return this.solveMany([b], true)[0]!;
+  }
+
+  /**
+   * 🩺 由最近一次分解的因子計算主元範圍與 1-範數條件數估計
+   *
+   * 只做 O(nnz) 的 ‖A‖₁ 與數次前代/回代，不重新分解。
+   * 尚未分解、矩陣已修改或使用迭代求解器時返回 null。
+   */
+  getFactorizationDiagnostics(): FactorizationDiagnostics | null {
+    if (!this._factorized) return null;
+    const solver = this._solverMode === 'auto' ? this._selection?.solver : this._solverMode;
+
+    if (solver === 'klu' && this._numeric) {
+      const factors = this._numeric;
+      const inverseNorm = ConditionEstimate.inverseOneNorm(this.rows,
+        b => SparseLU.solve(factors, b), b => SparseLU.solveTranspose(factors, b));
+      return ConditionEstimate.diagnostics('klu', this._oneNorm(), inverseNorm, SparseLU.pivotRange(factors));
+    }
+
+    const dense = solver === 'dense' ? this._dense
+      : solver === 'numeric' && this._numericLU ? this._packNumericLU(this._numericLU)
+      : null;
+    if (!dense) return null;
+    const inverseNorm = ConditionEstimate.inverseOneNorm(this.rows,
+      b => DenseLU.solve(dense, b), b => DenseLU.solveTranspose(dense, b));
+    return ConditionEstimate.diagnostics(solver as 'dense' | 'numeric', this._oneNorm(), inverseNorm, DenseLU.pivotRange(dense));
+  }
+
+  /**
+   * 🎚️ 啟用/停用混合精度 (稀疏 LU 因子以 Float32 存儲並以迭代精化恢復雙精度)
+   *
+   * 作用於 klu 模式及 auto 選中稀疏 LU 時。
+   */
+  setMixedPrecision(enabled: boolean): void {
+    if (enabled === this._mixedPrecision) return;
+    this._mixedPrecision = enabled;
+    this._mixedPrecisionStalled = false;
     this._factorized = false;
   }
 
+  /**
+   * 🔍 auto 模式當前的求解器選擇 (首次分解前或非 auto 模式時為 null)
+   */
+  get solverSelection(): SolverSelection | null {
+    return this._selection;
+  }
+
   /**
    * 釋放 WASM 佔用的內存
    */
@@ -393,7 +800,7 @@ export class SparseMatrix implements ISparseMatrix {
       try {
         this._kluSolver.dispose();
       } catch (error) {
-        console.warn('⚠️ KLU 求解器清理時發生錯誤:', error);
+        log.warn('⚠️ KLU 求解器清理時發生錯誤:', error);
       }
       this._kluSolver = null;
     }
@@ -408,6 +815,7 @@ export class SparseMatrix implements ISparseMatrix {
     this._rowPointers.fill(0);
     this._factorized = false;
     this._kluSolver = null;
+    // 保留 _symbolic / _numeric：重新裝配後模式通常不變，可直接重分解
   }
 
   /**
@@ -415,7 +823,7 @@ export class SparseMatrix implements ISparseMatrix {
    */
   getInfo(): MatrixInfo {
     const fillIn = this.nnz / (this.rows * this.cols);
-    const symmetric = this._isSymmetric();
+    const { patternSymmetry, symmetric } = this._symmetry();
     
     return {
       rows: this.rows,
@@ -423,7 +831,10 @@ export class SparseMatrix implements ISparseMatrix {
       nnz: this.nnz,
       fillIn,
       symmetric,
-      factorized: this._factorized
+      patternSymmetry,
+      factorized: this._factorized,
+      solverMode: this._solverMode,
+      solverSelection: this._selection
     };
   }
 
@@ -486,63 +897,182 @@ export class SparseMatrix implements ISparseMatrix {
    * @returns 一個包含子矩陣和索引映射的對象
    */
   submatrix(rowsToRemove: number[], colsToRemove: number[]): { matrix: ISparseMatrix, mapping: number[] } {
+    const subMatrix = new SparseMatrix(this.rows - rowsToRemove.length, this.cols - colsToRemove.length);
+    subMatrix._solverMode = this._solverMode;
+    subMatrix._mixedPrecision = this._mixedPrecision;
+    const mapping = subMatrix.loadSubmatrix(this, rowsToRemove, colsToRemove);
+    return { matrix: subMatrix, mapping };
+  }
+
+  /**
+   * 📥 以 source 移除指定行列後的內容原地覆蓋本矩陣
+   *
+   * 與 loadCSC 相同保留求解器狀態 (auto 選擇、稠密緩衝區、符號/數值分解)，
+   * 模式不變時下一次求解只做數值重分解。
+   *
+   * @returns 從新列索引到原列索引的映射，用於還原解
+   */
+  loadSubmatrix(source: SparseMatrix, rowsToRemove: number[], colsToRemove: number[]): number[] {
+    if (source.rows - rowsToRemove.length !== this.rows || source.cols - colsToRemove.length !== this.cols) {
+      throw new Error(`子矩陣維度不匹配: ${source.rows - rowsToRemove.length}x${source.cols - colsToRemove.length} vs ${this.rows}x${this.cols}`);
+    }
     const rowsToRemoveSet = new Set(rowsToRemove);
     const colsToRemoveSet = new Set(colsToRemove);
-
-    const newRows = this.rows - rowsToRemove.length;
-    const newCols = this.cols - colsToRemove.length;
-
-    const subMatrix = new SparseMatrix(newRows, newCols);
-    
-    // 創建從舊索引到新索引的映射
-    const rowMapping: number[] = [];
-    let currentRow = 0;
-    for (let i = 0; i < this.rows; i++) {
-      if (!rowsToRemoveSet.has(i)) {
-        rowMapping[i] = currentRow++;
+    const colMapping = new Array<number>(source.cols).fill(-1);
+    const inverseColMapping: number[] = [];
+    for (let j = 0; j < source.cols; j++) {
+      if (!colsToRemoveSet.has(j)) {
+        colMapping[j] = inverseColMapping.length;
+        inverseColMapping.push(j);
       }
     }
 
-    const colMapping: number[] = [];
-    let currentCol = 0;
-    for (let i = 0; i < this.cols; i++) {
-      if (!colsToRemoveSet.has(i)) {
-        colMapping[i] = currentCol++;
+    // 源矩陣各行列索引遞增，映射保序，直接按行複製即得有效 CSR
+    const rowPointers = new Array<number>(this.rows + 1);
+    const colIndices: number[] = [];
+    const values: number[] = [];
+    let row = 0;
+    rowPointers[0] = 0;
+    for (let i = 0; i < source.rows; i++) {
+      if (rowsToRemoveSet.has(i)) continue;
+      for (let k = source._rowPointers[i]!; k < source._rowPointers[i + 1]!; k++) {
+        const col = colMapping[source._colIndices[k]!]!;
+        if (col < 0) continue;
+        colIndices.push(col);
+        values.push(source._values[k]!);
       }
+      rowPointers[++row] = values.length;
     }
 
-    // 填充子矩陣
-    for (let i = 0; i < this.rows; i++) {
-      if (rowsToRemoveSet.has(i)) continue;
+    this._rowPointers = rowPointers;
+    this._colIndices = colIndices;
+    this._values = values;
+    this._factorized = false;
+    return inverseColMapping;
+  }
 
-      const start = this._rowPointers[i]!
-      const end = this._rowPointers[i + 1]!;
+  // 私有方法
 
-      for (let k = start; k < end; k++) {
-        const j = this._colIndices[k]!;
-        if (colsToRemoveSet.has(j)) continue;
+  private get _timed(): boolean {
+    return this._timing || this._phaseListener !== null;
+  }
 
-        const newRow = rowMapping[i]!;
-        const newCol = colMapping[j]!;
-        const value = this._values[k]!;
-        
-        subMatrix.add(newRow, newCol, value);
+  private _endPhase(phase: 'factor' | 'solve', start: number): void {
+    const duration = performance.now() - start;
+    if (this._timing) {
+      if (phase === 'factor') this._statistics.factorTime += duration;
+      else this._statistics.solveTime += duration;
+    }
+    this._phaseListener?.(phase, start, duration);
+  }
+
+  /**
+   * auto 模式：稀疏模式與上次選擇時一致則沿用，否則重新選擇
+   */
+  private _resolveAutoSolver(): AutoSolverChoice {
+    if (!this._selection || !this._patternMatchesSelection()) {
+      this._selection = this._selectSolver();
+      this._selectionPattern = {
+        rowPointers: Int32Array.from(this._rowPointers),
+        colIndices: Int32Array.from(this._colIndices)
+      };
+      if (log.debugEnabled) {
+        const s = this._selection;
+        log.debug(`🎛️ auto: 選擇 ${s.solver} (n=${s.n}, nnz=${s.nnz}, 模式對稱 ${s.patternSymmetry.toFixed(2)}, 對角佔優 ${s.diagonalDominance.toExponential(2)})`);
       }
     }
+    return this._selection.solver;
+  }
 
-    // 返回從新索引到舊索引的映射，用於還原解
-    const inverseColMapping: number[] = [];
-    for(let i=0; i<colMapping.length; i++) {
-      if(colMapping[i] !== undefined) {
-        inverseColMapping[colMapping[i]!] = i;
+  private _patternMatchesSelection(): boolean {
+    const pattern = this._selectionPattern;
+    if (!pattern || pattern.colIndices.length !== this._colIndices.length) return false;
+    for (let i = 0; i <= this.rows; i++) {
+      if (pattern.rowPointers[i] !== this._rowPointers[i]) return false;
+    }
+    for (let k = 0; k < this._colIndices.length; k++) {
+      if (pattern.colIndices[k] !== this._colIndices[k]) return false;
+    }
+    return true;
+  }
+
+  /**
+   * O(nnz·log) 掃描 CSR：規模、密度、模式對稱性與行對角佔優度
+   */
+  private _selectSolver(): SolverSelection {
+    const n = this.rows;
+    const nnz = this.nnz;
+    let diagonalDominance = Infinity;
+
+    for (let i = 0; i < n; i++) {
+      let diagonal = 0;
+      let offDiagonalSum = 0;
+      for (let k = this._rowPointers[i]!; k < this._rowPointers[i + 1]!; k++) {
+        const magnitude = Math.abs(this._values[k]!);
+        if (this._colIndices[k] === i) {
+          diagonal = magnitude;
+        } else {
+          offDiagonalSum += magnitude;
+        }
+      }
+      if (offDiagonalSum > 0) {
+        diagonalDominance = Math.min(diagonalDominance, diagonal / offDiagonalSum);
+      } else if (diagonal === 0) {
+        diagonalDominance = 0;
       }
     }
 
-    return { matrix: subMatrix, mapping: inverseColMapping };
+    const density = n > 0 ? nnz / (n * n) : 1;
+    let solver: AutoSolverChoice = 'klu';
+    if (n <= AUTO_DENSE_MAX_SIZE || (n <= AUTO_DENSE_MAX_SIZE_DENSE_PATTERN && density >= AUTO_DENSE_MIN_DENSITY)) {
+      solver = 'dense';
+    } else if (n >= AUTO_ITERATIVE_MIN_SIZE && diagonalDominance >= AUTO_ITERATIVE_MIN_DOMINANCE) {
+      solver = 'iterative';
+    }
+
+    return {
+      solver,
+      n,
+      nnz,
+      density,
+      patternSymmetry: this._symmetry().patternSymmetry,
+      diagonalDominance
+    };
   }
 
+  /** 在第 row 行 (列索引遞增) 中二分查找 col，返回存儲位置或 -1 */
+  private _findInRow(row: number, col: number): number {
+    let low = this._rowPointers[row]!;
+    let high = this._rowPointers[row + 1]! - 1;
+    while (low <= high) {
+      const mid = (low + high) >> 1;
+      const c = this._colIndices[mid]!;
+      if (c === col) return mid;
+      if (c < col) low = mid + 1;
+      else high = mid - 1;
+    }
+    return -1;
+  }
 
-  // 私有方法
+  /**
+   * 以行優先 Float64Array 裝載並原地分解 (重用緩衝區)
+   */
+  private _factorDense(): void {
+    const n = this.rows;
+    if (!this._dense || this._dense.n !== n) {
+      this._dense = DenseLU.allocate(n);
+    }
+    const lu = this._dense.lu;
+    lu.fill(0);
+    for (let i = 0; i < n; i++) {
+      const row = i * n;
+      for (let k = this._rowPointers[i]!; k < this._rowPointers[i + 1]!; k++) {
+        lu[row + this._colIndices[k]!] = this._values[k]!;
+      }
+    }
+    DenseLU.factor(this._dense);
+    this._statistics.factorizations++;
+  }
 
   private _validateIndices(row: number, col: number): void {
     if (row < 0 || row >= this.rows) {
@@ -573,29 +1103,159 @@ export class SparseMatrix implements ISparseMatrix {
     }
   }
 
-  private _isSymmetric(): boolean {
-    if (this.rows !== this.cols) return false;
-    
-    // 檢查對稱性
+  /**
+   * 沿稀疏模式檢查對稱性 O(nnz·log)：每個非對角元在鏡像行中二分查找 (j,i)
+   */
+  private _symmetry(): { patternSymmetry: number; symmetric: boolean } {
+    if (this.rows !== this.cols) return { patternSymmetry: 0, symmetric: false };
+
+    let offDiagonal = 0;
+    let mirrored = 0;
+    let symmetric = true;
     for (let i = 0; i < this.rows; i++) {
-      for (let j = i + 1; j < this.cols; j++) {
-        if (Math.abs(this.get(i, j) - this.get(j, i)) > 1e-12) {
-          return false;
+      for (let k = this._rowPointers[i]!; k < this._rowPointers[i + 1]!; k++) {
+        const j = this._colIndices[k]!;
+        if (j === i) continue;
+        offDiagonal++;
+        const mirror = this._findInRow(j, i);
+        if (mirror >= 0) {
+          mirrored++;
+          if (Math.abs(this._values[k]! - this._values[mirror]!) > 1e-12) symmetric = false;
+        } else if (Math.abs(this._values[k]!) > 1e-12) {
+          symmetric = false;
         }
       }
     }
-    
-    return true;
+    return { patternSymmetry: offDiagonal > 0 ? mirrored / offDiagonal : 1, symmetric };
+  }
+
+  /** ‖A‖₁ = 最大列絕對值和 */
+  private _oneNorm(): number {
+    const columnSums = new Float64Array(this.cols);
+    for (let k = 0; k < this._values.length; k++) {
+      columnSums[this._colIndices[k]!]! += Math.abs(this._values[k]!);
+    }
+    let norm = 0;
+    for (let j = 0; j < this.cols; j++) norm = Math.max(norm, columnSums[j]!);
+    return norm;
+  }
+
+  /**
+   * 按當前求解器確保因子可用並分塊求解 (迭代模式改為逐個求解)
+   */
+  private _solveManyFactored(B: readonly IVector[], transpose: boolean): IVector[] {
+    if (!this._factorized) {
+      this.factorize();
+    }
+    const solver = this._solverMode === 'auto' ? this._selection!.solver : this._solverMode;
+    const rhs = B.map(b => b.toArray());
+
+    let dense: DenseFactorization;
+    switch (solver) {
+      case 'iterative':
+        return this._solveManyIterative(B, transpose);
+
+      case 'klu': {
+        if (!this._numeric) this.factorize();
+        if (SparseLU.precision(this._numeric!) === 'single') {
+          return this._solveWithRefinement(B, transpose);
+        }
+        const start = this._timed ? performance.now() : 0;
+        const solutions = SparseLU.solveMany(this._numeric!, rhs, transpose);
+        this._statistics.solves += B.length;
+        if (this._timed) this._endPhase('solve', start);
+        return solutions.map(x => Vector.from(Array.from(x)));
+      }
+
+      case 'dense':
+        if (!this._dense) this.factorize();
+        dense = this._dense!;
+        break;
+
+      case 'numeric':
+      default:
+        if (!this._numericLU) {
+          const start = this._timed ? performance.now() : 0;
+          this._numericLU = numeric.LU(this.toDense());
+          this._statistics.factorizations++;
+          if (this._timed) this._endPhase('factor', start);
+        }
+        dense = this._packNumericLU(this._numericLU);
+        break;
+    }
+
+    const start = this._timed ? performance.now() : 0;
+    const solutions = DenseLU.solveMany(dense, rhs, transpose);
+    this._statistics.solves += B.length;
+    if (this._timed) this._endPhase('solve', start);
+    for (const x of solutions) {
+      if (x.some(v => !Number.isFinite(v))) throw new Error('Solution contains NaN or Infinity');
+    }
+    return solutions.map(x => Vector.from(Array.from(x)));
+  }
+
+  private _solveManyIterative(B: readonly IVector[], transpose: boolean): IVector[] {
+    if (!transpose) return B.map(b => this._solveIterative(b));
+    // Aᵀ 的 CSR 即 A 的 CSC：直接以 A 的 CSR 數組裝載
+    const transposed = new SparseMatrix(this.cols, this.rows);
+    transposed.loadCSC({
+      rows: this.cols,
+      cols: this.rows,
+      nnz: this.nnz,
+      colPointers: this._rowPointers,
+      rowIndices: this._colIndices,
+      values: this._values
+    });
+    return B.map(b => transposed._solveIterative(b));
+  }
+
+  /** y = Aᵀ·x */
+  private _multiplyTranspose(x: IVector): IVector {
+    const y = new Vector(this.cols);
+    for (let i = 0; i < this.rows; i++) {
+      const xi = x.get(i);
+      if (xi === 0) continue;
+      for (let k = this._rowPointers[i]!; k < this._rowPointers[i + 1]!; k++) {
+        y.add(this._colIndices[k]!, this._values[k]! * xi);
+      }
+    }
+    return y;
+  }
+
+  /** ‖A‖∞ = 最大行絕對值和 */
+  private _infinityNorm(): number {
+    let norm = 0;
+    for (let i = 0; i < this.rows; i++) {
+      let sum = 0;
+      for (let k = this._rowPointers[i]!; k < this._rowPointers[i + 1]!; k++) {
+        sum += Math.abs(this._values[k]!);
+      }
+      norm = Math.max(norm, sum);
+    }
+    return norm;
+  }
+
+  /** numeric.LU 的行數組結果複製為行優先稠密因子 */
+  private _packNumericLU(lup: { LU: number[][]; P: number[] }): DenseFactorization {
+    const n = this.rows;
+    const packed = DenseLU.allocate(n);
+    for (let i = 0; i < n; i++) {
+      packed.lu.set(lup.LU[i]!, i * n);
+      packed.pivots[i] = lup.P[i]!;
+    }
+    return packed;
   }
 
   /**
-   * 克隆矩陣
+   * 克隆矩陣 (連同求解器模式與混合精度設置，不含分解結果)
    */
   clone(): SparseMatrix {
     const cloned = new SparseMatrix(this.rows, this.cols);
     cloned._values = [...this._values];
     cloned._colIndices = [...this._colIndices];
     cloned._rowPointers = [...this._rowPointers];
+    cloned._solverMode = this._solverMode;
+    cloned._mixedPrecision = this._mixedPrecision;
     cloned._factorized = false;
     return cloned;
   }
@@ -661,6 +1321,12 @@ export class SparseMatrix implements ISparseMatrix {
   }
 }
 
+function maxAbs(values: ArrayLike<number>): number {
+  let max = 0;
+  for (let i = 0; i < values.length; i++) max = Math.max(max, Math.abs(values[i]!));
+  return max;
+}
+
 /**
  * CSC 格式矩陣數據結構
  */
@@ -679,5 +1345,10 @@ export interface MatrixInfo {
   readonly nnz: number;
   readonly fillIn: number;
   readonly symmetric: boolean;
+  /** 非對角元中 (i,j) 與 (j,i) 同時存在的比例 (無非對角元時為 1) */
+  readonly patternSymmetry: number;
   readonly factorized: boolean;
+  readonly solverMode: SolverMode;
+  /** auto 模式的選擇結果 (首次分解前或非 auto 模式時為 null) */
+  readonly solverSelection: SolverSelection | null;
 }
\ No newline at end of file
@@ -0,0 +1,113 @@
+/**
+ * 📄 MatrixMarket 文本格式 - AkingSPICE 2.1
+ *
+ * 讀寫 NIST MatrixMarket 交換格式 (https://math.nist.gov/MatrixMarket/formats.html)：
+ * - 稀疏矩陣：coordinate real general (讀取另支持 integer / symmetric)
+ * - 向量：array real general (n × 1)
+ * 數值以最短可往返的十進制輸出，讀回後逐位相同。
+ */
+
+import type { CSCMatrix } from './matrix';
+
+const MATRIX_BANNER = '%%MatrixMarket matrix coordinate real general';
+const VECTOR_BANNER = '%%MatrixMarket matrix array real general';
+
+export namespace MatrixMarket {
+  /**
+   * 📝 輸出稀疏矩陣 (索引從 1 開始，按列優先順序)
+   * @param comments 附加的註釋行 (不含前導 %)
+   */
+  export function formatMatrix(matrix: CSCMatrix, comments: readonly string[] = []): string {
+    const lines = [MATRIX_BANNER, ...comments.map(comment => `% ${comment}`), `${matrix.rows} ${matrix.cols} ${matrix.nnz}`];
+    for (let j = 0; j < matrix.cols; j++) {
+      for (let k = matrix.colPointers[j]!; k < matrix.colPointers[j + 1]!; k++) {
+        lines.push(`${matrix.rowIndices[k]! + 1} ${j + 1} ${matrix.values[k]!}`);
+      }
+    }
+    return `${lines.join('\n')}\n`;
+  }
+
+  /**
+   * 📖 讀取 coordinate 格式稀疏矩陣為 CSC (重複項累加)
+   */
+  export function parseMatrix(text: string): CSCMatrix {
+    const { header, body } = split(text);
+    const [object, format, field, symmetry] = header;
+    if (object !== 'matrix' || format !== 'coordinate') {
+      throw new Error(`Unsupported MatrixMarket object: ${header.join(' ')}`);
+    }
+    if (field !== 'real' && field !== 'integer') throw new Error(`Unsupported MatrixMarket field: ${field}`);
+    if (symmetry !== 'general' && symmetry !== 'symmetric') throw new Error(`Unsupported MatrixMarket symmetry: ${symmetry}`);
+
+    const [rows, cols, entries] = body[0]!.map(Number) as [number, number, number];
+    if (body.length - 1 < entries) throw new Error(`MatrixMarket data truncated: ${body.length - 1} of ${entries} entries`);
+
+    const triplets: [number, number, number][] = [];
+    for (let e = 1; e <= entries; e++) {
+      const [i, j, v] = body[e]!.map(Number) as [number, number, number];
+      triplets.push([i - 1, j - 1, v]);
+      if (symmetry === 'symmetric' && i !== j) triplets.push([j - 1, i - 1, v]);
+    }
+    triplets.sort((a, b) => a[1] - b[1] || a[0] - b[0]);
+
+    const colPointers = new Array<number>(cols + 1).fill(0);
+    const rowIndices: number[] = [];
+    const values: number[] = [];
+    let previousRow = -1;
+    let previousCol = -1;
+    for (const [i, j, v] of triplets) {
+      if (i === previousRow && j === previousCol) {
+        values[values.length - 1]! += v;
+        continue;
+      }
+      rowIndices.push(i);
+      values.push(v);
+      colPointers[j + 1]!++;
+      previousRow = i;
+      previousCol = j;
+    }
+    for (let j = 0; j < cols; j++) {
+      colPointers[j + 1]! += colPointers[j]!;
+    }
+    return { rows, cols, nnz: values.length, colPointers, rowIndices, values };
+  }
+
+  /**
+   * 📝 輸出稠密向量 (n × 1 array)
+   */
+  export function formatVector(values: ArrayLike<number>, comments: readonly string[] = []): string {
+    const lines = [VECTOR_BANNER, ...comments.map(comment => `% ${comment}`), `${values.length} 1`];
+    for (let i = 0; i < values.length; i++) lines.push(`${values[i]!}`);
+    return `${lines.join('\n')}\n`;
+  }
+
+  /**
+   * 📖 讀取 array 格式向量 (n × 1)
+   */
+  export function parseVector(text: string): Float64Array {
+    const { header, body } = split(text);
+    if (header[0] !== 'matrix' || header[1] !== 'array') {
+      throw new Error(`Unsupported MatrixMarket object: ${header.join(' ')}`);
+    }
+    const [rows, cols] = body[0]!.map(Number) as [number, number];
+    if (cols !== 1) throw new Error(`Expected a column vector, got ${rows}x${cols}`);
+    if (body.length - 1 < rows) throw new Error(`MatrixMarket data truncated: ${body.length - 1} of ${rows} values`);
+    const values = new Float64Array(rows);
+    for (let i = 0; i < rows; i++) values[i] = Number(body[i + 1]![0]);
+    return values;
+  }
+
+  function split(text: string): { header: string[]; body: string[][] } {
+    const lines = text.split('\n');
+    const banner = lines[0]?.trim().split(/\s+/) ?? [];
+    if (banner[0]?.toLowerCase() !== '%%matrixmarket') throw new Error('Missing %%MatrixMarket banner');
+    const body: string[][] = [];
+    for (let i = 1; i < lines.length; i++) {
+      const line = lines[i]!.trim();
+      if (line === '' || line.startsWith('%')) continue;
+      body.push(line.split(/\s+/));
+    }
+    if (body.length === 0) throw new Error('MatrixMarket size line missing');
+    return { header: banner.slice(1).map(token => token.toLowerCase()), body };
+  }
+}
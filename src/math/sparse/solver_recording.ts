@@ -0,0 +1,373 @@
+/**
+ * 🎞️ 線性求解序列錄製與重放 - AkingSPICE 2.1
+ *
+ * 記錄一次仿真實際求解的 (雅可比, RHS) 序列，脫離器件模型單獨調校求解器：
+ * - SolverRecorder：掛到引擎 (engine.setSolverRecorder) 後，DC 與瞬態 Newton 的每次線性求解記錄一幀；
+ *   稀疏模式與上一幀不同時標記 patternChange，模式不變的幀共享同一份結構陣列
+ * - 兩種存儲：MatrixMarket 目錄 (manifest.json + 每幀 A/b 文本，通用工具可讀)
+ *   與緊湊二進制 (.aksr，模式只在變化時寫入)
+ * - replay()：把序列交給指定模式的 SparseMatrix，統計分解/求解耗時與殘差
+ *
+ * 📋 用法：
+ *   const recorder = new SolverRecorder();
+ *   engine.setSolverRecorder(recorder);
+ *   await engine.runSimulation();
+ *   SolverRecording.writeBinary(recorder.frames, 'run.aksr');
+ *   // npm run benchmark:replay -- run.aksr
+ */
+
+import { mkdirSync, readFileSync, statSync, writeFileSync } from 'fs';
+import { join } from 'path';
+import type { IVector, Time } from '../../types/index';
+import { SparseMatrix, createSolverStatistics, accumulateSolverStatistics } from './matrix';
+import type { CSCMatrix, SolverMode } from './matrix';
+import { Vector } from './vector';
+import { MatrixMarket } from './matrix_market';
+
+const MAGIC = 'AKSR';
+const VERSION = 1;
+const PREAMBLE_BYTES = 16;      // 魔數 + 版本 + 幀數 + 保留
+const FRAME_HEADER_BYTES = 24;  // 時間 (f64) + 標誌 + 維度 + 非零數 + 保留
+const FLAG_PATTERN_CHANGE = 1;
+const FLAG_DC = 2;
+const MANIFEST_SCHEMA = 'akingspice-solver-recording/1';
+
+const align8 = (bytes: number): number => (bytes + 7) & ~7;
+
+/**
+ * 求解來源
+ */
+export type SolverRecordingSource = 'dc' | 'transient';
+
+/**
+ * 一次線性求解 A x = b
+ */
+export interface SolverRecordingFrame {
+  readonly source: SolverRecordingSource;
+  readonly time: Time;
+  readonly patternChange: boolean;  // 稀疏模式與上一幀不同 (首幀恆為 true)
+  readonly matrix: CSCMatrix;
+  readonly rhs: Float64Array;
+}
+
+/**
+ * 錄製配置
+ */
+export interface SolverRecorderOptions {
+  /** 最多記錄的幀數，超出後丟棄 (默認 10000) */
+  readonly maxFrames?: number;
+}
+
+export class SolverRecorder {
+  readonly maxFrames: number;
+  private readonly _frames: SolverRecordingFrame[] = [];
+  private _droppedFrames = 0;
+
+  constructor(options: SolverRecorderOptions = {}) {
+    this.maxFrames = Math.max(0, Math.floor(options.maxFrames ?? 10000));
+  }
+
+  get frames(): readonly SolverRecordingFrame[] {
+    return this._frames;
+  }
+
+  /** 超出 maxFrames 未記錄的幀數 */
+  get droppedFrames(): number {
+    return this._droppedFrames;
+  }
+
+  /**
+   * 📸 記錄一次求解前的系統 (複製數值，之後修改矩陣不影響記錄)
+   */
+  record(matrix: SparseMatrix, rhs: IVector, source: SolverRecordingSource, time: Time): void {
+    if (this._frames.length >= this.maxFrames) {
+      this._droppedFrames++;
+      return;
+    }
+    const csc = matrix.toCSC();
+    const previous = this._frames[this._frames.length - 1]?.matrix;
+    const samePattern = previous !== undefined && sharesPattern(previous, csc);
+    this._frames.push({
+      source,
+      time,
+      patternChange: !samePattern,
+      matrix: samePattern
+        ? { ...csc, colPointers: previous.colPointers, rowIndices: previous.rowIndices }
+        : csc,
+      rhs: Float64Array.from(rhs.toArray())
+    });
+  }
+
+  clear(): void {
+    this._frames.length = 0;
+    this._droppedFrames = 0;
+  }
+}
+
+/**
+ * 單個求解器模式的重放結果 (耗時為毫秒，殘差為 ‖Ax − b‖∞ / ‖b‖∞)
+ */
+export interface SolverReplayResult {
+  readonly mode: SolverMode;
+  readonly mixedPrecision: boolean;
+  readonly frames: number;
+  readonly failures: number;
+  readonly factorTime: number;
+  readonly solveTime: number;
+  readonly factorizations: number;
+  readonly refactorizations: number;
+  readonly solves: number;
+  readonly refinementSteps: number;
+  readonly precisionFallbacks: number;
+  readonly maxResidual: number;
+  readonly meanResidual: number;
+}
+
+export namespace SolverRecording {
+  /**
+   * 📦 編碼為緊湊二進制 (小端序；稀疏結構只在 patternChange 幀寫入)
+   */
+  export function encode(frames: readonly SolverRecordingFrame[]): Uint8Array {
+    let size = PREAMBLE_BYTES;
+    for (const frame of frames) {
+      const n = frame.matrix.cols;
+      size += FRAME_HEADER_BYTES + 8 * (frame.matrix.nnz + frame.rhs.length);
+      if (frame.patternChange) size += align8(4 * (n + 1 + frame.matrix.nnz));
+    }
+
+    const bytes = new Uint8Array(size);
+    const view = new DataView(bytes.buffer);
+    for (let i = 0; i < MAGIC.length; i++) bytes[i] = MAGIC.charCodeAt(i);
+    view.setUint32(4, VERSION, true);
+    view.setUint32(8, frames.length, true);
+
+    let offset = PREAMBLE_BYTES;
+    let pattern: CSCMatrix | null = null;
+    for (const frame of frames) {
+      const { matrix } = frame;
+      if (!frame.patternChange && (!pattern || !sharesPattern(pattern, matrix))) {
+        throw new Error('Recording frame without patternChange does not match the previous sparsity pattern');
+      }
+      const flags = (frame.patternChange ? FLAG_PATTERN_CHANGE : 0) | (frame.source === 'dc' ? FLAG_DC : 0);
+      view.setFloat64(offset, frame.time, true);
+      view.setUint32(offset + 8, flags, true);
+      view.setUint32(offset + 12, matrix.cols, true);
+      view.setUint32(offset + 16, matrix.nnz, true);
+      offset += FRAME_HEADER_BYTES;
+
+      if (frame.patternChange) {
+        const start = offset;
+        for (const p of matrix.colPointers) { view.setInt32(offset, p, true); offset += 4; }
+        for (const r of matrix.rowIndices) { view.setInt32(offset, r, true); offset += 4; }
+        offset = start + align8(offset - start);
+        pattern = matrix;
+      }
+      for (const v of matrix.values) { view.setFloat64(offset, v, true); offset += 8; }
+      for (const v of frame.rhs) { view.setFloat64(offset, v, true); offset += 8; }
+    }
+    return bytes;
+  }
+
+  /**
+   * 📦 解碼 encode() 的輸出
+   */
+  export function decode(bytes: Uint8Array): SolverRecordingFrame[] {
+    const view = new DataView(bytes.buffer, bytes.byteOffset, bytes.byteLength);
+    const magic = String.fromCharCode(...bytes.subarray(0, MAGIC.length));
+    if (bytes.byteLength < PREAMBLE_BYTES || magic !== MAGIC) {
+      throw new Error('Not a solver recording (bad magic)');
+    }
+    const version = view.getUint32(4, true);
+    if (version !== VERSION) {
+      throw new Error(`Unsupported solver recording version ${version}`);
+    }
+
+    const count = view.getUint32(8, true);
+    const frames: SolverRecordingFrame[] = [];
+    let offset = PREAMBLE_BYTES;
+    let pattern: { colPointers: number[]; rowIndices: number[] } | null = null;
+    for (let f = 0; f < count; f++) {
+      if (offset + FRAME_HEADER_BYTES > bytes.byteLength) throw new Error(`Solver recording truncated at frame ${f}`);
+      const time = view.getFloat64(offset, true);
+      const flags = view.getUint32(offset + 8, true);
+      const n = view.getUint32(offset + 12, true);
+      const nnz = view.getUint32(offset + 16, true);
+      offset += FRAME_HEADER_BYTES;
+
+      const patternChange = (flags & FLAG_PATTERN_CHANGE) !== 0;
+      if (patternChange) {
+        const start = offset;
+        const colPointers = new Array<number>(n + 1);
+        const rowIndices = new Array<number>(nnz);
+        for (let j = 0; j <= n; j++) { colPointers[j] = view.getInt32(offset, true); offset += 4; }
+        for (let k = 0; k < nnz; k++) { rowIndices[k] = view.getInt32(offset, true); offset += 4; }
+        offset = start + align8(offset - start);
+        pattern = { colPointers, rowIndices };
+      } else if (!pattern || pattern.colPointers.length !== n + 1 || pattern.rowIndices.length !== nnz) {
+        throw new Error(`Solver recording frame ${f} reuses a missing or mismatched pattern`);
+      }
+      if (offset + 8 * (nnz + n) > bytes.byteLength) throw new Error(`Solver recording truncated at frame ${f}`);
+
+      const values = new Array<number>(nnz);
+      for (let k = 0; k < nnz; k++) { values[k] = view.getFloat64(offset, true); offset += 8; }
+      const rhs = new Float64Array(n);
+      for (let i = 0; i < n; i++) { rhs[i] = view.getFloat64(offset, true); offset += 8; }
+
+      frames.push({
+        source: (flags & FLAG_DC) !== 0 ? 'dc' : 'transient',
+        time,
+        patternChange,
+        matrix: { rows: n, cols: n, nnz, colPointers: pattern.colPointers, rowIndices: pattern.rowIndices, values },
+        rhs
+      });
+    }
+    return frames;
+  }
+
+  export function writeBinary(frames: readonly SolverRecordingFrame[], path: string): void {
+    writeFileSync(path, encode(frames));
+  }
+
+  export function readBinary(path: string): SolverRecordingFrame[] {
+    return decode(readFileSync(path));
+  }
+
+  /**
+   * 📝 寫入 MatrixMarket 目錄：manifest.json 列出各幀元數據與文件名，
+   * 每幀 A<k>.mtx (coordinate) 與 b<k>.mtx (array)，模式變化同時標註在 A 的註釋行
+   */
+  export function writeMatrixMarket(frames: readonly SolverRecordingFrame[], directory: string): void {
+    mkdirSync(directory, { recursive: true });
+    const entries = frames.map((frame, index) => {
+      const id = String(index).padStart(6, '0');
+      const comment = `akingspice frame=${index} source=${frame.source} time=${frame.time}${frame.patternChange ? ' pattern-change' : ''}`;
+      writeFileSync(join(directory, `A${id}.mtx`), MatrixMarket.formatMatrix(frame.matrix, [comment]));
+      writeFileSync(join(directory, `b${id}.mtx`), MatrixMarket.formatVector(frame.rhs, [comment]));
+      return {
+        source: frame.source,
+        time: frame.time,
+        patternChange: frame.patternChange,
+        matrix: `A${id}.mtx`,
+        rhs: `b${id}.mtx`
+      };
+    });
+    writeFileSync(join(directory, 'manifest.json'), `${JSON.stringify({ schema: MANIFEST_SCHEMA, frames: entries }, null, 2)}\n`);
+  }
+
+  /**
+   * 📖 讀取 MatrixMarket 目錄；模式不變的幀共享上一幀的結構陣列
+   */
+  export function readMatrixMarket(directory: string): SolverRecordingFrame[] {
+    const manifest = JSON.parse(readFileSync(join(directory, 'manifest.json'), 'utf8')) as {
+      schema: string;
+      frames: { source: SolverRecordingSource; time: Time; patternChange: boolean; matrix: string; rhs: string }[];
+    };
+    if (manifest.schema !== MANIFEST_SCHEMA) {
+      throw new Error(`Unsupported solver recording schema: ${manifest.schema}`);
+    }
+    const frames: SolverRecordingFrame[] = [];
+    for (const entry of manifest.frames) {
+      let matrix = MatrixMarket.parseMatrix(readFileSync(join(directory, entry.matrix), 'utf8'));
+      const previous = frames[frames.length - 1]?.matrix;
+      if (previous && sharesPattern(previous, matrix)) {
+        matrix = { ...matrix, colPointers: previous.colPointers, rowIndices: previous.rowIndices };
+      }
+      frames.push({
+        source: entry.source,
+        time: entry.time,
+        patternChange: entry.patternChange,
+        matrix,
+        rhs: MatrixMarket.parseVector(readFileSync(join(directory, entry.rhs), 'utf8'))
+      });
+    }
+    return frames;
+  }
+
+  /**
+   * 📂 按路徑類型讀取 (目錄為 MatrixMarket，文件為二進制)
+   */
+  export function read(path: string): SolverRecordingFrame[] {
+    return statSync(path).isDirectory() ? readMatrixMarket(path) : readBinary(path);
+  }
+
+  /**
+   * 🔁 以指定求解器模式重放序列
+   *
+   * 同一模式沿用一個 SparseMatrix，稀疏模式不變時 klu 走數值重分解路徑，與仿真中的行為一致。
+   * mixedPrecision 時稀疏 LU 因子以 Float32 存儲並迭代精化。
+   */
+  export function replay(
+    frames: readonly SolverRecordingFrame[],
+    mode: SolverReplayResult['mode'],
+    mixedPrecision: boolean = false
+  ): SolverReplayResult {
+    let matrix: SparseMatrix | null = null;
+    let failures = 0;
+    let maxResidual = 0;
+    let residualSum = 0;
+    const statistics = createSolverStatistics();
+    const collect = (retired: SparseMatrix | null): void => {
+      if (retired) accumulateSolverStatistics(statistics, retired.statistics);
+    };
+
+    for (const frame of frames) {
+      const n = frame.matrix.cols;
+      if (!matrix || matrix.rows !== n) {
+        collect(matrix);
+        matrix = new SparseMatrix(n, n);
+        matrix.setSolverMode(mode);
+        matrix.setMixedPrecision(mixedPrecision);
+        matrix.setTimingEnabled(true);
+      }
+      matrix.loadCSC(frame.matrix);
+      const b = Vector.from(Array.from(frame.rhs));
+      try {
+        const x = matrix.solve(b);
+        const residual = relativeResidual(matrix, x, b);
+        if (!Number.isFinite(residual)) {
+          failures++;
+          continue;
+        }
+        maxResidual = Math.max(maxResidual, residual);
+        residualSum += residual;
+      } catch {
+        failures++;
+      }
+    }
+    collect(matrix);
+
+    const solved = frames.length - failures;
+    return {
+      mode,
+      mixedPrecision,
+      frames: frames.length,
+      failures,
+      ...statistics,
+      maxResidual,
+      meanResidual: solved > 0 ? residualSum / solved : 0
+    };
+  }
+}
+
+function sharesPattern(a: CSCMatrix, b: CSCMatrix): boolean {
+  if (a.cols !== b.cols || a.nnz !== b.nnz) return false;
+  if (a.colPointers === b.colPointers && a.rowIndices === b.rowIndices) return true;
+  for (let j = 0; j <= a.cols; j++) {
+    if (a.colPointers[j] !== b.colPointers[j]) return false;
+  }
+  for (let k = 0; k < a.nnz; k++) {
+    if (a.rowIndices[k] !== b.rowIndices[k]) return false;
+  }
+  return true;
+}
+
+function relativeResidual(matrix: SparseMatrix, x: IVector, b: IVector): number {
+  const Ax = matrix.multiply(x);
+  let residual = 0;
+  let scale = 0;
+  for (let i = 0; i < b.size; i++) {
+    residual = Math.max(residual, Math.abs(Ax.get(i) - b.get(i)));
+    scale = Math.max(scale, Math.abs(b.get(i)));
+  }
+  return scale > 0 ? residual / scale : residual;
+}
@@ -0,0 +1,813 @@
+/**
+ * 🧮 稀疏 LU 分解 (KLU 風格) - AkingSPICE 2.1
+ *
+ * 純 TypeScript 實現的左視 (left-looking) Gilbert-Peierls LU 分解，
+ * 介面仿照 KLU 的 analyze / factor / refactor / solve 四段式設計：
+ *
+ * - analyze:  符號分析 (列排序、稀疏模式)，只依賴稀疏模式，可在多次分解間共享
+ * - factor:   數值分解 (帶門檻部分主元)，產生 L/U 因子與主元序列
+ * - refactor: 沿用既有主元序列與 L/U 模式，只重算數值 (Newton 迭代/蒙地卡羅樣本)
+ * - solve:    前代/回代求解
+ *
+ * 分解形式: P·A·Q = L·U
+ * - Q 為符號分析給出的列排序 (A + Aᵀ 上的最小度排序)
+ * - P 為數值分解時的行主元序列 (pinv)
+ * - L 為單位下三角，U 為上三角，皆以 CSC 存儲，行索引為主元序號
+ */
+
+import type { CSCMatrix } from './matrix';
+
+/**
+ * 符號分解結果 (可在相同稀疏模式的矩陣間共享)
+ */
+export interface SymbolicFactorization {
+  /** 矩陣維度 */
+  readonly n: number;
+
+  /** 列排序: 第 k 個消去的列為 q[k] */
+  readonly q: Int32Array;
+
+  /** 原矩陣稀疏模式 (用於驗證模式一致性) */
+  readonly colPointers: Int32Array;
+  readonly rowIndices: Int32Array;
+}
+
+/**
+ * 因子數值存儲 (Float32Array 為單精度因子，配合迭代精化使用)
+ */
+export type FactorValues = Float64Array | Float32Array;
+
+/**
+ * 數值分解結果
+ */
+export interface NumericFactorization {
+  readonly symbolic: SymbolicFactorization;
+
+  /** 行主元逆排列: 原始行 i 為第 pinv[i] 個主元 */
+  readonly pinv: Int32Array;
+
+  /** L 因子 (CSC，每列第一個元素為單位對角線) */
+  readonly Lp: Int32Array;
+  readonly Li: Int32Array;
+  readonly Lx: FactorValues;
+
+  /** U 因子 (CSC，每列最後一個元素為主元，非對角元素按行序號遞增排列) */
+  readonly Up: Int32Array;
+  readonly Ui: Int32Array;
+  readonly Ux: FactorValues;
+}
+
+/**
+ * 數值分解選項
+ */
+export interface SparseLUOptions {
+  /** 對角主元偏好門檻 (KLU 預設 0.001) */
+  readonly pivotTolerance?: number;
+
+  /** refactor 時可接受的最小相對主元 */
+  readonly refactorPivotTolerance?: number;
+
+  /** 因子存儲精度 (single: Float32Array，記憶體減半；消去運算仍以 Float64 進行) */
+  readonly precision?: 'double' | 'single';
+}
+
+/**
+ * 🚀 KLU 風格稀疏 LU 分解
+ */
+export namespace SparseLU {
+  const DEFAULT_PIVOT_TOLERANCE = 1e-3;
+  const DEFAULT_REFACTOR_PIVOT_TOLERANCE = 1e-12;
+  const SOLVE_BLOCK_SIZE = 32;  // solveMany 每塊的右側向量數
+
+  /**
+   * 🔍 符號分析：計算列排序並記錄稀疏模式
+   */
+  export function analyze(A: CSCMatrix): SymbolicFactorization {
+    if (A.rows !== A.cols) {
+      throw new Error(`稀疏 LU 僅支持方陣: ${A.rows}x${A.cols}`);
+    }
+    const n = A.rows;
+    const colPointers = Int32Array.from(A.colPointers);
+    const rowIndices = Int32Array.from(A.rowIndices.slice(0, A.nnz));
+
+    return {
+      n,
+      q: minimumDegreeOrdering(n, colPointers, rowIndices),
+      colPointers,
+      rowIndices
+    };
+  }
+
+  /**
+   * ✅ 檢查矩陣的稀疏模式是否與符號分析結果一致
+   */
+  export function matchesPattern(symbolic: SymbolicFactorization, A: CSCMatrix): boolean {
+    if (A.rows !== symbolic.n || A.cols !== symbolic.n || A.nnz !== symbolic.rowIndices.length) {
+      return false;
+    }
+    for (let j = 0; j <= symbolic.n; j++) {
+      if (A.colPointers[j] !== symbolic.colPointers[j]) return false;
+    }
+    for (let p = 0; p < A.nnz; p++) {
+      if (A.rowIndices[p] !== symbolic.rowIndices[p]) return false;
+    }
+    return true;
+  }
+
+  /**
+   * 🔢 數值分解 (Gilbert-Peierls，帶門檻部分主元)
+   *
+   * @throws 矩陣結構或數值奇異時拋出錯誤
+   */
+  export function factor(
+    symbolic: SymbolicFactorization,
+    A: CSCMatrix,
+    options: SparseLUOptions = {}
+  ): NumericFactorization {
+    const n = symbolic.n;
+    const tol = options.pivotTolerance ?? DEFAULT_PIVOT_TOLERANCE;
+    const q = symbolic.q;
+    const Ap = A.colPointers;
+    const Ai = A.rowIndices;
+    const Ax = A.values;
+
+    // L/U 以可增長陣列收集，完成後轉為 typed array
+    const Lp = new Int32Array(n + 1);
+    const Up = new Int32Array(n + 1);
+    const Li: number[] = [];
+    const Lx: number[] = [];
+    const Ui: number[] = [];
+    const Ux: number[] = [];
+
+    const pinv = new Int32Array(n).fill(-1);
+    const x = new Float64Array(n);
+    const xi = new Int32Array(n);
+    const stack = new Int32Array(n);
+    const pstack = new Int32Array(n);
+    const mark = new Int32Array(n);
+    let epoch = 0;
+
+    for (let k = 0; k < n; k++) {
+      Lp[k] = Li.length;
+      Up[k] = Ui.length;
+      const col = q[k]!;
+
+      // 1. 符號: 求 L 圖上 A(:,col) 的可達集合 (拓撲序)
+      epoch++;
+      let top = n;
+      for (let p = Ap[col]!; p < Ap[col + 1]!; p++) {
+        const i = Ai[p]!;
+        if (mark[i] !== epoch) {
+          top = _depthFirstSearch(i, Lp, Li, pinv, top, xi, stack, pstack, mark, epoch);
+        }
+      }
+
+      // 2. 數值: 稀疏三角求解 x = L \ A(:,col)
+      for (let p = top; p < n; p++) x[xi[p]!] = 0;
+      for (let p = Ap[col]!; p < Ap[col + 1]!; p++) x[Ai[p]!] = Ax[p]!;
+      for (let px = top; px < n; px++) {
+        const j = xi[px]!;
+        const J = pinv[j]!;
+        if (J < 0) continue;
+        const xj = x[j]!;
+        for (let p = Lp[J]! + 1; p < Lp[J + 1]!; p++) {
+          x[Li[p]!]! -= Lx[p]! * xj;
+        }
+      }
+
+      // 3. 選主元: 未成為主元的行中絕對值最大者，若對角元足夠大則優先取對角
+      let ipiv = -1;
+      let maxAbs = -1;
+      for (let p = top; p < n; p++) {
+        const i = xi[p]!;
+        if (pinv[i]! < 0) {
+          const t = Math.abs(x[i]!);
+          if (t > maxAbs) {
+            maxAbs = t;
+            ipiv = i;
+          }
+        } else {
+          Ui.push(pinv[i]!);
+          Ux.push(x[i]!);
+        }
+      }
+      if (ipiv === -1 || maxAbs <= 0 || !isFinite(maxAbs)) {
+        throw new Error(`稀疏 LU 分解失敗: 第 ${k} 列 (原始列 ${col}) 矩陣奇異`);
+      }
+      if (pinv[col]! < 0 && mark[col] === epoch && Math.abs(x[col]!) >= maxAbs * tol) {
+        ipiv = col;
+      }
+
+      const pivot = x[ipiv]!;
+      Ui.push(k);
+      Ux.push(pivot);
+      pinv[ipiv] = k;
+      Li.push(ipiv);
+      Lx.push(1);
+      for (let p = top; p < n; p++) {
+        const i = xi[p]!;
+        if (pinv[i]! < 0) {
+          Li.push(i);
+          Lx.push(x[i]! / pivot);
+        }
+        x[i] = 0;
+      }
+    }
+    Lp[n] = Li.length;
+    Up[n] = Ui.length;
+
+    // L 的行索引轉換為主元序號
+    const LiPermuted = new Int32Array(Li.length);
+    for (let p = 0; p < Li.length; p++) {
+      LiPermuted[p] = pinv[Li[p]!]!;
+    }
+
+    const numeric: NumericFactorization = {
+      symbolic,
+      pinv,
+      Lp,
+      Li: LiPermuted,
+      Lx: options.precision === 'single' ? Float32Array.from(Lx) : Float64Array.from(Lx),
+      Up,
+      Ui: Int32Array.from(Ui),
+      Ux: options.precision === 'single' ? Float32Array.from(Ux) : Float64Array.from(Ux)
+    };
+    _sortUColumns(numeric);
+    return numeric;
+  }
+
+  /**
+   * 🔎 因子存儲精度
+   */
+  export function precision(numeric: NumericFactorization): 'double' | 'single' {
+    return numeric.Lx instanceof Float32Array ? 'single' : 'double';
+  }
+
+  /**
+   * ♻️ 數值重分解：沿用主元序列與 L/U 模式，只更新數值
+   *
+   * 要求 A 的稀疏模式與符號分析時一致，沿用原因子的存儲精度。
+   *
+   * @returns 成功時返回 true；主元過小時返回 false (呼叫者應改用 factor)
+   */
+  export function refactor(
+    numeric: NumericFactorization,
+    A: CSCMatrix,
+    options: SparseLUOptions = {}
+  ): boolean {
+    const { symbolic, pinv, Lp, Li, Lx, Up, Ui, Ux } = numeric;
+    const n = symbolic.n;
+    const tol = options.refactorPivotTolerance ?? DEFAULT_REFACTOR_PIVOT_TOLERANCE;
+    const q = symbolic.q;
+    const x = new Float64Array(n);
+
+    for (let k = 0; k < n; k++) {
+      const col = q[k]!;
+      let colNorm = 0;
+      for (let p = A.colPointers[col]!; p < A.colPointers[col + 1]!; p++) {
+        const v = A.values[p]!;
+        x[pinv[A.rowIndices[p]!]!] = v;
+        colNorm = Math.max(colNorm, Math.abs(v));
+      }
+
+      const uEnd = Up[k + 1]! - 1;
+      for (let p = Up[k]!; p < uEnd; p++) {
+        const j = Ui[p]!;
+        const ujk = x[j]!;
+        Ux[p] = ujk;
+        x[j] = 0;
+        if (ujk === 0) continue;
+        for (let r = Lp[j]! + 1; r < Lp[j + 1]!; r++) {
+          x[Li[r]!]! -= Lx[r]! * ujk;
+        }
+      }
+
+      const pivot = x[k]!;
+      x[k] = 0;
+      if (!isFinite(pivot) || Math.abs(pivot) <= tol * colNorm || pivot === 0) {
+        return false;
+      }
+      Ux[uEnd] = pivot;
+
+      for (let r = Lp[k]! + 1; r < Lp[k + 1]!; r++) {
+        const i = Li[r]!;
+        Lx[r] = x[i]! / pivot;
+        x[i] = 0;
+      }
+    }
+    return true;
+  }
+
+  /**
+   * 🎯 求解 A·x = b
+   */
+  export function solve(numeric: NumericFactorization, b: ArrayLike<number>): Float64Array {
+    const { symbolic, pinv, Lp, Li, Lx, Up, Ui, Ux } = numeric;
+    const n = symbolic.n;
+    const y = new Float64Array(n);
+
+    // y = P·b
+    for (let i = 0; i < n; i++) {
+      y[pinv[i]!] = b[i]!;
+    }
+
+    // L·z = y (單位下三角)
+    for (let j = 0; j < n; j++) {
+      const yj = y[j]!;
+      if (yj === 0) continue;
+      for (let p = Lp[j]! + 1; p < Lp[j + 1]!; p++) {
+        y[Li[p]!]! -= Lx[p]! * yj;
+      }
+    }
+
+    // U·w = z
+    for (let j = n - 1; j >= 0; j--) {
+      const diag = Up[j + 1]! - 1;
+      y[j]! /= Ux[diag]!;
+      const yj = y[j]!;
+      if (yj === 0) continue;
+      for (let p = Up[j]!; p < diag; p++) {
+        y[Ui[p]!]! -= Ux[p]! * yj;
+      }
+    }
+
+    // x = Q·w
+    const x = new Float64Array(n);
+    for (let k = 0; k < n; k++) {
+      x[symbolic.q[k]!] = y[k]!;
+    }
+    return x;
+  }
+
+  /**
+   * 🎯 求解 Aᵀ·x = b (Aᵀ = Q·Uᵀ·Lᵀ·P)
+   */
+  export function solveTranspose(numeric: NumericFactorization, b: ArrayLike<number>): Float64Array {
+    const { symbolic, pinv, Lp, Li, Lx, Up, Ui, Ux } = numeric;
+    const n = symbolic.n;
+    const y = new Float64Array(n);
+
+    // y = Qᵀ·b
+    for (let k = 0; k < n; k++) {
+      y[k] = b[symbolic.q[k]!]!;
+    }
+
+    // Uᵀ·v = y (U 的第 j 列即 Uᵀ 的第 j 行)
+    for (let j = 0; j < n; j++) {
+      const diag = Up[j + 1]! - 1;
+      let sum = y[j]!;
+      for (let p = Up[j]!; p < diag; p++) {
+        sum -= Ux[p]! * y[Ui[p]!]!;
+      }
+      y[j] = sum / Ux[diag]!;
+    }
+
+    // Lᵀ·w = v (單位上三角)
+    for (let j = n - 1; j >= 0; j--) {
+      let sum = y[j]!;
+      for (let p = Lp[j]! + 1; p < Lp[j + 1]!; p++) {
+        sum -= Lx[p]! * y[Li[p]!]!;
+      }
+      y[j] = sum;
+    }
+
+    // x = Pᵀ·w
+    const x = new Float64Array(n);
+    for (let i = 0; i < n; i++) {
+      x[i] = y[pinv[i]!]!;
+    }
+    return x;
+  }
+
+  /**
+   * 🎯 多右側向量求解 A·X = B (transpose 時求解 Aᵀ·X = B)
+   *
+   * 每 SOLVE_BLOCK_SIZE 個右側向量交錯存放 (y[k * count + s])，
+   * 前代/回代時每個 L/U 元素只讀取一次並作用於整個塊。
+   */
+  export function solveMany(
+    numeric: NumericFactorization,
+    B: readonly ArrayLike<number>[],
+    transpose: boolean = false
+  ): Float64Array[] {
+    const { symbolic, pinv } = numeric;
+    const n = symbolic.n;
+    const q = symbolic.q;
+    const results: Float64Array[] = [];
+    const y = new Float64Array(n * Math.min(SOLVE_BLOCK_SIZE, B.length));
+
+    for (let first = 0; first < B.length; first += SOLVE_BLOCK_SIZE) {
+      const count = Math.min(SOLVE_BLOCK_SIZE, B.length - first);
+      for (let s = 0; s < count; s++) {
+        const b = B[first + s]!;
+        if (transpose) {
+          for (let k = 0; k < n; k++) y[k * count + s] = b[q[k]!]!;
+        } else {
+          for (let i = 0; i < n; i++) y[pinv[i]! * count + s] = b[i]!;
+        }
+      }
+
+      if (transpose) {
+        _blockSolveTranspose(numeric, y, count);
+      } else {
+        _blockSolve(numeric, y, count);
+      }
+
+      for (let s = 0; s < count; s++) {
+        const x = new Float64Array(n);
+        if (transpose) {
+          for (let i = 0; i < n; i++) x[i] = y[pinv[i]! * count + s]!;
+        } else {
+          for (let k = 0; k < n; k++) x[q[k]!] = y[k * count + s]!;
+        }
+        results.push(x);
+      }
+    }
+    return results;
+  }
+
+  /**
+   * 📏 U 對角元 (主元) 絕對值的範圍，O(n)
+   */
+  export function pivotRange(numeric: NumericFactorization): { min: number; max: number } {
+    let min = Infinity;
+    let max = 0;
+    for (let j = 0; j < numeric.symbolic.n; j++) {
+      const pivot = Math.abs(numeric.Ux[numeric.Up[j + 1]! - 1]!);
+      min = Math.min(min, pivot);
+      max = Math.max(max, pivot);
+    }
+    return { min, max };
+  }
+
+  /**
+   * 🧬 批量數值重分解 (多實例鎖步)
+   *
+   * 同一稀疏模式的 count 個矩陣共用 numeric 的主元序列與 L/U 模式，
+   * 數值以「實例最內層」排列: values[p * count + s] 為第 s 個實例的第 p 個非零元。
+   * 最內層迴圈遍歷實例，便於 JIT 向量化。
+   *
+   * @param values - A 的批量數值 (長度 nnz·count，模式與符號分析一致)
+   * @param Lx - 輸出 L 數值 (長度 nnz(L)·count)
+   * @param Ux - 輸出 U 數值 (長度 nnz(U)·count)
+   * @param status - 輸出: 1 表示該實例分解成功，0 表示主元過小 (需單獨分解)
+   */
+  export function refactorBatch(
+    numeric: NumericFactorization,
+    values: Float64Array,
+    count: number,
+    Lx: Float64Array,
+    Ux: Float64Array,
+    status: Uint8Array,
+    options: SparseLUOptions = {}
+  ): void {
+    const { symbolic, pinv, Lp, Li, Up, Ui } = numeric;
+    const n = symbolic.n;
+    const tol = options.refactorPivotTolerance ?? DEFAULT_REFACTOR_PIVOT_TOLERANCE;
+    const Ap = symbolic.colPointers;
+    const Ai = symbolic.rowIndices;
+    const q = symbolic.q;
+    const x = new Float64Array(n * count);
+    const colNorm = new Float64Array(count);
+    status.fill(1);
+
+    for (let k = 0; k < n; k++) {
+      const col = q[k]!;
+      colNorm.fill(0);
+      for (let p = Ap[col]!; p < Ap[col + 1]!; p++) {
+        const xo = pinv[Ai[p]!]! * count;
+        const vo = p * count;
+        for (let s = 0; s < count; s++) {
+          const v = values[vo + s]!;
+          x[xo + s] = v;
+          const a = Math.abs(v);
+          if (a > colNorm[s]!) colNorm[s] = a;
+        }
+      }
+
+      const uEnd = Up[k + 1]! - 1;
+      for (let p = Up[k]!; p < uEnd; p++) {
+        const jo = Ui[p]! * count;
+        const uo = p * count;
+        for (let s = 0; s < count; s++) {
+          Ux[uo + s] = x[jo + s]!;
+          x[jo + s] = 0;
+        }
+        const j = Ui[p]!;
+        for (let r = Lp[j]! + 1; r < Lp[j + 1]!; r++) {
+          const io = Li[r]! * count;
+          const lo = r * count;
+          for (let s = 0; s < count; s++) {
+            x[io + s]! -= Lx[lo + s]! * Ux[uo + s]!;
+          }
+        }
+      }
+
+      const ko = k * count;
+      const dOff = uEnd * count;
+      for (let s = 0; s < count; s++) {
+        let pivot = x[ko + s]!;
+        x[ko + s] = 0;
+        if (!isFinite(pivot) || pivot === 0 || Math.abs(pivot) <= tol * colNorm[s]!) {
+          status[s] = 0;
+          pivot = 1; // 避免 NaN 擴散到其他列，該實例的結果將被丟棄
+        }
+        Ux[dOff + s] = pivot;
+      }
+
+      const lDiag = Lp[k]! * count;
+      for (let s = 0; s < count; s++) Lx[lDiag + s] = 1;
+      for (let r = Lp[k]! + 1; r < Lp[k + 1]!; r++) {
+        const io = Li[r]! * count;
+        const lo = r * count;
+        for (let s = 0; s < count; s++) {
+          Lx[lo + s] = x[io + s]! / Ux[dOff + s]!;
+          x[io + s] = 0;
+        }
+      }
+    }
+  }
+
+  /**
+   * 🎯 批量求解 (配合 refactorBatch)
+   *
+   * @param b - 批量右側向量 (長度 n·count，實例最內層)
+   * @returns 批量解向量 (同樣排列)
+   */
+  export function solveBatch(
+    numeric: NumericFactorization,
+    Lx: Float64Array,
+    Ux: Float64Array,
+    count: number,
+    b: Float64Array
+  ): Float64Array {
+    const { symbolic, pinv, Lp, Li, Up, Ui } = numeric;
+    const n = symbolic.n;
+    const y = new Float64Array(n * count);
+
+    for (let i = 0; i < n; i++) {
+      const yo = pinv[i]! * count;
+      const bo = i * count;
+      for (let s = 0; s < count; s++) y[yo + s] = b[bo + s]!;
+    }
+
+    for (let j = 0; j < n; j++) {
+      const jo = j * count;
+      for (let p = Lp[j]! + 1; p < Lp[j + 1]!; p++) {
+        const io = Li[p]! * count;
+        const lo = p * count;
+        for (let s = 0; s < count; s++) {
+          y[io + s]! -= Lx[lo + s]! * y[jo + s]!;
+        }
+      }
+    }
+
+    for (let j = n - 1; j >= 0; j--) {
+      const jo = j * count;
+      const diag = Up[j + 1]! - 1;
+      const dOff = diag * count;
+      for (let s = 0; s < count; s++) y[jo + s]! /= Ux[dOff + s]!;
+      for (let p = Up[j]!; p < diag; p++) {
+        const io = Ui[p]! * count;
+        const uo = p * count;
+        for (let s = 0; s < count; s++) {
+          y[io + s]! -= Ux[uo + s]! * y[jo + s]!;
+        }
+      }
+    }
+
+    const x = new Float64Array(n * count);
+    for (let k = 0; k < n; k++) {
+      const xo = symbolic.q[k]! * count;
+      const yo = k * count;
+      for (let s = 0; s < count; s++) x[xo + s] = y[yo + s]!;
+    }
+    return x;
+  }
+
+  /**
+   * 📏 因子的非零元素數量 (L 與 U 合計)
+   */
+  export function factorNonZeros(numeric: NumericFactorization): number {
+    return numeric.Lp[numeric.symbolic.n]! + numeric.Up[numeric.symbolic.n]!;
+  }
+
+  // === 內部輔助函數 ===
+
+  /** 交錯塊上的 L·U 求解 (y 已按主元序號排列) */
+  function _blockSolve(numeric: NumericFactorization, y: Float64Array, count: number): void {
+    const { Lp, Li, Lx, Up, Ui, Ux } = numeric;
+    const n = numeric.symbolic.n;
+
+    for (let j = 0; j < n; j++) {
+      const jc = j * count;
+      for (let p = Lp[j]! + 1; p < Lp[j + 1]!; p++) {
+        const l = Lx[p]!;
+        const ic = Li[p]! * count;
+        for (let s = 0; s < count; s++) y[ic + s]! -= l * y[jc + s]!;
+      }
+    }
+
+    for (let j = n - 1; j >= 0; j--) {
+      const jc = j * count;
+      const diag = Up[j + 1]! - 1;
+      const pivot = Ux[diag]!;
+      for (let s = 0; s < count; s++) y[jc + s]! /= pivot;
+      for (let p = Up[j]!; p < diag; p++) {
+        const u = Ux[p]!;
+        const ic = Ui[p]! * count;
+        for (let s = 0; s < count; s++) y[ic + s]! -= u * y[jc + s]!;
+      }
+    }
+  }
+
+  /** 交錯塊上的 Uᵀ·Lᵀ 求解 */
+  function _blockSolveTranspose(numeric: NumericFactorization, y: Float64Array, count: number): void {
+    const { Lp, Li, Lx, Up, Ui, Ux } = numeric;
+    const n = numeric.symbolic.n;
+
+    for (let j = 0; j < n; j++) {
+      const jc = j * count;
+      const diag = Up[j + 1]! - 1;
+      for (let p = Up[j]!; p < diag; p++) {
+        const u = Ux[p]!;
+        const ic = Ui[p]! * count;
+        for (let s = 0; s < count; s++) y[jc + s]! -= u * y[ic + s]!;
+      }
+      const pivot = Ux[diag]!;
+      for (let s = 0; s < count; s++) y[jc + s]! /= pivot;
+    }
+
+    for (let j = n - 1; j >= 0; j--) {
+      const jc = j * count;
+      for (let p = Lp[j]! + 1; p < Lp[j + 1]!; p++) {
+        const l = Lx[p]!;
+        const ic = Li[p]! * count;
+        for (let s = 0; s < count; s++) y[jc + s]! -= l * y[ic + s]!;
+      }
+    }
+  }
+
+  /**
+   * 非遞迴 DFS：在 L 的圖上從節點 j 出發，將完成的節點逆序壓入 xi
+   */
+  function _depthFirstSearch(
+    start: number,
+    Lp: Int32Array,
+    Li: number[],
+    pinv: Int32Array,
+    top: number,
+    xi: Int32Array,
+    stack: Int32Array,
+    pstack: Int32Array,
+    mark: Int32Array,
+    epoch: number
+  ): number {
+    let head = 0;
+    stack[0] = start;
+    while (head >= 0) {
+      const j = stack[head]!;
+      const jnew = pinv[j]!;
+      if (mark[j] !== epoch) {
+        mark[j] = epoch;
+        pstack[head] = jnew < 0 ? 0 : Lp[jnew]! + 1;
+      }
+      let done = true;
+      const pEnd = jnew < 0 ? 0 : Lp[jnew + 1]!;
+      for (let p = pstack[head]!; p < pEnd; p++) {
+        const i = Li[p]!;
+        if (mark[i] === epoch) continue;
+        pstack[head] = p + 1;
+        stack[++head] = i;
+        done = false;
+        break;
+      }
+      if (done) {
+        head--;
+        xi[--top] = j;
+      }
+    }
+    return top;
+  }
+
+  /**
+   * 將 U 每列的非對角元素按主元序號遞增排列 (refactor 依賴此順序)
+   */
+  function _sortUColumns(numeric: NumericFactorization): void {
+    const { Up, Ui, Ux } = numeric;
+    const n = numeric.symbolic.n;
+    for (let k = 0; k < n; k++) {
+      const start = Up[k]!;
+      const end = Up[k + 1]! - 1;
+      if (end - start < 2) continue;
+      const entries: Array<[number, number]> = [];
+      for (let p = start; p < end; p++) {
+        entries.push([Ui[p]!, Ux[p]!]);
+      }
+      entries.sort((a, b) => a[0] - b[0]);
+      for (let p = start; p < end; p++) {
+        const [row, value] = entries[p - start]!;
+        Ui[p] = row;
+        Ux[p] = value;
+      }
+    }
+  }
+
+  /**
+   * 📐 最小度排序 (作用於 A + Aᵀ 的對稱模式)
+   *
+   * 使用顯式消去圖與帶延遲更新的二叉堆，
+   * 對電路矩陣 (每行僅有少量非零元) 足夠高效。
+   */
+  export function minimumDegreeOrdering(
+    n: number,
+    colPointers: ArrayLike<number>,
+    rowIndices: ArrayLike<number>
+  ): Int32Array {
+    const adjacency: Set<number>[] = [];
+    for (let i = 0; i < n; i++) adjacency.push(new Set());
+    for (let j = 0; j < n; j++) {
+      for (let p = colPointers[j]!; p < colPointers[j + 1]!; p++) {
+        const i = rowIndices[p]!;
+        if (i !== j) {
+          adjacency[i]!.add(j);
+          adjacency[j]!.add(i);
+        }
+      }
+    }
+
+    // 最小堆: 以 (度數, 節點序號) 排序，過期項在彈出時丟棄
+    const heapDegree: number[] = [];
+    const heapNode: number[] = [];
+    const push = (degree: number, node: number): void => {
+      let c = heapDegree.length;
+      heapDegree.push(degree);
+      heapNode.push(node);
+      while (c > 0) {
+        const parent = (c - 1) >> 1;
+        if (heapDegree[parent]! < degree || (heapDegree[parent] === degree && heapNode[parent]! < node)) break;
+        heapDegree[c] = heapDegree[parent]!;
+        heapNode[c] = heapNode[parent]!;
+        c = parent;
+      }
+      heapDegree[c] = degree;
+      heapNode[c] = node;
+    };
+    const pop = (): [number, number] => {
+      const degree = heapDegree[0]!;
+      const node = heapNode[0]!;
+      const lastDegree = heapDegree.pop()!;
+      const lastNode = heapNode.pop()!;
+      const size = heapDegree.length;
+      if (size > 0) {
+        let c = 0;
+        for (;;) {
+          let child = 2 * c + 1;
+          if (child >= size) break;
+          if (child + 1 < size && (heapDegree[child + 1]! < heapDegree[child]! ||
+              (heapDegree[child + 1] === heapDegree[child] && heapNode[child + 1]! < heapNode[child]!))) {
+            child++;
+          }
+          if (heapDegree[child]! > lastDegree || (heapDegree[child] === lastDegree && heapNode[child]! > lastNode)) break;
+          heapDegree[c] = heapDegree[child]!;
+          heapNode[c] = heapNode[child]!;
+          c = child;
+        }
+        heapDegree[c] = lastDegree;
+        heapNode[c] = lastNode;
+      }
+      return [degree, node];
+    };
+
+    for (let i = 0; i < n; i++) push(adjacency[i]!.size, i);
+
+    const eliminated = new Uint8Array(n);
+    const order = new Int32Array(n);
+    let k = 0;
+    while (k < n) {
+      const [degree, v] = pop();
+      if (eliminated[v] || degree !== adjacency[v]!.size) continue;
+
+      eliminated[v] = 1;
+      order[k++] = v;
+
+      // 消去 v: 其鄰居形成團
+      const neighbors = Array.from(adjacency[v]!);
+      for (const a of neighbors) adjacency[a]!.delete(v);
+      for (let s = 0; s < neighbors.length; s++) {
+        const a = neighbors[s]!;
+        const setA = adjacency[a]!;
+        for (let t = s + 1; t < neighbors.length; t++) {
+          const b = neighbors[t]!;
+          if (!setA.has(b)) {
+            setA.add(b);
+            adjacency[b]!.add(a);
+          }
+        }
+      }
+      for (const a of neighbors) push(adjacency[a]!.size, a);
+      adjacency[v]!.clear();
+    }
+    return order;
+  }
+}
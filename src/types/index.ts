@@ -59,6 +59,8 @@ export interface ISparseMatrix {
   // 求解接口 (支持異步 KLU)
   factorize(): void;
   solve(rhs: IVector): IVector;
+  solveMany(rhs: readonly IVector[], transpose?: boolean): IVector[];  // 多右側向量共用一次分解
+  solveTranspose(rhs: IVector): IVector;                              // Aᵀx = b (伴隨/靈敏度)
   clone(): ISparseMatrix;
   clear(): void;
   
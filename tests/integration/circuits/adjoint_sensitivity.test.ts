@@ -0,0 +1,124 @@
+/**
+ * 🎯 伴隨靈敏度集成測試
+ *
+ * 測試目標：
+ * 1. DC 分壓器信號對 R/V 的導數與解析解一致 (含 I(R) 對 R 的顯式依賴)
+ * 2. 二極體 IS 的 DC 靈敏度與有限差分一致
+ * 3. RC 充電各類 .MEAS 對全部參數的導數與重新仿真的中心差分一致
+ */
+
+import { describe, test, expect } from 'vitest';
+import { SpiceNetlistParser } from '../../../src/core/parser/spice_netlist_parser';
+import { CircuitSimulationEngine } from '../../../src/core/simulation/circuit_simulation_engine';
+import type { SimulationConfig } from '../../../src/core/simulation/circuit_simulation_engine';
+import { Resistor } from '../../../src/components/passive/resistor';
+import { Capacitor } from '../../../src/components/passive/capacitor';
+import { VoltageSource } from '../../../src/components/sources/voltage_source';
+import { IntelligentDiode } from '../../../src/core/devices/intelligent_diode';
+import type { ComponentInterface } from '../../../src/core/interfaces/component';
+
+const MEASURES = `* RC charging measurements
+V1 in 0 DC 10
+R1 in a 1k
+C1 a 0 0.1u
+.TRAN 1u 0.2m
+.MEAS TRAN vavg AVG V(a) FROM=0 TO=0.1m
+.MEAS TRAN irms RMS I(R1) FROM=20u TO=0.15m
+.MEAS TRAN charge INTEG I(R1)
+.MEAS TRAN rise TRIG V(a) VAL=1 RISE=1 TARG V(a) VAL=6 RISE=1
+.MEAS TRAN t50 WHEN V(a)=5
+.MEAS TRAN vfind FIND V(a) AT=55u
+.MEAS TRAN never WHEN V(a)=20 CROSS=1
+.END`;
+
+interface RCValues { V1: number; R1: number; C1: number }
+const NOMINAL: RCValues = { V1: 10, R1: 1000, C1: 1e-7 };
+
+async function run(devices: ComponentInterface[], config: Partial<SimulationConfig>) {
+  const engine = new CircuitSimulationEngine({
+    initialTimeStep: 1e-6,
+    maxTimeStep: 1e-6,
+    minTimeStep: 1e-8,
+    ...config
+  });
+  devices.forEach(device => engine.addDevice(device));
+  const result = await engine.runSimulation();
+  expect(result.success).toBe(true);
+  return { engine, result };
+}
+
+function rc(values: RCValues): ComponentInterface[] {
+  return [
+    new VoltageSource('V1', ['in', '0'], values.V1),
+    new Resistor('R1', ['in', 'a'], values.R1),
+    new Capacitor('C1', ['a', '0'], values.C1)
+  ];
+}
+
+describe('Adjoint Sensitivity', () => {
+  test('DC 分壓器與解析解一致', async () => {
+    const { engine } = await run([
+      new VoltageSource('V1', ['in', '0'], 10),
+      new Resistor('R1', ['in', 'out'], 1000),
+      new Resistor('R2', ['out', '0'], 3000)
+    ], { endTime: 2e-6, adjointSensitivity: true });
+
+    const sensitivities = engine.computeSensitivities(['V(out)', 'I(R2)']);
+    // V(out) = V·R2/(R1+R2)，I(R2) = V/(R1+R2)
+    const vout = sensitivities.get('V(out)')!;
+    expect(vout.get('V1')!).toBeCloseTo(0.75, 10);
+    expect(vout.get('R1')! / -1.875e-3).toBeCloseTo(1, 8);
+    expect(vout.get('R2')! / 6.25e-4).toBeCloseTo(1, 8);
+    const current = sensitivities.get('I(R2)')!;
+    expect(current.get('R1')! / -6.25e-7).toBeCloseTo(1, 8);
+    expect(current.get('R2')! / -6.25e-7).toBeCloseTo(1, 8);
+  });
+
+  test('二極體 IS 的 DC 靈敏度與有限差分一致', async () => {
+    const operatingPoint = async (Is: number) => {
+      const diode = new IntelligentDiode('D1', ['a', '0'], { Is, n: 1, Rs: 0, Cj0: 0, Vj: 0.7, m: 0.5, tt: 0 });
+      return run([
+        new VoltageSource('V1', ['in', '0'], 5),
+        new Resistor('R1', ['in', 'a'], 1000),
+        diode
+      ], { endTime: 2e-6, adjointSensitivity: true, voltageToleranceAbs: 1e-12, voltageToleranceRel: 1e-12 });
+    };
+    const Is = 1e-14;
+    const { engine } = await operatingPoint(Is);
+    const adjoint = engine.computeSensitivities(['V(a)']).get('V(a)')!.get('D1.IS')!;
+
+    const voltage = async (value: number) => (await operatingPoint(value)).engine.getOperatingPoint()!.get(engine.getNodeIdByName('a')!);
+    const h = Is * 1e-4;
+    const difference = (await voltage(Is + h) - await voltage(Is - h)) / (2 * h);
+    // 正向偏壓下 ∂V/∂IS ≈ -nVt/IS
+    expect(adjoint).toBeLessThan(0);
+    expect(adjoint / difference).toBeCloseTo(1, 3);
+  });
+
+  test('RC 充電 .MEAS 對全部參數與中心差分一致', async () => {
+    const { measurements } = new SpiceNetlistParser().parseNetlist(MEASURES);
+    const config = { endTime: 2e-4, measurements, solverMode: 'klu' as const };
+    const { engine } = await run(rc(NOMINAL), { ...config, adjointSensitivity: true });
+    const sensitivities = engine.computeSensitivities();
+    expect(sensitivities.has('never')).toBe(false);
+
+    for (const parameter of ['V1', 'R1', 'C1'] as const) {
+      const h = NOMINAL[parameter] * 1e-4;
+      const plus = (await run(rc({ ...NOMINAL, [parameter]: NOMINAL[parameter] + h }), config)).result.measurements!;
+      const minus = (await run(rc({ ...NOMINAL, [parameter]: NOMINAL[parameter] - h }), config)).result.measurements!;
+      for (const name of ['vavg', 'irms', 'charge', 'rise', 't50', 'vfind']) {
+        const difference = (plus.get(name)! - minus.get(name)!) / (2 * h);
+        const adjoint = sensitivities.get(name)!.get(parameter)!;
+        expect(Math.abs(adjoint - difference)).toBeLessThan(1e-3 * Math.abs(difference) + 1e-12);
+      }
+    }
+
+    // WHEN V(a)=5：t = τ·ln2，∂t/∂R = C·ln2
+    expect(sensitivities.get('t50')!.get('R1')! / (1e-7 * Math.LN2)).toBeCloseTo(1, 2);
+  });
+
+  test('未開啟記錄時拋出錯誤', async () => {
+    const { engine } = await run(rc(NOMINAL), { endTime: 2e-6 });
+    expect(() => engine.computeSensitivities(['V(a)'])).toThrow();
+  });
+});
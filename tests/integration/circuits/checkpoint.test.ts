@@ -0,0 +1,91 @@
+/**
+ * 📸 檢查點/恢復集成測試
+ *
+ * 測試目標：
+ * 1. 從中途檢查點恢復後逐位重現原始仿真
+ * 2. 從已完成的仿真分叉並延長 endTime
+ * 3. 格式錯誤與拓撲不符的檢查點被拒絕
+ */
+
+import { describe, test, expect } from 'vitest';
+import { CircuitSimulationEngine } from '../../../src/core/simulation/circuit_simulation_engine';
+import type { SimulationConfig } from '../../../src/core/simulation/circuit_simulation_engine';
+import { Resistor } from '../../../src/components/passive/resistor';
+import { Capacitor } from '../../../src/components/passive/capacitor';
+import { VoltageSource } from '../../../src/components/sources/voltage_source';
+
+const TAU = 1e-4;
+
+function createEngine(config: Partial<SimulationConfig> = {}, extraNode = false): CircuitSimulationEngine {
+  const engine = new CircuitSimulationEngine({
+    endTime: 3 * TAU,
+    initialTimeStep: 1e-6,
+    maxTimeStep: 5e-6,
+    minTimeStep: 1e-7,
+    probes: ['V(a)'],
+    ...config
+  });
+  engine.addDevice(new VoltageSource('V1', ['in', '0'], 10));
+  engine.addDevice(new Resistor('R1', ['in', 'a'], 1000));
+  engine.addDevice(new Capacitor('C1', ['a', '0'], 1e-7));
+  if (extraNode) engine.addDevice(new Resistor('R2', ['a', 'b'], 1000));
+  return engine;
+}
+
+describe('Simulation Checkpoint', () => {
+  test('中途恢復逐位重現', async () => {
+    const engine = createEngine();
+    const reference = await engine.runSimulation();
+    const a = engine.getNodeIdByName('a')!;
+    const time = Array.from(reference.waveformData.timePoints);
+    const va = Array.from(reference.waveformData.nodeVoltages.get(a)!);
+
+    // 在第 3 塊之後保存檢查點並中止
+    const original = createEngine();
+    let rows = 0;
+    let chunks = 0;
+    let blob: Uint8Array | null = null;
+    for await (const chunk of original.stream({ chunkRows: 16 })) {
+      rows += chunk.rowCount;
+      if (++chunks === 3) {
+        blob = original.checkpoint();
+        break;
+      }
+    }
+    expect(blob!.byteLength).toBeLessThan(4096);
+
+    const resumed = createEngine();
+    resumed.restore(blob!);
+    const result = await resumed.runSimulation();
+    expect(result.success).toBe(true);
+    expect(resumed.getWaveformStore()!.rowCount).toBe(time.length);
+    expect(Array.from(result.waveformData.timePoints)).toEqual(time.slice(rows));
+    expect(Array.from(result.waveformData.nodeVoltages.get(a)!)).toEqual(va.slice(rows));
+  });
+
+  test('從已完成的仿真延長', async () => {
+    const first = createEngine({ endTime: 2 * TAU });
+    await first.runSimulation();
+    const blob = first.checkpoint();
+
+    const extended = createEngine({ endTime: 5 * TAU });
+    extended.restore(blob);
+    const result = await extended.runSimulation();
+    expect(result.success).toBe(true);
+    expect(result.waveformData.timePoints[0]!).toBeGreaterThan(2 * TAU);
+    const va = result.waveformData.nodeVoltages.get(extended.getNodeIdByName('a')!)!;
+    expect(va[va.length - 1]!).toBeCloseTo(10 * (1 - Math.exp(-5)), 1);
+  });
+
+  test('拒絕無效檢查點', async () => {
+    expect(() => createEngine().restore(new Uint8Array(32))).toThrow('Not a simulation checkpoint');
+
+    const engine = createEngine({ endTime: TAU });
+    await engine.runSimulation();
+    const mismatched = createEngine({}, true);
+    mismatched.restore(engine.checkpoint());
+    const result = await mismatched.runSimulation();
+    expect(result.success).toBe(false);
+    expect(result.errorMessage!).toMatch(/topology/);
+  });
+});
@@ -0,0 +1,88 @@
+/**
+ * 📏 .MEAS 在線測量集成測試
+ *
+ * 測試目標：
+ * 1. 解析 .MEAS 各類測量語法
+ * 2. RC 充電電路的 AVG/RMS/MAX/INTEG/TRIG-TARG/WHEN/FIND 與解析解一致
+ * 3. 只需測量時可完全不記錄波形
+ */
+
+import { describe, test, expect } from 'vitest';
+import { SpiceNetlistParser } from '../../../src/core/parser/spice_netlist_parser';
+import { CircuitSimulationEngine } from '../../../src/core/simulation/circuit_simulation_engine';
+import type { SimulationConfig } from '../../../src/core/simulation/circuit_simulation_engine';
+import { Resistor } from '../../../src/components/passive/resistor';
+import { Capacitor } from '../../../src/components/passive/capacitor';
+import { VoltageSource } from '../../../src/components/sources/voltage_source';
+
+const TAU = 1e-4;
+
+const MEASURES = `* RC charging measurements
+V1 in 0 DC 10
+R1 in a 1k
+C1 a 0 0.1u
+.TRAN 1u 0.5m
+.MEAS TRAN vavg AVG V(a) FROM=0 TO=0.1m
+.MEAS TRAN vmax MAX V(a)
+.MEAS TRAN irms RMS I(R1) FROM = 0 TO = 0.5m
+.MEAS TRAN charge INTEG I(r1)
+.MEAS TRAN rise TRIG V(a) VAL=1 RISE=1 TARG V(a) VAL=9 RISE=1
+.MEAS TRAN t50 WHEN V(a)=5
+.MEAS TRAN vfind FIND V(a) AT=0.2m
+.MEAS TRAN never WHEN V(a)=20 CROSS=1
+.MEAS TRAN bogus DERIV V(a)
+.END`;
+
+async function charge(config: Partial<SimulationConfig>) {
+  const engine = new CircuitSimulationEngine({
+    endTime: 5 * TAU,
+    initialTimeStep: 1e-6,
+    maxTimeStep: 1e-5,
+    minTimeStep: 1e-8,
+    ...config
+  });
+  engine.addDevice(new VoltageSource('V1', ['in', '0'], 10));
+  engine.addDevice(new Resistor('R1', ['in', 'a'], 1000));
+  engine.addDevice(new Capacitor('C1', ['a', '0'], 1e-7));
+  const result = await engine.runSimulation();
+  return { engine, result };
+}
+
+describe('.MEAS Online Measurements', () => {
+  test('解析 .MEAS', () => {
+    const netlist = new SpiceNetlistParser().parseNetlist(MEASURES);
+    expect(netlist.measurements.map(m => m.name)).toEqual(
+      ['vavg', 'vmax', 'irms', 'charge', 'rise', 't50', 'vfind', 'never']
+    );
+    expect(netlist.measurements[0]).toEqual({ name: 'vavg', kind: 'AVG', signal: 'V(a)', from: 0, to: 1e-4 });
+    expect(netlist.measurements[3]!.signal).toBe('I(R1)');
+    expect(netlist.measurements[4]!.trigger).toEqual({ signal: 'V(a)', value: 1, edge: 'RISE', count: 1, delay: 0 });
+    expect(netlist.measurements[5]!.trigger!.edge).toBe('CROSS');
+    expect(netlist.warnings.some(warning => warning.includes('DERIV'))).toBe(true);
+  });
+
+  test('RC 充電測量與解析解一致', async () => {
+    const { measurements } = new SpiceNetlistParser().parseNetlist(MEASURES);
+    const { result } = await charge({ measurements });
+    expect(result.success).toBe(true);
+    const values = result.measurements!;
+
+    // V(t) = 10·(1 - e^(-t/τ))，I(t) = 10 mA·e^(-t/τ)
+    expect(values.get('vavg')!).toBeCloseTo(10 * Math.exp(-1), 2);
+    expect(values.get('vmax')!).toBeCloseTo(10 * (1 - Math.exp(-5)), 1);
+    expect(values.get('irms')!).toBeCloseTo(0.01 * Math.sqrt((1 - Math.exp(-10)) / 10), 4);
+    expect(values.get('charge')!).toBeCloseTo(1e-7 * 10 * (1 - Math.exp(-5)), 8);
+    expect(values.get('rise')! / TAU).toBeCloseTo(Math.log(9), 3);
+    expect(values.get('t50')! / TAU).toBeCloseTo(Math.log(2), 3);
+    expect(values.get('vfind')!).toBeCloseTo(10 * (1 - Math.exp(-2)), 2);
+    expect(values.get('never')).toBe(null);
+  });
+
+  test('只需測量時不記錄波形', async () => {
+    const { measurements } = new SpiceNetlistParser().parseNetlist(MEASURES);
+    const stored = await charge({ measurements });
+    const { engine, result } = await charge({ measurements, saveIntermediateResults: false });
+    expect(result.waveformData.timePoints.length).toBe(0);
+    expect(engine.getMeasurements().get('t50')).toBe(stored.result.measurements!.get('t50'));
+  });
+});
@@ -0,0 +1,60 @@
+/**
+ * 🕒 輸出時間網格集成測試
+ *
+ * 測試目標：
+ * 1. outputTimeStep (.TRAN tstep) 網格上記錄，點數與內部步數無關
+ * 2. 顯式輸出時間點
+ * 3. 插值結果符合 RC 解析解 V(t) = Vf·(1 - e^(-t/τ))
+ */
+
+import { describe, test, expect } from 'vitest';
+import { CircuitSimulationEngine } from '../../../src/core/simulation/circuit_simulation_engine';
+import type { SimulationConfig } from '../../../src/core/simulation/circuit_simulation_engine';
+import { Resistor } from '../../../src/components/passive/resistor';
+import { Capacitor } from '../../../src/components/passive/capacitor';
+import { VoltageSource } from '../../../src/components/sources/voltage_source';
+
+const TAU = 1e-4;
+
+async function charge(config: Partial<SimulationConfig>) {
+  const engine = new CircuitSimulationEngine({
+    endTime: 5 * TAU,
+    initialTimeStep: 1e-5,
+    maxTimeStep: 1e-4,
+    minTimeStep: 1e-7,
+    ...config
+  });
+  engine.addDevice(new VoltageSource('V1', ['in', '0'], 10));
+  engine.addDevice(new Resistor('R1', ['in', 'a'], 1000));
+  engine.addDevice(new Capacitor('C1', ['a', '0'], 1e-7));
+  const result = await engine.runSimulation();
+  const voltages = result.waveformData.nodeVoltages.get(engine.getNodeIdByName('a')!)!;
+  return { result, time: result.waveformData.timePoints, voltages };
+}
+
+describe('Output Time Grid', () => {
+  test('在 tstep 網格上記錄', async () => {
+    const { result, time, voltages } = await charge({ outputTimeStep: TAU / 2 });
+    expect(result.success).toBe(true);
+    expect(time.length).toBe(11);
+    expect(result.totalSteps).toBeGreaterThan(time.length);
+    time.forEach((t, k) => expect(t).toBeCloseTo(k * TAU / 2, 15));
+
+    voltages.forEach((v, k) => {
+      const exact = 10 * (1 - Math.exp(-time[k]! / TAU));
+      expect(Math.abs(v - exact)).toBeLessThan(0.05);
+    });
+  });
+
+  test('網格不整除時最後一點落在 tstop', async () => {
+    const { time } = await charge({ outputTimeStep: 2 * TAU });
+    expect(Array.from(time)).toEqual([0, 2 * TAU, 4 * TAU, 5 * TAU]);
+  });
+
+  test('顯式輸出時間點', async () => {
+    const outputTimes = [0, 0.7 * TAU, TAU, 3.3 * TAU];
+    const { time, voltages } = await charge({ outputTimes });
+    expect(Array.from(time)).toEqual(outputTimes);
+    expect(voltages[2]).toBeCloseTo(10 * (1 - Math.exp(-1)), 1);
+  });
+});
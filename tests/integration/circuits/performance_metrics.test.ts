@@ -0,0 +1,89 @@
+/**
+ * ⏱️ 性能指標集成測試
+ *
+ * 測試目標：
+ * 1. 各階段計時與分解/重分解/Newton 計數均被實際累計，且階段耗時之和不超過總耗時
+ * 2. 關閉 enablePerformanceMonitoring 時不計時，但計數照常
+ * 3. 每次運行重新統計
+ * 4. DC Newton 迭代沿用同一去地子矩陣：首次分解後只做數值重分解
+ */
+
+import { describe, test, expect } from 'vitest';
+import { CircuitSimulationEngine } from '../../../src/core/simulation/circuit_simulation_engine';
+import type { SimulationConfig } from '../../../src/core/simulation/circuit_simulation_engine';
+import { Resistor } from '../../../src/components/passive/resistor';
+import { Capacitor } from '../../../src/components/passive/capacitor';
+import { VoltageSource } from '../../../src/components/sources/voltage_source';
+import { DIODE_CLAMP, solveDC } from '../../utils/DCFixtures';
+
+const TAU = 1e-4;
+
+function createEngine(config: Partial<SimulationConfig> = {}): CircuitSimulationEngine {
+  const engine = new CircuitSimulationEngine({
+    endTime: 2 * TAU,
+    initialTimeStep: 1e-6,
+    maxTimeStep: 5e-6,
+    minTimeStep: 1e-7,
+    solverMode: 'klu',
+    ...config
+  });
+  engine.addDevice(new VoltageSource('V1', ['in', '0'], 10));
+  engine.addDevice(new Resistor('R1', ['in', 'a'], 1000));
+  engine.addDevice(new Capacitor('C1', ['a', '0'], 1e-7));
+  return engine;
+}
+
+describe('Performance Metrics', () => {
+  test('各階段計時與計數', async () => {
+    const result = await createEngine().runSimulation();
+    expect(result.success).toBe(true);
+    const metrics = result.performanceMetrics;
+
+    expect(metrics.newtonIterations).toBeGreaterThan(result.totalSteps);
+    expect(metrics.averageIterationsPerStep).toBeGreaterThanOrEqual(1);
+    // 拓撲不變：首次完整分解後沿用主元順序重分解
+    expect(metrics.matrixFactorizations).toBeGreaterThan(0);
+    expect(metrics.matrixRefactorizations).toBeGreaterThan(metrics.matrixFactorizations);
+
+    for (const phase of [
+      'matrixAssemblyTime', 'deviceEvaluationTime', 'matrixFactorizationTime', 'matrixSolutionTime',
+      'convergenceCheckTime', 'waveformSaveTime'
+    ] as const) {
+      expect(metrics[phase]).toBeGreaterThan(0);
+    }
+    const phases = metrics.matrixAssemblyTime + metrics.deviceEvaluationTime + metrics.matrixFactorizationTime
+      + metrics.matrixSolutionTime + metrics.convergenceCheckTime + metrics.eventDetectionTime + metrics.waveformSaveTime;
+    expect(phases).toBeLessThanOrEqual(metrics.totalSimulationTime);
+    expect(metrics.heapPeakUsage).toBeGreaterThan(0);
+  });
+
+  test('關閉監控時只計數', async () => {
+    const result = await createEngine({ enablePerformanceMonitoring: false }).runSimulation();
+    const metrics = result.performanceMetrics;
+    expect(metrics.newtonIterations).toBeGreaterThan(0);
+    expect(metrics.matrixFactorizations + metrics.matrixRefactorizations).toBeGreaterThan(0);
+    expect(metrics.matrixAssemblyTime).toBe(0);
+    expect(metrics.deviceEvaluationTime).toBe(0);
+    expect(metrics.matrixFactorizationTime).toBe(0);
+    expect(metrics.matrixSolutionTime).toBe(0);
+    expect(metrics.convergenceCheckTime).toBe(0);
+    expect(metrics.heapPeakUsage).toBe(0);
+  });
+
+  test('每次運行重新統計', async () => {
+    const engine = createEngine();
+    const first = await engine.runSimulation();
+    const iterations = first.performanceMetrics.newtonIterations;
+    const second = await engine.runSimulation();
+    expect(second.performanceMetrics).not.toBe(first.performanceMetrics);
+    expect(second.performanceMetrics.newtonIterations).toBe(iterations);
+  });
+  test('DC Newton 迭代沿用去地子矩陣分解', async () => {
+    const { result } = await solveDC(DIODE_CLAMP, { solverMode: 'klu', dcStrategy: 'newton' });
+    expect(result.success).toBe(true);
+    const metrics = result.performanceMetrics;
+    expect(metrics.newtonIterations).toBeGreaterThan(2);
+    expect(metrics.matrixFactorizations).toBe(1);
+    expect(metrics.matrixRefactorizations).toBe(metrics.newtonIterations - 1);
+  });
+});
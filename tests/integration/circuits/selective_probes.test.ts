@@ -0,0 +1,93 @@
+/**
+ * 🔎 選擇性探測集成測試 (.SAVE / .PROBE)
+ *
+ * 測試目標：
+ * 1. 解析器規整 .SAVE/.PROBE 信號名
+ * 2. 只記錄被探測的節點電壓與器件電流，其餘信號不佔存儲
+ * 3. 被探測信號的數值與全量記錄一致
+ */
+
+import { describe, test, expect } from 'vitest';
+import { SpiceNetlistParser } from '../../../src/core/parser/spice_netlist_parser';
+import { CircuitSimulationEngine, SimulationEventType } from '../../../src/core/simulation/circuit_simulation_engine';
+import { Resistor } from '../../../src/components/passive/resistor';
+import { Capacitor } from '../../../src/components/passive/capacitor';
+import { VoltageSource } from '../../../src/components/sources/voltage_source';
+
+const LADDER = `* RC ladder
+V1 in 0 DC 10
+R1 in a 1k
+C1 a 0 1u
+R2 a b 1k
+C2 b 0 1u
+R3 b out 1k
+C3 out 0 1u
+.SAVE v(out) I(r2)
+.PROBE TRAN b
+.TRAN 10u 1m
+.END`;
+
+async function run(probes?: readonly string[]) {
+  const engine = new CircuitSimulationEngine({
+    endTime: 1e-3,
+    initialTimeStep: 1e-5,
+    maxTimeStep: 2e-5,
+    minTimeStep: 5e-6,
+    ...(probes !== undefined ? { probes } : {})
+  });
+  engine.addDevice(new VoltageSource('V1', ['in', '0'], 10));
+  engine.addDevice(new Resistor('R1', ['in', 'a'], 1000));
+  engine.addDevice(new Capacitor('C1', ['a', '0'], 1e-6));
+  engine.addDevice(new Resistor('R2', ['a', 'b'], 1000));
+  engine.addDevice(new Capacitor('C2', ['b', '0'], 1e-6));
+  engine.addDevice(new Resistor('R3', ['b', 'out'], 1000));
+  engine.addDevice(new Capacitor('C3', ['out', '0'], 1e-6));
+  const result = await engine.runSimulation();
+  return { engine, result };
+}
+
+describe('Selective Probe Capture', () => {
+  test('解析 .SAVE 與 .PROBE', () => {
+    const parser = new SpiceNetlistParser();
+    const netlist = parser.parseNetlist(LADDER);
+    expect(netlist.probes).toEqual(['V(out)', 'I(R2)', 'V(b)']);
+    expect(parser.parseNetlist(LADDER.replace('.SAVE v(out) I(r2)', '.SAVE V(a,b)')).warnings
+      .some(warning => warning.includes('Unsupported probe'))).toBe(true);
+  });
+
+  test('只記錄被探測的信號', async () => {
+    const full = await run();
+    expect(full.result.success).toBe(true);
+    expect(full.engine.getWaveformStore()!.numericColumns.length).toBeGreaterThan(10);
+
+    const probed = await run(new SpiceNetlistParser().parseNetlist(LADDER).probes);
+    expect(probed.result.success).toBe(true);
+    const store = probed.engine.getWaveformStore()!;
+    expect([...store.numericColumns].sort()).toEqual(['I(R2)', 'V(b)', 'V(out)']);
+    expect(store.enumColumns).toEqual(['S(R2)']);
+
+    const data = probed.result.waveformData;
+    expect(data.nodeVoltages.size).toBe(2);
+    expect(data.deviceCurrents.size).toBe(1);
+    expect(data.nodeVoltages.has(probed.engine.getNodeIdByName('a')!)).toBe(false);
+    expect(data.deviceCurrents.has('R1')).toBe(false);
+  });
+
+  test('探測值與全量記錄一致', async () => {
+    const full = await run();
+    const probed = await run(['out', 'i(R2)', 'I(V1)']);
+    const fullData = full.result.waveformData;
+    const data = probed.result.waveformData;
+    expect(data.timePoints.length).toBe(fullData.timePoints.length);
+
+    const out = probed.engine.getNodeIdByName('out')!;
+    const last = data.timePoints.length - 1;
+    expect(data.nodeVoltages.get(out)![last]).toBeCloseTo(fullData.nodeVoltages.get(out)![last]!, 12);
+    expect(data.deviceCurrents.get('R2')![last]).toBeCloseTo(fullData.deviceCurrents.get('R2')![last]!, 15);
+    expect(data.deviceCurrents.get('V1')![last]).toBeCloseTo(fullData.deviceCurrents.get('V1')![last]!, 15);
+    expect(probed.engine.getSimulationEvents().some(event => event.type === SimulationEventType.PROBE_UNKNOWN)).toBe(false);
+
+    const missing = await run(['V(nowhere)']);
+    expect(missing.engine.getSimulationEvents().some(event => event.type === SimulationEventType.PROBE_UNKNOWN)).toBe(true);
+  });
+});
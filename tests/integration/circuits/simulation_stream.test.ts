@@ -0,0 +1,148 @@
+/**
+ * 📡 流式仿真集成測試
+ *
+ * 測試目標：
+ * 1. stream() 逐塊交付的樣本與波形存儲一致，迭代結束返回 SimulationResult
+ * 2. 背壓：消費者未取下一塊時仿真不推進；暫停/恢復在塊之間生效
+ * 3. AbortSignal 取消 (狀態 ABORTED) 與提前 break 都會停止仿真
+ * 4. 不記錄樣本的運行 (saveIntermediateResults=false) 也按 maxLatency 讓出事件循環，暫停與取消及時生效
+ */
+
+import { describe, test, expect } from 'vitest';
+import { CircuitSimulationEngine, SimulationState } from '../../../src/core/simulation/circuit_simulation_engine';
+import type { SimulationConfig } from '../../../src/core/simulation/circuit_simulation_engine';
+import type { SimulationStreamChunk } from '../../../src/core/simulation/simulation_stream';
+import { Resistor } from '../../../src/components/passive/resistor';
+import { Capacitor } from '../../../src/components/passive/capacitor';
+import { VoltageSource } from '../../../src/components/sources/voltage_source';
+
+const TAU = 1e-4;
+
+function createEngine(config: Partial<SimulationConfig> = {}): CircuitSimulationEngine {
+  const engine = new CircuitSimulationEngine({
+    endTime: 5 * TAU,
+    initialTimeStep: 1e-6,
+    maxTimeStep: 2e-6,
+    minTimeStep: 1e-7,
+    probes: ['V(a)', 'I(V1)'],
+    ...config
+  });
+  engine.addDevice(new VoltageSource('V1', ['in', '0'], 10));
+  engine.addDevice(new Resistor('R1', ['in', 'a'], 1000));
+  engine.addDevice(new Capacitor('C1', ['a', '0'], 1e-7));
+  return engine;
+}
+
+const sleep = (ms: number) => new Promise(resolve => setTimeout(resolve, ms));
+
+describe('Simulation Stream', () => {
+  test('逐塊交付全部樣本', async () => {
+    const engine = createEngine();
+    const chunks: SimulationStreamChunk[] = [];
+    const iterator = engine.stream({ chunkRows: 32, maxLatency: Infinity });
+    let next = await iterator.next();
+    while (!next.done) {
+      chunks.push(next.value);
+      next = await iterator.next();
+    }
+
+    const result = next.value;
+    expect(result.success).toBe(true);
+    expect(chunks.length).toBeGreaterThan(3);
+    expect(chunks[0]!.columns).toEqual(['V(a)', 'I(V1)']);
+    chunks.slice(0, -1).forEach(chunk => expect(chunk.rowCount).toBe(32));
+
+    let row = 0;
+    const time: number[] = [];
+    const va: number[] = [];
+    for (const chunk of chunks) {
+      expect(chunk.startRow).toBe(row);
+      row += chunk.rowCount;
+      time.push(...chunk.time);
+      va.push(...chunk.values.subarray(0, chunk.rowCount));
+    }
+    expect(time).toEqual(Array.from(result.waveformData.timePoints));
+    expect(va).toEqual(Array.from(result.waveformData.nodeVoltages.get(engine.getNodeIdByName('a')!)!));
+    expect(va[va.length - 1]!).toBeCloseTo(10 * (1 - Math.exp(-5)), 1);
+  });
+
+  test('背壓與暫停', async () => {
+    const engine = createEngine();
+    const iterator = engine.stream({ chunkRows: 16 });
+    const first = await iterator.next();
+    expect(first.done).toBe(false);
+
+    // 消費者未請求下一塊時仿真掛起
+    const suspendedAt = engine.getSimulationStatus().currentTime;
+    await sleep(20);
+    expect(engine.getSimulationStatus().currentTime).toBe(suspendedAt);
+
+    // 暫停後請求下一塊也不推進，恢復後繼續
+    engine.pauseSimulation();
+    const pending = iterator.next();
+    await sleep(20);
+    expect(engine.getSimulationStatus().currentTime).toBe(suspendedAt);
+    engine.resumeSimulation();
+    const second = await pending;
+    expect(second.done).toBe(false);
+    expect(engine.getSimulationStatus().currentTime).toBeGreaterThan(suspendedAt);
+
+    // 提前結束迭代會停止仿真
+    await iterator.return(undefined as never);
+    expect(engine.getSimulationStatus().state).toBe(SimulationState.COMPLETED);
+    expect(engine.getSimulationStatus().currentTime).toBeLessThan(5 * TAU);
+  });
+
+  test('AbortSignal 取消', async () => {
+    const engine = createEngine();
+    const controller = new AbortController();
+    const received: SimulationStreamChunk[] = [];
+    const consume = async () => {
+      for await (const chunk of engine.stream({ chunkRows: 16, signal: controller.signal })) {
+        if (received.push(chunk) === 2) controller.abort();
+      }
+    };
+    await expect(consume()).rejects.toThrow();
+    expect(received.length).toBe(2);
+    expect(engine.getSimulationStatus().state).toBe(SimulationState.ABORTED);
+    expect(engine.getSimulationStatus().currentTime).toBeLessThan(5 * TAU);
+  });
+
+  test('無樣本可交付時仍按 maxLatency 讓出事件循環', async () => {
+    const config = { endTime: 200 * TAU, maxTimeStep: 1e-6, saveIntermediateResults: false };
+
+    // 定時器在仿真中途觸發暫停，恢復後跑完且不交付任何塊
+    const paused = createEngine(config);
+    let pausedAt = -1;
+    const timer = setTimeout(() => {
+      paused.pauseSimulation();
+      pausedAt = paused.getSimulationStatus().currentTime;
+      setTimeout(() => paused.resumeSimulation(), 10);
+    }, 5);
+    const chunks: SimulationStreamChunk[] = [];
+    const iterator = paused.stream({ maxLatency: 2 });
+    let next = await iterator.next();
+    while (!next.done) {
+      chunks.push(next.value);
+      next = await iterator.next();
+    }
+    clearTimeout(timer);
+    expect(next.value.success).toBe(true);
+    expect(chunks.length).toBe(0);
+    expect(pausedAt).toBeGreaterThan(0);
+    expect(pausedAt).toBeLessThan(200 * TAU);
+
+    // 定時器中止同樣在仿真結束前生效
+    const aborted = createEngine(config);
+    const controller = new AbortController();
+    setTimeout(() => controller.abort(), 5);
+    const consume = async () => {
+      for await (const chunk of aborted.stream({ maxLatency: 2, signal: controller.signal })) {
+        chunks.push(chunk);
+      }
+    };
+    await expect(consume()).rejects.toThrow();
+    expect(aborted.getSimulationStatus().state).toBe(SimulationState.ABORTED);
+    expect(aborted.getSimulationStatus().currentTime).toBeLessThan(200 * TAU);
+  });
+});
@@ -0,0 +1,80 @@
+/**
+ * 🧵 執行軌迹集成測試
+ *
+ * 測試目標：
+ * 1. 開啟 trace 後記錄時間步、Newton、裝配、分解、求解、積分器重啟跨度，並導出合法的 Chrome Trace JSON
+ * 2. 未開啟時不記錄
+ * 3. 環形緩衝寫滿後覆蓋最舊跨度並計數
+ */
+
+import { describe, test, expect } from 'vitest';
+import { CircuitSimulationEngine } from '../../../src/core/simulation/circuit_simulation_engine';
+import type { SimulationConfig } from '../../../src/core/simulation/circuit_simulation_engine';
+import { SimulationTracer } from '../../../src/core/simulation/simulation_tracer';
+import { Resistor } from '../../../src/components/passive/resistor';
+import { Capacitor } from '../../../src/components/passive/capacitor';
+import { VoltageSource } from '../../../src/components/sources/voltage_source';
+
+function createEngine(config: Partial<SimulationConfig> = {}): CircuitSimulationEngine {
+  const engine = new CircuitSimulationEngine({
+    endTime: 2e-5,
+    initialTimeStep: 1e-6,
+    maxTimeStep: 5e-6,
+    minTimeStep: 1e-7,
+    solverMode: 'klu',
+    ...config
+  });
+  engine.addDevice(new VoltageSource('V1', ['in', '0'], 10));
+  engine.addDevice(new Resistor('R1', ['in', 'a'], 1000));
+  engine.addDevice(new Capacitor('C1', ['a', '0'], 1e-7));
+  return engine;
+}
+
+describe('Simulation Trace', () => {
+  test('記錄各類跨度並導出 Chrome Trace', async () => {
+    const engine = createEngine({ trace: {} });
+    const result = await engine.runSimulation();
+    expect(result.success).toBe(true);
+
+    const tracer = engine.getTracer()!;
+    expect(tracer.droppedSpans).toBe(0);
+    const trace = JSON.parse(tracer.exportChromeTrace());
+    const spans = trace.traceEvents.filter((event: { ph: string }) => event.ph === 'X');
+    expect(spans).toHaveLength(tracer.spanCount);
+
+    const names = new Set(spans.map((event: { name: string }) => event.name));
+    for (const name of ['timestep', 'newton', 'assemble', 'factor', 'solve', 'integrator_restart']) {
+      expect(names.has(name)).toBe(true);
+    }
+    expect(spans.filter((event: { name: string }) => event.name === 'timestep')).toHaveLength(result.totalSteps);
+
+    for (const span of spans) {
+      expect(span.dur).toBeGreaterThanOrEqual(0);
+      expect(Number.isFinite(span.args.time)).toBe(true);
+      expect(Number.isFinite(span.args.dt)).toBe(true);
+    }
+    const newton = spans.find((event: { name: string; args: { dt: number } }) => event.name === 'newton' && event.args.dt > 0);
+    expect(newton.args.residual).toBeGreaterThanOrEqual(0);
+    expect(newton.args.iteration).toBeGreaterThanOrEqual(0);
+  });
+
+  test('未開啟時不記錄', async () => {
+    const engine = createEngine();
+    await engine.runSimulation();
+    expect(engine.getTracer()).toBeNull();
+  });
+
+  test('環形緩衝覆蓋最舊跨度', () => {
+    const tracer = new SimulationTracer({ capacity: 4 });
+    for (let i = 0; i < 10; i++) {
+      tracer.record('solve', i, 1, i * 1e-6, 1e-6);
+    }
+    expect(tracer.spanCount).toBe(4);
+    expect(tracer.droppedSpans).toBe(6);
+
+    const trace = tracer.toChromeTrace();
+    const times = trace.traceEvents.filter(event => event.ph === 'X').map(event => event.args['time']);
+    expect(times).toEqual([6e-6, 7e-6, 8e-6, 9e-6]);
+    expect(trace.otherData.droppedSpans).toBe(6);
+  });
+});
@@ -0,0 +1,104 @@
+/**
+ * 📐 自適應同倫集成測試
+ *
+ * 測試目標：
+ * 1. 容易的電路：步長自動放大，總步數少於固定 10 步的對數 Gmin 排程
+ * 2. 困難的步：失敗時二分步長並從上一收斂點 (解與器件線性化點) 繼續，而非整體放棄
+ * 3. 偽瞬態連續：偽步長按殘差下降放大，失敗時退回上一偽時間步並縮小步長
+ */
+
+import { describe, test, expect } from 'vitest';
+import { SpiceNetlistParser } from '../../../src/core/parser/spice_netlist_parser';
+import { CircuitSimulationEngine, SimulationEventType } from '../../../src/core/simulation/circuit_simulation_engine';
+import type { DeviceStateSnapshot } from '../../../src/core/devices/intelligent_device_model';
+import { DIODE_CLAMP, solveDC } from '../../utils/DCFixtures';
+
+// 三個二極體串聯：純 Newton 在 4 次迭代內無法從遠處收斂
+const DIODE_STACK = `* diode stack
+V1 in 0 DC 10
+R1 in out 1k
+D1 out a DMOD
+D2 a b DMOD
+D3 b 0 DMOD
+.MODEL DMOD D IS=1e-16 N=1
+.END`;
+
+describe('Adaptive Homotopy', () => {
+  test('容易的電路自動放大步長', async () => {
+    const { result, events } = await solveDC(DIODE_CLAMP, { dcStrategy: 'gmin' });
+    expect(result.success).toBe(true);
+
+    const steps = events.filter(event => event.type === SimulationEventType.GMIN_STEP);
+    const failures = events.filter(event => event.type === SimulationEventType.GMIN_STEP_FAILED);
+    expect(failures.length).toBe(0);
+    // 固定排程需要 11 個 Gmin 點 + 最終檢查
+    expect(steps.length).toBeLessThan(11);
+  });
+
+  test('源步進失敗時二分步長並繼續', async () => {
+    // 限制 Newton 迭代次數，使 25% 的源步長無法一步收斂
+    const { result, events, out } = await solveDC(DIODE_CLAMP, { dcStrategy: 'source', maxNewtonIterations: 5 });
+    expect(result.success).toBe(true);
+    expect(events.filter(event => event.type === SimulationEventType.SOURCE_STEP_FAILED).length).toBeGreaterThan(0);
+
+    const reference = await solveDC(DIODE_CLAMP);
+    expect(out).toBeCloseTo(reference.out, 6);
+  });
+
+  test('拒絕的步同時退回器件線性化點', async () => {
+    const parser = new SpiceNetlistParser();
+    const devices = parser.createDevicesFromNetlist(parser.parseNetlist(DIODE_CLAMP));
+    const diode = devices.find(device => device.name === 'D1')! as typeof devices[number] & {
+      getStateSnapshot(): DeviceStateSnapshot;
+      restoreStateSnapshot(snapshot: DeviceStateSnapshot): void;
+    };
+    const restored: DeviceStateSnapshot[] = [];
+    const restore = diode.restoreStateSnapshot.bind(diode);
+    diode.restoreStateSnapshot = snapshot => {
+      restored.push(snapshot);
+      restore(snapshot);
+    };
+
+    const engine = new CircuitSimulationEngine({ endTime: 0, dcStrategy: 'source', maxNewtonIterations: 5 });
+    engine.addDevices(devices);
+    expect((await engine.runSimulation()).success).toBe(true);
+
+    const failures = engine.getSimulationEvents().filter(event => event.type === SimulationEventType.SOURCE_STEP_FAILED);
+    expect(failures.length).toBeGreaterThan(0);
+    expect(restored.length).toBe(failures.length);
+    // 退回的線性化點是已收斂的低源步，結電壓不超過最終工作點
+    const out = engine.getOperatingPoint()!.get(engine.getNodeIdByName('out')!);
+    for (const snapshot of restored) {
+      expect(snapshot.internalStates['voltage'] as number).toBeLessThanOrEqual(out + 1e-9);
+    }
+  });
+
+  test('偽瞬態連續按殘差放大偽步長', async () => {
+    const { result, events, out } = await solveDC(DIODE_CLAMP, { dcStrategy: 'ptc' });
+    expect(result.success).toBe(true);
+    expect(events.filter(event => event.type === SimulationEventType.PTC_STEP_FAILED).length).toBe(0);
+
+    // 接受步的偽電導 C/h 單調下降，且少於固定 10 步的對數排程
+    const conductances = events
+      .filter(event => event.type === SimulationEventType.PTC_STEP && !Number.isNaN(event.value))
+      .map(event => event.value);
+    expect(conductances.length).toBeGreaterThan(1);
+    expect(conductances.length).toBeLessThan(10);
+    for (let i = 1; i < conductances.length; i++) {
+      expect(conductances[i]!).toBeLessThan(conductances[i - 1]!);
+    }
+
+    const reference = await solveDC(DIODE_CLAMP);
+    expect(out).toBeCloseTo(reference.out, 6);
+  });
+
+  test('偽瞬態連續失敗時縮小偽步長並繼續', async () => {
+    const { result, events, out } = await solveDC(DIODE_STACK, { dcStrategy: 'ptc', maxNewtonIterations: 4 });
+    expect(result.success).toBe(true);
+    expect(events.filter(event => event.type === SimulationEventType.PTC_STEP_FAILED).length).toBeGreaterThan(0);
+
+    const reference = await solveDC(DIODE_STACK, { dcStrategy: 'gmin' });
+    expect(reference.result.success).toBe(true);
+    expect(out).toBeCloseTo(reference.out, 6);
+  });
+});
@@ -0,0 +1,265 @@
+/**
+ * 🧬 鎖步批量仿真集成測試
+ * 
+ * 測試目標：
+ * 1. 向量化內核 (R/C/L/V) 的 DC 結果與解析解一致
+ * 2. 二極體、MOSFET 批量內核的結果與單實例引擎一致
+ * 3. 批量瞬態 (Backward Euler) 逼近 RC 解析解，DC 失敗的實例不推進
+ * 4. 含二極體、MOSFET 的批量瞬態與固定步長的單實例引擎逐步一致
+ * 5. 拓撲不一致、器件或器件參數不支持時拋出異常
+ */
+
+import { describe, test, expect } from 'vitest';
+import { BatchedCircuitSimulator } from '../../../src/core/simulation/batched_simulation';
+import { CircuitSimulationEngine } from '../../../src/core/simulation/circuit_simulation_engine';
+import { Resistor } from '../../../src/components/passive/resistor';
+import { Capacitor } from '../../../src/components/passive/capacitor';
+import { Inductor } from '../../../src/components/passive/inductor';
+import { VoltageSource } from '../../../src/components/sources/voltage_source';
+import { SmartDeviceFactory } from '../../../src/core/devices/intelligent_device_factory';
+import { IntelligentDiode } from '../../../src/core/devices/intelligent_diode';
+import { IntelligentMOSFET } from '../../../src/core/devices/intelligent_mosfet';
+import type { ComponentInterface } from '../../../src/core/interfaces/component';
+
+// 批量內核不建模的寄生/額定參數取中性值
+const IDEAL_DIODE = { Rs: 0, Cj0: 0, tt: 0 };
+const IDEAL_MOSFET = { Cgs: 0, Cgd: 0, Vmax: Infinity, Imax: Infinity };
+
+// 單實例引擎的 DC 工作點 (節點電壓)
+async function engineOperatingPoint(devices: ComponentInterface[], node: string): Promise<number> {
+  const engine = new CircuitSimulationEngine({ endTime: 0 });
+  engine.addDevices(devices);
+  await engine.runSimulation();
+  return engine.getOperatingPoint()!.get(engine.getNodeIdByName(node)!);
+}
+
+// 批量瞬態與固定步長 (min = max = dt) 單實例引擎在 endTime 內各時間點的最大偏差
+async function maxTransientDeviation(
+  build: (value: number) => ComponentInterface[],
+  values: readonly number[],
+  node: string,
+  endTime: number,
+  dt: number
+): Promise<number> {
+  const batched = new BatchedCircuitSimulator(values.map(build)).runTransient(endTime, dt, [node]);
+  expect(Array.from(batched.converged)).toEqual(values.map(() => 1));
+  const voltages = batched.nodeVoltages.get(node)!;
+
+  let deviation = 0;
+  for (let s = 0; s < values.length; s++) {
+    const engine = new CircuitSimulationEngine({ endTime, initialTimeStep: dt, minTimeStep: dt, maxTimeStep: dt });
+    engine.addDevices(build(values[s]!));
+    const { success, waveformData } = await engine.runSimulation();
+    expect(success).toBe(true);
+    const reference = waveformData.nodeVoltages.get(engine.getNodeIdByName(node)!)!;
+    let compared = 0;
+    waveformData.timePoints.forEach((time, k) => {
+      const step = Math.round(time / dt);
+      if (step > batched.timePoints.length - 1) return;
+      deviation = Math.max(deviation, Math.abs(voltages[step * values.length + s]! - reference[k]!));
+      compared++;
+    });
+    expect(compared).toBe(batched.timePoints.length - 1);
+  }
+  return deviation;
+}
+
+describe('BatchedCircuitSimulator - DC', () => {
+  test('電阻分壓 + 電感短路 (純向量化內核)', () => {
+    const r2Values = [500, 1000, 2000, 4000];
+    const sim = new BatchedCircuitSimulator(r2Values.map(r2 => [
+      new VoltageSource('V1', ['in', '0'], 12),
+      new Inductor('L1', ['in', 'mid'], 1e-3),
+      new Resistor('R1', ['mid', 'out'], 1000),
+      new Resistor('R2', ['out', '0'], r2),
+      new Capacitor('C1', ['out', '0'], 1e-6)
+    ]));
+
+    expect(sim.kernelStatistics).toEqual({ linear: 5, nonlinear: 0, pivotRefreshes: 0 });
+
+    const op = sim.solveOperatingPoint();
+    const out = sim.getNodeIdByName('out')!;
+    r2Values.forEach((r2, s) => {
+      expect(op.converged[s]).toBe(1);
+      expect(sim.getValue(op.solution, out, s)).toBeCloseTo(12 * r2 / (1000 + r2), 5);
+    });
+  });
+
+  test('二極體鉗位與單實例引擎一致', async () => {
+    // V1 < 0 的實例二極體反偏，與正偏實例混合鎖步
+    const r1Values = [500, 1000, 4000, -1000];
+    const build = (r1: number) => [
+      new VoltageSource('V1', ['in', '0'], Math.sign(r1) * 10),
+      new Resistor('R1', ['in', 'out'], Math.abs(r1)),
+      new Resistor('R2', ['out', '0'], 1000),
+      SmartDeviceFactory.createDiode('D1', ['out', '0'], IDEAL_DIODE)
+    ];
+
+    const sim = new BatchedCircuitSimulator(r1Values.map(build));
+    expect(sim.kernelStatistics.nonlinear).toBe(1);
+    const op = sim.solveOperatingPoint();
+    const out = sim.getNodeIdByName('out')!;
+
+    for (let s = 0; s < r1Values.length; s++) {
+      expect(op.converged[s]).toBe(1);
+      expect(sim.getValue(op.solution, out, s)).toBeCloseTo(await engineOperatingPoint(build(r1Values[s]!), 'out'), 6);
+    }
+  });
+
+  test('MOSFET 各工作區與單實例引擎一致', async () => {
+    // 截止、飽和、線性
+    const gateVoltages = [1, 4, 10];
+    const build = (vg: number) => [
+      new VoltageSource('VDD', ['vdd', '0'], 10),
+      new VoltageSource('VG', ['g', '0'], vg),
+      new Resistor('RD', ['vdd', 'd'], 100),
+      SmartDeviceFactory.createMOSFET('M1', ['d', 'g', '0'], IDEAL_MOSFET)
+    ];
+
+    const sim = new BatchedCircuitSimulator(gateVoltages.map(build));
+    expect(sim.kernelStatistics.nonlinear).toBe(1);
+    const op = sim.solveOperatingPoint();
+    const drain = sim.getNodeIdByName('d')!;
+
+    for (let s = 0; s < gateVoltages.length; s++) {
+      expect(op.converged[s]).toBe(1);
+      expect(sim.getValue(op.solution, drain, s)).toBeCloseTo(await engineOperatingPoint(build(gateVoltages[s]!), 'd'), 6);
+    }
+  });
+
+  test('多數實例主元失效時重新選主元', () => {
+    // 首個實例以 R1 的電導為主元；其餘實例該電導相對極小，共享主元序列失效
+    const r1Values = [1, 1e15, 1e15];
+    const sim = new BatchedCircuitSimulator(r1Values.map(r1 => [
+      new VoltageSource('V1', ['in', '0'], 1),
+      new Resistor('R1', ['in', 'out'], r1),
+      new Resistor('R2', ['out', '0'], 1)
+    ]));
+    const op = sim.solveOperatingPoint();
+    const out = sim.getNodeIdByName('out')!;
+
+    expect(sim.kernelStatistics.pivotRefreshes).toBe(1);
+    r1Values.forEach((r1, s) => {
+      expect(op.converged[s]).toBe(1);
+      expect(sim.getValue(op.solution, out, s) * (r1 + 1)).toBeCloseTo(1, 9);
+    });
+  });
+
+  test('熱啟動初值只需少量迭代', () => {
+    const build = (r1: number) => [
+      new VoltageSource('V1', ['in', '0'], 10),
+      new Resistor('R1', ['in', 'out'], r1),
+      SmartDeviceFactory.createDiode('D1', ['out', '0'], IDEAL_DIODE)
+    ];
+    const nominal = new BatchedCircuitSimulator([build(1000)]).solveOperatingPoint();
+
+    const sim = new BatchedCircuitSimulator([build(950), build(1000), build(1050)]);
+    const cold = sim.solveOperatingPoint();
+    const warm = new BatchedCircuitSimulator([build(950), build(1000), build(1050)])
+      .solveOperatingPoint(Float64Array.from({ length: 3 * sim.size }, (_, k) => nominal.solution[Math.floor(k / 3)]!));
+
+    expect(Array.from(warm.converged)).toEqual([1, 1, 1]);
+    expect(warm.iterations).toBeLessThan(cold.iterations);
+  });
+
+  test('拓撲不一致時拋出異常', () => {
+    expect(() => new BatchedCircuitSimulator([
+      [new VoltageSource('V1', ['a', '0'], 1), new Resistor('R1', ['a', '0'], 1)],
+      [new VoltageSource('V1', ['a', '0'], 1), new Resistor('R1', ['a', 'b'], 1)]
+    ])).toThrow();
+  });
+
+  test('不支持的器件類型拋出異常', () => {
+    const unsupported = {
+      name: 'X1', type: 'X', nodes: ['a', '0'],
+      assemble: () => {},
+      validate: () => ({ isValid: true, errors: [], warnings: [] }),
+      getInfo: () => ({ type: 'X', name: 'X1', nodes: ['a', '0'], parameters: {} })
+    };
+    expect(() => new BatchedCircuitSimulator([[new VoltageSource('V1', ['a', '0'], 1), unsupported]]))
+      .toThrow(/X1/);
+  });
+
+  test('內核未建模的器件參數拋出異常而非忽略', () => {
+    const diode = (parameters: Record<string, number>) => [[
+      new VoltageSource('V1', ['a', '0'], 1),
+      new Resistor('R1', ['a', 'b'], 1000),
+      SmartDeviceFactory.createDiode('D1', ['b', '0'], { ...IDEAL_DIODE, ...parameters })
+    ]];
+    const mosfet = (parameters: Record<string, number>) => [[
+      new VoltageSource('V1', ['a', '0'], 1),
+      new Resistor('R1', ['a', 'b'], 1000),
+      SmartDeviceFactory.createMOSFET('M1', ['b', 'a', '0'], { ...IDEAL_MOSFET, ...parameters })
+    ]];
+
+    expect(() => new BatchedCircuitSimulator(diode({}))).not.toThrow();
+    expect(() => new BatchedCircuitSimulator(diode({ Rs: 0.01 }))).toThrow(/D1 parameter Rs/);
+    expect(() => new BatchedCircuitSimulator(diode({ Cj0: 1e-12 }))).toThrow(/D1 parameter Cj0/);
+    expect(() => new BatchedCircuitSimulator(mosfet({}))).not.toThrow();
+    expect(() => new BatchedCircuitSimulator(mosfet({ Cgd: 2e-12 }))).toThrow(/M1 parameter Cgd/);
+    expect(() => new BatchedCircuitSimulator(mosfet({ Imax: 10 }))).toThrow(/M1 parameter Imax/);
+
+    // 任一實例違反即拒絕
+    expect(() => new BatchedCircuitSimulator([...diode({}), ...diode({ tt: 1e-9 })])).toThrow(/D1 parameter tt/);
+  });
+});
+
+describe('BatchedCircuitSimulator - 瞬態', () => {
+  test('RC 充電逼近解析解', () => {
+    const rValues = [1000, 2000];
+    const C = 1e-6;
+    const sim = new BatchedCircuitSimulator(rValues.map(r => [
+      new VoltageSource('V1', ['in', '0'], 5),
+      new Resistor('R1', ['in', 'out'], r),
+      new Capacitor('C1', ['out', '0'], C)
+    ]));
+
+    const endTime = 2e-3;
+    const result = sim.runTransient(endTime, 1e-6, ['out']);
+    const out = result.nodeVoltages.get('out')!;
+    const last = result.timePoints.length - 1;
+
+    expect(result.timePoints[last]).toBeCloseTo(endTime, 12);
+    rValues.forEach((r, s) => {
+      expect(result.converged[s]).toBe(1);
+      expect(out[s]).toBe(0); // 零初始條件
+      const expected = 5 * (1 - Math.exp(-endTime / (r * C)));
+      expect(Math.abs(out[last * rValues.length + s]! - expected)).toBeLessThan(5e-3);
+    });
+  });
+
+  test('DC 未收斂的實例不推進且報告失敗', () => {
+    const build = (Is: number) => [
+      new VoltageSource('V1', ['in', '0'], 5),
+      new Resistor('R1', ['in', 'out'], 1000),
+      new Capacitor('C1', ['out', '0'], 1e-6),
+      new IntelligentDiode('D1', ['out', '0'], { Is, n: 1, Rs: 0, Cj0: 0, Vj: 0.7, m: 0.5, tt: 0 })
+    ];
+    const sim = new BatchedCircuitSimulator([build(1e-14), build(NaN)]);
+    expect(Array.from(sim.solveOperatingPoint().converged)).toEqual([1, 0]);
+    expect(Array.from(sim.runTransient(1e-5, 1e-6, ['out']).converged)).toEqual([1, 0]);
+  });
+
+  test('二極體 RC 鉗位與固定步長單實例引擎逐步一致', async () => {
+    // 電容充電至二極體導通後被鉗位
+    const build = (r1: number) => [
+      new VoltageSource('V1', ['in', '0'], 5),
+      new Resistor('R1', ['in', 'out'], r1),
+      new Capacitor('C1', ['out', '0'], 1e-8),
+      new IntelligentDiode('D1', ['out', '0'], { Is: 1e-14, n: 1, Vj: 0.7, m: 0.5, ...IDEAL_DIODE })
+    ];
+    expect(await maxTransientDeviation(build, [1000, 4000], 'out', 2e-5, 1e-7)).toBeLessThan(1e-5);
+  });
+
+  test('MOSFET 負載各工作區與固定步長單實例引擎逐步一致', async () => {
+    // 截止、飽和、線性
+    const build = (vg: number) => [
+      new VoltageSource('VDD', ['vdd', '0'], 10),
+      new VoltageSource('VG', ['g', '0'], vg),
+      new Resistor('RD', ['vdd', 'd'], 100),
+      new Capacitor('CD', ['d', '0'], 1e-8),
+      new IntelligentMOSFET('M1', ['d', 'g', '0'], { Vth: 3, Kp: 0.1, lambda: 0.01, Ron: 0.1, Roff: 1e9, ...IDEAL_MOSFET })
+    ];
+    expect(await maxTransientDeviation(build, [1, 4, 10], 'd', 5e-6, 1e-7)).toBeLessThan(1e-5);
+  });
+});
@@ -0,0 +1,80 @@
+/**
+ * 💾 DC 工作點緩存集成測試
+ *
+ * 測試目標：
+ * 1. 內容哈希與分析命令、註釋無關，但隨元件值變化
+ * 2. 命中時一次 Newton 迭代驗證即採用緩存解
+ * 3. 磁盤持久化：新的緩存實例可讀回條目
+ */
+
+import { describe, test, expect } from 'vitest';
+import { mkdtempSync, rmSync } from 'fs';
+import { tmpdir } from 'os';
+import { join } from 'path';
+import { SpiceNetlistParser } from '../../../src/core/parser/spice_netlist_parser';
+import { CircuitSimulationEngine, SimulationEventType } from '../../../src/core/simulation/circuit_simulation_engine';
+import { DCOperatingPointCache } from '../../../src/core/simulation/dc_operating_point_cache';
+import { DIODE_CLAMP } from '../../utils/DCFixtures';
+
+const CLAMP = DIODE_CLAMP.replace('.END', '.TRAN 1u 10u\n.END');
+
+async function runWithCache(netlistText: string, cache: DCOperatingPointCache) {
+  const parser = new SpiceNetlistParser();
+  const netlist = parser.parseNetlist(netlistText);
+  const engine = new CircuitSimulationEngine({ endTime: 0 });
+  engine.addDevices(parser.createDevicesFromNetlist(netlist));
+  engine.setOperatingPointCache(cache, DCOperatingPointCache.hashNetlist(netlist));
+  const result = await engine.runSimulation();
+  return { engine, result, out: engine.getOperatingPoint()!.get(engine.getNodeIdByName('out')!) };
+}
+
+describe('DC Operating Point Cache', () => {
+  test('內容哈希', () => {
+    const parser = new SpiceNetlistParser();
+    const hash = (text: string) => DCOperatingPointCache.hashNetlist(parser.parseNetlist(text));
+
+    const base = hash(CLAMP);
+    expect(base).toHaveLength(64);
+    expect(hash(CLAMP.replace('.TRAN 1u 10u', '.TRAN 2u 50u'))).toBe(base);
+    expect(hash(CLAMP.replace('* diode clamp', '* another title'))).toBe(base);
+    expect(hash(CLAMP.replace('R2 out 0 1k', 'R2 out 0 2k'))).not.toBe(base);
+    expect(hash(CLAMP.replace('IS=1e-14', 'IS=2e-14'))).not.toBe(base);
+  });
+
+  test('命中時一次迭代驗證', async () => {
+    const cache = new DCOperatingPointCache();
+    const first = await runWithCache(CLAMP, cache);
+    expect(first.result.success).toBe(true);
+    expect(first.engine.isOperatingPointFromCache()).toBe(false);
+
+    const second = await runWithCache(CLAMP.replace('.TRAN 1u 10u', '.TRAN 5u 1m'), cache);
+    expect(second.result.success).toBe(true);
+    expect(second.engine.isOperatingPointFromCache()).toBe(true);
+    expect(second.out).toBeCloseTo(first.out, 9);
+
+    const newtonEvents = second.engine.getSimulationEvents().filter(event => event.type === SimulationEventType.DC_NR_CONVERGED);
+    expect(newtonEvents.length).toBe(1);
+    expect(cache.getStatistics().hits).toBe(1);
+  });
+
+  test('不同網表不會命中', async () => {
+    const cache = new DCOperatingPointCache();
+    await runWithCache(CLAMP, cache);
+    const other = await runWithCache(CLAMP.replace('V1 in 0 DC 10', 'V1 in 0 DC 5'), cache);
+    expect(other.result.success).toBe(true);
+    expect(other.engine.isOperatingPointFromCache()).toBe(false);
+    expect(cache.getStatistics().entries).toBe(2);
+  });
+
+  test('磁盤持久化', async () => {
+    const directory = mkdtempSync(join(tmpdir(), 'akingspice-dc-cache-'));
+    try {
+      const first = await runWithCache(CLAMP, new DCOperatingPointCache(directory));
+      const second = await runWithCache(CLAMP, new DCOperatingPointCache(directory));
+      expect(second.engine.isOperatingPointFromCache()).toBe(true);
+      expect(second.out).toBeCloseTo(first.out, 9);
+    } finally {
+      rmSync(directory, { recursive: true, force: true });
+    }
+  });
+});
@@ -0,0 +1,129 @@
+/**
+ * 🏁 DC 同伦策略竞速集成測試
+ *
+ * 測試目標：
+ * 1. 每種單一 dcStrategy (含偽瞬態連續) 都能求得相同的工作點
+ * 2. 競速返回第一個收斂的策略，其餘策略被取消
+ * 3. 勝出的解可作為熱啟動初值
+ * 4. worker 模式：首個回傳的結果勝出並終止其餘 worker，未回傳即退出的 worker 記為失敗，超時生效
+ */
+
+import { describe, test, expect } from 'vitest';
+import { mkdtempSync, writeFileSync } from 'fs';
+import { tmpdir } from 'os';
+import { join } from 'path';
+import { SpiceNetlistParser } from '../../../src/core/parser/spice_netlist_parser';
+import { CircuitSimulationEngine, SimulationEventType } from '../../../src/core/simulation/circuit_simulation_engine';
+import { DCStrategyRace } from '../../../src/core/simulation/dc_strategy_race';
+import { DIODE_CLAMP as CLAMP, solveDC } from '../../utils/DCFixtures';
+
+describe('DC Strategy Race', () => {
+  test('單一策略求得一致的工作點', async () => {
+    const reference = await solveDC(CLAMP);
+    expect(reference.result.success).toBe(true);
+    for (const dcStrategy of ['gmin', 'source', 'ptc'] as const) {
+      const { result, out } = await solveDC(CLAMP, { dcStrategy });
+      expect(result.success).toBe(true);
+      expect(out).toBeCloseTo(reference.out, 6);
+    }
+  });
+
+  test('競速返回第一個收斂的工作點', async () => {
+    const race = new DCStrategyRace(CLAMP);
+    const result = await race.run({ mode: 'inline' });
+
+    expect(result.success).toBe(true);
+    expect(result.winner).not.toBeNull();
+    // 勝出後其餘策略被取消，不會全部完成
+    expect(result.outcomes.length).toBeLessThan(4);
+    expect(result.outcomes[result.outcomes.length - 1]!.strategy).toBe(result.winner!);
+
+    const reference = await solveDC(CLAMP);
+    expect(result.operatingPoint.get('out')!).toBeCloseTo(reference.out, 6);
+  });
+
+  test('勝出的解作為熱啟動初值', async () => {
+    const race = new DCStrategyRace(CLAMP);
+    const result = await race.run({ mode: 'inline', strategies: ['ptc', 'gmin'] });
+    expect(result.solution).not.toBeNull();
+
+    const parser = new SpiceNetlistParser();
+    const engine = new CircuitSimulationEngine({ endTime: 0 });
+    engine.addDevices(parser.createDevicesFromNetlist(parser.parseNetlist(CLAMP)));
+    engine.setInitialGuess(result.solution!);
+    const op = await engine.runSimulation();
+
+    expect(op.success).toBe(true);
+    const events = engine.getSimulationEvents();
+    expect(events.some(event => event.type === SimulationEventType.DC_WARM_START_FAILED)).toBe(false);
+    expect(events.filter(event => event.type === SimulationEventType.GMIN_STEP).length).toBe(0);
+  });
+
+  test('inline 模式按順序執行，超時在策略之間檢查', async () => {
+    const race = new DCStrategyRace(CLAMP);
+    const first = await race.run({ mode: 'inline', strategies: ['ptc', 'gmin'] });
+    expect(first.outcomes.map(outcome => outcome.strategy)).toEqual(['ptc']);
+
+    const expired = await race.run({ mode: 'inline', timeout: 0 });
+    expect(expired.success).toBe(false);
+    expect(expired.outcomes.length).toBe(0);
+  });
+
+  test('全部策略失敗時返回失敗', async () => {
+    // 並聯的兩個不同電壓源：矩陣奇異，任何策略都無解
+    const race = new DCStrategyRace(`* conflicting sources
+V1 a 0 DC 1
+V2 a 0 DC 2
+R1 a 0 1k
+.END`);
+    const result = await race.run({ mode: 'inline', strategies: ['newton', 'ptc'] });
+    expect(result.success).toBe(false);
+    expect(result.winner).toBeNull();
+    expect(result.outcomes.length).toBe(2);
+  });
+});
+
+// 注入的 worker 腳本 (CommonJS)，模擬各種 worker 行為
+const WORKER_DIR = mkdtempSync(join(tmpdir(), 'dc-race-'));
+function workerScript(name: string, body: string): string {
+  const path = join(WORKER_DIR, `${name}.cjs`);
+  writeFileSync(path, `const { parentPort, workerData } = require('worker_threads');\n${body}\n`);
+  return path;
+}
+
+describe('DC Strategy Race - workers', () => {
+  test('首個回傳的 worker 勝出，其餘被終止', async () => {
+    const script = workerScript('gmin-wins', `
+if (workerData.strategy === 'gmin') {
+  parentPort.postMessage({ strategy: 'gmin', success: true, operatingPoint: new Map([['out', 0.7]]), solution: [10, 0.7], elapsed: 0 });
+} else {
+  setInterval(() => {}, 1000);
+}`);
+    const result = await new DCStrategyRace(CLAMP).run({ mode: 'workers', workerScript: script });
+
+    expect(result.success).toBe(true);
+    expect(result.winner).toBe('gmin');
+    expect(result.operatingPoint.get('out')).toBe(0.7);
+    expect(result.outcomes.length).toBe(1);
+  });
+
+  test('未回傳結果就退出的 worker 記為失敗', async () => {
+    const script = workerScript('silent-exit', 'process.exit(3);');
+    const result = await new DCStrategyRace(CLAMP).run({ mode: 'workers', workerScript: script, strategies: ['newton', 'ptc'] });
+
+    expect(result.success).toBe(false);
+    expect(result.outcomes.length).toBe(2);
+    for (const outcome of result.outcomes) {
+      expect(outcome.errorMessage).toMatch(/exited with code 3/);
+    }
+  });
+
+  test('超時終止全部 worker', async () => {
+    const script = workerScript('hang', 'setInterval(() => {}, 1000);');
+    const result = await new DCStrategyRace(CLAMP).run({ mode: 'workers', workerScript: script, timeout: 200 });
+
+    expect(result.success).toBe(false);
+    expect(result.outcomes.length).toBe(0);
+    expect(result.totalTime).toBeLessThan(5000);
+  });
+});
@@ -0,0 +1,145 @@
+/**
+ * 📈 DC 掃描分析集成測試
+ *
+ * 測試目標：
+ * 1. `.DC source start stop step` 產生正確的掃描點
+ * 2. 線性電路：切線預測精確，每點 1 次 Newton 迭代
+ * 3. 非線性電路：連續性方法每點平均 ~2 次迭代，且無需同倫回退
+ * 4. 掃描結果與單點 DC 工作點一致，掃描後電源恢復原值
+ */
+
+import { describe, test, expect } from 'vitest';
+import { SpiceNetlistParser } from '../../../src/core/parser/spice_netlist_parser';
+import { CircuitSimulationEngine } from '../../../src/core/simulation/circuit_simulation_engine';
+import type { DCSweepConfig } from '../../../src/core/simulation/circuit_simulation_engine';
+import type { ComponentInterface } from '../../../src/core/interfaces/component';
+import { VoltageSource } from '../../../src/components/sources/voltage_source';
+import { SolverRecorder } from '../../../src/math/sparse/solver_recording';
+
+const DIODE_SWEEP = `* diode I-V sweep
+V1 in 0 DC 0
+R1 in out 1k
+D1 out 0 DMOD
+.MODEL DMOD D IS=1e-14 N=1
+.DC V1 0 5 0.1
+.END`;
+
+const MOSFET_SWEEP = `* nmos output characteristic
+VGS g 0 DC 3
+VDS d 0 DC 0
+RD d x 10
+M1 x g 0 0 NMOD
+.MODEL NMOD NMOS VTO=1 KP=1e-4
+.DC VDS 0 5 0.1
+.END`;
+
+function sweepConfig(netlist: string): { engine: CircuitSimulationEngine; devices: ComponentInterface[]; config: DCSweepConfig } {
+  const parser = new SpiceNetlistParser();
+  const parsed = parser.parseNetlist(netlist);
+  const command = parsed.analysisCommands.find(analysis => analysis.type === 'DC')!;
+  const engine = new CircuitSimulationEngine({ endTime: 0 });
+  const devices = parser.createDevicesFromNetlist(parsed);
+  engine.addDevices(devices);
+  return {
+    engine,
+    devices,
+    config: {
+      source: command.parameters.get('source') as string,
+      start: command.parameters.get('start') as number,
+      stop: command.parameters.get('stop') as number,
+      step: command.parameters.get('step') as number
+    }
+  };
+}
+
+describe('DC Sweep Analysis', () => {
+  test('線性電路：切線預測一步收斂', async () => {
+    const engine = new CircuitSimulationEngine({ endTime: 0 });
+    const parser = new SpiceNetlistParser();
+    engine.addDevices(parser.createDevicesFromNetlist(parser.parseNetlist(`* divider
+V1 in 0 DC 1
+R1 in out 1k
+R2 out 0 3k
+.END`)));
+    const recorder = new SolverRecorder();
+    engine.setSolverRecorder(recorder);
+
+    const result = await engine.runDCSweep({ source: 'V1', start: -2, stop: 2, step: 0.5 });
+
+    expect(result.success).toBe(true);
+    expect(result.sweepValues.length).toBe(9);
+    expect(result.homotopyPoints.length).toBe(0);
+    const out = result.nodeVoltages.get('out')!;
+    result.sweepValues.forEach((value, i) => {
+      expect(out[i]).toBeCloseTo(0.75 * value, 9);
+    });
+    // 第一個點之後，切線預測即為精確解
+    for (let i = 1; i < result.newtonIterations.length; i++) {
+      expect(result.newtonIterations[i]).toBe(1);
+    }
+    // 切線求解不作為 Newton 幀錄製
+    expect(recorder.frames.length).toBe(result.newtonIterations.reduce((sum, n) => sum + n, 0));
+  });
+
+  test('二極體 I-V 掃描：連續性熱啟動', async () => {
+    const { engine, config } = sweepConfig(DIODE_SWEEP);
+    const result = await engine.runDCSweep(config);
+
+    expect(result.success).toBe(true);
+    expect(result.sweepValues.length).toBe(51);
+    expect(result.sweepValues[50]).toBeCloseTo(5, 12);
+    expect(result.homotopyPoints.length).toBe(0);
+
+    // 二極體電壓單調遞增並鉗位在 ~0.7V
+    const out = result.nodeVoltages.get('out')!;
+    for (let i = 1; i < out.length; i++) {
+      expect(out[i]!).toBeGreaterThanOrEqual(out[i - 1]! - 1e-9);
+    }
+    expect(out[50]!).toBeGreaterThan(0.6);
+    expect(out[50]!).toBeLessThan(0.8);
+
+    const continued = result.newtonIterations.slice(1);
+    const average = continued.reduce((sum, n) => sum + n, 0) / continued.length;
+    expect(average).toBeLessThan(4);
+  });
+
+  test('MOSFET 輸出特性掃描', async () => {
+    const { engine, config } = sweepConfig(MOSFET_SWEEP);
+    const result = await engine.runDCSweep(config);
+
+    expect(result.success).toBe(true);
+    expect(result.homotopyPoints.length).toBe(0);
+    const continued = result.newtonIterations.slice(1);
+    const average = continued.reduce((sum, n) => sum + n, 0) / continued.length;
+    expect(average).toBeLessThan(4);
+  });
+
+  test('掃描終點與單點 DC 工作點一致，且電源恢復原值', async () => {
+    const { engine, devices, config } = sweepConfig(DIODE_SWEEP);
+    const result = await engine.runDCSweep({ ...config, start: 0, stop: 3, step: 0.5 });
+    expect(result.success).toBe(true);
+
+    const parser = new SpiceNetlistParser();
+    const single = new CircuitSimulationEngine({ endTime: 0 });
+    single.addDevices(parser.createDevicesFromNetlist(parser.parseNetlist(DIODE_SWEEP.replace('DC 0', 'DC 3'))));
+    const op = await single.runSimulation();
+    expect(op.success).toBe(true);
+
+    const outIndex = single.getNodeIdByName('out')!;
+    const last = result.nodeVoltages.get('out')!;
+    expect(last[last.length - 1]!).toBeCloseTo(single.getOperatingPoint()!.get(outIndex), 5);
+
+    // 掃描後 V1 回到網表中的 0V，同一引擎的 DC 工作點為零解
+    const source = devices.find(device => device.name === 'V1') as VoltageSource;
+    expect(source.dcValue).toBe(0);
+    const after = await engine.runSimulation();
+    expect(after.success).toBe(true);
+    expect(engine.getOperatingPoint()!.get(engine.getNodeIdByName('out')!)).toBeCloseTo(0, 9);
+  });
+
+  test('無效的掃描參數', async () => {
+    const { engine, config } = sweepConfig(DIODE_SWEEP);
+    await expect(engine.runDCSweep({ ...config, source: 'V9' })).rejects.toThrow();
+    await expect(engine.runDCSweep({ ...config, step: -0.1 })).rejects.toThrow();
+  });
+});
@@ -0,0 +1,113 @@
+/**
+ * 🎲 蒙特卡罗 / 角點分析集成測試
+ * 
+ * 測試目標：
+ * 1. 網表只解析一次，樣本按容差重建數值
+ * 2. 樣本 DC 工作點從標稱解熱啟動
+ * 3. 樣本間共享符號分解
+ * 4. 角點分析倍率正確套用
+ * 5. 熱啟動回退標記不依賴事件日誌 (長瞬態會把 DC 事件擠出環形緩衝區)
+ */
+
+import { describe, test, expect } from 'vitest';
+import { SpiceNetlistParser } from '../../../src/core/parser/spice_netlist_parser';
+import { MonteCarloAnalysis } from '../../../src/core/simulation/monte_carlo';
+import { CircuitSimulationEngine, SimulationEventType } from '../../../src/core/simulation/circuit_simulation_engine';
+import { Vector } from '../../../src/math/sparse/vector';
+import { DIODE_CLAMP } from '../../utils/DCFixtures';
+
+describe('MonteCarloAnalysis', () => {
+  test('標稱解與樣本統計', async () => {
+    const parser = new SpiceNetlistParser();
+    const netlist = parser.parseNetlist(DIODE_CLAMP);
+    const analysis = new MonteCarloAnalysis(netlist, parser);
+
+    const result = await analysis.run({
+      samples: 8,
+      seed: 42,
+      tolerances: [
+        { target: 'R', tolerance: 0.05, distribution: 'uniform' },
+        { target: 'D1.IS', tolerance: 0.3 }
+      ],
+      outputs: ['out']
+    });
+
+    expect(result.nominal.success).toBe(true);
+    const nominalOut = result.nominal.operatingPoint.get('out')!;
+    // 二極體鉗位: 正向壓降在 0.5V ~ 0.8V 之間
+    expect(nominalOut).toBeGreaterThan(0.5);
+    expect(nominalOut).toBeLessThan(0.8);
+
+    expect(result.samples.length).toBe(8);
+    expect(result.failedSamples).toBe(0);
+    for (const sample of result.samples) {
+      expect(sample.homotopyFallback).toBe(false);
+      expect(sample.parameters.has('R1')).toBe(true);
+      expect(sample.parameters.has('D1.IS')).toBe(true);
+      expect(Math.abs(sample.parameters.get('R1')! / 1000 - 1)).toBeLessThanOrEqual(0.05);
+    }
+
+    const stats = result.statistics.get('out')!;
+    expect(stats.min).toBeLessThanOrEqual(stats.mean);
+    expect(stats.max).toBeGreaterThanOrEqual(stats.mean);
+    expect(Math.abs(stats.mean - nominalOut)).toBeLessThan(0.05);
+  });
+
+  test('相同種子得到相同樣本', async () => {
+    const parser = new SpiceNetlistParser();
+    const netlist = parser.parseNetlist(DIODE_CLAMP);
+    const config = {
+      samples: 3,
+      seed: 7,
+      tolerances: [{ target: 'R2', tolerance: 0.1 }],
+      outputs: ['out']
+    };
+
+    const a = await new MonteCarloAnalysis(netlist, parser).run(config);
+    const b = await new MonteCarloAnalysis(netlist, parser).run(config);
+    for (let i = 0; i < 3; i++) {
+      expect(a.samples[i]!.parameters.get('R2')).toBe(b.samples[i]!.parameters.get('R2'));
+    }
+  });
+
+  test('角點分析套用倍率', async () => {
+    const parser = new SpiceNetlistParser();
+    const netlist = parser.parseNetlist(`* resistive divider
+V1 in 0 DC 12
+R1 in out 3k
+R2 out 0 1k
+.END`);
+    const analysis = new MonteCarloAnalysis(netlist, parser);
+
+    const result = await analysis.runCorners([
+      { name: 'r2_low', scale: { R2: 0.5 } },
+      { name: 'r1_high', scale: { r1: 2 } }
+    ], { outputs: ['out'] });
+
+    expect(result.nominal.operatingPoint.get('out')).toBeCloseTo(3, 6);
+    expect(result.samples[0]!.name).toBe('r2_low');
+    expect(result.samples[0]!.operatingPoint.get('out')).toBeCloseTo(12 * 500 / 3500, 6);
+    expect(result.samples[1]!.operatingPoint.get('out')).toBeCloseTo(12 * 1000 / 7000, 6);
+  });
+  test('熱啟動回退標記不依賴事件日誌', async () => {
+    const parser = new SpiceNetlistParser();
+    const engine = new CircuitSimulationEngine({
+      endTime: 1e-4,
+      initialTimeStep: 1e-6,
+      maxTimeStep: 1e-6,
+      eventLogCapacity: 16
+    });
+    engine.addDevices(parser.createDevicesFromNetlist(parser.parseNetlist(DIODE_CLAMP)));
+    // 遠離工作點的初值使熱啟動 Newton 失敗
+    engine.setInitialGuess(Vector.from([-50, -50, -50, -50]));
+    const result = await engine.runSimulation();
+
+    expect(result.success).toBe(true);
+    expect(engine.isWarmStartFailed()).toBe(true);
+    expect(engine.getSimulationEvents().some(event => event.type === SimulationEventType.DC_WARM_START_FAILED)).toBe(false);
+
+    engine.setInitialGuess(engine.getOperatingPoint()!);
+    await engine.runSimulation();
+    expect(engine.isWarmStartFailed()).toBe(false);
+  });
+});
@@ -0,0 +1,125 @@
+/**
+ * 🧪 條件數估計與分解診斷單元測試
+ *
+ * 測試轉置求解、Hager/Higham ‖A⁻¹‖₁ 估計，以及 SparseMatrix 各求解器模式的診斷與對稱性檢測
+ */
+
+import { describe, test, expect } from 'vitest';
+import { SparseMatrix } from '../../../src/math/sparse/matrix';
+import { SparseLU } from '../../../src/math/sparse/sparse_lu';
+import { DenseLU } from '../../../src/math/sparse/dense_lu';
+import { Vector } from '../../../src/math/sparse/vector';
+
+// 非對稱、含零對角元的 6×6 系統
+const entries: Array<[number, number, number]> = [
+  [0, 0, 4], [0, 2, -1], [1, 1, 3e-3], [1, 0, 2], [1, 5, 1],
+  [2, 2, 5], [2, 3, -2], [3, 1, 1], [3, 3, 7], [4, 4, 1e-4],
+  [4, 2, 0.5], [5, 0, 1], [5, 4, -3], [0, 5, 0.25]
+];
+
+function buildMatrix(mode: 'numeric' | 'klu' | 'auto'): SparseMatrix {
+  const A = new SparseMatrix(6, 6);
+  for (const [i, j, v] of entries) {
+    A.add(i, j, v);
+  }
+  A.setSolverMode(mode);
+  return A;
+}
+
+// 精確 κ₁：以單位向量逐列求逆
+function exactCondition(A: SparseMatrix): number {
+  const n = A.rows;
+  const dense = A.toDense();
+  const normA = Math.max(...dense[0]!.map((_, j) => dense.reduce((sum, row) => sum + Math.abs(row[j]!), 0)));
+  const csc = A.toCSC();
+  const factors = SparseLU.factor(SparseLU.analyze(csc), csc);
+  let normInverse = 0;
+  for (let j = 0; j < n; j++) {
+    const e = new Float64Array(n);
+    e[j] = 1;
+    normInverse = Math.max(normInverse, SparseLU.solve(factors, e).reduce((sum, v) => sum + Math.abs(v), 0));
+  }
+  return normA * normInverse;
+}
+
+function transposeMultiply(A: SparseMatrix, x: Float64Array): number[] {
+  const dense = A.toDense();
+  return dense[0]!.map((_, j) => dense.reduce((sum, row, i) => sum + row[j]! * x[i]!, 0));
+}
+
+describe('轉置求解', () => {
+  test('SparseLU 與 DenseLU 求解 Aᵀx = b', () => {
+    const A = buildMatrix('klu');
+    const b = [1, -2, 3, 0.5, 4, -1];
+
+    const csc = A.toCSC();
+    const sparse = SparseLU.solveTranspose(SparseLU.factor(SparseLU.analyze(csc), csc), b);
+
+    const dense = DenseLU.allocate(6);
+    A.toDense().forEach((row, i) => dense.lu.set(row, i * 6));
+    DenseLU.factor(dense);
+    const denseSolution = DenseLU.solveTranspose(dense, b);
+
+    const check = (x: Float64Array) => transposeMultiply(A, x).forEach((v, i) => expect(v).toBeCloseTo(b[i]!, 10));
+    check(sparse);
+    check(denseSolution);
+  });
+});
+
+describe('SparseMatrix - 分解診斷', () => {
+  test('各直接求解器的條件數估計與精確值一致', () => {
+    const exact = exactCondition(buildMatrix('klu'));
+    for (const mode of ['numeric', 'klu', 'auto'] as const) {
+      const A = buildMatrix(mode);
+      expect(A.getFactorizationDiagnostics()).toBeNull();
+      A.solve(Vector.from([1, 1, 1, 1, 1, 1]));
+
+      const diagnostics = A.getFactorizationDiagnostics()!;
+      expect(diagnostics.solver).toBe(mode === 'auto' ? 'dense' : mode);
+      expect(diagnostics.conditionEstimate).toBeLessThanOrEqual(exact * (1 + 1e-12));
+      expect(diagnostics.conditionEstimate).toBeGreaterThan(exact / 3);
+      expect(diagnostics.minPivot).toBeGreaterThan(0);
+      expect(diagnostics.maxPivot).toBeGreaterThanOrEqual(diagnostics.minPivot);
+    }
+  });
+
+  test('對角矩陣的估計精確', () => {
+    const A = new SparseMatrix(2, 2);
+    A.set(0, 0, 1);
+    A.set(1, 1, 1e-6);
+    A.setSolverMode('klu');
+    A.solve(Vector.from([1, 1]));
+    const diagnostics = A.getFactorizationDiagnostics()!;
+    expect(diagnostics.conditionEstimate).toBeCloseTo(1e6, 3);
+    expect(diagnostics.minPivot).toBe(1e-6);
+    expect(diagnostics.maxPivot).toBe(1);
+  });
+
+  test('奇異矩陣報告無窮條件數，修改後診斷失效', () => {
+    const A = new SparseMatrix(2, 2);
+    A.set(0, 0, 1); A.set(0, 1, 2);
+    A.set(1, 0, 2); A.set(1, 1, 4);
+    A.solve(Vector.from([1, 2]));
+    expect(A.getFactorizationDiagnostics()!.conditionEstimate).toBe(Infinity);
+    expect(A.getFactorizationDiagnostics()!.reciprocalCondition).toBe(0);
+
+    A.set(1, 1, 5);
+    expect(A.getFactorizationDiagnostics()).toBeNull();
+  });
+});
+
+describe('SparseMatrix - 對稱性', () => {
+  test('沿稀疏模式檢測數值與結構對稱', () => {
+    const A = new SparseMatrix(3, 3);
+    A.set(0, 0, 2); A.set(0, 1, -1); A.set(1, 0, -1); A.set(1, 1, 2);
+    expect(A.getInfo().symmetric).toBe(true);
+    expect(A.getInfo().patternSymmetry).toBe(1);
+
+    A.set(1, 0, -0.5);
+    expect(A.getInfo().symmetric).toBe(false);
+    expect(A.getInfo().patternSymmetry).toBe(1);
+
+    A.set(2, 0, 1);
+    expect(A.getInfo().patternSymmetry).toBeCloseTo(2 / 3, 12);
+  });
+});
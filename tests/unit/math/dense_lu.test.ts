@@ -0,0 +1,144 @@
+/**
+ * 🧪 DenseLU 與 auto 求解器選擇單元測試
+ *
+ * 測試原地稠密 LU 的分解/求解、SparseMatrix auto 模式的選擇與重新選擇，以及去地子矩陣的原地更新
+ */
+
+import { describe, test, expect } from 'vitest';
+import { SparseMatrix } from '../../../src/math/sparse/matrix';
+import { DenseLU } from '../../../src/math/sparse/dense_lu';
+import { Vector } from '../../../src/math/sparse/vector';
+
+// 典型 MNA 結構：電阻網絡 + 電壓源支路 (對角為零，需要行交換)
+const mnaEntries: Array<[number, number, number]> = [
+  [0, 0, 1e-3], [0, 1, -1e-3], [1, 0, -1e-3], [1, 1, 1.5e-3],
+  [1, 2, -5e-4], [2, 1, -5e-4], [2, 2, 5e-4 + 1e-3],
+  [0, 3, 1], [3, 0, 1]
+];
+
+function buildMatrix(entries: Array<[number, number, number]>, n: number): SparseMatrix {
+  const A = new SparseMatrix(n, n);
+  for (const [i, j, v] of entries) {
+    A.add(i, j, v);
+  }
+  return A;
+}
+
+// n 節點電阻鏈 + 接地電阻 (對稱模式)，以 CSC 直接裝載避免逐個 set()
+function ladder(n: number, diagonal: number): SparseMatrix {
+  const colPointers = [0];
+  const rowIndices: number[] = [];
+  const values: number[] = [];
+  for (let j = 0; j < n; j++) {
+    if (j > 0) { rowIndices.push(j - 1); values.push(-1); }
+    rowIndices.push(j); values.push(diagonal);
+    if (j < n - 1) { rowIndices.push(j + 1); values.push(-1); }
+    colPointers.push(rowIndices.length);
+  }
+  const A = new SparseMatrix(n, n);
+  A.loadCSC({ rows: n, cols: n, nnz: values.length, colPointers, rowIndices, values });
+  return A;
+}
+
+describe('DenseLU - 原地分解與求解', () => {
+  test('求解含零對角元的 MNA 系統', () => {
+    const A = buildMatrix(mnaEntries, 4);
+    const x = [10, 7, 2, -3e-3];
+    const b = A.multiply(Vector.from(x)).toArray();
+
+    const factorization = DenseLU.allocate(4);
+    A.toDense().forEach((row, i) => factorization.lu.set(row, i * 4));
+    DenseLU.factor(factorization);
+    const solution = DenseLU.solve(factorization, b);
+
+    for (let i = 0; i < 4; i++) {
+      expect(solution[i]).toBeCloseTo(x[i]!, 10);
+    }
+  });
+
+  test('奇異矩陣拋出錯誤', () => {
+    const factorization = DenseLU.allocate(2);
+    factorization.lu.set([1, 2, 2, 4]);
+    expect(() => DenseLU.factor(factorization)).toThrow();
+  });
+});
+
+describe('SparseMatrix - auto 模式', () => {
+  test('小系統選擇稠密 LU 並在 clear() 後重用', () => {
+    const A = buildMatrix(mnaEntries, 4);
+    A.setSolverMode('auto');
+    expect(A.getInfo().solverSelection).toBeNull();
+
+    const x = Vector.from([1, 2, 3, 4]);
+    expect(A.solve(A.multiply(x)).minus(x).norm()).toBeLessThan(1e-9);
+    const selection = A.getInfo().solverSelection;
+    expect(selection?.solver).toBe('dense');
+    expect(selection?.patternSymmetry).toBe(1);
+    expect(selection?.diagonalDominance).toBe(0);
+
+    A.clear();
+    for (const [i, j, v] of mnaEntries) {
+      A.add(i, j, 2 * v);
+    }
+    expect(A.solve(A.multiply(x)).minus(x).norm()).toBeLessThan(1e-9);
+    expect(A.solverSelection).toBe(selection);
+    expect(A.statistics.factorizations).toBe(2);
+  });
+
+  test('中等稀疏系統選擇稀疏 LU，模式改變時重新選擇', () => {
+    const A = ladder(120, 2.5);
+    A.setSolverMode('auto');
+    const x = Vector.from(Array.from({ length: 120 }, (_, i) => Math.sin(i)));
+    expect(A.solve(A.multiply(x)).minus(x).norm()).toBeLessThan(1e-9);
+    const first = A.solverSelection!;
+    expect(first.solver).toBe('klu');
+    expect(first.diagonalDominance).toBeCloseTo(1.25, 12);
+
+    A.set(0, 119, 0.5);
+    expect(A.solve(A.multiply(x)).minus(x).norm()).toBeLessThan(1e-9);
+    expect(A.solverSelection).not.toBe(first);
+    expect(A.solverSelection!.patternSymmetry).toBeLessThan(1);
+  });
+
+  test('大規模強對角佔優系統選擇迭代法', () => {
+    const A = ladder(2000, 4);
+    A.setSolverMode('auto');
+    const x = Vector.from(Array.from({ length: 2000 }, (_, i) => Math.cos(i)));
+    const b = A.multiply(x);
+    expect(A.solve(b).minus(x).norm() / x.norm()).toBeLessThan(1e-9);
+    expect(A.getInfo().solverSelection?.solver).toBe('iterative');
+    expect(A.statistics.factorizations).toBe(0);
+  });
+  test('loadSubmatrix 原地更新保留選擇與稠密緩衝區', () => {
+    // 第 0 行/列視為地，移除後為 3×3
+    const A = buildMatrix([[0, 0, 1], [0, 1, -1], [1, 0, -1], ...mnaEntries.map(
+      ([i, j, v]): [number, number, number] => [i + 1, j + 1, v])], 5);
+    const { matrix, mapping } = A.submatrix([0], [0]);
+    const reduced = matrix as SparseMatrix;
+    reduced.setSolverMode('auto');
+    expect(mapping).toEqual([1, 2, 3, 4]);
+    expect(reduced.toDense()).toEqual(buildMatrix(mnaEntries, 4).toDense());
+
+    const x = Vector.from([1, 2, 3, 4]);
+    expect(reduced.solve(reduced.multiply(x)).minus(x).norm()).toBeLessThan(1e-9);
+    const selection = reduced.solverSelection;
+
+    A.set(2, 2, 3e-3);
+    expect(reduced.loadSubmatrix(A, [0], [0])).toEqual(mapping);
+    expect(reduced.get(1, 1)).toBe(3e-3);
+    expect(reduced.solve(reduced.multiply(x)).minus(x).norm()).toBeLessThan(1e-9);
+    expect(reduced.solverSelection).toBe(selection);
+    expect(reduced.statistics.factorizations).toBe(2);
+    expect(() => reduced.loadSubmatrix(A, [], [])).toThrow();
+  });
+  test('clone 保留求解器模式與混合精度', () => {
+    const A = ladder(120, 2.5);
+    A.setSolverMode('auto');
+    A.setMixedPrecision(true);
+    const cloned = A.clone();
+    const x = Vector.from(Array.from({ length: 120 }, (_, i) => Math.sin(i)));
+    expect(cloned.solve(cloned.multiply(x)).minus(x).norm()).toBeLessThan(1e-9);
+    expect(cloned.solverSelection?.solver).toBe('klu');
+    expect(cloned.statistics.refinementSteps).toBeGreaterThan(0);
+  });
+});
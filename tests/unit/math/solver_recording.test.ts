@@ -0,0 +1,140 @@
+/**
+ * 🧪 線性求解序列錄製單元測試
+ *
+ * 測試 MatrixMarket 往返、二進制與目錄兩種存儲的往返 (含模式變化標記)、
+ * 引擎錄製 DC/瞬態求解，以及各求解器模式重放的殘差
+ */
+
+import { describe, test, expect } from 'vitest';
+import { mkdtempSync, rmSync } from 'fs';
+import { tmpdir } from 'os';
+import { join } from 'path';
+import { SparseMatrix } from '../../../src/math/sparse/matrix';
+import { Vector } from '../../../src/math/sparse/vector';
+import { MatrixMarket } from '../../../src/math/sparse/matrix_market';
+import { SolverRecorder, SolverRecording } from '../../../src/math/sparse/solver_recording';
+import { CircuitSimulationEngine } from '../../../src/core/simulation/circuit_simulation_engine';
+import { Resistor } from '../../../src/components/passive/resistor';
+import { Capacitor } from '../../../src/components/passive/capacitor';
+import { VoltageSource } from '../../../src/components/sources/voltage_source';
+
+function tridiagonal(n: number, scale: number = 1): SparseMatrix {
+  const matrix = new SparseMatrix(n, n);
+  for (let i = 0; i < n; i++) {
+    matrix.set(i, i, 4 * scale);
+    if (i > 0) matrix.set(i, i - 1, -1 * scale);
+    if (i < n - 1) matrix.set(i, i + 1, -1.25 * scale);
+  }
+  return matrix;
+}
+
+function withTempDir(run: (dir: string) => void): void {
+  const dir = mkdtempSync(join(tmpdir(), 'aksr-'));
+  try {
+    run(dir);
+  } finally {
+    rmSync(dir, { recursive: true, force: true });
+  }
+}
+
+describe('MatrixMarket', () => {
+  test('矩陣與向量逐位往返', () => {
+    const matrix = tridiagonal(5, Math.PI);
+    const csc = matrix.toCSC();
+    expect(MatrixMarket.parseMatrix(MatrixMarket.formatMatrix(csc, ['comment']))).toEqual(csc);
+
+    const vector = Float64Array.from([0.1, -2e-300, 1 / 3, 0, 7]);
+    expect(Array.from(MatrixMarket.parseVector(MatrixMarket.formatVector(vector)))).toEqual(Array.from(vector));
+  });
+
+  test('讀取對稱格式並累加重複項', () => {
+    const text = [
+      '%%MatrixMarket matrix coordinate real symmetric',
+      '% lower triangle',
+      '2 2 3',
+      '1 1 2',
+      '2 1 -1',
+      '2 2 1',
+      ''
+    ].join('\n');
+    const matrix = new SparseMatrix(2, 2);
+    matrix.loadCSC(MatrixMarket.parseMatrix(text));
+    expect(matrix.toDense()).toEqual([[2, -1], [-1, 1]]);
+  });
+});
+
+describe('SolverRecording', () => {
+  function recordSequence(): SolverRecorder {
+    const recorder = new SolverRecorder();
+    const b = Vector.from([1, 2, 3, 4]);
+    recorder.record(tridiagonal(4), b, 'dc', 0);
+    recorder.record(tridiagonal(4, 2), b, 'transient', 1e-6);
+    const changed = tridiagonal(4);
+    changed.set(0, 3, 0.5);
+    recorder.record(changed, b, 'transient', 2e-6);
+    return recorder;
+  }
+
+  test('標記模式變化並共享結構', () => {
+    const frames = recordSequence().frames;
+    expect(frames.map(frame => frame.patternChange)).toEqual([true, false, true]);
+    expect(frames[1]!.matrix.rowIndices).toBe(frames[0]!.matrix.rowIndices);
+  });
+
+  test('二進制往返', () => {
+    const frames = recordSequence().frames;
+    const decoded = SolverRecording.decode(SolverRecording.encode(frames));
+    expect(decoded).toEqual(frames);
+    expect(decoded[1]!.matrix.colPointers).toBe(decoded[0]!.matrix.colPointers);
+  });
+
+  test('MatrixMarket 目錄往返', () => {
+    const frames = recordSequence().frames;
+    withTempDir(dir => {
+      SolverRecording.writeMatrixMarket(frames, dir);
+      expect(SolverRecording.read(dir)).toEqual(frames);
+    });
+  });
+
+  test('超出 maxFrames 後丟棄', () => {
+    const recorder = new SolverRecorder({ maxFrames: 1 });
+    recorder.record(tridiagonal(3), Vector.from([1, 1, 1]), 'dc', 0);
+    recorder.record(tridiagonal(3), Vector.from([1, 1, 1]), 'dc', 0);
+    expect(recorder.frames).toHaveLength(1);
+    expect(recorder.droppedFrames).toBe(1);
+  });
+
+  test('引擎錄製並以各模式重放', async () => {
+    const engine = new CircuitSimulationEngine({
+      endTime: 1e-5,
+      initialTimeStep: 1e-6,
+      maxTimeStep: 1e-6,
+      minTimeStep: 1e-7,
+      solverMode: 'klu'
+    });
+    engine.addDevice(new VoltageSource('V1', ['in', '0'], 10));
+    engine.addDevice(new Resistor('R1', ['in', 'a'], 1000));
+    engine.addDevice(new Capacitor('C1', ['a', '0'], 1e-7));
+    const recorder = new SolverRecorder();
+    engine.setSolverRecorder(recorder);
+    expect((await engine.runSimulation()).success).toBe(true);
+
+    const frames = recorder.frames;
+    expect(frames.some(frame => frame.source === 'dc')).toBe(true);
+    expect(frames.some(frame => frame.source === 'transient')).toBe(true);
+    expect(frames[0]!.patternChange).toBe(true);
+
+    withTempDir(dir => {
+      const path = join(dir, 'run.aksr');
+      SolverRecording.writeBinary(frames, path);
+      expect(SolverRecording.read(path)).toEqual(frames);
+    });
+
+    const klu = SolverRecording.replay(frames, 'klu');
+    expect(klu.frames).toBe(frames.length);
+    expect(klu.failures).toBe(0);
+    expect(klu.maxResidual).toBeLessThan(1e-12);
+    expect(klu.refactorizations).toBeGreaterThan(0);
+    expect(SolverRecording.replay(frames, 'numeric').maxResidual).toBeLessThan(1e-12);
+  });
+});
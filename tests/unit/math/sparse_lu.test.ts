@@ -0,0 +1,243 @@
+/**
+ * 🧪 SparseLU 單元測試
+ * 
+ * 測試 KLU 風格稀疏 LU 的分析/分解/重分解/求解
+ */
+
+import { describe, test, expect } from 'vitest';
+import { SparseMatrix } from '../../../src/math/sparse/matrix';
+import { SparseLU } from '../../../src/math/sparse/sparse_lu';
+import { Vector } from '../../../src/math/sparse/vector';
+
+function buildMatrix(entries: Array<[number, number, number]>, n: number): SparseMatrix {
+  const A = new SparseMatrix(n, n);
+  for (const [i, j, v] of entries) {
+    A.add(i, j, v);
+  }
+  return A;
+}
+
+// 典型 MNA 結構：電阻網絡 + 電壓源支路 (對角為零)
+const mnaEntries: Array<[number, number, number]> = [
+  [0, 0, 1e-3], [0, 1, -1e-3], [1, 0, -1e-3], [1, 1, 1.5e-3],
+  [1, 2, -5e-4], [2, 1, -5e-4], [2, 2, 5e-4 + 1e-3],
+  [0, 3, 1], [3, 0, 1]
+];
+
+describe('SparseLU - 分解與求解', () => {
+  test('求解含零對角元的 MNA 系統', () => {
+    const A = buildMatrix(mnaEntries, 4);
+    const x = Vector.from([10, 7, 2, -3e-3]);
+    const b = A.multiply(x);
+
+    const csc = A.toCSC();
+    const numeric = SparseLU.factor(SparseLU.analyze(csc), csc);
+    const solution = SparseLU.solve(numeric, b.toArray());
+
+    for (let i = 0; i < 4; i++) {
+      expect(solution[i]).toBeCloseTo(x.get(i), 10);
+    }
+  });
+
+  test('重分解沿用模式，結果與完整分解一致', () => {
+    const A = buildMatrix(mnaEntries, 4);
+    const csc = A.toCSC();
+    const symbolic = SparseLU.analyze(csc);
+    const numeric = SparseLU.factor(symbolic, csc);
+
+    const scaled = { ...csc, values: csc.values.map((v, k) => v * (1 + 0.01 * k)) };
+    expect(SparseLU.matchesPattern(symbolic, scaled)).toBe(true);
+    expect(SparseLU.refactor(numeric, scaled)).toBe(true);
+
+    const reference = SparseLU.factor(symbolic, scaled);
+    const b = [1, 2, 3, 4];
+    const x1 = SparseLU.solve(numeric, b);
+    const x2 = SparseLU.solve(reference, b);
+    for (let i = 0; i < 4; i++) {
+      expect(x1[i]).toBeCloseTo(x2[i]!, 10);
+    }
+  });
+
+  test('批量重分解/求解與逐實例結果一致', () => {
+    const A = buildMatrix(mnaEntries, 4);
+    const csc = A.toCSC();
+    const symbolic = SparseLU.analyze(csc);
+    const pivotFactor = SparseLU.factor(symbolic, csc);
+
+    const count = 3;
+    const scales = [1, 2, 0.5];
+    const values = new Float64Array(csc.nnz * count);
+    const b = new Float64Array(4 * count);
+    for (let s = 0; s < count; s++) {
+      for (let p = 0; p < csc.nnz; p++) values[p * count + s] = csc.values[p]! * (scales[s]! + 0.01 * p);
+      for (let i = 0; i < 4; i++) b[i * count + s] = i + s;
+    }
+
+    const Lx = new Float64Array(pivotFactor.Lx.length * count);
+    const Ux = new Float64Array(pivotFactor.Ux.length * count);
+    const status = new Uint8Array(count);
+    SparseLU.refactorBatch(pivotFactor, values, count, Lx, Ux, status);
+    const x = SparseLU.solveBatch(pivotFactor, Lx, Ux, count, b);
+
+    for (let s = 0; s < count; s++) {
+      expect(status[s]).toBe(1);
+      const single = { ...csc, values: csc.values.map((_, p) => values[p * count + s]!) };
+      const reference = SparseLU.solve(SparseLU.factor(symbolic, single), [0, 1, 2, 3].map(i => i + s));
+      for (let i = 0; i < 4; i++) {
+        expect(x[i * count + s]).toBeCloseTo(reference[i]!, 10);
+      }
+    }
+  });
+
+  test('奇異矩陣應拋出異常', () => {
+    const A = buildMatrix([[0, 0, 1], [1, 0, 2]], 2);
+    const csc = A.toCSC();
+    expect(() => SparseLU.factor(SparseLU.analyze(csc), csc)).toThrow();
+  });
+
+  test('模式改變時 matchesPattern 返回 false', () => {
+    const A = buildMatrix(mnaEntries, 4);
+    const symbolic = SparseLU.analyze(A.toCSC());
+    A.add(3, 3, 1);
+    expect(SparseLU.matchesPattern(symbolic, A.toCSC())).toBe(false);
+  });
+});
+
+describe('SparseMatrix - klu 模式', () => {
+  test('同步求解並在 clear() 後共享符號分解', () => {
+    const A = buildMatrix(mnaEntries, 4);
+    A.setSolverMode('klu');
+    const x = Vector.from([1, 2, 3, 4]);
+    const solution = A.solve(A.multiply(x));
+    expect(solution.minus(x).norm()).toBeLessThan(1e-9);
+
+    const symbolic = A.getSymbolicFactorization();
+    expect(symbolic).not.toBeNull();
+
+    A.clear();
+    for (const [i, j, v] of mnaEntries) {
+      A.add(i, j, 2 * v);
+    }
+    const solution2 = A.solve(A.multiply(x));
+    expect(solution2.minus(x).norm()).toBeLessThan(1e-9);
+    expect(A.getSymbolicFactorization()).toBe(symbolic);
+  });
+});
+
+describe('SparseMatrix - 混合精度', () => {
+  test('單精度因子經迭代精化達到雙精度殘差', () => {
+    const n = 200;
+    const A = new SparseMatrix(n, n);
+    for (let i = 0; i < n; i++) {
+      A.add(i, i, 2.000001 + i * 1e-3);
+      if (i > 0) A.add(i, i - 1, -1);
+      if (i < n - 1) A.add(i, i + 1, -1.1);
+    }
+    A.setSolverMode('klu');
+    A.setMixedPrecision(true);
+
+    const x = Vector.from(Array.from({ length: n }, (_, i) => Math.sin(i) * 1e3));
+    const solution = A.solve(A.multiply(x));
+    expect(solution.minus(x).norm() / x.norm()).toBeLessThan(1e-12);
+    expect(A.statistics.refinementSteps).toBeGreaterThan(0);
+    expect(A.statistics.precisionFallbacks).toBe(0);
+
+    // 模式不變時沿用單精度因子重分解
+    A.loadCSC(A.toCSC());
+    A.solve(A.multiply(x));
+    expect(A.statistics.refactorizations).toBe(1);
+    expect(A.statistics.precisionFallbacks).toBe(0);
+  });
+
+  test('病態矩陣精化停滯時改用雙精度分解', () => {
+    // 8 階 Hilbert 矩陣 (κ ≈ 1e10，遠超單精度可精化範圍)
+    const n = 8;
+    const entries: Array<[number, number, number]> = [];
+    for (let i = 0; i < n; i++) {
+      for (let j = 0; j < n; j++) entries.push([i, j, 1 / (i + j + 1)]);
+    }
+    const A = buildMatrix(entries, n);
+    A.setSolverMode('klu');
+    A.setMixedPrecision(true);
+    const x = Vector.ones(n);
+    const solution = A.solve(A.multiply(x));
+    expect(A.statistics.precisionFallbacks).toBe(1);
+    expect(solution.minus(x).norm()).toBeLessThan(1e-4);
+
+    // 停滯後保持雙精度直到稀疏模式改變
+    A.loadCSC(A.toCSC());
+    A.solve(A.multiply(x));
+    expect(A.statistics.precisionFallbacks).toBe(1);
+    expect(A.statistics.refinementSteps).toBeLessThanOrEqual(10);
+  });
+});
+
+describe('SparseMatrix - 多右側向量求解', () => {
+  // 非對稱、對角佔優 (迭代模式亦可收斂)
+  function buildSystem(n: number): SparseMatrix {
+    const A = new SparseMatrix(n, n);
+    for (let i = 0; i < n; i++) {
+      A.add(i, i, 6 + (i % 3));
+      if (i > 0) A.add(i, i - 1, -1.5);
+      if (i < n - 1) A.add(i, i + 1, -0.5);
+      if (i + 7 < n) A.add(i, i + 7, 1);
+    }
+    return A;
+  }
+
+  function transposeTimes(A: SparseMatrix, x: Vector): Vector {
+    const y = new Vector(A.cols);
+    for (let i = 0; i < A.rows; i++) {
+      for (let j = 0; j < A.cols; j++) y.add(j, A.get(i, j) * x.get(i));
+    }
+    return y;
+  }
+
+  const rhs = (n: number, count: number) =>
+    Array.from({ length: count }, (_, s) => Vector.from(Array.from({ length: n }, (_, i) => Math.sin((i + 1) * (s + 1)))));
+
+  for (const mode of ['numeric', 'klu', 'auto', 'iterative'] as const) {
+    test(`${mode} 模式求解 A·X = B 與 Aᵀ·X = B`, () => {
+      const n = 50;
+      const A = buildSystem(n);
+      A.setSolverMode(mode);
+      const B = rhs(n, 40);  // 跨越兩個求解塊
+
+      const X = A.solveMany(B);
+      const XT = A.solveMany(B, true);
+      expect(X).toHaveLength(40);
+      for (let s = 0; s < B.length; s++) {
+        expect(A.multiply(X[s]!).minus(B[s]!).norm()).toBeLessThan(1e-9);
+        expect(transposeTimes(A, XT[s]!).minus(B[s]!).norm()).toBeLessThan(1e-9);
+      }
+      expect(A.solveTranspose(B[3]!).minus(XT[3]!).norm()).toBeLessThan(1e-12);
+      if (mode === 'klu') {
+        expect(A.statistics.factorizations).toBe(1);
+        expect(A.statistics.solves).toBe(81);
+      }
+    });
+  }
+
+  test('混合精度下分塊精化', () => {
+    const n = 120;
+    const A = buildSystem(n);
+    A.setSolverMode('klu');
+    A.setMixedPrecision(true);
+    const B = rhs(n, 5);
+    const XT = A.solveMany(B, true);
+    for (let s = 0; s < B.length; s++) {
+      expect(transposeTimes(A, XT[s]!).minus(B[s]!).norm() / B[s]!.norm()).toBeLessThan(1e-13);
+    }
+    expect(A.statistics.refinementSteps).toBeGreaterThan(0);
+    expect(A.statistics.precisionFallbacks).toBe(0);
+  });
+
+  test('與逐個 solve() 結果一致', () => {
+    const A = buildMatrix(mnaEntries, 4);
+    A.setSolverMode('klu');
+    const B = rhs(4, 3);
+    const X = A.solveMany(B);
+    B.forEach((b, s) => expect(X[s]!.minus(A.solve(b)).norm()).toBeLessThan(1e-15));
+    expect(A.solveMany([])).toEqual([]);
+  });
+});
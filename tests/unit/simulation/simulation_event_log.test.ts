@@ -0,0 +1,72 @@
+/**
+ * 🧪 分級日誌與事件日誌單元測試
+ *
+ * 測試級別開關、共享日誌器的統一調級、輸出目標替換，以及事件環形緩衝的覆蓋與物化
+ */
+
+import { describe, test, expect, afterEach } from 'vitest';
+import { Logger, LogLevel, getLogger, setLogLevel, setLogSink } from '../../../src/core/logging/logger';
+import { SimulationEventLog, SimulationEventType } from '../../../src/core/simulation/simulation_event_log';
+
+describe('Logger', () => {
+  afterEach(() => {
+    setLogLevel(LogLevel.WARN);
+    setLogSink(null);
+  });
+
+  test('級別開關', () => {
+    const logger = new Logger('test', LogLevel.INFO);
+    expect([logger.errorEnabled, logger.warnEnabled, logger.infoEnabled, logger.debugEnabled])
+      .toEqual([true, true, true, false]);
+    logger.setLevel(LogLevel.SILENT);
+    expect(logger.errorEnabled).toBe(false);
+  });
+
+  test('關閉的級別不輸出', () => {
+    const lines: string[] = [];
+    setLogSink((level, scope, message) => lines.push(`${LogLevel[level]} ${scope} ${message}`));
+    const logger = new Logger('test', LogLevel.WARN);
+    logger.debug('hidden');
+    logger.info('hidden');
+    logger.warn('shown');
+    logger.error('shown');
+    expect(lines).toEqual(['WARN test shown', 'ERROR test shown']);
+  });
+
+  test('setLogLevel 作用於全部共享日誌器', () => {
+    const shared = getLogger('sparse');
+    expect(getLogger('sparse')).toBe(shared);
+    setLogLevel(LogLevel.DEBUG);
+    expect(shared.debugEnabled).toBe(true);
+    expect(getLogger('new-scope').debugEnabled).toBe(true);
+    setLogLevel(LogLevel.ERROR, 'sparse');
+    expect(shared.warnEnabled).toBe(false);
+    expect(getLogger('new-scope').warnEnabled).toBe(true);
+  });
+});
+
+describe('SimulationEventLog', () => {
+  test('按記錄順序物化', () => {
+    const log = new SimulationEventLog(8);
+    log.record(SimulationEventType.INFO, 0, undefined, 'start');
+    log.record(SimulationEventType.STEP_ACCEPTED, 1e-6, 'R1', '', 2e-6);
+    const events = log.toArray();
+    expect(events).toHaveLength(2);
+    expect(events[0]!.type).toBe(SimulationEventType.INFO);
+    expect(events[0]!.value).toBeNaN();
+    expect(events[1]).toEqual({ time: 1e-6, type: SimulationEventType.STEP_ACCEPTED, deviceId: 'R1', description: '', value: 2e-6 });
+  });
+
+  test('寫滿後覆蓋最舊事件', () => {
+    const log = new SimulationEventLog(3);
+    for (let i = 0; i < 10; i++) {
+      log.record(SimulationEventType.STEP_ACCEPTED, i, undefined, '', i);
+    }
+    expect(log.size).toBe(3);
+    expect(log.droppedEvents).toBe(7);
+    expect(log.toArray().map(event => event.time)).toEqual([7, 8, 9]);
+
+    log.clear();
+    expect(log.toArray()).toEqual([]);
+  });
+});
@@ -0,0 +1,80 @@
+/**
+ * 🧪 波形壓縮單元測試
+ *
+ * 測試 XOR 無損編碼往返、分段線性編碼的誤差界，以及 WaveformStore 的透明壓縮
+ */
+
+import { describe, test, expect } from 'vitest';
+import { WaveformCodec } from '../../../src/core/simulation/waveform_codec';
+import { WaveformStore } from '../../../src/core/simulation/waveform_store';
+
+// PWM 開關節點：平台段 + 有限斜率邊沿，疊加小幅漣波
+function pwm(t: number): number {
+  const period = 10e-6;
+  const phase = (t % period) / period;
+  const edge = 0.01;
+  const level = phase < edge ? phase / edge : phase < 0.4 ? 1 : phase < 0.4 + edge ? 1 - (phase - 0.4) / edge : 0;
+  return 12 * level;
+}
+
+describe('Waveform Codec', () => {
+  test('XOR 無損往返', () => {
+    const values = [0, -0, 1, 1, 1, 1.5, -2.25, Math.PI, 1e-300, -1e300, Infinity, NaN, 1, 12, 12, 12.000001];
+    for (let i = 0; i < 200; i++) values.push(Math.sin(i * 0.1) * 1e3);
+
+    const encoded = WaveformCodec.encodeLossless(values);
+    const decoded = new Float64Array(values.length);
+    WaveformCodec.decodeLossless(encoded, decoded);
+    values.forEach((v, i) => expect(Object.is(decoded[i], v)).toBe(true));
+  });
+
+  test('分段線性編碼遵守誤差界', () => {
+    const n = 4000;
+    const time = Float64Array.from({ length: n }, (_, i) => i * 25e-9);
+    const values = time.map(t => pwm(t) + 1e-3 * Math.sin(2 * Math.PI * t / 10e-6));
+    const bound = { absoluteTolerance: 1e-3, relativeTolerance: 1e-4 };
+
+    const encoded = WaveformCodec.encodePiecewiseLinear(time, values, bound);
+    const decoded = new Float64Array(n);
+    WaveformCodec.decodePiecewiseLinear(encoded, time, decoded);
+
+    for (let i = 0; i < n; i++) {
+      const tolerance = Math.max(bound.absoluteTolerance, bound.relativeTolerance * Math.abs(values[i]!));
+      expect(Math.abs(decoded[i]! - values[i]!)).toBeLessThanOrEqual(tolerance * (1 + 1e-9));
+    }
+    expect(decoded[0]).toBe(values[0]);
+    expect(encoded.retained).toBeLessThan(n / 20);
+    expect(encoded.words.byteLength).toBeLessThan(8 * n / 20);
+  });
+
+  test('WaveformStore 透明壓縮', () => {
+    const options = { chunkBytes: 8 * 3 * 512 };
+    const plain = new WaveformStore(['V(sw)', 'I(L1)'], [], options);
+    const packed = new WaveformStore(['V(sw)', 'I(L1)'], [], {
+      ...options,
+      compression: { absoluteTolerance: 1e-3, columns: { 'I(L1)': { absoluteTolerance: 1e-4 } } }
+    });
+
+    for (let i = 0; i < 5000; i++) {
+      const t = i * 20e-9;
+      const row = [pwm(t), 1 + 0.1 * Math.sin(2 * Math.PI * t / 10e-6)];
+      plain.append(t, row);
+      packed.append(t, row);
+    }
+    expect(packed.rowCount).toBe(plain.rowCount);
+    expect(packed.compressionRatio()).toBeGreaterThan(8);
+    expect(packed.memoryUsage()).toBeLessThan(plain.memoryUsage() / 2);
+
+    const data = packed.createWaveformData(new Map([[0, 'V(sw)']]), new Map([['L1', 'I(L1)']]), new Map());
+    expect(Array.from(data.timePoints)).toEqual(Array.from(plain.getTime()));
+    const exactV = plain.getColumn('V(sw)');
+    const exactI = plain.getColumn('I(L1)');
+    const sw = data.nodeVoltages.get(0)!;
+    const il = data.deviceCurrents.get('L1')!;
+    for (let i = 0; i < exactV.length; i++) {
+      expect(Math.abs(sw[i]! - exactV[i]!)).toBeLessThanOrEqual(12 * 1e-4 + 1e-12);
+      expect(Math.abs(il[i]! - exactI[i]!)).toBeLessThanOrEqual(1.1 * 1e-4 + 1e-12);
+    }
+    expect(packed.chunks[0]!.values.length).toBe(512 * 2);
+  });
+});
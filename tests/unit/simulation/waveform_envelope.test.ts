@@ -0,0 +1,95 @@
+/**
+ * 🧪 波形包絡金字塔單元測試
+ *
+ * 測試增量包絡與暴力計算一致、查詢選層、放大時退回原始樣本，以及釋放塊後仍可查詢
+ */
+
+import { describe, test, expect } from 'vitest';
+import { WaveformStore } from '../../../src/core/simulation/waveform_store';
+
+const DT = 1e-6;
+
+// 帶尖峰的正弦：每 997 點一個窄脈衝，檢查包絡不會漏掉極值
+function signal(i: number): number {
+  return Math.sin(i * 0.01) + (i % 997 === 500 ? 5 : 0);
+}
+
+// 暴力計算每個像素的 min/max
+function bruteForce(count: number, start: number, end: number, pixels: number) {
+  const min = new Float64Array(pixels).fill(NaN);
+  const max = new Float64Array(pixels).fill(NaN);
+  for (let i = 0; i < count; i++) {
+    const t = i * DT;
+    if (t < start || t > end) continue;
+    const p = Math.min(pixels - 1, Math.floor((t - start) / (end - start) * pixels));
+    const v = signal(i);
+    if (!(v >= min[p]!)) min[p] = v;
+    if (!(v <= max[p]!)) max[p] = v;
+  }
+  return { min, max };
+}
+
+function fill(store: WaveformStore, count: number): void {
+  for (let i = 0; i < count; i++) store.append(i * DT, [signal(i), -signal(i)]);
+}
+
+describe('Waveform Envelope', () => {
+  test('縮小視圖的包絡包含全部極值', () => {
+    const count = 100_003;
+    const store = new WaveformStore(['V(out)', 'I(L1)'], [], { chunkBytes: 1 << 16, envelope: {} });
+    fill(store, count);
+
+    const end = (count - 1) * DT;
+    const pixels = 500;
+    const envelope = store.getEnvelope('V(out)', 0, end, pixels);
+    const exact = bruteForce(count, 0, end, pixels);
+    expect(envelope.level).toBeGreaterThan(5);
+
+    // 桶按起始時間歸入像素，跨越像素邊界的桶最多延伸到下一像素；全域極值必須一致
+    const global = (a: Float64Array, f: (x: number, y: number) => number) => a.reduce((x, y) => f(x, y));
+    expect(global(envelope.max, Math.max)).toBe(global(exact.max, Math.max));
+    expect(global(envelope.min, Math.min)).toBe(global(exact.min, Math.min));
+    for (let p = 1; p < pixels - 1; p++) {
+      expect(Math.max(envelope.max[p - 1]!, envelope.max[p]!)).toBeGreaterThanOrEqual(exact.max[p]!);
+      expect(Math.min(envelope.min[p - 1]!, envelope.min[p]!)).toBeLessThanOrEqual(exact.min[p]!);
+      expect(envelope.max[p]!).toBeLessThanOrEqual(Math.max(exact.max[p]!, exact.max[p + 1]!));
+      expect(envelope.min[p]!).toBeGreaterThanOrEqual(Math.min(exact.min[p]!, exact.min[p + 1]!));
+    }
+
+    const inverted = store.getEnvelope('I(L1)', 0, end, pixels);
+    expect(Array.from(inverted.max)).toEqual(Array.from(envelope.min).map(v => -v));
+  });
+
+  test('放大時退回原始樣本', () => {
+    const store = new WaveformStore(['V(out)', 'I(L1)'], [], { envelope: { minLevel: 3 } });
+    fill(store, 20_000);
+
+    const start = 0.0100005;
+    const end = 0.0101005;
+    const envelope = store.getEnvelope('V(out)', start, end, 100);
+    expect(envelope.level).toBe(0);
+    const exact = bruteForce(20_000, start, end, 100);
+    expect(Array.from(envelope.min)).toEqual(Array.from(exact.min));
+    expect(Array.from(envelope.max)).toEqual(Array.from(exact.max));
+  });
+
+  test('釋放塊後仍可查詢，未滿的桶也計入', () => {
+    const count = 50_001;
+    const store = new WaveformStore(['V(out)', 'I(L1)'], [], {
+      chunkBytes: 1 << 14, retainChunks: false, envelope: { minLevel: 4 }
+    });
+    fill(store, count);
+    expect(store.firstRetainedRow).toBeGreaterThan(0);
+
+    const end = (count - 1) * DT;
+    const envelope = store.getEnvelope('V(out)', 0, end, 200);
+    expect(envelope.level).toBeGreaterThanOrEqual(4);
+    expect(envelope.max.every(v => !Number.isNaN(v))).toBe(true);
+    expect(envelope.max[199]!).toBeGreaterThanOrEqual(signal(count - 1));
+
+    // 細於最細層的窗口：原始樣本已釋放，以最細層作答
+    const zoomed = store.getEnvelope('V(out)', 0.0100005, 0.0100505, 100);
+    expect(zoomed.level).toBe(4);
+    expect(() => store.getEnvelope('V(x)', 0, end, 10)).toThrow('Unknown waveform column');
+  });
+});
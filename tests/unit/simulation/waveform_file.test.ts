@@ -0,0 +1,130 @@
+/**
+ * 🧪 二進制列式波形文件單元測試
+ *
+ * 測試流式寫入、按信號與時間範圍隨機讀取、狀態列與 SPICE rawfile 導出
+ */
+
+import { describe, test, expect } from 'vitest';
+import { mkdtempSync, readFileSync, rmSync } from 'fs';
+import { tmpdir } from 'os';
+import { join } from 'path';
+import { WaveformStore } from '../../../src/core/simulation/waveform_store';
+import { WaveformFileReader, WaveformFileWriter } from '../../../src/core/simulation/waveform_file';
+
+// 每塊 16 行
+const SMALL_CHUNK = 8 * 3 * 16;
+
+function withDirectory(body: (directory: string) => void): void {
+  const directory = mkdtempSync(join(tmpdir(), 'akingspice-waveform-'));
+  try {
+    body(directory);
+  } finally {
+    rmSync(directory, { recursive: true, force: true });
+  }
+}
+
+function writeRamp(path: string, rows: number): void {
+  const writer = new WaveformFileWriter(path);
+  const store = new WaveformStore(['V(out)', 'I(R1)'], ['S(D1)'], {
+    chunkBytes: SMALL_CHUNK,
+    retainChunks: false,
+    sink: writer.sink
+  });
+  const off = store.encode('off');
+  const on = store.encode('on');
+  for (let i = 0; i < rows; i++) {
+    store.append(i * 1e-3, [i, -2 * i], [i < rows / 2 ? off : on]);
+  }
+  store.flush();
+  writer.close();
+}
+
+describe('Waveform File', () => {
+  test('寫入後重新打開並讀取整列', () => {
+    withDirectory(directory => {
+      const path = join(directory, 'ramp.akw');
+      writeRamp(path, 100);
+
+      const reader = WaveformFileReader.open(path);
+      try {
+        expect(reader.numericColumns).toEqual(['V(out)', 'I(R1)']);
+        expect(reader.rowCount).toBe(100);
+        expect(reader.chunkCount).toBe(Math.ceil(100 / 16));
+
+        const { time, values } = reader.readSignal('I(R1)');
+        expect(time.length).toBe(100);
+        for (let i = 0; i < 100; i++) {
+          expect(values[i]).toBe(-2 * i);
+        }
+        expect(() => reader.readSignal('V(missing)')).toThrow();
+      } finally {
+        reader.close();
+      }
+    });
+  });
+
+  test('按時間範圍隨機讀取', () => {
+    withDirectory(directory => {
+      const path = join(directory, 'ramp.akw');
+      writeRamp(path, 1000);
+
+      const reader = WaveformFileReader.open(path);
+      try {
+        // 跨越兩個塊的邊界
+        const { time, values } = reader.readSignal('V(out)', 0.0305, 0.0405);
+        expect(Array.from(values)).toEqual(Array.from({ length: 10 }, (_, k) => 31 + k));
+        expect(time[0]).toBeCloseTo(0.031, 12);
+
+        expect(reader.readTime(2, 3).length).toBe(0);
+        expect(reader.readTime(0.9985).length).toBe(1);
+      } finally {
+        reader.close();
+      }
+    });
+  });
+
+  test('狀態列讀回', () => {
+    withDirectory(directory => {
+      const path = join(directory, 'ramp.akw');
+      writeRamp(path, 40);
+
+      const reader = WaveformFileReader.open(path);
+      try {
+        const { states } = reader.readStates('S(D1)', 0.0175, 0.0215);
+        expect(states).toEqual(['off', 'off', 'on', 'on']);
+        expect(reader.readChunk(1).enums[0]!.codes.length).toBe(2);
+      } finally {
+        reader.close();
+      }
+    });
+  });
+
+  test('導出 SPICE 二進制 rawfile', () => {
+    withDirectory(directory => {
+      const path = join(directory, 'ramp.akw');
+      const rawPath = join(directory, 'ramp.raw');
+      writeRamp(path, 50);
+
+      const reader = WaveformFileReader.open(path);
+      reader.exportRawfile(rawPath, { title: 'ramp' });
+      reader.close();
+
+      const raw = readFileSync(rawPath);
+      const marker = raw.indexOf('Binary:\n');
+      const head = raw.toString('latin1', 0, marker);
+      expect(head).toContain('Title: ramp');
+      expect(head).toMatch(/No\. Variables: 3\n/);
+      expect(head).toMatch(/No\. Points: 50\s*\n/);
+      expect(head).toContain('\t1\tv(out)\tvoltage');
+      expect(head).toContain('\t2\ti(R1)\tcurrent');
+
+      const start = marker + 'Binary:\n'.length;
+      const data = new Float64Array(raw.buffer.slice(raw.byteOffset + start, raw.byteOffset + raw.length));
+      expect(data.length).toBe(50 * 3);
+      // 第 7 點：time, v(out), i(R1)
+      expect(data[7 * 3]).toBeCloseTo(0.007, 12);
+      expect(data[7 * 3 + 1]).toBe(7);
+      expect(data[7 * 3 + 2]).toBe(-14);
+    });
+  });
+});
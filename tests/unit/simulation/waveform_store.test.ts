@@ -0,0 +1,101 @@
+/**
+ * 🧪 WaveformStore 單元測試
+ *
+ * 測試分塊列式存儲的追加、封存、遊程編碼、物化與釋放
+ */
+
+import { describe, test, expect } from 'vitest';
+import { WaveformStore } from '../../../src/core/simulation/waveform_store';
+import type { WaveformChunk } from '../../../src/core/simulation/waveform_store';
+
+// 每塊 16 行 (最小塊)
+const SMALL_CHUNK = 8 * 3 * 16;
+
+describe('WaveformStore', () => {
+  test('追加與物化跨塊數據', () => {
+    const store = new WaveformStore(['V(a)', 'V(b)'], [], { chunkBytes: SMALL_CHUNK });
+    expect(store.chunkRows).toBe(16);
+
+    for (let i = 0; i < 40; i++) {
+      store.append(i * 1e-6, [i, -i]);
+    }
+    expect(store.rowCount).toBe(40);
+    expect(store.chunks.length).toBe(2);
+
+    const time = store.getTime();
+    const a = store.getColumn('V(a)');
+    const b = store.getColumn('V(b)');
+    expect(time.length).toBe(40);
+    for (let i = 0; i < 40; i++) {
+      expect(time[i]).toBe(i * 1e-6);
+      expect(a[i]).toBe(i);
+      expect(b[i]).toBe(-i);
+    }
+    expect(() => store.getColumn('V(c)')).toThrow();
+  });
+
+  test('狀態列遊程編碼', () => {
+    const store = new WaveformStore(['V(a)'], ['S(M1)'], { chunkBytes: 8 * 2 * 16 });
+    const on = store.encode('on');
+    const off = store.encode('off');
+    expect(store.encode('on')).toBe(on);
+
+    for (let i = 0; i < 16; i++) {
+      store.append(i, [0], [i < 10 ? off : on]);
+    }
+    const runs = store.chunks[0]!.enums[0]!;
+    expect(Array.from(runs.codes)).toEqual([off, on]);
+    expect(Array.from(runs.ends)).toEqual([10, 16]);
+
+    const states = store.getEnumColumn('S(M1)');
+    expect(states.length).toBe(16);
+    expect(states[9]).toBe('off');
+    expect(states[10]).toBe('on');
+  });
+
+  test('封存後交給 sink 並釋放', () => {
+    const flushed: WaveformChunk[] = [];
+    const store = new WaveformStore(['V(a)', 'V(b)'], ['S(R1)'], {
+      chunkBytes: SMALL_CHUNK,
+      retainChunks: false,
+      sink: chunk => flushed.push(chunk)
+    });
+
+    for (let i = 0; i < 1000; i++) {
+      store.append(i, [i, 2 * i], [0]);
+    }
+    store.flush();
+
+    expect(flushed.length).toBe(Math.ceil(1000 / 16));
+    expect(flushed[flushed.length - 1]!.rowCount).toBe(1000 % 16);
+    expect(flushed.reduce((sum, chunk) => sum + chunk.rowCount, 0)).toBe(1000);
+    // 列優先：第二列從 rowCount 處開始
+    const chunk = flushed[3]!;
+    expect(chunk.startRow).toBe(48);
+    expect(chunk.values[chunk.rowCount]).toBe(2 * 48);
+
+    // 內存只保留未封存的緩衝區
+    expect(store.chunks.length).toBe(0);
+    expect(store.getTime().length).toBe(0);
+    expect(store.memoryUsage()).toBeLessThan(SMALL_CHUNK * 2);
+  });
+
+  test('WaveformData 視圖按需物化', () => {
+    const store = new WaveformStore(['V(a)', 'I(R1)'], ['S(R1)'], { chunkBytes: SMALL_CHUNK });
+    const normal = store.encode('normal');
+    for (let i = 0; i < 20; i++) {
+      store.append(i, [i, i / 1000], [normal]);
+    }
+
+    const data = store.createWaveformData(
+      new Map([[0, 'V(a)']]),
+      new Map([['R1', 'I(R1)']]),
+      new Map([['R1', 'S(R1)']])
+    );
+    expect(data.timePoints.length).toBe(20);
+    expect(data.timePoints).toBe(data.timePoints);
+    expect(data.nodeVoltages.get(0)![19]).toBe(19);
+    expect(data.deviceCurrents.get('R1')![5]).toBeCloseTo(0.005, 12);
+    expect(data.deviceStates.get('R1')![0]).toBe('normal');
+  });
+});
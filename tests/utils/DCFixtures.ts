@@ -0,0 +1,33 @@
+/**
+ * 🔌 DCFixtures - DC 求解測試共用電路與工具
+ *
+ * 二極體鉗位分壓器：各 DC 策略、同倫、工作點快取與蒙特卡羅測試共用
+ */
+
+import { SpiceNetlistParser } from '../../src/core/parser/spice_netlist_parser';
+import { CircuitSimulationEngine } from '../../src/core/simulation/circuit_simulation_engine';
+import type { SimulationConfig } from '../../src/core/simulation/circuit_simulation_engine';
+
+/** 10V 經 1k/1k 分壓，out 被二極體鉗位在 ~0.6V */
+export const DIODE_CLAMP = `* diode clamp
+V1 in 0 DC 10
+R1 in out 1k
+R2 out 0 1k
+D1 out 0 DMOD
+.MODEL DMOD D IS=1e-14 N=1
+.END`;
+
+/**
+ * 以給定配置求解網表的 DC 工作點
+ *
+ * @returns out 為 V(out)，失敗時為 NaN
+ */
+export async function solveDC(netlist: string, config: Partial<SimulationConfig> = {}) {
+  const parser = new SpiceNetlistParser();
+  const engine = new CircuitSimulationEngine({ endTime: 0, ...config });
+  engine.addDevices(parser.createDevicesFromNetlist(parser.parseNetlist(netlist)));
+  const result = await engine.runSimulation();
+  const events = engine.getSimulationEvents();
+  const out = result.success ? engine.getOperatingPoint()!.get(engine.getNodeIdByName('out')!) : NaN;
+  return { engine, result, events, out };
+}